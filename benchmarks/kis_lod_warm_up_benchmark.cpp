@@ -0,0 +1,141 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <simpletest.h>
+
+#include "kis_lod_warm_up_benchmark.h"
+
+#include <QAtomicInteger>
+#include <QElapsedTimer>
+
+#include <KoColor.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+#include <kis_image.h>
+#include <kis_group_layer.h>
+#include <kis_paint_layer.h>
+#include <kis_paint_device.h>
+#include <kis_simple_stroke_strategy.h>
+#include <KisLodPreferences.h>
+
+namespace {
+
+const int IMAGE_SIZE = 4096;
+const int NUM_LAYERS = 4;
+const int LEVEL_OF_DETAIL = 2;
+const int NUM_RUNS = 10;
+
+struct DabJobData : public KisStrokeJobData
+{
+    KisStrokeJobData* createLodClone(int levelOfDetail) override {
+        Q_UNUSED(levelOfDetail);
+        return new DabJobData();
+    }
+};
+
+/**
+ * Records the time when the first dab of the stroke (which is
+ * the dab of its LoDN clone) is executed
+ */
+class FirstDabStrokeStrategy : public KisSimpleStrokeStrategy
+{
+public:
+    FirstDabStrokeStrategy(const QElapsedTimer *timer, QAtomicInteger<qint64> *latency)
+        : KisSimpleStrokeStrategy(QLatin1String("first-dab-stroke")),
+          m_timer(timer),
+          m_latency(latency)
+    {
+        enableJob(JOB_DOSTROKE);
+    }
+
+    KisStrokeStrategy* createLodClone(int levelOfDetail) override {
+        Q_UNUSED(levelOfDetail);
+        return new FirstDabStrokeStrategy(m_timer, m_latency);
+    }
+
+    void doStrokeCallback(KisStrokeJobData *data) override {
+        Q_UNUSED(data);
+        m_latency->testAndSetOrdered(-1, m_timer->nsecsElapsed());
+    }
+
+private:
+    const QElapsedTimer *m_timer;
+    QAtomicInteger<qint64> *m_latency;
+};
+
+void makeLodPlanesOutdated(KisImageSP image)
+{
+    // a stroke without a LoD clone is a legacy one
+    KisStrokeId id = image->startStroke(new KisSimpleStrokeStrategy(QLatin1String("legacy-stroke")));
+    image->endStroke(id);
+    image->waitForDone();
+}
+
+qint64 measureFirstDabLatency(KisImageSP image)
+{
+    QElapsedTimer timer;
+    QAtomicInteger<qint64> latency(-1);
+
+    timer.start();
+
+    KisStrokeId id = image->startStroke(new FirstDabStrokeStrategy(&timer, &latency));
+    image->addJob(id, new DabJobData());
+    image->endStroke(id);
+    image->waitForDone();
+
+    return latency.loadAcquire();
+}
+
+}
+
+void KisLodWarmUpBenchmark::benchmarkFirstDabLatency_data()
+{
+    QTest::addColumn<bool>("warmUp");
+
+    QTest::newRow("cold") << false;
+    QTest::newRow("warm") << true;
+}
+
+void KisLodWarmUpBenchmark::benchmarkFirstDabLatency()
+{
+    QFETCH(bool, warmUp);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, IMAGE_SIZE, IMAGE_SIZE, cs, "lod warm-up benchmark");
+
+    for (int i = 0; i < NUM_LAYERS; i++) {
+        KisPaintLayerSP layer = new KisPaintLayer(image, QString("layer %1").arg(i), OPACITY_OPAQUE_U8 / 2);
+        layer->paintDevice()->fill(image->bounds(), KoColor(QColor(64 * i, 128, 255 - 64 * i), cs));
+        image->addNode(layer, image->root());
+    }
+
+    image->initialRefreshGraph();
+
+    image->setLodPreferences(KisLodPreferences(LEVEL_OF_DETAIL));
+    image->waitForDone();
+
+    qint64 totalLatency = 0;
+
+    for (int i = 0; i < NUM_RUNS; i++) {
+        makeLodPlanesOutdated(image);
+
+        if (warmUp) {
+            // that is what the idle tasks manager does in the GUI
+            QVERIFY(image->warmUpLevelOfDetail());
+            image->waitForDone();
+        }
+
+        const qint64 latency = measureFirstDabLatency(image);
+        QVERIFY(latency >= 0);
+
+        totalLatency += latency;
+    }
+
+    QTest::setBenchmarkResult(qreal(totalLatency) / NUM_RUNS / 1000000.0, QTest::WalltimeMilliseconds);
+}
+
+SIMPLE_TEST_MAIN(KisLodWarmUpBenchmark)
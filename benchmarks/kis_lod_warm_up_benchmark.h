@@ -0,0 +1,26 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_LOD_WARM_UP_BENCHMARK_H
+#define KIS_LOD_WARM_UP_BENCHMARK_H
+
+#include <simpletest.h>
+
+/**
+ * Measures the latency of the first dab of an Instant Preview stroke
+ * started right after a legacy (non-LoD) action, with and without
+ * warming up LoD planes while the image is idle
+ */
+class KisLodWarmUpBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void benchmarkFirstDabLatency_data();
+    void benchmarkFirstDabLatency();
+};
+
+#endif
@@ -0,0 +1,205 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_swap_compression_benchmark.h"
+#include <simpletest.h>
+
+#include <QImage>
+#include <QElapsedTimer>
+
+#include <KoColorSpaceRegistry.h>
+#include <KoColorModelStandardIds.h>
+
+#include <testutil.h>
+
+#include "kis_debug.h"
+#include "kis_paint_device.h"
+#include "tiles3/kis_tile_data.h"
+#include "tiles3/swap/kis_abstract_compression.h"
+#include "tiles3/swap/kis_tile_compressor_factory.h"
+
+#define TEST_FILE "hakonepa.png"
+
+namespace {
+
+const KoColorSpace* colorSpaceForDepth(const QString &depthId)
+{
+    return KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), depthId, 0);
+}
+
+/**
+ * Splits a real image into the tile-sized chunks of raw pixel data,
+ * exactly the way they are stored in KisTileData
+ */
+QVector<QByteArray> loadTiles(const KoColorSpace *cs)
+{
+    QImage image(TestUtil::fetchDataFileLazy(TEST_FILE));
+
+    KisPaintDeviceSP dev = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb8());
+    dev->convertFromQImage(image, 0);
+    if (*dev->colorSpace() != *cs) {
+        dev->convertTo(cs);
+    }
+
+    const QRect bounds = dev->exactBounds();
+    const int tileDataSize = cs->pixelSize() * KisTileData::WIDTH * KisTileData::HEIGHT;
+
+    QVector<QByteArray> tiles;
+
+    for (int y = bounds.top(); y <= bounds.bottom(); y += KisTileData::HEIGHT) {
+        for (int x = bounds.left(); x <= bounds.right(); x += KisTileData::WIDTH) {
+            QByteArray tile(tileDataSize, Qt::Uninitialized);
+            dev->readBytes((quint8*)tile.data(), x, y, KisTileData::WIDTH, KisTileData::HEIGHT);
+            tiles.append(tile);
+        }
+    }
+
+    return tiles;
+}
+
+void addCodecRows()
+{
+    QTest::addColumn<QString>("codec");
+    QTest::addColumn<QString>("depth");
+
+    Q_FOREACH (const QString &codec, KisTileCompressorFactory::availableSwapCompressions()) {
+        Q_FOREACH (const QString &depth, QStringList() << Integer8BitsColorDepthID.id()
+                                                      << Integer16BitsColorDepthID.id()
+                                                      << Float32BitsColorDepthID.id()) {
+
+            QTest::addRow("%s-%s", codec.toLatin1().data(), depth.toLatin1().data()) << codec << depth;
+        }
+    }
+}
+
+}
+
+void KisSwapCompressionBenchmark::testRoundTrip_data()
+{
+    addCodecRows();
+}
+
+void KisSwapCompressionBenchmark::testRoundTrip()
+{
+    QFETCH(QString, codec);
+    QFETCH(QString, depth);
+
+    const KoColorSpace *cs = colorSpaceForDepth(depth);
+    if (!cs) {
+        QSKIP("Color space is not available");
+    }
+
+    QScopedPointer<KisAbstractCompression> compression(KisTileCompressorFactory::createCompression(codec));
+    QVERIFY(compression);
+
+    const QVector<QByteArray> tiles = loadTiles(cs);
+    QVERIFY(!tiles.isEmpty());
+
+    const int tileDataSize = tiles.first().size();
+    QByteArray linearized(tileDataSize, Qt::Uninitialized);
+    QByteArray compressed(compression->outputBufferSize(tileDataSize), Qt::Uninitialized);
+    QByteArray decompressed(tileDataSize, Qt::Uninitialized);
+    QByteArray result(tileDataSize, Qt::Uninitialized);
+
+    Q_FOREACH (QByteArray tile, tiles) {
+        KisAbstractCompression::linearizeColors((quint8*)tile.data(), (quint8*)linearized.data(),
+                                                tileDataSize, cs->pixelSize());
+
+        const qint32 compressedBytes =
+            compression->compress((quint8*)linearized.data(), tileDataSize,
+                                  (quint8*)compressed.data(), compressed.size());
+        QVERIFY(compressedBytes > 0);
+        QVERIFY(compressedBytes <= compressed.size());
+
+        const qint32 decompressedBytes =
+            compression->decompress((quint8*)compressed.data(), compressedBytes,
+                                    (quint8*)decompressed.data(), tileDataSize);
+        QCOMPARE(decompressedBytes, tileDataSize);
+
+        KisAbstractCompression::delinearizeColors((quint8*)decompressed.data(), (quint8*)result.data(),
+                                                  tileDataSize, cs->pixelSize());
+        QCOMPARE(result, tile);
+    }
+}
+
+void KisSwapCompressionBenchmark::benchmarkCodecs_data()
+{
+    addCodecRows();
+}
+
+void KisSwapCompressionBenchmark::benchmarkCodecs()
+{
+    QFETCH(QString, codec);
+    QFETCH(QString, depth);
+
+    const KoColorSpace *cs = colorSpaceForDepth(depth);
+    if (!cs) {
+        QSKIP("Color space is not available");
+    }
+
+    QScopedPointer<KisAbstractCompression> compression(KisTileCompressorFactory::createCompression(codec));
+    QVERIFY(compression);
+
+    QVector<QByteArray> tiles = loadTiles(cs);
+    QVERIFY(!tiles.isEmpty());
+
+    const int numPasses = 10;
+    const int tileDataSize = tiles.first().size();
+    const qint64 totalUncompressed = qint64(numPasses) * tiles.size() * tileDataSize;
+
+    QByteArray linearized(tileDataSize, Qt::Uninitialized);
+    QVector<QByteArray> compressedTiles(tiles.size());
+    qint64 totalCompressed = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int pass = 0; pass < numPasses; pass++) {
+        totalCompressed = 0;
+
+        for (int i = 0; i < tiles.size(); i++) {
+            QByteArray &compressed = compressedTiles[i];
+            compressed.resize(compression->outputBufferSize(tileDataSize));
+
+            KisAbstractCompression::linearizeColors((quint8*)tiles[i].data(), (quint8*)linearized.data(),
+                                                    tileDataSize, cs->pixelSize());
+
+            const qint32 bytes = compression->compress((quint8*)linearized.data(), tileDataSize,
+                                                       (quint8*)compressed.data(), compressed.size());
+            compressed.resize(bytes);
+            totalCompressed += qMin(bytes, tileDataSize);
+        }
+    }
+
+    const qint64 compressionTime = timer.nsecsElapsed();
+    timer.restart();
+
+    for (int pass = 0; pass < numPasses; pass++) {
+        for (int i = 0; i < tiles.size(); i++) {
+            const QByteArray &compressed = compressedTiles[i];
+
+            compression->decompress((const quint8*)compressed.data(), compressed.size(),
+                                    (quint8*)linearized.data(), tileDataSize);
+            KisAbstractCompression::delinearizeColors((quint8*)linearized.data(), (quint8*)tiles[i].data(),
+                                                      tileDataSize, cs->pixelSize());
+        }
+    }
+
+    const qint64 decompressionTime = timer.nsecsElapsed();
+
+    auto megabytesPerSecond = [totalUncompressed] (qint64 nsecs) {
+        return nsecs > 0 ? qreal(totalUncompressed) / (1 << 20) / (qreal(nsecs) / 1e9) : 0.0;
+    };
+
+    qInfo().noquote() << QString("%1 %2: compression %3 MB/s, decompression %4 MB/s, ratio %5")
+                         .arg(codec, -4)
+                         .arg(depth, -4)
+                         .arg(megabytesPerSecond(compressionTime), 8, 'f', 1)
+                         .arg(megabytesPerSecond(decompressionTime), 8, 'f', 1)
+                         .arg(qreal(tiles.size() * tileDataSize) / totalCompressed, 0, 'f', 3);
+}
+
+SIMPLE_TEST_MAIN(KisSwapCompressionBenchmark)
@@ -0,0 +1,23 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KIS_SWAP_COMPRESSION_BENCHMARK_H
+#define KIS_SWAP_COMPRESSION_BENCHMARK_H
+
+#include <simpletest.h>
+
+class KisSwapCompressionBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testRoundTrip_data();
+    void testRoundTrip();
+
+    void benchmarkCodecs_data();
+    void benchmarkCodecs();
+};
+
+#endif /* KIS_SWAP_COMPRESSION_BENCHMARK_H */
@@ -0,0 +1,180 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_swapped_data_store_benchmark.h"
+#include <simpletest.h>
+
+#include <QElapsedTimer>
+#include <QSet>
+#include <QThread>
+
+#include "kis_debug.h"
+
+#include "tiles3/kis_tile_data.h"
+#include "tiles3/kis_tile_data_store.h"
+#include "tiles3/kis_tile_data_store_iterators.h"
+
+
+namespace {
+
+const qint32 PIXEL_SIZE = 4;
+const qint32 NUM_TILES_PER_THREAD = 512;
+const qint32 NUM_CYCLES = 16;
+
+inline quint8 patternValue(qint32 tileIndex, qint32 byteIndex)
+{
+    return quint8(tileIndex + (byteIndex / PIXEL_SIZE) % 61 + byteIndex % PIXEL_SIZE);
+}
+
+/**
+ * Every thread owns its own set of tile data objects and loads
+ * them from swap the same way KisTile does, that is, via
+ * KisTileData::blockSwapping() and
+ * KisTileDataStore::ensureTileDataLoaded()
+ */
+class SwappingInThread : public QThread
+{
+public:
+    SwappingInThread(KisTileDataStore *store, qint32 firstTileIndex)
+        : m_store(store),
+          m_firstTileIndex(firstTileIndex)
+    {
+        const quint8 defaultPixel[PIXEL_SIZE] = {0};
+        const qint32 dataSize = PIXEL_SIZE * KisTileData::WIDTH * KisTileData::HEIGHT;
+
+        for (qint32 i = 0; i < NUM_TILES_PER_THREAD; i++) {
+            KisTileData *td = new KisTileData(PIXEL_SIZE, defaultPixel, m_store, false);
+
+            for (qint32 j = 0; j < dataSize; j++) {
+                td->data()[j] = patternValue(m_firstTileIndex + i, j);
+            }
+
+            m_store->registerTileData(td);
+            m_tiles.append(td);
+        }
+    }
+
+    ~SwappingInThread() override
+    {
+        Q_FOREACH (KisTileData *td, m_tiles) {
+            m_store->freeTileData(td);
+        }
+    }
+
+    const QList<KisTileData*>& tiles() const {
+        return m_tiles;
+    }
+
+    bool hasFailed() const {
+        return m_failed;
+    }
+
+protected:
+    void run() override
+    {
+        for (qint32 i = 0; i < m_tiles.size(); i++) {
+            KisTileData *td = m_tiles[i];
+
+            td->blockSwapping();
+            const bool isCorrect =
+                td->data()[PIXEL_SIZE * 77] == patternValue(m_firstTileIndex + i, PIXEL_SIZE * 77);
+            td->unblockSwapping();
+
+            if (!isCorrect) {
+                m_failed = true;
+                return;
+            }
+        }
+    }
+
+private:
+    KisTileDataStore *m_store;
+    qint32 m_firstTileIndex;
+    QList<KisTileData*> m_tiles;
+    bool m_failed = false;
+};
+
+qint32 swapOutTiles(KisTileDataStore *store, const QSet<KisTileData*> &tiles)
+{
+    qint32 numSwappedOut = 0;
+
+    KisTileDataStoreIterator *iter = store->beginIteration();
+
+    while (iter->hasNext()) {
+        KisTileData *td = iter->next();
+
+        if (tiles.contains(td) && iter->trySwapOut(td)) {
+            numSwappedOut++;
+        }
+    }
+
+    store->endIteration(iter);
+
+    return numSwappedOut;
+}
+
+}
+
+void KisSwappedDataStoreBenchmark::benchmarkConcurrentSwapping_data()
+{
+    QTest::addColumn<int>("numThreads");
+
+    Q_FOREACH (int numThreads, QList<int>() << 1 << 2 << 4 << 8) {
+        QTest::addRow("threads-%d", numThreads) << numThreads;
+    }
+}
+
+void KisSwappedDataStoreBenchmark::benchmarkConcurrentSwapping()
+{
+    QFETCH(int, numThreads);
+
+    KisTileDataStore *store = KisTileDataStore::instance();
+
+    QList<SwappingInThread*> threads;
+    QSet<KisTileData*> tiles;
+
+    for (int i = 0; i < numThreads; i++) {
+        SwappingInThread *thread = new SwappingInThread(store, i * NUM_TILES_PER_THREAD);
+        threads.append(thread);
+
+        Q_FOREACH (KisTileData *td, thread->tiles()) {
+            tiles.insert(td);
+        }
+    }
+
+    qint64 elapsed = 0;
+    qint64 numSwapIns = 0;
+
+    for (qint32 cycle = 0; cycle < NUM_CYCLES; cycle++) {
+        numSwapIns += swapOutTiles(store, tiles);
+
+        QElapsedTimer timer;
+        timer.start();
+
+        Q_FOREACH (SwappingInThread *thread, threads) {
+            thread->start();
+        }
+
+        Q_FOREACH (SwappingInThread *thread, threads) {
+            thread->wait();
+        }
+
+        elapsed += timer.nsecsElapsed();
+
+        Q_FOREACH (SwappingInThread *thread, threads) {
+            QVERIFY(!thread->hasFailed());
+        }
+    }
+
+    qInfo().noquote() << QString("shards: %1 threads: %2: %3 swap-ins per second")
+                         .arg(store->m_swappedStore.numShards(), 2)
+                         .arg(numThreads, 2)
+                         .arg(qreal(numSwapIns) / (qreal(elapsed) / 1e9), 10, 'f', 0);
+
+    qDeleteAll(threads);
+}
+
+SIMPLE_TEST_MAIN(KisSwappedDataStoreBenchmark)
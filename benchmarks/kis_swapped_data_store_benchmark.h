@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KIS_SWAPPED_DATA_STORE_BENCHMARK_H
+#define KIS_SWAPPED_DATA_STORE_BENCHMARK_H
+
+#include <simpletest.h>
+
+class KisSwappedDataStoreBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void benchmarkConcurrentSwapping_data();
+    void benchmarkConcurrentSwapping();
+};
+
+#endif /* KIS_SWAPPED_DATA_STORE_BENCHMARK_H */
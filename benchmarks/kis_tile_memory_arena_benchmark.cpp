@@ -0,0 +1,112 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_tile_memory_arena_benchmark.h"
+
+#include <simpletest.h>
+
+#include <thread>
+#include <vector>
+
+#include "tiles3/kis_tile_memory_arena.h"
+#include "tiles3/kis_tile_data_interface.h"
+
+#define PIXEL_SIZE 4
+#define NUM_CYCLES 200
+#define NUM_BUFFERS 256
+
+namespace {
+
+/**
+ * Emulates a stroke: every thread allocates a bunch of tiles,
+ * touches them and then frees them in a different order
+ */
+void allocationLoop(bool useArena)
+{
+    const int bufferSize = PIXEL_SIZE * __TILE_DATA_WIDTH * __TILE_DATA_HEIGHT;
+    std::vector<quint8*> buffers(NUM_BUFFERS);
+
+    for (int cycle = 0; cycle < NUM_CYCLES; cycle++) {
+        for (int i = 0; i < NUM_BUFFERS; i++) {
+            buffers[i] = useArena ?
+                KisTileMemoryArena::instance()->allocate(PIXEL_SIZE) :
+                (quint8*) malloc(bufferSize);
+
+            buffers[i][0] = quint8(i);
+        }
+
+        for (int i = 0; i < NUM_BUFFERS; i++) {
+            quint8 *ptr = buffers[(i * 7) % NUM_BUFFERS];
+
+            if (useArena) {
+                KisTileMemoryArena::instance()->release(ptr, PIXEL_SIZE);
+            } else {
+                free(ptr);
+            }
+        }
+    }
+}
+
+void runAllocationThreads(bool useArena, int numThreads)
+{
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < numThreads; i++) {
+        threads.emplace_back(allocationLoop, useArena);
+    }
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+}
+
+void KisTileMemoryArenaBenchmark::benchmarkAllocation_data()
+{
+    QTest::addColumn<bool>("useArena");
+    QTest::addColumn<int>("numThreads");
+
+    for (int numThreads : {1, 4, 8}) {
+        QTest::addRow("malloc, %d threads", numThreads) << false << numThreads;
+        QTest::addRow("arena, %d threads", numThreads) << true << numThreads;
+    }
+}
+
+void KisTileMemoryArenaBenchmark::benchmarkAllocation()
+{
+    QFETCH(bool, useArena);
+    QFETCH(int, numThreads);
+
+    QBENCHMARK {
+        runAllocationThreads(useArena, numThreads);
+    }
+}
+
+void KisTileMemoryArenaBenchmark::benchmarkReservedMemory_data()
+{
+    QTest::addColumn<int>("numThreads");
+
+    for (int numThreads : {1, 4, 8}) {
+        QTest::addRow("%d threads", numThreads) << numThreads;
+    }
+}
+
+void KisTileMemoryArenaBenchmark::benchmarkReservedMemory()
+{
+    QFETCH(int, numThreads);
+
+    runAllocationThreads(true, numThreads);
+
+    KisTileMemoryArena::instance()->trimAllMemory();
+
+    KisTileMemoryArena::Statistics stats =
+        KisTileMemoryArena::instance()->statistics();
+
+    QTest::setBenchmarkResult(stats.reservedSize, QTest::BytesAllocated);
+}
+
+SIMPLE_TEST_MAIN(KisTileMemoryArenaBenchmark)
@@ -0,0 +1,28 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_TILE_MEMORY_ARENA_BENCHMARK_H
+#define KIS_TILE_MEMORY_ARENA_BENCHMARK_H
+
+#include <simpletest.h>
+
+class KisTileMemoryArenaBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void benchmarkAllocation_data();
+    void benchmarkAllocation();
+
+    /**
+     * Reports the memory reserved by the arena after the
+     * allocation loop and trimming of the free buffers
+     */
+    void benchmarkReservedMemory_data();
+    void benchmarkReservedMemory();
+};
+
+#endif
@@ -0,0 +1,197 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_tile_size_benchmark.h"
+#include "kis_benchmark_values.h"
+
+#include <QBuffer>
+#include <QRandomGenerator>
+
+#include <simpletest.h>
+
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoCompositeOpRegistry.h>
+
+#include "kis_paint_device.h"
+#include "kis_painter.h"
+#include "kis_iterator_ng.h"
+#include "kis_paint_device_writer.h"
+#include "kis_image_config.h"
+
+#include "tiles3/kis_tile_data.h"
+#include "tiles3/kis_tile_data_store.h"
+#include "tiles3/swap/kis_swapped_data_store.h"
+
+namespace {
+
+class BufferPaintDeviceWriter : public KisPaintDeviceWriter
+{
+public:
+    BufferPaintDeviceWriter(QBuffer *buffer)
+        : m_buffer(buffer)
+    {
+    }
+
+    bool write(const QByteArray &data) override {
+        return m_buffer->write(data) == data.size();
+    }
+
+    bool write(const char* data, qint64 length) override {
+        return m_buffer->write(data, length) == length;
+    }
+
+private:
+    QBuffer *m_buffer;
+};
+
+/**
+ * Fills the buffer with a smooth gradient and some noise, so that
+ * the compression has some work to do, but doesn't fail completely
+ */
+void fillWithTestData(quint8 *data, int width, int height, int pixelSize)
+{
+    QRandomGenerator rng(1);
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            for (int i = 0; i < pixelSize; i++) {
+                *data++ = quint8((x + y) / 32 + (rng.bounded(4)));
+            }
+        }
+    }
+}
+
+}
+
+void KisTileSizeBenchmark::initTestCase()
+{
+    qDebug() << "Tile size:" << KisTileData::WIDTH << "x" << KisTileData::HEIGHT;
+
+    m_colorSpace = KoColorSpaceRegistry::instance()->rgb8();
+    m_device = new KisPaintDevice(m_colorSpace);
+
+    const int pixelSize = m_colorSpace->pixelSize();
+    QByteArray buffer(TEST_IMAGE_WIDTH * TEST_IMAGE_HEIGHT * pixelSize, Qt::Uninitialized);
+    fillWithTestData((quint8*)buffer.data(), TEST_IMAGE_WIDTH, TEST_IMAGE_HEIGHT, pixelSize);
+
+    m_device->writeBytes((const quint8*)buffer.constData(), 0, 0, TEST_IMAGE_WIDTH, TEST_IMAGE_HEIGHT);
+}
+
+void KisTileSizeBenchmark::cleanupTestCase()
+{
+    m_device = 0;
+}
+
+void KisTileSizeBenchmark::benchmarkHLineIterator()
+{
+    const int pixelSize = m_colorSpace->pixelSize();
+    quint64 sum = 0;
+
+    QBENCHMARK {
+        KisHLineConstIteratorSP it = m_device->createHLineConstIteratorNG(0, 0, TEST_IMAGE_WIDTH);
+
+        for (int y = 0; y < TEST_IMAGE_HEIGHT; y++) {
+            do {
+                sum += it->rawDataConst()[pixelSize - 1];
+            } while (it->nextPixel());
+            it->nextRow();
+        }
+    }
+
+    QVERIFY(sum > 0);
+}
+
+void KisTileSizeBenchmark::benchmarkVLineIterator()
+{
+    const int pixelSize = m_colorSpace->pixelSize();
+    quint64 sum = 0;
+
+    QBENCHMARK {
+        KisVLineConstIteratorSP it = m_device->createVLineConstIteratorNG(0, 0, TEST_IMAGE_HEIGHT);
+
+        for (int x = 0; x < TEST_IMAGE_WIDTH; x++) {
+            do {
+                sum += it->rawDataConst()[pixelSize - 1];
+            } while (it->nextPixel());
+            it->nextColumn();
+        }
+    }
+
+    QVERIFY(sum > 0);
+}
+
+void KisTileSizeBenchmark::benchmarkBitBlt()
+{
+    KisPaintDeviceSP dstDevice = new KisPaintDevice(m_colorSpace);
+
+    QBENCHMARK {
+        KisPainter gc(dstDevice);
+        gc.setCompositeOpId(COMPOSITE_OVER);
+        gc.bitBlt(0, 0, m_device, 0, 0, TEST_IMAGE_WIDTH, TEST_IMAGE_HEIGHT);
+    }
+}
+
+void KisTileSizeBenchmark::benchmarkSwapRoundTrip()
+{
+    /**
+     * The amount of data is the same for all the tile sizes
+     */
+    const int pixelSize = m_colorSpace->pixelSize();
+    const int tileDataSize = pixelSize * KisTileData::WIDTH * KisTileData::HEIGHT;
+    const int numTiles = 64 * MiB / tileDataSize;
+
+    KisImageConfig config(false);
+    config.setMaxSwapSize(1024);
+
+    KisSwappedDataStore store;
+
+    QByteArray pattern(tileDataSize, Qt::Uninitialized);
+    fillWithTestData((quint8*)pattern.data(), KisTileData::WIDTH, KisTileData::HEIGHT, pixelSize);
+
+    const quint8 defaultPixel[4] = {0, 0, 0, 0};
+    QVector<KisTileData*> tileDataList;
+
+    for (int i = 0; i < numTiles; i++) {
+        KisTileData *td = new KisTileData(pixelSize, defaultPixel, KisTileDataStore::instance());
+
+        // make the tiles different to avoid deduplication
+        memcpy(td->data(), pattern.constData(), tileDataSize);
+        memcpy(td->data(), &i, sizeof(i));
+
+        tileDataList.append(td);
+    }
+
+    QBENCHMARK_ONCE {
+        Q_FOREACH (KisTileData *td, tileDataList) {
+            QVERIFY(store.trySwapOutTileData(td));
+        }
+
+        Q_FOREACH (KisTileData *td, tileDataList) {
+            store.swapInTileData(td);
+        }
+    }
+
+    qDeleteAll(tileDataList);
+}
+
+void KisTileSizeBenchmark::benchmarkSave()
+{
+    qint64 size = 0;
+
+    QBENCHMARK {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        BufferPaintDeviceWriter writer(&buffer);
+
+        QVERIFY(m_device->write(writer));
+        size = buffer.size();
+    }
+
+    qDebug() << "Saved size:" << size;
+}
+
+SIMPLE_TEST_MAIN(KisTileSizeBenchmark)
@@ -0,0 +1,40 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_TILE_SIZE_BENCHMARK_H
+#define KIS_TILE_SIZE_BENCHMARK_H
+
+#include <simpletest.h>
+
+#include <kis_types.h>
+
+class KoColorSpace;
+
+/**
+ * The tile size is selected at build time (KRITA_TILE_SIZE), so to
+ * compare different sizes, build Krita with each of them and run
+ * this benchmark in every build.
+ */
+class KisTileSizeBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkHLineIterator();
+    void benchmarkVLineIterator();
+    void benchmarkBitBlt();
+    void benchmarkSwapRoundTrip();
+    void benchmarkSave();
+
+private:
+    const KoColorSpace *m_colorSpace = 0;
+    KisPaintDeviceSP m_device;
+};
+
+#endif
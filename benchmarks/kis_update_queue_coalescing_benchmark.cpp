@@ -0,0 +1,188 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <simpletest.h>
+
+#include "kis_update_queue_coalescing_benchmark.h"
+
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+
+#include <KoColor.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+#include <kis_image.h>
+#include <kis_image_config.h>
+#include <kis_group_layer.h>
+#include <kis_paint_layer.h>
+#include <kis_paint_device.h>
+#include <kis_simple_update_queue.h>
+
+namespace {
+
+const int IMAGE_SIZE = 4096;
+const int NUM_LAYERS = 4;
+const int NUM_BATCHES = 200;
+const int DABS_PER_BATCH = 50;
+const int DAB_SIZE = 3;
+const int SPRAY_RADIUS = 150;
+
+/**
+ * Every batch is the dirty region of one update of a spray
+ * stroke moving diagonally across the image
+ */
+QVector<QVector<QRect>> sprayBatches()
+{
+    QRandomGenerator random(42);
+    QVector<QVector<QRect>> batches;
+
+    for (int i = 0; i < NUM_BATCHES; i++) {
+        const QPoint center(SPRAY_RADIUS + i * (IMAGE_SIZE - 2 * SPRAY_RADIUS) / NUM_BATCHES,
+                            SPRAY_RADIUS + i * (IMAGE_SIZE - 2 * SPRAY_RADIUS) / NUM_BATCHES);
+
+        QVector<QRect> batch;
+        for (int j = 0; j < DABS_PER_BATCH; j++) {
+            const QPoint offset(random.bounded(-SPRAY_RADIUS, SPRAY_RADIUS),
+                                random.bounded(-SPRAY_RADIUS, SPRAY_RADIUS));
+            batch.append(QRect(center + offset, QSize(DAB_SIZE, DAB_SIZE)));
+        }
+        batches.append(batch);
+    }
+
+    return batches;
+}
+
+/**
+ * Switches off the coalescing of the rects for the lifetime
+ * of the object by nullifying the overhead of the walkers
+ */
+struct CoalescingOverride
+{
+    CoalescingOverride(bool coalesce)
+        : m_oldWalkerOverhead(KisImageConfig(true).updateWalkerOverhead()),
+          m_oldNodeOverhead(KisImageConfig(true).updateNodeOverhead())
+    {
+        KisImageConfig cfg(false);
+        cfg.setUpdateWalkerOverhead(coalesce ? cfg.updateWalkerOverhead(true) : 0);
+        cfg.setUpdateNodeOverhead(coalesce ? cfg.updateNodeOverhead(true) : 0);
+    }
+
+    ~CoalescingOverride() {
+        KisImageConfig cfg(false);
+        cfg.setUpdateWalkerOverhead(m_oldWalkerOverhead);
+        cfg.setUpdateNodeOverhead(m_oldNodeOverhead);
+    }
+
+private:
+    int m_oldWalkerOverhead;
+    int m_oldNodeOverhead;
+};
+
+void addCoalescingData()
+{
+    QTest::addColumn<bool>("coalesce");
+
+    QTest::newRow("plain") << false;
+    QTest::newRow("coalesced") << true;
+}
+
+KisImageSP createImage(KisPaintLayerSP *topLayer)
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, IMAGE_SIZE, IMAGE_SIZE, cs, "coalescing benchmark");
+
+    for (int i = 0; i < NUM_LAYERS; i++) {
+        KisPaintLayerSP layer = new KisPaintLayer(image, QString("layer %1").arg(i), OPACITY_OPAQUE_U8 / 2);
+        layer->paintDevice()->fill(image->bounds(), KoColor(QColor(64 * i, 128, 255 - 64 * i), cs));
+        image->addNode(layer, image->root());
+        *topLayer = layer;
+    }
+
+    image->initialRefreshGraph();
+
+    return image;
+}
+
+int countWalkers(KisNodeSP node, const QVector<QVector<QRect>> &batches, const QRect &bounds)
+{
+    KisTestableSimpleUpdateQueue queue;
+
+    Q_FOREACH (const QVector<QRect> &batch, batches) {
+        queue.addUpdateJob(node, batch, bounds, 0, KisProjectionUpdateFlag::None);
+    }
+
+    return queue.getWalkersList().size();
+}
+
+}
+
+void KisUpdateQueueCoalescingBenchmark::benchmarkQueueing_data()
+{
+    addCoalescingData();
+}
+
+void KisUpdateQueueCoalescingBenchmark::benchmarkQueueing()
+{
+    QFETCH(bool, coalesce);
+    CoalescingOverride coalescingOverride(coalesce);
+
+    KisPaintLayerSP topLayer;
+    KisImageSP image = createImage(&topLayer);
+
+    const QVector<QVector<QRect>> batches = sprayBatches();
+
+    qDebug() << "rects:" << NUM_BATCHES * DABS_PER_BATCH
+             << "walkers:" << countWalkers(topLayer, batches, image->bounds());
+
+    QBENCHMARK {
+        countWalkers(topLayer, batches, image->bounds());
+    }
+}
+
+void KisUpdateQueueCoalescingBenchmark::benchmarkScatteredDabs_data()
+{
+    addCoalescingData();
+}
+
+void KisUpdateQueueCoalescingBenchmark::benchmarkScatteredDabs()
+{
+    QFETCH(bool, coalesce);
+    CoalescingOverride coalescingOverride(coalesce);
+
+    KisPaintLayerSP topLayer;
+    KisImageSP image = createImage(&topLayer);
+
+    const QVector<QVector<QRect>> batches = sprayBatches();
+
+    /**
+     * The walkers may also be merged with the ones still pending
+     * in the image's queue, so the number is an upper estimate
+     */
+    const int numWalkers = countWalkers(topLayer, batches, image->bounds());
+
+    QElapsedTimer timer;
+    timer.start();
+
+    int iterations = 0;
+
+    QBENCHMARK {
+        iterations++;
+
+        Q_FOREACH (const QVector<QRect> &batch, batches) {
+            topLayer->setDirty(batch);
+        }
+        image->waitForDone();
+    }
+
+    const qreal seconds = qMax(qreal(1e-3), qreal(timer.elapsed()) / 1000);
+
+    qDebug() << "walkers:" << numWalkers
+             << "total time:" << timer.elapsed() << "ms"
+             << "walkers per second:" << qRound(numWalkers * iterations / seconds);
+}
+
+SIMPLE_TEST_MAIN(KisUpdateQueueCoalescingBenchmark)
@@ -0,0 +1,29 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_UPDATE_QUEUE_COALESCING_BENCHMARK_H
+#define KIS_UPDATE_QUEUE_COALESCING_BENCHMARK_H
+
+#include <simpletest.h>
+
+/**
+ * Measures the overhead of the merge walkers created for scattered
+ * dabs (like the ones of a spray brush) with and without coalescing
+ * of small rects in KisSimpleUpdateQueue
+ */
+class KisUpdateQueueCoalescingBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void benchmarkQueueing_data();
+    void benchmarkQueueing();
+
+    void benchmarkScatteredDabs_data();
+    void benchmarkScatteredDabs();
+};
+
+#endif
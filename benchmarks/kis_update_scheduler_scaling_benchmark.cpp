@@ -0,0 +1,127 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <simpletest.h>
+
+#include "kis_update_scheduler_scaling_benchmark.h"
+
+#include <KoColor.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+#include <kis_image.h>
+#include <kis_group_layer.h>
+#include <kis_paint_layer.h>
+#include <kis_paint_device.h>
+#include <KisRunnableBasedStrokeStrategy.h>
+#include <KisRunnableStrokeJobData.h>
+
+namespace {
+
+const int IMAGE_SIZE = 4096;
+const int JOB_SIZE = 32;
+const int JOB_SPACING = 64;
+const int NUM_LAYERS = 4;
+
+void addThreadsData()
+{
+    QTest::addColumn<int>("threads");
+
+    for (int threads = 1; threads <= 64; threads *= 2) {
+        QTest::newRow(QString("%1").arg(threads).toLatin1()) << threads;
+    }
+}
+
+/**
+ * The rects are separated by gaps, so that the update queue
+ * could not merge them into bigger patches
+ */
+QVector<QRect> smallJobRects()
+{
+    QVector<QRect> rects;
+
+    for (int y = 0; y < IMAGE_SIZE; y += JOB_SPACING) {
+        for (int x = 0; x < IMAGE_SIZE; x += JOB_SPACING) {
+            rects.append(QRect(x, y, JOB_SIZE, JOB_SIZE));
+        }
+    }
+
+    return rects;
+}
+
+}
+
+void KisUpdateSchedulerScalingBenchmark::benchmarkMergeJobs_data()
+{
+    addThreadsData();
+}
+
+void KisUpdateSchedulerScalingBenchmark::benchmarkMergeJobs()
+{
+    QFETCH(int, threads);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, IMAGE_SIZE, IMAGE_SIZE, cs, "scaling benchmark");
+    image->setWorkingThreadsLimit(threads);
+
+    KisPaintLayerSP topLayer;
+
+    for (int i = 0; i < NUM_LAYERS; i++) {
+        KisPaintLayerSP layer = new KisPaintLayer(image, QString("layer %1").arg(i), OPACITY_OPAQUE_U8 / 2);
+        layer->paintDevice()->fill(image->bounds(), KoColor(QColor(64 * i, 128, 255 - 64 * i), cs));
+        image->addNode(layer, image->root());
+        topLayer = layer;
+    }
+
+    image->initialRefreshGraph();
+
+    const QVector<QRect> rects = smallJobRects();
+
+    QBENCHMARK {
+        Q_FOREACH (const QRect &rc, rects) {
+            topLayer->setDirty(rc);
+        }
+        image->waitForDone();
+    }
+}
+
+void KisUpdateSchedulerScalingBenchmark::benchmarkStrokeJobs_data()
+{
+    addThreadsData();
+}
+
+void KisUpdateSchedulerScalingBenchmark::benchmarkStrokeJobs()
+{
+    QFETCH(int, threads);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, IMAGE_SIZE, IMAGE_SIZE, cs, "scaling benchmark");
+    image->setWorkingThreadsLimit(threads);
+
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+    const KoColor color(Qt::red, cs);
+
+    const QVector<QRect> rects = smallJobRects();
+
+    QBENCHMARK {
+        KisStrokeId id = image->startStroke(
+            new KisRunnableBasedStrokeStrategy(QLatin1String("scaling-benchmark-stroke")));
+
+        Q_FOREACH (const QRect &rc, rects) {
+            image->addJob(id,
+                new KisRunnableStrokeJobData(
+                    [dev, rc, color] () {
+                        dev->fill(rc, color);
+                    },
+                    KisStrokeJobData::CONCURRENT));
+        }
+
+        image->endStroke(id);
+        image->waitForDone();
+    }
+}
+
+SIMPLE_TEST_MAIN(KisUpdateSchedulerScalingBenchmark)
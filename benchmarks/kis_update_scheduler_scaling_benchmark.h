@@ -0,0 +1,30 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_UPDATE_SCHEDULER_SCALING_BENCHMARK_H
+#define KIS_UPDATE_SCHEDULER_SCALING_BENCHMARK_H
+
+#include <simpletest.h>
+
+/**
+ * Measures how the update scheduler scales with the number of
+ * working threads, when the image is fed with lots of small jobs:
+ * merge jobs (like the updates of a brush stroke) and concurrent
+ * stroke jobs (like the dabs of a multithreaded brush)
+ */
+class KisUpdateSchedulerScalingBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void benchmarkMergeJobs_data();
+    void benchmarkMergeJobs();
+
+    void benchmarkStrokeJobs_data();
+    void benchmarkStrokeJobs();
+};
+
+#endif
@@ -0,0 +1,88 @@
+# SPDX-License-Identifier: BSD-3-Clause
+# SPDX-FileCopyrightText: 2026 Krita developers
+
+#[=======================================================================[.rst:
+FindLZ4
+-------
+
+Find LZ4 headers and library.
+
+Imported Targets
+^^^^^^^^^^^^^^^^
+
+``LZ4::LZ4``
+  The LZ4 library, if found.
+
+Result Variables
+^^^^^^^^^^^^^^^^
+
+This will define the following variables in your project:
+
+``LZ4_FOUND``
+  true if (the requested version of) LZ4 is available.
+``LZ4_VERSION``
+  the version of LZ4.
+``LZ4_LIBRARIES``
+  the libraries to link against to use LZ4.
+``LZ4_INCLUDE_DIRS``
+  where to find the LZ4 headers.
+
+#]=======================================================================]
+
+include(FindPackageHandleStandardArgs)
+
+find_package(PkgConfig QUIET)
+
+if (PkgConfig_FOUND)
+    pkg_check_modules(PC_LZ4 QUIET liblz4)
+    set(LZ4_VERSION ${PC_LZ4_VERSION})
+endif ()
+
+find_path(LZ4_INCLUDE_DIR
+    NAMES lz4.h
+    HINTS ${PC_LZ4_INCLUDEDIR} ${PC_LZ4_INCLUDE_DIRS}
+)
+
+find_library(LZ4_LIBRARY
+    NAMES lz4 liblz4
+    HINTS ${PC_LZ4_LIBDIR} ${PC_LZ4_LIBRARY_DIRS}
+)
+
+if (NOT LZ4_VERSION AND LZ4_INCLUDE_DIR)
+    file(READ ${LZ4_INCLUDE_DIR}/lz4.h _lz4_version_content)
+
+    string(REGEX MATCH "#define LZ4_VERSION_MAJOR[ \t]+([0-9]+)" _major_match ${_lz4_version_content})
+    set(_lz4_major ${CMAKE_MATCH_1})
+    string(REGEX MATCH "#define LZ4_VERSION_MINOR[ \t]+([0-9]+)" _minor_match ${_lz4_version_content})
+    set(_lz4_minor ${CMAKE_MATCH_1})
+    string(REGEX MATCH "#define LZ4_VERSION_RELEASE[ \t]+([0-9]+)" _release_match ${_lz4_version_content})
+    set(_lz4_release ${CMAKE_MATCH_1})
+
+    if (_major_match AND _minor_match AND _release_match)
+        set(LZ4_VERSION "${_lz4_major}.${_lz4_minor}.${_lz4_release}")
+    endif()
+endif()
+
+find_package_handle_standard_args(LZ4
+    FOUND_VAR LZ4_FOUND
+    REQUIRED_VARS LZ4_INCLUDE_DIR LZ4_LIBRARY
+    VERSION_VAR LZ4_VERSION
+)
+
+if (LZ4_FOUND)
+    if (NOT TARGET LZ4::LZ4)
+        add_library(LZ4::LZ4 UNKNOWN IMPORTED GLOBAL)
+        set_target_properties(LZ4::LZ4 PROPERTIES
+            IMPORTED_LOCATION "${LZ4_LIBRARY}"
+            INTERFACE_INCLUDE_DIRECTORIES "${LZ4_INCLUDE_DIR}"
+        )
+    endif ()
+
+    set(LZ4_LIBRARIES ${LZ4_LIBRARY})
+    set(LZ4_INCLUDE_DIRS ${LZ4_INCLUDE_DIR})
+endif()
+
+mark_as_advanced(
+    LZ4_INCLUDE_DIR
+    LZ4_LIBRARY
+)
@@ -0,0 +1,88 @@
+# SPDX-License-Identifier: BSD-3-Clause
+# SPDX-FileCopyrightText: 2026 Krita developers
+
+#[=======================================================================[.rst:
+FindZstd
+--------
+
+Find Zstd headers and library.
+
+Imported Targets
+^^^^^^^^^^^^^^^^
+
+``Zstd::Zstd``
+  The Zstd library, if found.
+
+Result Variables
+^^^^^^^^^^^^^^^^
+
+This will define the following variables in your project:
+
+``Zstd_FOUND``
+  true if (the requested version of) Zstd is available.
+``Zstd_VERSION``
+  the version of Zstd.
+``Zstd_LIBRARIES``
+  the libraries to link against to use Zstd.
+``Zstd_INCLUDE_DIRS``
+  where to find the Zstd headers.
+
+#]=======================================================================]
+
+include(FindPackageHandleStandardArgs)
+
+find_package(PkgConfig QUIET)
+
+if (PkgConfig_FOUND)
+    pkg_check_modules(PC_ZSTD QUIET libzstd)
+    set(Zstd_VERSION ${PC_ZSTD_VERSION})
+endif ()
+
+find_path(Zstd_INCLUDE_DIR
+    NAMES zstd.h
+    HINTS ${PC_ZSTD_INCLUDEDIR} ${PC_ZSTD_INCLUDE_DIRS}
+)
+
+find_library(Zstd_LIBRARY
+    NAMES zstd libzstd
+    HINTS ${PC_ZSTD_LIBDIR} ${PC_ZSTD_LIBRARY_DIRS}
+)
+
+if (NOT Zstd_VERSION AND Zstd_INCLUDE_DIR)
+    file(READ ${Zstd_INCLUDE_DIR}/zstd.h _zstd_version_content)
+
+    string(REGEX MATCH "#define ZSTD_VERSION_MAJOR[ \t]+([0-9]+)" _major_match ${_zstd_version_content})
+    set(_zstd_major ${CMAKE_MATCH_1})
+    string(REGEX MATCH "#define ZSTD_VERSION_MINOR[ \t]+([0-9]+)" _minor_match ${_zstd_version_content})
+    set(_zstd_minor ${CMAKE_MATCH_1})
+    string(REGEX MATCH "#define ZSTD_VERSION_RELEASE[ \t]+([0-9]+)" _release_match ${_zstd_version_content})
+    set(_zstd_release ${CMAKE_MATCH_1})
+
+    if (_major_match AND _minor_match AND _release_match)
+        set(Zstd_VERSION "${_zstd_major}.${_zstd_minor}.${_zstd_release}")
+    endif()
+endif()
+
+find_package_handle_standard_args(Zstd
+    FOUND_VAR Zstd_FOUND
+    REQUIRED_VARS Zstd_INCLUDE_DIR Zstd_LIBRARY
+    VERSION_VAR Zstd_VERSION
+)
+
+if (Zstd_FOUND)
+    if (NOT TARGET Zstd::Zstd)
+        add_library(Zstd::Zstd UNKNOWN IMPORTED GLOBAL)
+        set_target_properties(Zstd::Zstd PROPERTIES
+            IMPORTED_LOCATION "${Zstd_LIBRARY}"
+            INTERFACE_INCLUDE_DIRECTORIES "${Zstd_INCLUDE_DIR}"
+        )
+    endif ()
+
+    set(Zstd_LIBRARIES ${Zstd_LIBRARY})
+    set(Zstd_INCLUDE_DIRS ${Zstd_INCLUDE_DIR})
+endif()
+
+mark_as_advanced(
+    Zstd_INCLUDE_DIR
+    Zstd_LIBRARY
+)
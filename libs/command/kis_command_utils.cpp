@@ -33,6 +33,11 @@ namespace KisCommandUtils
         m_store.undoAll();
     }
 
+    qint64 AggregateCommand::memoryUsage() const
+    {
+        return KUndo2Command::memoryUsage() + m_store.memoryUsage();
+    }
+
     void AggregateCommand::addCommand(KUndo2Command *cmd)
     {
         if (!cmd) return;
@@ -104,6 +109,12 @@ namespace KisCommandUtils
         }
     }
 
+    qint64 SkipFirstRedoWrapper::memoryUsage() const
+    {
+        return KUndo2Command::memoryUsage() +
+            (m_child ? m_child->memoryUsage() : 0);
+    }
+
     SkipFirstRedoBase::SkipFirstRedoBase(bool skipFirstRedo, KUndo2Command *parent)
         : KUndo2Command(parent),
           m_firstRedo(skipFirstRedo)
@@ -198,6 +209,14 @@ namespace KisCommandUtils
         KUndo2Command::undo();
     }
 
+    qint64 CompositeCommand::memoryUsage() const {
+        qint64 result = KUndo2Command::memoryUsage();
+        Q_FOREACH (const KUndo2Command *cmd, m_commands) {
+            result += cmd->memoryUsage();
+        }
+        return result;
+    }
+
     void redoAndMergeIntoAccumulatingCommand(KUndo2Command *cmd, QScopedPointer<KUndo2Command> &accumulatingCommand)
     {
         cmd->redo();
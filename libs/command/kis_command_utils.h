@@ -31,6 +31,7 @@ namespace KisCommandUtils
 
         void redo() override;
         void undo() override;
+        qint64 memoryUsage() const override;
 
     protected:
         virtual void populateChildCommands() = 0;
@@ -69,6 +70,7 @@ namespace KisCommandUtils
         SkipFirstRedoWrapper(KUndo2Command *child = 0, KUndo2Command *parent = 0);
         void redo() override;
         void undo() override;
+        qint64 memoryUsage() const override;
 
     private:
         bool m_firstRedo;
@@ -126,6 +128,7 @@ namespace KisCommandUtils
 
         void redo() override;
         void undo() override;
+        qint64 memoryUsage() const override;
 
     private:
         QVector<KUndo2Command*> m_commands;
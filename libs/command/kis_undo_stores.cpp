@@ -73,6 +73,11 @@ void KisSurrogateUndoStore::clear()
     m_undoStack->clear();
 }
 
+qint64 KisSurrogateUndoStore::memoryUsage() const
+{
+    return m_undoStack->undoMemoryUsage();
+}
+
 void KisSurrogateUndoStore::undoAll()
 {
     while(m_undoStack->canUndo()) {
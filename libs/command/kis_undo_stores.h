@@ -40,6 +40,14 @@ public:
 
     void clear();
 
+    /**
+     * \return the memory occupied by the undo data of the
+     * commands in the store
+     *
+     * \see KUndo2Command::memoryUsage()
+     */
+    qint64 memoryUsage() const;
+
 private:
     KUndo2Stack *m_undoStack;
 };
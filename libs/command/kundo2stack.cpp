@@ -422,6 +422,22 @@ void KUndo2Command::redoMergedCommands()
     }
     redo();
 }
+
+qint64 KUndo2Command::memoryUsage() const
+{
+    qint64 result = 0;
+
+    Q_FOREACH (const KUndo2Command *child, d->child_list) {
+        result += child->memoryUsage();
+    }
+
+    Q_FOREACH (const KUndo2Command *cmd, mergeCommandsVector()) {
+        result += cmd->memoryUsage();
+    }
+
+    return result;
+}
+
 QVector<KUndo2Command*> KUndo2Command::mergeCommandsVector() const
 {
     return m_mergeCommandsVector;
@@ -577,7 +593,7 @@ void KUndo2QStack::purgeRedoState()
     bool cleanStateChanged = false;
 
     while (m_index < m_command_list.size()) {
-        delete m_command_list.takeLast();
+        deleteCommand(m_command_list.takeLast());
         redoStateChanged = true;
     }
 
@@ -597,21 +613,48 @@ void KUndo2QStack::purgeRedoState()
 }
 
 /*! \internal
-    If the number of commands on the stack exceeds the undo limit, deletes commands from
-    the bottom of the stack.
+    If the number of commands on the stack exceeds the undo limit or their undo data
+    exceeds the undo memory limit, deletes commands from the bottom of the stack.
 
     Returns true if commands were deleted.
 */
 
 bool KUndo2QStack::checkUndoLimit()
 {
-    if (m_undo_limit <= 0 || !m_macro_stack.isEmpty() || m_undo_limit >= m_command_list.count())
+    if (!m_macro_stack.isEmpty())
         return false;
 
-    int del_count = m_command_list.count() - m_undo_limit;
+    int del_count = 0;
+
+    if (m_undo_limit > 0 && m_undo_limit < m_command_list.count()) {
+        del_count = m_command_list.count() - m_undo_limit;
+    }
+
+    if (m_undo_memory_limit > 0) {
+        qint64 totalUsage = m_undo_memory_usage;
+
+        for (int i = 0; i < del_count; ++i) {
+            totalUsage -= m_command_list[i]->memoryUsage();
+        }
+
+        /**
+         * The command at the current index (the one that has just
+         * been pushed) is never deleted, even if it alone doesn't
+         * fit into the limit
+         */
+        const int maxDelCount = qMin(m_index, m_command_list.count() - 1);
+
+        while (totalUsage > m_undo_memory_limit && del_count < maxDelCount) {
+            totalUsage -= m_command_list[del_count]->memoryUsage();
+            ++del_count;
+        }
+    }
+
+    if (del_count <= 0)
+        return false;
 
     for (int i = 0; i < del_count; ++i)
-        delete m_command_list.takeFirst();
+        deleteCommand(m_command_list.takeFirst());
 
     m_index -= del_count;
     if (m_clean_index != -1) {
@@ -623,6 +666,17 @@ bool KUndo2QStack::checkUndoLimit()
     return true;
 }
 
+/*! \internal
+    Deletes \a cmd, which has been removed from the command list, and
+    excludes its undo data from the cached memory usage of the stack.
+*/
+
+void KUndo2QStack::deleteCommand(KUndo2Command *cmd)
+{
+    m_undo_memory_usage -= cmd->memoryUsage();
+    delete cmd;
+}
+
 /*!
     Constructs an empty undo stack with the parent \a parent. The
     stack will initially be in the clean state. If \a parent is a
@@ -632,7 +686,7 @@ bool KUndo2QStack::checkUndoLimit()
 */
 
 KUndo2QStack::KUndo2QStack(QObject *parent)
-    : QObject(parent), m_index(0), m_clean_index(0), m_group(0), m_undo_limit(0)
+    : QObject(parent), m_index(0), m_clean_index(0), m_group(0), m_undo_limit(0), m_undo_memory_limit(0), m_undo_memory_usage(0)
     , m_useCumulativeUndoRedo(false)
 {
 #ifndef QT_NO_UNDOGROUP
@@ -682,6 +736,7 @@ void KUndo2QStack::clear()
     m_macro_stack.clear();
     qDeleteAll(m_command_list);
     m_command_list.clear();
+    m_undo_memory_usage = 0;
 
     m_index = 0;
     m_clean_index = 0;
@@ -738,7 +793,7 @@ void KUndo2QStack::push(KUndo2Command *cmd)
         if (m_index > 0)
             cur = m_command_list.at(m_index - 1);
         while (m_index < m_command_list.size())
-            delete m_command_list.takeLast();
+            deleteCommand(m_command_list.takeLast());
         if (m_clean_index > m_index)
             m_clean_index = -1; // we've deleted the clean state
     }
@@ -851,6 +906,13 @@ void KUndo2QStack::push(KUndo2Command *cmd)
         }
     }
 
+    /**
+     * The undo data of the current command is going to change if
+     * the command is merged, so remember the old size to update
+     * the cached memory usage of the stack
+     */
+    const qint64 curMemoryUsage = try_merge && !macro ? cur->memoryUsage() : 0;
+
     if (try_merge && !macro && cur->canAnnihilateWith(cmd)) {
         delete cmd;
         if (!macro) {
@@ -858,7 +920,7 @@ void KUndo2QStack::push(KUndo2Command *cmd)
             // otherwise we would have to do cleanup for the clean state
             Q_ASSERT(m_clean_index != m_index);
 
-            delete m_command_list.takeLast();
+            deleteCommand(m_command_list.takeLast());
             m_index--;
 
             Q_EMIT indexChanged(m_index);
@@ -873,6 +935,8 @@ void KUndo2QStack::push(KUndo2Command *cmd)
     } else if (try_merge && cur->mergeWith(cmd)) {
         delete cmd;
         if (!macro) {
+            m_undo_memory_usage += cur->memoryUsage() - curMemoryUsage;
+
             Q_EMIT indexChanged(m_index);
             Q_EMIT canUndoChanged(canUndo());
             Q_EMIT undoTextChanged(undoText());
@@ -884,6 +948,7 @@ void KUndo2QStack::push(KUndo2Command *cmd)
             m_macro_stack.last()->d->child_list.append(cmd);
         } else {
             m_command_list.append(cmd);
+            m_undo_memory_usage += cmd->memoryUsage();
 
             checkUndoLimit();
             setIndex(m_index + 1, false);
@@ -1218,7 +1283,7 @@ void KUndo2QStack::beginMacro(const KUndo2MagicString &text)
 
     if (m_macro_stack.isEmpty()) {
         while (m_index < m_command_list.size())
-            delete m_command_list.takeLast();
+            deleteCommand(m_command_list.takeLast());
         if (m_clean_index > m_index)
             m_clean_index = -1; // we've deleted the clean state
         m_command_list.append(cmd);
@@ -1254,6 +1319,8 @@ void KUndo2QStack::endMacro()
     m_macro_stack.removeLast();
 
     if (m_macro_stack.isEmpty()) {
+        m_undo_memory_usage += m_command_list.last()->memoryUsage();
+
         checkUndoLimit();
         setIndex(m_index + 1, false);
     }
@@ -1324,6 +1391,40 @@ int KUndo2QStack::undoLimit() const
     return m_undo_limit;
 }
 
+/*!
+    Sets the maximum memory occupied by the undo data of the commands on this stack.
+
+    When the total KUndo2Command::memoryUsage() of the commands exceeds the limit,
+    commands are deleted from the bottom of the stack. The latest undoable command is
+    never deleted. The default value is 0, which means that there is no limit.
+
+    Unlike setUndoLimit(), the limit can be changed on a non-empty stack. It is applied
+    on the next push.
+*/
+
+void KUndo2QStack::setUndoMemoryLimit(qint64 limit)
+{
+    m_undo_memory_limit = limit;
+}
+
+qint64 KUndo2QStack::undoMemoryLimit() const
+{
+    return m_undo_memory_limit;
+}
+
+/*!
+    Returns the memory occupied by the undo data of the commands on this stack,
+    including the undone ones. The value is cached and updated when the commands
+    are pushed, merged or deleted.
+
+    \sa setUndoMemoryLimit()
+*/
+
+qint64 KUndo2QStack::undoMemoryUsage() const
+{
+    return m_undo_memory_usage;
+}
+
 /*!
     \property KUndo2QStack::active
     \brief the active status of this stack.
@@ -123,6 +123,15 @@ public:
     virtual void undoMergedCommands();
     virtual void redoMergedCommands();
 
+    /**
+     * \return an estimation of the memory occupied by the undo data
+     * of the command in bytes. The default implementation sums up the
+     * usage of the child and merged commands.
+     *
+     * \see KUndo2QStack::setUndoMemoryLimit()
+     */
+    virtual qint64 memoryUsage() const;
+
     /**
      * \return user-defined object associated with the command
      *
@@ -193,6 +202,18 @@ public:
     void setUndoLimit(int limit);
     int undoLimit() const;
 
+    /**
+     * The maximum memory, in bytes, that the undo data of the
+     * commands on the stack may occupy. When the limit is exceeded,
+     * the oldest commands are deleted. The latest undoable command
+     * is never deleted. Zero means no limit.
+     *
+     * \see KUndo2Command::memoryUsage()
+     */
+    void setUndoMemoryLimit(qint64 limit);
+    qint64 undoMemoryLimit() const;
+    qint64 undoMemoryUsage() const;
+
     const KUndo2Command *command(int index) const;
 
     void setUseCumulativeUndoRedo(bool value);
@@ -229,12 +250,15 @@ private:
     int m_clean_index;
     KUndo2Group *m_group;
     int m_undo_limit;
+    qint64 m_undo_memory_limit;
+    qint64 m_undo_memory_usage;
     bool m_useCumulativeUndoRedo;
     KisCumulativeUndoData m_cumulativeUndoData;
 
     // also from QUndoStackPrivate
     void setIndex(int idx, bool clean);
     bool checkUndoLimit();
+    void deleteCommand(KUndo2Command *cmd);
 
     Q_DISABLE_COPY(KUndo2QStack)
     friend class KUndo2Group;
@@ -9,6 +9,7 @@
 
 #include <kundo2stack.h>
 #include <kundo2command.h>
+#include <kis_command_utils.h>
 
 
 void TestKUndo2Stack::testExcludeFromMerge()
@@ -429,4 +430,103 @@ void TestKUndo2Stack::testCleanIndexBeforeMerge()
     QCOMPARE(stack.command(2)->isMerged(), false);
 }
 
+namespace {
+struct SizedCommand : public KUndo2Command
+{
+    SizedCommand(int id, qint64 size)
+        : KUndo2Command(kundo2_noi18n(QString::number(id))),
+          m_size(size)
+    {
+    }
+
+    qint64 memoryUsage() const override {
+        return m_size;
+    }
+
+private:
+    qint64 m_size;
+};
+}
+
+void TestKUndo2Stack::testUndoMemoryLimit()
+{
+    KUndo2Stack stack;
+    stack.setUndoMemoryLimit(1000);
+
+    for (int i = 0; i < 4; i++) {
+        stack.push(new SizedCommand(i, 250));
+    }
+
+    QCOMPARE(stack.count(), 4);
+    QCOMPARE(stack.index(), stack.count());
+    QCOMPARE(stack.undoMemoryUsage(), qint64(1000));
+
+    // the oldest command is dropped to fit into the limit
+    stack.push(new SizedCommand(4, 250));
+
+    QCOMPARE(stack.count(), 4);
+    QCOMPARE(stack.index(), stack.count());
+    QCOMPARE(stack.command(0)->text().toString(), QString("1"));
+    QCOMPARE(stack.undoMemoryUsage(), qint64(1000));
+
+    // a single large command pushes out several old ones
+    stack.push(new SizedCommand(5, 600));
+
+    QCOMPARE(stack.count(), 2);
+    QCOMPARE(stack.command(0)->text().toString(), QString("4"));
+    QCOMPARE(stack.command(1)->text().toString(), QString("5"));
+    QCOMPARE(stack.undoMemoryUsage(), qint64(850));
+
+    // the latest command is kept even if it doesn't fit itself
+    stack.push(new SizedCommand(6, 2000));
+
+    QCOMPARE(stack.count(), 1);
+    QCOMPARE(stack.index(), stack.count());
+    QCOMPARE(stack.command(0)->text().toString(), QString("6"));
+    QCOMPARE(stack.undoMemoryUsage(), qint64(2000));
+
+    // nothing is dropped when the limit is reset
+    stack.setUndoMemoryLimit(0);
+    stack.push(new SizedCommand(7, 0));
+    stack.push(new SizedCommand(8, 0));
+
+    QCOMPARE(stack.count(), 3);
+    QCOMPARE(stack.undoMemoryUsage(), qint64(2000));
+
+    // undone commands are accounted until they are purged
+    stack.undo();
+    stack.undo();
+    QCOMPARE(stack.undoMemoryUsage(), qint64(2000));
+
+    stack.push(new SizedCommand(9, 100));
+    QCOMPARE(stack.count(), 2);
+    QCOMPARE(stack.undoMemoryUsage(), qint64(2100));
+
+    stack.clear();
+    QCOMPARE(stack.undoMemoryUsage(), qint64(0));
+}
+
+void TestKUndo2Stack::testCompositeMemoryUsage()
+{
+    KisCommandUtils::CompositeCommand *composite = new KisCommandUtils::CompositeCommand();
+    composite->addCommand(new SizedCommand(0, 100));
+    composite->addCommand(new SizedCommand(1, 200));
+    QCOMPARE(composite->memoryUsage(), qint64(300));
+
+    KisCommandUtils::SkipFirstRedoWrapper wrapper(new SizedCommand(2, 50));
+    QCOMPARE(wrapper.memoryUsage(), qint64(50));
+
+    // the children of the lambda command appear on the first redo()
+    KisCommandUtils::LambdaCommand *lambda =
+        new KisCommandUtils::LambdaCommand([] () { return new SizedCommand(3, 400); });
+    QCOMPARE(lambda->memoryUsage(), qint64(0));
+
+    KUndo2Stack stack;
+    stack.push(composite);
+    stack.push(lambda);
+
+    QCOMPARE(lambda->memoryUsage(), qint64(400));
+    QCOMPARE(stack.undoMemoryUsage(), qint64(700));
+}
+
 SIMPLE_TEST_MAIN(TestKUndo2Stack)
@@ -20,6 +20,8 @@ private Q_SLOTS:
     void testMaxGroupDuration();
     void testCleanIndexAfterMerge();
     void testCleanIndexBeforeMerge();
+    void testUndoMemoryLimit();
+    void testCompositeMemoryUsage();
 };
 
 #endif // TESTKUNDO2STACK_H
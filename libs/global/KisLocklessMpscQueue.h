@@ -0,0 +1,101 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  References:
+ *    * Dmitry Vyukov, Intrusive MPSC node-based queue,
+ *      https://www.1024cores.net/home/lock-free-algorithms/queues/intrusive-mpsc-node-based-queue
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISLOCKLESSMPSCQUEUE_H
+#define KISLOCKLESSMPSCQUEUE_H
+
+#include <atomic>
+#include <utility>
+
+#include <QThread>
+
+/**
+ * A lock-free unbounded FIFO queue for multiple producers and
+ * a single consumer.
+ *
+ * push() can be called from any number of threads simultaneously,
+ * it never blocks and costs one atomic exchange. pop() and isEmpty()
+ * may be called by one thread at a time only (e.g. under the lock
+ * that serializes the consumers).
+ *
+ * The order of the elements pushed by one thread is preserved. When
+ * pop() finds a push, which has already taken its place in the queue
+ * but has not been linked yet, it waits for the producer to finish
+ * linking, so all the completed pushes are always visible to the
+ * consumer.
+ */
+template<class T>
+class KisLocklessMpscQueue
+{
+private:
+    struct Node {
+        std::atomic<Node*> next {nullptr};
+        T data {};
+    };
+
+public:
+    KisLocklessMpscQueue()
+        : m_head(new Node()),
+          m_tail(m_head)
+    {
+    }
+
+    ~KisLocklessMpscQueue() {
+        T value;
+        while (pop(value));
+        delete m_head;
+    }
+
+    void push(T data) {
+        Node *node = new Node();
+        node->data = std::move(data);
+
+        Node *prev = m_tail.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    bool pop(T &value) {
+        Node *head = m_head;
+        Node *next = head->next.load(std::memory_order_acquire);
+
+        if (!next) {
+            if (m_tail.load(std::memory_order_acquire) == head) return false;
+
+            /**
+             * Some producer has already exchanged the tail, but hasn't
+             * linked its node yet. It is just a couple of instructions
+             * away from that.
+             */
+            while (!(next = head->next.load(std::memory_order_acquire))) {
+                QThread::yieldCurrentThread();
+            }
+        }
+
+        value = std::move(next->data);
+        next->data = T();
+
+        m_head = next;
+        delete head;
+
+        return true;
+    }
+
+    bool isEmpty() const {
+        return m_tail.load(std::memory_order_acquire) == m_head;
+    }
+
+private:
+    Q_DISABLE_COPY(KisLocklessMpscQueue)
+
+    Node *m_head;
+    std::atomic<Node*> m_tail;
+};
+
+#endif // KISLOCKLESSMPSCQUEUE_H
@@ -0,0 +1,321 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisTracer.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+#include <QStandardPaths>
+#include <QThread>
+
+#include "kis_debug.h"
+
+const int KisTracer::ThreadBufferSize = 16384;
+
+std::atomic<bool> KisTracer::s_isEnabled {false};
+
+namespace {
+
+struct ThreadBuffer
+{
+    /**
+     * The lock is taken by the owning thread on every write, so it is
+     * never contended except when the events are being exported
+     */
+    QMutex lock;
+
+    std::vector<KisTracer::Event> events;
+    quint64 writeIndex = 0;
+
+    int threadId = 0;
+    std::atomic<bool> isFree {false};
+};
+
+/**
+ * Returns the buffer to the tracer when the thread exits. The events
+ * stay in the buffer until it is reused by another thread and
+ * overwritten.
+ */
+struct ThreadBufferHolder
+{
+    ~ThreadBufferHolder() {
+        if (buffer) {
+            buffer->isFree.store(true);
+        }
+    }
+
+    ThreadBuffer *buffer = 0;
+};
+
+}
+
+struct Q_DECL_HIDDEN KisTracer::Private
+{
+    QElapsedTimer timer;
+
+    mutable QMutex buffersLock;
+    std::vector<ThreadBuffer*> buffers;
+
+    int lastThreadId = 0;
+    QMap<int, QString> threadNames;
+
+    void addEvent(Category category, const char *name, qint64 startNs, qint64 durationNs);
+
+    ThreadBuffer* acquireBuffer();
+    ThreadBuffer* currentThreadBuffer();
+};
+
+ThreadBuffer* KisTracer::Private::acquireBuffer()
+{
+    QThread *thread = QThread::currentThread();
+
+    QString threadName = thread->objectName();
+    if (QCoreApplication::instance() && QCoreApplication::instance()->thread() == thread) {
+        threadName = "Main thread";
+    }
+
+    QMutexLocker l(&buffersLock);
+
+    const int threadId = ++lastThreadId;
+    threadNames.insert(threadId, !threadName.isEmpty() ? threadName : QString("Thread %1").arg(threadId));
+
+    ThreadBuffer *buffer = 0;
+
+    for (ThreadBuffer *buf : buffers) {
+        bool expected = true;
+        if (buf->isFree.compare_exchange_strong(expected, false)) {
+            buffer = buf;
+            break;
+        }
+    }
+
+    if (!buffer) {
+        buffer = new ThreadBuffer();
+        buffer->events.resize(ThreadBufferSize);
+        buffers.push_back(buffer);
+    }
+
+    QMutexLocker bufferLocker(&buffer->lock);
+    buffer->threadId = threadId;
+
+    return buffer;
+}
+
+ThreadBuffer* KisTracer::Private::currentThreadBuffer()
+{
+    thread_local ThreadBufferHolder holder;
+
+    if (!holder.buffer) {
+        holder.buffer = acquireBuffer();
+    }
+
+    return holder.buffer;
+}
+
+KisTracer::KisTracer()
+    : m_d(new Private)
+{
+    m_d->timer.start();
+}
+
+KisTracer::~KisTracer()
+{
+    for (ThreadBuffer *buffer : m_d->buffers) {
+        delete buffer;
+    }
+    delete m_d;
+}
+
+KisTracer* KisTracer::instance()
+{
+    /**
+     * The tracer is never destroyed: the threads return their
+     * buffers on exit, which may happen after the destruction
+     * of static objects.
+     */
+    static KisTracer *s_instance = new KisTracer();
+    return s_instance;
+}
+
+void KisTracer::setEnabled(bool value)
+{
+    s_isEnabled.store(value, std::memory_order_relaxed);
+}
+
+qint64 KisTracer::timestamp() const
+{
+    return m_d->timer.nsecsElapsed();
+}
+
+void KisTracer::Private::addEvent(Category category, const char *name, qint64 startNs, qint64 durationNs)
+{
+    ThreadBuffer *buffer = currentThreadBuffer();
+
+    QMutexLocker l(&buffer->lock);
+
+    Event &event = buffer->events[buffer->writeIndex % ThreadBufferSize];
+    event.name = name;
+    event.category = category;
+    event.startNs = startNs;
+    event.durationNs = durationNs;
+    event.threadId = buffer->threadId;
+
+    buffer->writeIndex++;
+}
+
+void KisTracer::addCompleteEvent(Category category, const char *name, qint64 startNs, qint64 endNs)
+{
+    m_d->addEvent(category, name, startNs, endNs - startNs);
+}
+
+void KisTracer::addInstantEvent(Category category, const char *name)
+{
+    m_d->addEvent(category, name, timestamp(), -1);
+}
+
+void KisTracer::clear()
+{
+    QMutexLocker l(&m_d->buffersLock);
+
+    for (ThreadBuffer *buffer : m_d->buffers) {
+        QMutexLocker bufferLocker(&buffer->lock);
+        buffer->writeIndex = 0;
+    }
+}
+
+QVector<KisTracer::Event> KisTracer::events() const
+{
+    QVector<Event> result;
+
+    {
+        QMutexLocker l(&m_d->buffersLock);
+
+        for (ThreadBuffer *buffer : m_d->buffers) {
+            QMutexLocker bufferLocker(&buffer->lock);
+
+            const quint64 numEvents = qMin(buffer->writeIndex, quint64(ThreadBufferSize));
+
+            for (quint64 i = buffer->writeIndex - numEvents; i < buffer->writeIndex; i++) {
+                result.append(buffer->events[i % ThreadBufferSize]);
+            }
+        }
+    }
+
+    std::stable_sort(result.begin(), result.end(),
+                     [] (const Event &lhs, const Event &rhs) {
+                         return lhs.startNs < rhs.startNs;
+                     });
+
+    return result;
+}
+
+QByteArray KisTracer::toChromeTrace() const
+{
+    const qint64 pid = QCoreApplication::applicationPid();
+
+    QJsonArray traceEvents;
+
+    QMap<int, QString> threadNames;
+    {
+        QMutexLocker l(&m_d->buffersLock);
+        threadNames = m_d->threadNames;
+    }
+
+    const QVector<Event> allEvents = events();
+
+    QSet<int> usedThreads;
+
+    for (const Event &event : allEvents) {
+        QJsonObject object;
+        object["name"] = QString::fromLatin1(event.name);
+        object["cat"] = QString::fromLatin1(categoryName(event.category));
+        object["ts"] = qreal(event.startNs) / 1000.0;
+        object["pid"] = pid;
+        object["tid"] = event.threadId;
+
+        if (event.durationNs >= 0) {
+            object["ph"] = "X";
+            object["dur"] = qreal(event.durationNs) / 1000.0;
+        } else {
+            object["ph"] = "i";
+            object["s"] = "t";
+        }
+
+        traceEvents.append(object);
+        usedThreads.insert(event.threadId);
+    }
+
+    for (auto it = threadNames.constBegin(); it != threadNames.constEnd(); ++it) {
+        if (!usedThreads.contains(it.key())) continue;
+
+        QJsonObject args;
+        args["name"] = it.value();
+
+        QJsonObject object;
+        object["name"] = "thread_name";
+        object["ph"] = "M";
+        object["pid"] = pid;
+        object["tid"] = it.key();
+        object["args"] = args;
+
+        traceEvents.append(object);
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = traceEvents;
+    root["displayTimeUnit"] = "ms";
+
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+bool KisTracer::saveChromeTrace(const QString &fileName) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        warnKrita << "KisTracer: failed to open the trace file" << fileName;
+        return false;
+    }
+
+    return file.write(toChromeTrace()) >= 0;
+}
+
+QString KisTracer::defaultTraceFileName()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + "/krita-trace.json";
+}
+
+const char* KisTracer::categoryName(Category category)
+{
+    switch (category) {
+    case InputEvent:
+        return "input";
+    case StrokeJob:
+        return "stroke";
+    case DabRender:
+        return "dab";
+    case MergeWalker:
+        return "merge";
+    case TextureUpload:
+        return "texture";
+    case Paint:
+        return "paint";
+    case NumCategories:
+        break;
+    }
+
+    return "unknown";
+}
@@ -0,0 +1,164 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KISTRACER_H
+#define KISTRACER_H
+
+#include <atomic>
+
+#include <QtGlobal>
+#include <QVector>
+
+#include "kritaglobal_export.h"
+
+class QString;
+class QByteArray;
+
+/**
+ * A low-overhead recorder of timestamped events for measuring the
+ * latency of the whole painting pipeline: from the input event to the
+ * stroke jobs, dab rendering, the merge walkers, the texture upload
+ * and the final paint of the canvas.
+ *
+ * Every thread writes its events into its own ring buffer, so the
+ * threads never wait for each other while recording. When the buffer
+ * of a thread is full, the oldest events of this thread are
+ * overwritten.
+ *
+ * Tracing is disabled by default. When it is disabled, recording an
+ * event costs one relaxed atomic load.
+ *
+ * The recorded events can be exported into Chrome trace JSON format,
+ * which can be opened in chrome://tracing or in Perfetto UI.
+ *
+ * Usage:
+ *
+ * \code{.cpp}
+ * void KisSomeClass::doSomething()
+ * {
+ *     KIS_TRACE_SCOPE(StrokeJob, "do something");
+ *     ...
+ * }
+ * \endcode
+ *
+ * The names of the events must be string literals (or other strings
+ * with static storage duration), they are not copied.
+ */
+class KRITAGLOBAL_EXPORT KisTracer
+{
+public:
+    enum Category {
+        InputEvent = 0,
+        StrokeJob,
+        DabRender,
+        MergeWalker,
+        TextureUpload,
+        Paint,
+        NumCategories
+    };
+
+    struct Event {
+        const char *name = 0;
+        Category category = InputEvent;
+        qint64 startNs = 0;
+        qint64 durationNs = -1; ///< -1 for instant events
+        int threadId = 0;
+    };
+
+    /**
+     * The number of events kept for every thread
+     */
+    static const int ThreadBufferSize;
+
+public:
+    static KisTracer* instance();
+
+    static inline bool isEnabled() {
+        return s_isEnabled.load(std::memory_order_relaxed);
+    }
+
+    void setEnabled(bool value);
+
+    /**
+     * The time in nanoseconds since the creation of the tracer
+     */
+    qint64 timestamp() const;
+
+    void addCompleteEvent(Category category, const char *name, qint64 startNs, qint64 endNs);
+    void addInstantEvent(Category category, const char *name);
+
+    /**
+     * Drops all the recorded events
+     */
+    void clear();
+
+    /**
+     * All the recorded events sorted by their start time
+     */
+    QVector<Event> events() const;
+
+    QByteArray toChromeTrace() const;
+    bool saveChromeTrace(const QString &fileName) const;
+
+    /**
+     * The file the trace is saved to when tracing is switched off
+     * in the preferences or when Krita exits: krita-trace.json
+     * next to krita.log
+     */
+    static QString defaultTraceFileName();
+
+    static const char* categoryName(Category category);
+
+private:
+    KisTracer();
+    ~KisTracer();
+    Q_DISABLE_COPY(KisTracer)
+
+    static std::atomic<bool> s_isEnabled;
+
+    struct Private;
+    Private * const m_d;
+};
+
+/**
+ * Records a complete event lasting from the construction of the
+ * object till its destruction. If \p name is null, nothing is
+ * recorded.
+ */
+class KisTraceScope
+{
+public:
+    inline KisTraceScope(KisTracer::Category category, const char *name)
+        : m_category(category),
+          m_name(name),
+          m_startNs(name && KisTracer::isEnabled() ? KisTracer::instance()->timestamp() : -1)
+    {
+    }
+
+    inline ~KisTraceScope() {
+        if (m_startNs >= 0) {
+            KisTracer *tracer = KisTracer::instance();
+            tracer->addCompleteEvent(m_category, m_name, m_startNs, tracer->timestamp());
+        }
+    }
+
+private:
+    Q_DISABLE_COPY(KisTraceScope)
+
+    KisTracer::Category m_category;
+    const char *m_name;
+    qint64 m_startNs;
+};
+
+#define KIS_TRACE_CONCAT_IMPL(a, b) a##b
+#define KIS_TRACE_CONCAT(a, b) KIS_TRACE_CONCAT_IMPL(a, b)
+
+#define KIS_TRACE_SCOPE(category, name) \
+    KisTraceScope KIS_TRACE_CONCAT(__kisTraceScope, __LINE__)(KisTracer::category, name)
+
+#define KIS_TRACE_INSTANT(category, name) \
+    do { if (KisTracer::isEnabled()) KisTracer::instance()->addInstantEvent(KisTracer::category, name); } while (0)
+
+#endif // KISTRACER_H
@@ -0,0 +1,100 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisLocklessMpscQueueTest.h"
+
+#include <simpletest.h>
+
+#include <QThread>
+#include <QVector>
+
+#include "KisLocklessMpscQueue.h"
+
+
+void KisLocklessMpscQueueTest::testOperations()
+{
+    KisLocklessMpscQueue<int> queue;
+    int value = -1;
+
+    QVERIFY(queue.isEmpty());
+    QVERIFY(!queue.pop(value));
+
+    for (int i = 0; i < 10; i++) {
+        queue.push(i);
+    }
+
+    QVERIFY(!queue.isEmpty());
+
+    for (int i = 0; i < 5; i++) {
+        QVERIFY(queue.pop(value));
+        QCOMPARE(value, i);
+    }
+
+    queue.push(10);
+
+    for (int i = 5; i <= 10; i++) {
+        QVERIFY(queue.pop(value));
+        QCOMPARE(value, i);
+    }
+
+    QVERIFY(queue.isEmpty());
+    QVERIFY(!queue.pop(value));
+
+    // the destructor frees the remaining elements
+    queue.push(11);
+}
+
+void KisLocklessMpscQueueTest::stressTestProducers()
+{
+    const int numProducers = 4;
+    const int numValues = 100000;
+
+    KisLocklessMpscQueue<int> queue;
+    QVector<QThread*> threads;
+
+    for (int i = 0; i < numProducers; i++) {
+        threads << QThread::create([&queue, i] () {
+            for (int j = 0; j < numValues; j++) {
+                queue.push(i * numValues + j);
+            }
+        });
+    }
+
+    Q_FOREACH (QThread *thread, threads) {
+        thread->start();
+    }
+
+    QVector<int> lastValues(numProducers, -1);
+    int numPopped = 0;
+    bool orderPreserved = true;
+
+    while (numPopped < numProducers * numValues) {
+        int value = -1;
+        if (!queue.pop(value)) {
+            QThread::yieldCurrentThread();
+            continue;
+        }
+
+        const int producer = value / numValues;
+        const int index = value % numValues;
+
+        // the order of every producer is preserved
+        orderPreserved &= index == lastValues[producer] + 1;
+        lastValues[producer] = index;
+
+        numPopped++;
+    }
+
+    Q_FOREACH (QThread *thread, threads) {
+        thread->wait();
+        delete thread;
+    }
+
+    QVERIFY(orderPreserved);
+    QVERIFY(queue.isEmpty());
+}
+
+SIMPLE_TEST_MAIN(KisLocklessMpscQueueTest)
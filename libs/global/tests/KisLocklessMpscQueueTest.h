@@ -0,0 +1,21 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISLOCKLESSMPSCQUEUETEST_H
+#define KISLOCKLESSMPSCQUEUETEST_H
+
+#include <QObject>
+
+class KisLocklessMpscQueueTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testOperations();
+    void stressTestProducers();
+};
+
+#endif // KISLOCKLESSMPSCQUEUETEST_H
@@ -0,0 +1,162 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisTracerTest.h"
+
+#include <simpletest.h>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
+#include <QThread>
+
+#include "KisTracer.h"
+
+
+void KisTracerTest::init()
+{
+    KisTracer::instance()->clear();
+    KisTracer::instance()->setEnabled(true);
+}
+
+void KisTracerTest::cleanup()
+{
+    KisTracer::instance()->setEnabled(false);
+    KisTracer::instance()->clear();
+}
+
+void KisTracerTest::testDisabled()
+{
+    KisTracer::instance()->setEnabled(false);
+
+    {
+        KIS_TRACE_SCOPE(StrokeJob, "disabled");
+    }
+    KIS_TRACE_INSTANT(InputEvent, "disabled");
+
+    QVERIFY(KisTracer::instance()->events().isEmpty());
+}
+
+void KisTracerTest::testScope()
+{
+    {
+        KIS_TRACE_SCOPE(MergeWalker, "merge");
+        QTest::qSleep(2);
+    }
+    KIS_TRACE_INSTANT(InputEvent, "input");
+
+    {
+        KisTraceScope nullScope(KisTracer::Paint, 0);
+    }
+
+    const QVector<KisTracer::Event> events = KisTracer::instance()->events();
+    QCOMPARE(events.size(), 2);
+
+    QCOMPARE(QByteArray(events[0].name), QByteArray("merge"));
+    QCOMPARE(events[0].category, KisTracer::MergeWalker);
+    QVERIFY(events[0].durationNs >= 2000000);
+
+    QCOMPARE(QByteArray(events[1].name), QByteArray("input"));
+    QCOMPARE(events[1].category, KisTracer::InputEvent);
+    QCOMPARE(events[1].durationNs, qint64(-1));
+    QVERIFY(events[1].startNs >= events[0].startNs + events[0].durationNs);
+
+    QCOMPARE(events[0].threadId, events[1].threadId);
+}
+
+void KisTracerTest::testRingBuffer()
+{
+    const int numEvents = KisTracer::ThreadBufferSize + 10;
+
+    for (int i = 0; i < numEvents; i++) {
+        KIS_TRACE_SCOPE(DabRender, "dab");
+    }
+
+    const QVector<KisTracer::Event> events = KisTracer::instance()->events();
+    QCOMPARE(events.size(), KisTracer::ThreadBufferSize);
+
+    for (int i = 1; i < events.size(); i++) {
+        QVERIFY(events[i - 1].startNs <= events[i].startNs);
+    }
+}
+
+void KisTracerTest::testThreads()
+{
+    const int numThreads = 4;
+    const int numEventsPerThread = 100;
+
+    QVector<QThread*> threads;
+
+    for (int i = 0; i < numThreads; i++) {
+        threads << QThread::create([] () {
+            for (int j = 0; j < numEventsPerThread; j++) {
+                KIS_TRACE_SCOPE(StrokeJob, "job");
+            }
+        });
+    }
+
+    Q_FOREACH (QThread *thread, threads) {
+        thread->start();
+    }
+
+    Q_FOREACH (QThread *thread, threads) {
+        thread->wait();
+        delete thread;
+    }
+
+    const QVector<KisTracer::Event> events = KisTracer::instance()->events();
+    QCOMPARE(events.size(), numThreads * numEventsPerThread);
+
+    QSet<int> threadIds;
+    Q_FOREACH (const KisTracer::Event &event, events) {
+        threadIds.insert(event.threadId);
+    }
+    QCOMPARE(threadIds.size(), numThreads);
+}
+
+void KisTracerTest::testChromeTrace()
+{
+    {
+        KIS_TRACE_SCOPE(TextureUpload, "upload");
+    }
+    KIS_TRACE_INSTANT(Paint, "paint");
+
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(KisTracer::instance()->toChromeTrace(), &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    const QJsonArray traceEvents = doc.object()["traceEvents"].toArray();
+
+    int numCompleteEvents = 0;
+    int numInstantEvents = 0;
+    int numThreadNames = 0;
+
+    Q_FOREACH (const QJsonValue &value, traceEvents) {
+        const QJsonObject object = value.toObject();
+        const QString phase = object["ph"].toString();
+
+        if (phase == "X") {
+            QCOMPARE(object["name"].toString(), QString("upload"));
+            QCOMPARE(object["cat"].toString(), QString("texture"));
+            QVERIFY(object.contains("dur"));
+            numCompleteEvents++;
+        } else if (phase == "i") {
+            QCOMPARE(object["name"].toString(), QString("paint"));
+            QCOMPARE(object["cat"].toString(), QString("paint"));
+            numInstantEvents++;
+        } else if (phase == "M") {
+            QCOMPARE(object["name"].toString(), QString("thread_name"));
+            numThreadNames++;
+        }
+    }
+
+    QCOMPARE(numCompleteEvents, 1);
+    QCOMPARE(numInstantEvents, 1);
+    QCOMPARE(numThreadNames, 1);
+}
+
+SIMPLE_TEST_MAIN(KisTracerTest)
@@ -0,0 +1,27 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISTRACERTEST_H
+#define KISTRACERTEST_H
+
+#include <QObject>
+
+class KisTracerTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void testDisabled();
+    void testScope();
+    void testRingBuffer();
+    void testThreads();
+    void testChromeTrace();
+};
+
+#endif // KISTRACERTEST_H
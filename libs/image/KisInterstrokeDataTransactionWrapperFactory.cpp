@@ -49,6 +49,11 @@ struct BeginInterstrokeDataTransactionCommand : public KUndo2Command
         }
     }
 
+    qint64 memoryUsage() const override {
+        return KUndo2Command::memoryUsage() +
+            (m_dataSwapCommand ? m_dataSwapCommand->memoryUsage() : 0);
+    }
+
 private:
     bool m_firstRedo {true};
     KisPaintDeviceSP m_device;
@@ -81,6 +86,11 @@ struct EndInterstrokeDataTransactionCommand : public KUndo2Command
         }
     }
 
+    qint64 memoryUsage() const override {
+        return KUndo2Command::memoryUsage() +
+            (m_transactionCommand ? m_transactionCommand->memoryUsage() : 0);
+    }
+
 private:
     KisPaintDeviceSP m_device;
     QScopedPointer<KUndo2Command> m_transactionCommand;
@@ -0,0 +1,41 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KISUPDATESVIEWPORTHINT_H
+#define KISUPDATESVIEWPORTHINT_H
+
+#include <optional>
+
+#include <QRect>
+#include <QPointF>
+#include <QVector>
+
+/**
+ * The part of the image shown by one view, used to prioritize the
+ * updates of the image, \see KisSimpleUpdateQueue::setViewportHints()
+ */
+struct KisUpdatesViewportHint
+{
+    /**
+     * The area visible in the view in lod0 image pixels
+     */
+    QRect visibleRect;
+
+    /**
+     * The point the user is focused on in lod0 image pixels, usually,
+     * the position of the cursor. When unset, the center of
+     * \p visibleRect is used.
+     */
+    std::optional<QPointF> focusPoint;
+
+    QPointF effectiveFocusPoint() const {
+        return focusPoint ? *focusPoint : QRectF(visibleRect).center();
+    }
+};
+
+typedef QVector<KisUpdatesViewportHint> KisUpdatesViewportHints;
+
+#endif // KISUPDATESVIEWPORTHINT_H
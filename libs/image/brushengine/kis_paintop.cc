@@ -33,6 +33,7 @@
 
 #define BEZIER_FLATNESS_THRESHOLD 0.5
 #include <kis_distance_information.h>
+#include <KisTracer.h>
 
 #include <qnumeric.h>
 
@@ -147,6 +148,8 @@ void KisPaintOp::paintLine(const KisPaintInformation &pi1,
 
 void KisPaintOp::paintAt(const KisPaintInformation& info, KisDistanceInformation *currentDistance)
 {
+    KIS_TRACE_SCOPE(DabRender, "paint at");
+
     Q_ASSERT(currentDistance);
     KisPaintInformation pi(info);
     pi.paintAt(*this, currentDistance);
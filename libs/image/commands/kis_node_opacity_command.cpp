@@ -61,6 +61,12 @@ void KisNodeOpacityCommand::undo()
     }
 }
 
+qint64 KisNodeOpacityCommand::memoryUsage() const
+{
+    return KUndo2Command::memoryUsage() +
+        (m_autokey ? m_autokey->memoryUsage() : 0);
+}
+
 int KisNodeOpacityCommand::id() const
 {
     return KisCommandUtils::ChangeNodeOpacityId;
@@ -32,6 +32,8 @@ public:
     bool canMergeWith(const KUndo2Command *command) const override;
     bool canAnnihilateWith(const KUndo2Command *command) const override;
 
+    qint64 memoryUsage() const override;
+
 private:
     boost::optional<quint8> m_oldOpacity;
     QScopedPointer<KUndo2Command> m_autokey;
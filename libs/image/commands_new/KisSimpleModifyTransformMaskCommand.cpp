@@ -79,3 +79,14 @@ void KisSimpleModifyTransformMaskCommand::undo()
         m_mask->threadSafeForceStaticImageUpdate();
     }
 }
+
+qint64 KisSimpleModifyTransformMaskCommand::memoryUsage() const
+{
+    qint64 result = KUndo2Command::memoryUsage();
+
+    for (const std::unique_ptr<KUndo2Command> &cmd : m_undoCommands) {
+        result += cmd->memoryUsage();
+    }
+
+    return result;
+}
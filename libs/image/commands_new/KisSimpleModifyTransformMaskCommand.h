@@ -30,6 +30,8 @@ public:
 
     void redo() override;
 
+    qint64 memoryUsage() const override;
+
 private:
     bool m_isInitialized {false};
 
@@ -142,6 +142,11 @@ bool KisSavedCommand::isMerged() const
     return m_command->isMerged();
 }
 
+qint64 KisSavedCommand::memoryUsage() const
+{
+    return m_command->memoryUsage();
+}
+
 
 
 struct KisSavedMacroCommand::Private
@@ -171,6 +176,17 @@ KisSavedMacroCommand::~KisSavedMacroCommand()
     delete m_d;
 }
 
+qint64 KisSavedMacroCommand::memoryUsage() const
+{
+    qint64 result = KisSavedCommandBase::memoryUsage();
+
+    Q_FOREACH (const Private::SavedCommand &cmd, m_d->commands) {
+        result += cmd.command->memoryUsage();
+    }
+
+    return result;
+}
+
 void KisSavedMacroCommand::setMacroId(int value)
 {
     m_d->macroId = value;
@@ -57,6 +57,7 @@ public:
     using KisSavedCommandBase::setEndTime;
     QTime endTime() const override;
     bool isMerged() const override;
+    qint64 memoryUsage() const override;
 
     /**
      * The function lazily unwraps a saved command `cmd` and passes the internal
@@ -103,6 +104,8 @@ public:
     void getCommandExecutionJobs(QVector<KisStrokeJobData*> *jobs, bool undo, bool shouldGoToHistory = true) const;
 
     void setOverrideInfo(const KisSavedMacroCommand *overriddenCommand, const QVector<const KUndo2Command *> &skipWhileOverride);
+
+    qint64 memoryUsage() const override;
 protected:
     void addCommands(KisStrokeId id, bool undo) override;
 
@@ -34,3 +34,8 @@ void KisTransactionBasedCommand::undo()
     }
 }
 
+qint64 KisTransactionBasedCommand::memoryUsage() const
+{
+    return KUndo2Command::memoryUsage() +
+        (m_transactionData ? m_transactionData->memoryUsage() : 0);
+}
@@ -20,6 +20,8 @@ public:
     void redo() override;
     void undo() override;
 
+    qint64 memoryUsage() const override;
+
 protected:
     virtual KUndo2Command* paint() = 0;
 private:
@@ -34,6 +34,14 @@
 #include "kis_abstract_projection_plane.h"
 
 
+namespace {
+/**
+ * The flattened-below cache is used only when there are at least
+ * this number of layers below the changed one
+ */
+const int MIN_CACHED_LEAVES = 2;
+}
+
 //#define DEBUG_MERGER
 
 #ifdef DEBUG_MERGER
@@ -204,6 +212,7 @@ void KisAsyncMerger::startMerge(KisBaseRectsWalker &walker, bool notifyClones) {
                                                      m_currentProjection);
             currentLeaf->accept(originalVisitor);
             currentLeaf->projectionPlane()->recalculate(applyRect, currentLeaf->node(), item.m_renderFlags);
+            currentLeaf->bumpRevision();
 
             continue;
         }
@@ -211,6 +220,21 @@ void KisAsyncMerger::startMerge(KisBaseRectsWalker &walker, bool notifyClones) {
 
         if (!m_currentProjection) {
             setupProjection(currentLeaf, applyRect, useTempProjections);
+
+            /**
+             * LoD and LoD0 updates of the same area alternate during
+             * a stroke and would constantly reset each other's key,
+             * so only LoD0 composition is cached.
+             */
+            if (walker.levelOfDetail() == 0 &&
+                fetchFlattenedBelowCache(leafStack, item)) {
+
+                continue;
+            }
+        }
+
+        if (m_belowCachePoint && currentLeaf == m_belowCachePoint) {
+            storeFlattenedBelowCache();
         }
 
         KisUpdateOriginalVisitor originalVisitor(applyRect,
@@ -222,6 +246,7 @@ void KisAsyncMerger::startMerge(KisBaseRectsWalker &walker, bool notifyClones) {
                 currentLeaf->accept(originalVisitor);
                 currentLeaf->projectionPlane()->recalculate(applyRect, walker.startNode(), item.m_renderFlags);
             }
+            currentLeaf->bumpRevision();
         }
         else if(item.m_position & KisMergeWalker::N_ABOVE_FILTHY) {
             DEBUG_NODE_ACTION("Updating", "N_ABOVE_FILTHY", currentLeaf, applyRect);
@@ -230,6 +255,7 @@ void KisAsyncMerger::startMerge(KisBaseRectsWalker &walker, bool notifyClones) {
                     currentLeaf->accept(originalVisitor);
                     currentLeaf->projectionPlane()->recalculate(applyRect, currentLeaf->node(), item.m_renderFlags);
                 }
+                currentLeaf->bumpRevision();
             }
         }
         else if(item.m_position & KisMergeWalker::N_FILTHY_PROJECTION) {
@@ -237,6 +263,7 @@ void KisAsyncMerger::startMerge(KisBaseRectsWalker &walker, bool notifyClones) {
             if (currentLeaf->shouldBeRendered()) {
                 currentLeaf->projectionPlane()->recalculate(applyRect, walker.startNode(), item.m_renderFlags);
             }
+            currentLeaf->bumpRevision();
         }
         else /*if(item.m_position & KisMergeWalker::N_BELOW_FILTHY)*/ {
             DEBUG_NODE_ACTION("Updating", "N_BELOW_FILTHY", currentLeaf, applyRect);
@@ -272,6 +299,9 @@ void KisAsyncMerger::startMerge(KisBaseRectsWalker &walker, bool notifyClones) {
 void KisAsyncMerger::resetProjection() {
     m_currentProjection = 0;
     m_finalProjection = 0;
+
+    m_belowCachePoint = 0;
+    m_belowCacheKey.clear();
 }
 
 void KisAsyncMerger::setupProjection(KisProjectionLeafSP currentLeaf, const QRect& rect, bool useTempProjection) {
@@ -325,6 +355,75 @@ bool KisAsyncMerger::compositeWithProjection(KisProjectionLeafSP leaf, const QRe
     return true;
 }
 
+/**
+ * Checks whether the current level of the walker starts with a run of
+ * N_BELOW_FILTHY leaves, which can be fetched from the flattened-below
+ * cache of the first changed leaf (the cache point). If the cache has
+ * the data, the run is removed from the stack. Otherwise the cache
+ * point is saved to fill the cache when the merge reaches it.
+ */
+bool KisAsyncMerger::fetchFlattenedBelowCache(KisBaseRectsWalker::LeafStack &leafStack,
+                                              const KisBaseRectsWalker::JobItem &firstItem)
+{
+    if (!m_currentProjection) return false;
+
+    auto isCacheableItem = [&firstItem] (const KisBaseRectsWalker::JobItem &item) {
+        return (item.m_position & KisBaseRectsWalker::N_BELOW_FILTHY) &&
+            !(item.m_position & (KisBaseRectsWalker::N_EXTRA | KisBaseRectsWalker::N_TOPMOST)) &&
+            item.m_applyRect == firstItem.m_applyRect;
+    };
+
+    if (!isCacheableItem(firstItem)) return false;
+
+    int cachePointIndex = leafStack.size() - 1;
+    while (cachePointIndex >= 0 && isCacheableItem(leafStack[cachePointIndex])) {
+        cachePointIndex--;
+    }
+
+    if (cachePointIndex < 0) return false;
+
+    const int numCachedLeaves = leafStack.size() - cachePointIndex;
+    if (numCachedLeaves < MIN_CACHED_LEAVES) return false;
+
+    const KisBaseRectsWalker::JobItem &cachePoint = leafStack[cachePointIndex];
+    if (cachePoint.m_position & KisBaseRectsWalker::N_EXTRA) return false;
+
+    KisProjectionLeafSP cachePointLeaf = cachePoint.m_leaf;
+    if (!cachePointLeaf || cachePointLeaf->parent() != firstItem.m_leaf->parent()) return false;
+
+    KisFlattenedBelowCache::Key key;
+    for (KisProjectionLeafSP leaf = cachePointLeaf->prevSibling(); leaf; leaf = leaf->prevSibling()) {
+        key.append(leaf->revision());
+    }
+    key.append(numCachedLeaves);
+
+    if (cachePointLeaf->flattenedBelowCache()->fetch(key, firstItem.m_applyRect, m_currentProjection)) {
+        DEBUG_NODE_ACTION("Fetched flattened-below cache", "", cachePointLeaf, firstItem.m_applyRect);
+
+        for (int i = 1; i < numCachedLeaves; i++) {
+            leafStack.pop();
+        }
+        return true;
+    }
+
+    m_belowCachePoint = cachePointLeaf;
+    m_belowCacheKey = key;
+    m_belowCacheRect = firstItem.m_applyRect;
+
+    return false;
+}
+
+void KisAsyncMerger::storeFlattenedBelowCache()
+{
+    if (m_currentProjection) {
+        m_belowCachePoint->flattenedBelowCache()->store(m_belowCacheKey, m_belowCacheRect, m_currentProjection);
+        DEBUG_NODE_ACTION("Stored flattened-below cache", "", m_belowCachePoint, m_belowCacheRect);
+    }
+
+    m_belowCachePoint = 0;
+    m_belowCacheKey.clear();
+}
+
 void KisAsyncMerger::doNotifyClones(KisBaseRectsWalker &walker) {
     KisBaseRectsWalker::CloneNotificationsVector &vector =
         walker.cloneNotifications();
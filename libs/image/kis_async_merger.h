@@ -6,12 +6,13 @@
 #ifndef __KIS_ASYNC_MERGER_H
 #define __KIS_ASYNC_MERGER_H
 
+#include <QRect>
+
 #include "kritaimage_export.h"
 #include "kis_types.h"
 #include "KisRenderPassFlags.h"
-
-class QRect;
-class KisBaseRectsWalker;
+#include "kis_base_rects_walker.h"
+#include "kis_flattened_below_cache.h"
 
 class KRITAIMAGE_EXPORT KisAsyncMerger
 {
@@ -25,6 +26,10 @@ private:
     inline bool compositeWithProjection(KisProjectionLeafSP leaf, const QRect &rect);
     inline void doNotifyClones(KisBaseRectsWalker &walker);
 
+    inline bool fetchFlattenedBelowCache(KisBaseRectsWalker::LeafStack &leafStack,
+                                         const KisBaseRectsWalker::JobItem &firstItem);
+    inline void storeFlattenedBelowCache();
+
 private:
     /**
      * The place where intermediate results of layer's merge
@@ -50,6 +55,17 @@ private:
      * setupProjection()
      */
     KisPaintDeviceSP m_cachedPaintDevice;
+
+    /**
+     * When the composition of the lower layers was not found in
+     * the flattened-below cache of a leaf, we save it there when
+     * the merge reaches this leaf.
+     *
+     * \see KisFlattenedBelowCache
+     */
+    KisProjectionLeafSP m_belowCachePoint;
+    KisFlattenedBelowCache::Key m_belowCacheKey;
+    QRect m_belowCacheRect;
 };
 
 
@@ -0,0 +1,296 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_flattened_below_cache.h"
+
+#include <QGlobalStatic>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRegion>
+#include <QVector>
+
+#include <KoColorSpace.h>
+
+#include "kis_paint_device.h"
+#include "kis_painter.h"
+#include "KisImageConfigNotifier.h"
+#include "tiles3/kis_tile_data_store.h"
+#include "tiles3/swap/kis_tile_data_swapper_p.h"
+
+namespace {
+
+/**
+ * The part of the soft limit of the tile data store,
+ * which can be occupied by the caches
+ */
+const int SOFT_LIMIT_FRACTION = 4;
+
+qint64 regionMetric(const QRegion &region, qint32 pixelSize)
+{
+    qint64 area = 0;
+
+    for (const QRect &rc : region) {
+        area += qint64(rc.width()) * rc.height();
+    }
+
+    return area * pixelSize / (KisTileData::WIDTH * KisTileData::HEIGHT);
+}
+
+}
+
+struct Q_DECL_HIDDEN KisFlattenedBelowCache::Private
+{
+    mutable QMutex lock;
+
+    Key key;
+    KisPaintDeviceSP device;
+    QRegion validRegion;
+
+    void reset() {
+        QMutexLocker l(&lock);
+        key.clear();
+        device = 0;
+        validRegion = QRegion();
+    }
+
+    bool isCompatible(KisPaintDeviceSP dev) const {
+        return device && *device->colorSpace() == *dev->colorSpace();
+    }
+};
+
+/**
+ * Tracks the memory used by all the caches and evicts the least
+ * recently used ones. The lock of the registry is always taken
+ * before the lock of a cache.
+ */
+class KisFlattenedBelowCacheRegistry
+{
+public:
+    KisFlattenedBelowCacheRegistry() {
+        rereadLimits();
+
+        // follow the changes of the memory settings
+        m_configConnection =
+            QObject::connect(KisImageConfigNotifier::instance(), &KisImageConfigNotifier::configChanged,
+                             [this] () { rereadLimits(); });
+    }
+
+    ~KisFlattenedBelowCacheRegistry() {
+        QObject::disconnect(m_configConnection);
+    }
+
+    void rereadLimits() {
+        KisStoreLimits limits;
+
+        QMutexLocker l(&m_lock);
+        m_softLimit = limits.softLimit();
+        m_hardLimit = limits.hardLimit();
+        m_budget = m_softLimit / SOFT_LIMIT_FRACTION;
+    }
+
+    void updateCache(KisFlattenedBelowCache *cache, qint64 metric) {
+        QMutexLocker l(&m_lock);
+
+        m_lru.removeOne(cache);
+        m_lru.append(cache);
+
+        m_totalMetric += metric - m_sizes.value(cache, 0);
+        m_sizes[cache] = metric;
+
+        const qint64 storeMetric = KisTileDataStore::instance()->memoryMetric();
+
+        /**
+         * The memory of an evicted cache doesn't leave the store
+         * immediately, so we count the freed metric ourselves
+         * instead of rechecking the store after every eviction.
+         */
+        qint64 totalMetric = m_totalMetric;
+        qint64 softOverflow = storeMetric - m_softLimit;
+        qint64 hardOverflow = storeMetric - m_hardLimit;
+
+        QVector<KisFlattenedBelowCache*> victims;
+
+        Q_FOREACH (KisFlattenedBelowCache *victim, m_lru) {
+            if (totalMetric <= m_budget && softOverflow <= 0) break;
+            if (victim == cache) continue;
+
+            const qint64 victimMetric = m_sizes.value(victim, 0);
+            totalMetric -= victimMetric;
+            softOverflow -= victimMetric;
+            hardOverflow -= victimMetric;
+
+            victims.append(victim);
+        }
+
+        /**
+         * The cache that is being filled right now is evicted
+         * only when the store is about to start swapping out
+         * the working set
+         */
+        if (hardOverflow > 0) {
+            victims.append(cache);
+        }
+
+        Q_FOREACH (KisFlattenedBelowCache *victim, victims) {
+            evictImpl(victim);
+        }
+    }
+
+    void markUsed(KisFlattenedBelowCache *cache) {
+        QMutexLocker l(&m_lock);
+
+        if (m_lru.removeOne(cache)) {
+            m_lru.append(cache);
+        }
+    }
+
+    void removeCache(KisFlattenedBelowCache *cache) {
+        QMutexLocker l(&m_lock);
+
+        m_lru.removeOne(cache);
+        m_totalMetric -= m_sizes.take(cache);
+    }
+
+    void evictAll() {
+        QMutexLocker l(&m_lock);
+
+        while (!m_lru.isEmpty()) {
+            evictImpl(m_lru.first());
+        }
+    }
+
+    qint64 totalMetric() {
+        QMutexLocker l(&m_lock);
+        return m_totalMetric;
+    }
+
+private:
+    void evictImpl(KisFlattenedBelowCache *cache) {
+        m_lru.removeOne(cache);
+        m_totalMetric -= m_sizes.take(cache);
+        cache->m_d->reset();
+    }
+
+private:
+    QMutex m_lock;
+
+    /**
+     * The least recently used cache goes first
+     */
+    QList<KisFlattenedBelowCache*> m_lru;
+    QHash<KisFlattenedBelowCache*, qint64> m_sizes;
+    qint64 m_totalMetric = 0;
+
+    qint64 m_budget = 0;
+    qint64 m_softLimit = 0;
+    qint64 m_hardLimit = 0;
+
+    QMetaObject::Connection m_configConnection;
+};
+
+Q_GLOBAL_STATIC(KisFlattenedBelowCacheRegistry, s_registry)
+
+
+KisFlattenedBelowCache::KisFlattenedBelowCache()
+    : m_d(new Private)
+{
+}
+
+KisFlattenedBelowCache::~KisFlattenedBelowCache()
+{
+    if (s_registry.exists()) {
+        s_registry->removeCache(this);
+    }
+    delete m_d;
+}
+
+bool KisFlattenedBelowCache::fetch(const Key &key, const QRect &rect, KisPaintDeviceSP dst)
+{
+    KisPaintDeviceSP device;
+
+    {
+        QMutexLocker l(&m_d->lock);
+
+        if (m_d->key != key ||
+            !m_d->isCompatible(dst) ||
+            !QRegion(rect).subtracted(m_d->validRegion).isEmpty()) {
+
+            return false;
+        }
+
+        /**
+         * The device may be reset by the eviction while we are
+         * copying, so keep a reference to it
+         */
+        device = m_d->device;
+    }
+
+    KisPainter::copyAreaOptimized(rect.topLeft(), device, dst, rect);
+    s_registry->markUsed(this);
+
+    return true;
+}
+
+void KisFlattenedBelowCache::store(const Key &key, const QRect &rect, KisPaintDeviceSP src)
+{
+    KisPaintDeviceSP device;
+
+    {
+        QMutexLocker l(&m_d->lock);
+
+        if (m_d->key != key || !m_d->isCompatible(src)) {
+            m_d->key = key;
+            m_d->device = new KisPaintDevice(src->colorSpace());
+            m_d->device->prepareClone(src);
+            m_d->validRegion = QRegion();
+        }
+
+        device = m_d->device;
+    }
+
+    KisPainter::copyAreaOptimized(rect.topLeft(), src, device, rect);
+
+    qint64 metric = 0;
+
+    {
+        QMutexLocker l(&m_d->lock);
+
+        /**
+         * The cache has been evicted or reset with a newer
+         * key while we were copying the data
+         */
+        if (m_d->device != device || m_d->key != key) return;
+
+        m_d->validRegion += rect;
+        metric = regionMetric(m_d->validRegion, device->pixelSize());
+    }
+
+    s_registry->updateCache(this, metric);
+}
+
+void KisFlattenedBelowCache::clear()
+{
+    s_registry->removeCache(this);
+    m_d->reset();
+}
+
+qint64 KisFlattenedBelowCache::memoryMetric() const
+{
+    QMutexLocker l(&m_d->lock);
+    return m_d->device ? regionMetric(m_d->validRegion, m_d->device->pixelSize()) : 0;
+}
+
+qint64 KisFlattenedBelowCache::totalMemoryMetric()
+{
+    return s_registry->totalMetric();
+}
+
+void KisFlattenedBelowCache::testingEvictAll()
+{
+    s_registry->evictAll();
+}
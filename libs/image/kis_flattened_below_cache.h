@@ -0,0 +1,89 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef __KIS_FLATTENED_BELOW_CACHE_H
+#define __KIS_FLATTENED_BELOW_CACHE_H
+
+#include <QVector>
+
+#include "kritaimage_export.h"
+#include "kis_types.h"
+
+class QRect;
+
+/**
+ * Keeps the composition of all the layers lying below a projection
+ * leaf (inside the same parent), so that KisAsyncMerger could skip
+ * compositing of the lower layers when only the leaf itself or the
+ * layers above it have changed. E.g. a stroke on the topmost layer of
+ * a document with hundreds of layers would composite only the
+ * topmost layer into the cached background.
+ *
+ * The content is identified by a key: the list of revisions of the
+ * lower leaves (see KisProjectionLeaf::revision()). When the key
+ * changes, the whole cache is dropped. Inside one key the cache
+ * keeps track of the area, which has already been filled.
+ *
+ * All the caches share a memory budget, which is derived from the
+ * soft limit of KisTileDataStore and follows the changes of the
+ * memory settings. When the budget is exceeded or the store goes
+ * above its soft limit, the least recently used caches are evicted
+ * until the memory is back under the limits.
+ *
+ * The class is thread-safe, but the callers must guarantee that the
+ * same area of the cache is not accessed by two threads at the same
+ * time, which is true for KisAsyncMerger, since the merge jobs
+ * touching the same area of a parent layer are never executed
+ * concurrently.
+ */
+class KRITAIMAGE_EXPORT KisFlattenedBelowCache
+{
+public:
+    typedef QVector<quint64> Key;
+
+public:
+    KisFlattenedBelowCache();
+    ~KisFlattenedBelowCache();
+
+    /**
+     * Copies the cached content of \p rect into \p dst. Returns false
+     * if the cache doesn't have up-to-date data for the whole rect.
+     */
+    bool fetch(const Key &key, const QRect &rect, KisPaintDeviceSP dst);
+
+    /**
+     * Saves the content of \p src in \p rect into the cache. If the
+     * key differs from the stored one, all the cached data is dropped.
+     */
+    void store(const Key &key, const QRect &rect, KisPaintDeviceSP src);
+
+    /**
+     * Drops all the cached data and releases the memory
+     */
+    void clear();
+
+    /**
+     * The size of the cached data in KisTileDataStore metric units
+     */
+    qint64 memoryMetric() const;
+
+    /**
+     * The total size of all the caches in KisTileDataStore metric units
+     */
+    static qint64 totalMemoryMetric();
+
+    /**
+     * Evicts all the caches. Used in unittests only.
+     */
+    static void testingEvictAll();
+
+private:
+    friend class KisFlattenedBelowCacheRegistry;
+
+    struct Private;
+    Private * const m_d;
+};
+
+#endif /* __KIS_FLATTENED_BELOW_CACHE_H */
@@ -275,6 +275,13 @@ public:
     KisUpdateScheduler scheduler;
     QAtomicInt disableDirtyRequests;
 
+    /**
+     * The viewport hints of all the views showing the image,
+     * \see setUpdatesViewportHint()
+     */
+    QMutex viewportHintsLock;
+    QHash<const void*, KisUpdatesViewportHint> viewportHints;
+
     KisCompositeProgressProxy compositeProgressProxy;
 
     QPointF axesCenter;
@@ -2547,6 +2554,17 @@ void KisImage::explicitRegenerateLevelOfDetail()
     }
 }
 
+bool KisImage::warmUpLevelOfDetail()
+{
+    const KisLodPreferences pref = m_d->scheduler.lodPreferences();
+
+    if (pref.lodSupported() && pref.lodPreferred()) {
+        return m_d->scheduler.warmUpLevelOfDetail();
+    }
+
+    return false;
+}
+
 void KisImage::setLodPreferences(const KisLodPreferences &value)
 {
     m_d->scheduler.setLodPreferences(value);
@@ -2557,6 +2575,26 @@ KisLodPreferences KisImage::lodPreferences() const
     return m_d->scheduler.lodPreferences();
 }
 
+void KisImage::setUpdatesViewportHint(const void *view, const KisUpdatesViewportHint &hint)
+{
+    QMutexLocker l(&m_d->viewportHintsLock);
+    m_d->viewportHints.insert(view, hint);
+    m_d->scheduler.setViewportHints(m_d->viewportHints.values().toVector());
+}
+
+void KisImage::removeUpdatesViewportHint(const void *view)
+{
+    QMutexLocker l(&m_d->viewportHintsLock);
+    if (m_d->viewportHints.remove(view)) {
+        m_d->scheduler.setViewportHints(m_d->viewportHints.values().toVector());
+    }
+}
+
+qint64 KisImage::lastTimeToFirstVisiblePixel() const
+{
+    return m_d->scheduler.lastTimeToFirstVisiblePixel();
+}
+
 void KisImage::nodeCollapsedChanged(KisNode * node)
 {
     Q_UNUSED(node);
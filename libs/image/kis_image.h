@@ -21,6 +21,7 @@
 #include "kis_image_interfaces.h"
 #include "kis_strokes_queue_undo_result.h"
 #include "KisLodPreferences.h"
+#include "KisUpdatesViewportHint.h"
 #include "KisWraparoundAxis.h"
 
 #include <kritaimage_export.h>
@@ -769,6 +770,19 @@ public Q_SLOTS:
 
 public:
 
+    /**
+     * Regenerate LoD planes in the background if they have been made
+     * outdated by some legacy (non-LoD) action. The regeneration is
+     * cancelled as soon as the user starts a new action, but if that
+     * action supports Instant Preview, it just waits for the planes
+     * to be ready. Should be called when the image is idle, so the
+     * first Instant Preview stroke started after a legacy action
+     * doesn't need to wait for the full sync of the planes.
+     *
+     * \return true if the regeneration has been started
+     */
+    bool warmUpLevelOfDetail();
+
     /**
      * Set preferences for the level-of-detail functionality.
      * Due to multithreading considerations they may be applied
@@ -784,6 +798,27 @@ public:
      */
     KisLodPreferences lodPreferences() const;
 
+    /**
+     * Tell the image which part of it is visible in the view \p view
+     * and where the cursor is, so that the visible parts are updated
+     * first. Every view keeps its own hint, the image merges the hints
+     * of all the views. \p view is used as a key only.
+     *
+     * \see KisUpdateScheduler::setViewportHints()
+     */
+    void setUpdatesViewportHint(const void *view, const KisUpdatesViewportHint &hint);
+
+    /**
+     * Remove the hint of the view \p view, e.g. when it is closed,
+     * \see setUpdatesViewportHint()
+     */
+    void removeUpdatesViewportHint(const void *view);
+
+    /**
+     * \see KisUpdateScheduler::lastTimeToFirstVisiblePixel()
+     */
+    qint64 lastTimeToFirstVisiblePixel() const;
+
     KisImageAnimationInterface *animationInterface() const;
 
     /**
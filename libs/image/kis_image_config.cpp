@@ -22,6 +22,7 @@
 #include <QDir>
 
 #include "kis_global.h"
+#include "tiles3/swap/kis_tile_compressor_factory.h"
 #include <cmath>
 #include <QTemporaryFile>
 
@@ -124,6 +125,28 @@ qreal KisImageConfig::maxMergeCollectAlpha() const
     return m_config.readEntry("maxMergeCollectAlpha", 1.5);
 }
 
+int KisImageConfig::updateWalkerOverhead(bool requestDefault) const
+{
+    return !requestDefault ?
+        qMax(0, m_config.readEntry("updateWalkerOverhead", 4096)) : 4096;
+}
+
+void KisImageConfig::setUpdateWalkerOverhead(int value)
+{
+    m_config.writeEntry("updateWalkerOverhead", value);
+}
+
+int KisImageConfig::updateNodeOverhead(bool requestDefault) const
+{
+    return !requestDefault ?
+        qMax(0, m_config.readEntry("updateNodeOverhead", 256)) : 256;
+}
+
+void KisImageConfig::setUpdateNodeOverhead(int value)
+{
+    m_config.writeEntry("updateNodeOverhead", value);
+}
+
 qreal KisImageConfig::schedulerBalancingRatio() const
 {
     /**
@@ -168,6 +191,28 @@ void KisImageConfig::setSwapWindowSize(int value)
     m_config.writeEntry("swapWindowSize", value);
 }
 
+QString KisImageConfig::swapCompression(bool requestDefault) const
+{
+    const QString defaultValue = KisTileCompressorFactory::defaultSwapCompression();
+    return !requestDefault ?
+        m_config.readEntry("swapCompression", defaultValue) : defaultValue;
+}
+
+void KisImageConfig::setSwapCompression(const QString &value)
+{
+    m_config.writeEntry("swapCompression", value);
+}
+
+bool KisImageConfig::swapUncompressedTier(bool requestDefault) const
+{
+    return !requestDefault ? m_config.readEntry("swapUncompressedTier", false) : false;
+}
+
+void KisImageConfig::setSwapUncompressedTier(bool value)
+{
+    m_config.writeEntry("swapUncompressedTier", value);
+}
+
 int KisImageConfig::tilesHardLimit() const
 {
     qreal hp = qreal(memoryHardLimitPercent()) / 100.0;
@@ -191,6 +236,22 @@ int KisImageConfig::poolLimit() const
     return totalRAM() * hp * pp;
 }
 
+qreal KisImageConfig::historyCompressionLimitPercent(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("historyCompressionLimitPercent", 10.) : 10.;
+}
+
+void KisImageConfig::setHistoryCompressionLimitPercent(qreal value)
+{
+    m_config.writeEntry("historyCompressionLimitPercent", value);
+}
+
+int KisImageConfig::historyCompressionLimit() const
+{
+    return tilesHardLimit() * historyCompressionLimitPercent() / 100.0;
+}
+
 qreal KisImageConfig::memoryHardLimitPercent(bool requestDefault) const
 {
     return !requestDefault ?
@@ -620,6 +681,27 @@ void KisImageConfig::setFpsLimit(int value)
     m_config.writeEntry("fpsLimit", value);
 }
 
+bool KisImageConfig::canvasFramePacing(bool defaultValue) const
+{
+    return defaultValue ? false : m_config.readEntry("canvasFramePacing", false);
+}
+
+void KisImageConfig::setCanvasFramePacing(bool value)
+{
+    m_config.writeEntry("canvasFramePacing", value);
+}
+
+int KisImageConfig::canvasFramePacingBudget(bool defaultValue) const
+{
+    int budget = defaultValue ? 50 : m_config.readEntry("canvasFramePacingBudget", 50);
+    return qBound(10, budget, 100);
+}
+
+void KisImageConfig::setCanvasFramePacingBudget(int value)
+{
+    m_config.writeEntry("canvasFramePacingBudget", value);
+}
+
 bool KisImageConfig::useOnDiskAnimationCacheSwapping(bool defaultValue) const
 {
     return defaultValue ? true : m_config.readEntry("useOnDiskAnimationCacheSwapping", true);
@@ -34,6 +34,23 @@ public:
     qreal maxCollectAlpha() const;
     qreal maxMergeAlpha() const;
     qreal maxMergeCollectAlpha() const;
+
+    /**
+     * The cost model used by KisSimpleUpdateQueue for coalescing small
+     * dirty rects into bigger merge jobs. The cost of a walker is
+     * estimated as
+     *
+     *     walkerOverhead + numNodes * (nodeOverhead + area),
+     *
+     * where all the values are measured in the pixels of composition
+     * work. The rects are coalesced only when it decreases the cost.
+     */
+    int updateWalkerOverhead(bool requestDefault = false) const;
+    void setUpdateWalkerOverhead(int value);
+
+    int updateNodeOverhead(bool requestDefault = false) const;
+    void setUpdateNodeOverhead(int value);
+
     qreal schedulerBalancingRatio() const;
     void setSchedulerBalancingRatio(qreal value);
 
@@ -46,10 +63,36 @@ public:
     int swapWindowSize() const;
     void setSwapWindowSize(int value);
 
+    /**
+     * Id of the codec used for compressing tiles in the swap file,
+     * see KisTileCompressorFactory::availableSwapCompressions(). The
+     * value is read once per session, when the swap is initialized.
+     */
+    QString swapCompression(bool requestDefault = false) const;
+    void setSwapCompression(const QString &value);
+
+    /**
+     * When enabled, the tiles that were only read since they had
+     * been loaded from swap are stored uncompressed on the next
+     * swap-out, so they can be read right from the swap file.
+     * The value is read once per session.
+     */
+    bool swapUncompressedTier(bool requestDefault = false) const;
+    void setSwapUncompressedTier(bool value);
+
     int tilesHardLimit() const; // MiB
     int tilesSoftLimit() const; // MiB
     int poolLimit() const; // MiB
 
+    /**
+     * The maximum size of the compressed undo history kept in memory,
+     * in percents of tilesHardLimit(). Zero disables compression of
+     * the history. The value is read once per session.
+     */
+    qreal historyCompressionLimitPercent(bool requestDefault = false) const;
+    void setHistoryCompressionLimitPercent(qreal value);
+    int historyCompressionLimit() const; // MiB
+
     qreal memoryHardLimitPercent(bool requestDefault = false) const; // % of total RAM
     qreal memorySoftLimitPercent(bool requestDefault = false) const; // % of memoryHardLimitPercent() * (1 - 0.01 * memoryPoolLimitPercent())
     qreal memoryPoolLimitPercent(bool requestDefault = false) const; // % of memoryHardLimitPercent()
@@ -121,6 +164,20 @@ public:
     int fpsLimit(bool defaultValue = false) const;
     void setFpsLimit(int value);
 
+    /**
+     * When enabled, the canvas uploads the updated parts of the image
+     * into its textures in portions that fit into
+     * canvasFramePacingBudget() percent of a display frame. The rest
+     * of the updates is carried over to the next frame, so the cursor
+     * and the brush outline are still repainted with the refresh rate
+     * of the display during heavy updates.
+     */
+    bool canvasFramePacing(bool defaultValue = false) const;
+    void setCanvasFramePacing(bool value);
+
+    int canvasFramePacingBudget(bool defaultValue = false) const;
+    void setCanvasFramePacingBudget(int value);
+
     bool useOnDiskAnimationCacheSwapping(bool defaultValue = false) const;
     void setUseOnDiskAnimationCacheSwapping(bool value);
 
@@ -144,6 +144,20 @@ KisMemoryStatisticsServer::fetchMemoryStatistics(KisImageSP image) const
     stats.poolSize = tileStats.poolSize;
 
     stats.swapSize = tileStats.swapSize;
+    stats.swapFileSize = tileStats.swapFileSize;
+    stats.swapFragmentation = tileStats.swapFragmentation;
+    stats.swapChunkAllocationTime = tileStats.swapChunkAllocationTime;
+    stats.swapChunkFreeTime = tileStats.swapChunkFreeTime;
+    stats.swapPrefetchedTiles = tileStats.swapPrefetchedTiles;
+    stats.swapPrefetchHits = tileStats.swapPrefetchHits;
+    stats.swapInMisses = tileStats.swapInMisses;
+    stats.swapDirectReads = tileStats.swapDirectReads;
+    stats.swapDeduplicatedTiles = tileStats.swapDeduplicatedTiles;
+    stats.swapDeduplicatedSize = tileStats.swapDeduplicatedSize;
+
+    stats.compressedHistorySize = tileStats.compressedHistorySize;
+    stats.compressedHistoryOriginalSize = tileStats.compressedHistoryOriginalSize;
+    stats.compressedHistoryLimit = tileStats.compressedHistoryLimit;
 
     KisImageConfig cfg(true);
 
@@ -157,7 +171,6 @@ KisMemoryStatisticsServer::fetchMemoryStatistics(KisImageSP image) const
 
 void KisMemoryStatisticsServer::tryForceUpdateMemoryStatisticsWhileIdle()
 {
-    KisTileDataStore::instance()->tryForceUpdateMemoryStatisticsWhileIdle();
     notifyImageChanged();
 }
 
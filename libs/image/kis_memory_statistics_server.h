@@ -33,6 +33,20 @@ public:
               poolSize(0),
 
               swapSize(0),
+              swapFileSize(0),
+              swapFragmentation(0),
+              swapChunkAllocationTime(0),
+              swapChunkFreeTime(0),
+              swapPrefetchedTiles(0),
+              swapPrefetchHits(0),
+              swapInMisses(0),
+              swapDirectReads(0),
+              swapDeduplicatedTiles(0),
+              swapDeduplicatedSize(0),
+
+              compressedHistorySize(0),
+              compressedHistoryOriginalSize(0),
+              compressedHistoryLimit(0),
 
               totalMemoryLimit(0),
               tilesHardLimit(0),
@@ -52,6 +66,20 @@ public:
         qint64 poolSize;
 
         qint64 swapSize;
+        qint64 swapFileSize;
+        qreal swapFragmentation;
+        qint64 swapChunkAllocationTime; // ns
+        qint64 swapChunkFreeTime; // ns
+        qint64 swapPrefetchedTiles;
+        qint64 swapPrefetchHits;
+        qint64 swapInMisses;
+        qint64 swapDirectReads;
+        qint64 swapDeduplicatedTiles;
+        qint64 swapDeduplicatedSize;
+
+        qint64 compressedHistorySize;
+        qint64 compressedHistoryOriginalSize;
+        qint64 compressedHistoryLimit;
 
         qint64 totalMemoryLimit;
         qint64 tilesHardLimit;
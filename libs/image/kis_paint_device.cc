@@ -1823,6 +1823,11 @@ QImage KisPaintDevice::createThumbnail(qint32 maxw, qint32 maxh,
                            oversample, renderingIntent, conversionFlags);
 }
 
+void KisPaintDevice::prefetchRect(const QRect &rect) const
+{
+    m_d->dataManager()->prefetchRect(rect.translated(-m_d->x(), -m_d->y()));
+}
+
 KisHLineIteratorSP KisPaintDevice::createHLineIteratorNG(qint32 x, qint32 y, qint32 w)
 {
     m_d->cache()->invalidate();
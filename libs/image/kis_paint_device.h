@@ -829,6 +829,13 @@ public:
 
 public:
 
+    /**
+     * Hints the tiles engine that \p rect is going to be read soon,
+     * so that the tiles lying in the swap file could be loaded in
+     * background. The sequential iterators call it automatically.
+     */
+    void prefetchRect(const QRect &rect) const;
+
     KisHLineIteratorSP createHLineIteratorNG(qint32 x, qint32 y, qint32 w);
     KisHLineConstIteratorSP createHLineConstIteratorNG(qint32 x, qint32 y, qint32 w) const;
 
@@ -11,6 +11,8 @@
 #include "KisInterstrokeData.h"
 #include "KisSequentialIteratorProgress.h"
 #include "KoAlwaysInline.h"
+#include "KoBatchedColorConversion.h"
+#include "kis_image_config.h"
 #include "kis_command_utils.h"
 #include "kundo2command.h"
 
@@ -164,17 +166,10 @@ public:
                                KUndo2Command *parentCommand,
                                KoUpdater *updater = nullptr)
     {
-        using InternalSequentialConstIterator =
-            KisSequentialIteratorBase<ReadOnlyIteratorPolicy<DirectDataAccessPolicy>, DirectDataAccessPolicy, ProxyBasedProgressPolicy>;
-        using InternalSequentialIterator =
-            KisSequentialIteratorBase<WritableIteratorPolicy<DirectDataAccessPolicy>, DirectDataAccessPolicy, ProxyBasedProgressPolicy>;
-
         if (m_colorSpace == dstColorSpace || *m_colorSpace == *dstColorSpace) {
             return;
         }
 
-        QRect rc = m_dataManager->region().boundingRect();
-
         const int dstPixelSize = dstColorSpace->pixelSize();
         QScopedArrayPointer<quint8> dstDefaultPixel(new quint8[dstPixelSize]);
         memset(dstDefaultPixel.data(), 0, dstPixelSize);
@@ -182,29 +177,51 @@ public:
 
         KisDataManagerSP dstDataManager = new KisDataManager(dstPixelSize, dstDefaultPixel.data());
 
+        /**
+         * Both data managers have the same tile grid, so every existing
+         * source tile is converted right into the corresponding destination
+         * tile, without any intermediate buffers. The tiles that don't exist
+         * in the source device have the default pixel, which is already
+         * converted above.
+         */
+        const QVector<KisTileSP> tiles = m_dataManager->tiles();
 
-        if (!rc.isEmpty()) {
-            InternalSequentialConstIterator srcIt(DirectDataAccessPolicy(m_dataManager.data(), cacheInvalidator()), rc, updater);
-            InternalSequentialIterator dstIt(DirectDataAccessPolicy(dstDataManager.data(), cacheInvalidator()), rc, updater);
+        if (!tiles.isEmpty()) {
+            const int tilesPerBatch = 8;
+            const int numBatches = (tiles.size() + tilesPerBatch - 1) / tilesPerBatch;
 
-            int nConseqPixels = srcIt.nConseqPixels();
+            KoBatchedColorConversion conversion(m_colorSpace, dstColorSpace, renderingIntent, conversionFlags);
+            conversion.setMaxThreads(KisImageConfig(true).maxNumberOfThreads());
 
-            // since we are accessing data managers directly, the columns are always aligned
-            KIS_SAFE_ASSERT_RECOVER_NOOP(srcIt.nConseqPixels() == dstIt.nConseqPixels());
+            ProxyBasedProgressPolicy progressPolicy(updater);
+            progressPolicy.setRange(0, numBatches);
 
-            while(srcIt.nextPixels(nConseqPixels) &&
-                  dstIt.nextPixels(nConseqPixels)) {
+            KisDataManager *dstDataManagerPtr = dstDataManager.data();
 
-                nConseqPixels = srcIt.nConseqPixels();
+            conversion.run(numBatches,
+                [&tiles, dstDataManagerPtr] (int batch, const KoColorConversionTransformation *transformation) {
+                    const int begin = batch * tilesPerBatch;
+                    const int end = qMin(begin + tilesPerBatch, tiles.size());
 
-                const quint8 *srcData = srcIt.rawDataConst();
-                quint8 *dstData = dstIt.rawData();
+                    for (int i = begin; i < end; i++) {
+                        const KisTileSP &srcTile = tiles[i];
+                        KisTileSP dstTile = dstDataManagerPtr->getTile(srcTile->col(), srcTile->row(), true);
 
-                m_colorSpace->convertPixelsTo(srcData, dstData,
-                                              dstColorSpace,
-                                              nConseqPixels,
-                                              renderingIntent, conversionFlags);
-            }
+                        srcTile->lockForRead();
+                        dstTile->lockForWrite();
+
+                        transformation->transform(srcTile->data(), dstTile->data(),
+                                                  KisTileData::WIDTH * KisTileData::HEIGHT);
+
+                        dstTile->unlockForWrite();
+                        srcTile->unlockForRead();
+                    }
+                },
+                [&progressPolicy] (int numProcessedBatches) {
+                    progressPolicy.setValue(numProcessedBatches);
+                });
+
+            progressPolicy.setFinished();
         }
 
         // becomes owned by the parent
@@ -749,7 +749,8 @@ void KisPainter::bitBltImpl(qint32 dstX, qint32 dstY,
                 d->paramInfo.dstRowStride  = dstRowStride;
                 // if we don't use the oldRawData, we need to access the rawData of the source device.
                 d->paramInfo.srcRowStart   = useOldSrcData ? srcIt->oldRawData() : static_cast<KisRandomAccessor2*>(srcIt.data())->rawData();
-                d->paramInfo.srcRowStride  = srcRowStride;
+                // a uniform source tile is passed to the composite op as a single pixel
+                d->paramInfo.srcRowStride  = !useOldSrcData && srcIt->isUniformArea() ? 0 : srcRowStride;
                 d->paramInfo.maskRowStart  = static_cast<KisRandomAccessor2*>(maskIt.data())->rawData();
                 d->paramInfo.maskRowStride = maskRowStride;
                 d->paramInfo.rows          = rows;
@@ -797,7 +798,8 @@ void KisPainter::bitBltImpl(qint32 dstX, qint32 dstY,
                 d->paramInfo.dstRowStride  = dstRowStride;
                 // if we don't use the oldRawData, we need to access the rawData of the source device.
                 d->paramInfo.srcRowStart   = useOldSrcData ? srcIt->oldRawData() : static_cast<KisRandomAccessor2*>(srcIt.data())->rawData();
-                d->paramInfo.srcRowStride  = srcRowStride;
+                // a uniform source tile is passed to the composite op as a single pixel
+                d->paramInfo.srcRowStride  = !useOldSrcData && srcIt->isUniformArea() ? 0 : srcRowStride;
                 d->paramInfo.maskRowStart  = 0;
                 d->paramInfo.maskRowStride = 0;
                 d->paramInfo.rows          = rows;
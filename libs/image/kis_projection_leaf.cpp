@@ -21,6 +21,17 @@
 #include "kis_async_merger.h"
 #include "kis_node_graph_listener.h"
 #include "kis_clone_layer.h"
+#include "kis_flattened_below_cache.h"
+
+#include <atomic>
+
+namespace {
+std::atomic<quint64> s_lastRevision {0};
+
+quint64 nextRevision() {
+    return ++s_lastRevision;
+}
+}
 
 
 struct Q_DECL_HIDDEN KisProjectionLeaf::Private
@@ -30,6 +41,9 @@ struct Q_DECL_HIDDEN KisProjectionLeaf::Private
     KisNodeWSP node;
     bool isTemporaryHidden = false;
 
+    std::atomic<quint64> revision {nextRevision()};
+    mutable KisFlattenedBelowCache flattenedBelowCache;
+
     static bool checkPassThrough(const KisNode *node) {
         const KisGroupLayer *group = qobject_cast<const KisGroupLayer*>(node);
         return group && group->passThroughMode();
@@ -411,3 +425,18 @@ void KisProjectionLeaf::explicitlyRegeneratePassThroughProjection()
 
     m_d->temporarySetPassThrough(true);
 }
+
+quint64 KisProjectionLeaf::revision() const
+{
+    return m_d->revision.load(std::memory_order_acquire);
+}
+
+void KisProjectionLeaf::bumpRevision()
+{
+    m_d->revision.store(nextRevision(), std::memory_order_release);
+}
+
+KisFlattenedBelowCache* KisProjectionLeaf::flattenedBelowCache() const
+{
+    return &m_d->flattenedBelowCache;
+}
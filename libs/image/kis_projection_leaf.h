@@ -13,6 +13,7 @@
 #include "kritaimage_export.h"
 
 class KisNodeVisitor;
+class KisFlattenedBelowCache;
 
 
 class KRITAIMAGE_EXPORT KisProjectionLeaf
@@ -91,6 +92,23 @@ public:
      */
     void explicitlyRegeneratePassThroughProjection();
 
+    /**
+     * The revision of the leaf's projection. It is changed by
+     * KisAsyncMerger every time the projection is regenerated. The
+     * revisions are unique among all the leaves, so a list of them
+     * identifies the content of a stack of leaves.
+     */
+    quint64 revision() const;
+    void bumpRevision();
+
+    /**
+     * The composition of all the leaves lying below this one
+     * in the same parent.
+     *
+     * \see KisFlattenedBelowCache
+     */
+    KisFlattenedBelowCache* flattenedBelowCache() const;
+
 private:
     struct Private;
     const QScopedPointer<Private> m_d;
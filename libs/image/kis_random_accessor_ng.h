@@ -19,6 +19,15 @@ public:
     virtual qint32 numContiguousColumns(qint32 x) const = 0;
     virtual qint32 numContiguousRows(qint32 y) const = 0;
     virtual qint32 rowStride(qint32 x, qint32 y) const = 0;
+
+    /**
+     * Returns true if all the pixels of the contiguous area at the
+     * current position (see numContiguousColumns() and
+     * numContiguousRows()) have the same value. In such a case the
+     * area can be read as a single pixel, e.g. by passing zero
+     * srcRowStride to a composite op.
+     */
+    virtual bool isUniformArea() const = 0;
 };
 
 class KRITAIMAGE_EXPORT KisRandomAccessorNG : public KisRandomConstAccessorNG, public KisBaseAccessor
@@ -21,10 +21,12 @@ struct DevicePolicy {
     DevicePolicy(Convertible sel) : m_dev(sel) {}
 
     KisHLineConstIteratorSP createConstIterator(const QRect &rect) {
+        m_dev->prefetchRect(rect);
         return m_dev->createHLineConstIteratorNG(rect.x(), rect.y(), rect.width());
     }
 
     KisHLineIteratorSP createIterator(const QRect &rect) {
+        m_dev->prefetchRect(rect);
         return m_dev->createHLineIteratorNG(rect.x(), rect.y(), rect.width());
     }
 
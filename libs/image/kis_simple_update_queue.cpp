@@ -6,12 +6,19 @@
 
 #include "kis_simple_update_queue.h"
 
+#include <QHash>
 #include <QMutexLocker>
 #include <QVector>
 
+#include <algorithm>
+#include <vector>
+#include <limits>
+
 #include "kis_image_config.h"
 #include "kis_full_refresh_walker.h"
 #include "kis_spontaneous_job.h"
+#include "kis_lod_transform_base.h"
+#include "tiles3/kis_tile_data_interface.h"
 
 
 //#define ENABLE_DEBUG_JOIN
@@ -68,6 +75,9 @@ void KisSimpleUpdateQueue::updateSettings()
     m_maxCollectAlpha = config.maxCollectAlpha();
     m_maxMergeAlpha = config.maxMergeAlpha();
     m_maxMergeCollectAlpha = config.maxMergeCollectAlpha();
+
+    m_walkerOverhead = config.updateWalkerOverhead();
+    m_nodeOverhead = config.updateNodeOverhead();
 }
 
 int KisSimpleUpdateQueue::overrideLevelOfDetail() const
@@ -85,10 +95,89 @@ void KisSimpleUpdateQueue::processQueue(KisUpdaterContext &updaterContext)
     updaterContext.unlock();
 }
 
+void KisSimpleUpdateQueue::setViewportHints(const KisUpdatesViewportHints &hints)
+{
+    QMutexLocker locker(&m_lock);
+
+    m_viewportHints = hints;
+    m_priorityOrderDirty = true;
+}
+
+bool KisSimpleUpdateQueue::intersectsVisibleArea(const QRect &rc, int levelOfDetail) const
+{
+    QMutexLocker locker(&m_lock);
+    return intersectsVisibleAreaImpl(rc, levelOfDetail);
+}
+
+bool KisSimpleUpdateQueue::intersectsVisibleAreaImpl(const QRect &rc, int levelOfDetail) const
+{
+    const KisLodTransformBase t(levelOfDetail);
+
+    Q_FOREACH (const KisUpdatesViewportHint &hint, m_viewportHints) {
+        if (t.map(hint.visibleRect).intersects(rc)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void KisSimpleUpdateQueue::sortByViewportPriority()
+{
+    if (!m_priorityOrderDirty) return;
+    m_priorityOrderDirty = false;
+
+    if (m_viewportHints.isEmpty() || m_updatesList.size() <= 1) return;
+
+    struct Item {
+        bool isOffscreen;
+        qreal distance;
+        KisBaseRectsWalkerSP walker;
+    };
+
+    std::vector<Item> items;
+    items.reserve(m_updatesList.size());
+
+    Q_FOREACH (const KisBaseRectsWalkerSP &walker, m_updatesList) {
+        const int lod = walker->levelOfDetail();
+        const QRect rc = walker->requestedRect();
+        const KisLodTransformBase t(lod);
+
+        qreal distance = std::numeric_limits<qreal>::max();
+
+        Q_FOREACH (const KisUpdatesViewportHint &hint, m_viewportHints) {
+            const QPointF focus = t.map(hint.effectiveFocusPoint());
+
+            const qreal dx = std::max({qreal(rc.left()) - focus.x(), focus.x() - qreal(rc.right()), qreal(0)});
+            const qreal dy = std::max({qreal(rc.top()) - focus.y(), focus.y() - qreal(rc.bottom()), qreal(0)});
+
+            distance = std::min(distance, dx * dx + dy * dy);
+        }
+
+        items.push_back({!intersectsVisibleAreaImpl(rc, lod), distance, walker});
+    }
+
+    /**
+     * The sorting is stable, so the jobs with equal priority
+     * are still processed in FIFO order
+     */
+    std::stable_sort(items.begin(), items.end(),
+                     [] (const Item &lhs, const Item &rhs) {
+                         return lhs.isOffscreen != rhs.isOffscreen ?
+                             rhs.isOffscreen : lhs.distance < rhs.distance;
+                     });
+
+    m_updatesList.clear();
+    for (const Item &item : items) {
+        m_updatesList.append(item.walker);
+    }
+}
+
 bool KisSimpleUpdateQueue::processOneJob(KisUpdaterContext &updaterContext)
 {
     QMutexLocker locker(&m_lock);
 
+    sortByViewportPriority();
+
     KisBaseRectsWalkerSP item;
     KisMutableWalkersListIterator iter(m_updatesList);
     bool jobAdded = false;
@@ -188,7 +277,10 @@ void KisSimpleUpdateQueue::addJob(KisNodeSP node, const QVector<QRect> &rects,
 {
     QList<KisBaseRectsWalkerSP> walkers;
 
-    Q_FOREACH (const QRect &rc, rects) {
+    const QVector<QRect> coalescedRects =
+        rects.size() > 1 ? coalesceRects(node, rects) : rects;
+
+    Q_FOREACH (const QRect &rc, coalescedRects) {
         if (rc.isEmpty()) continue;
 
         KisBaseRectsWalkerSP walker;
@@ -237,6 +329,7 @@ void KisSimpleUpdateQueue::addJob(KisNodeSP node, const QVector<QRect> &rects,
     if (!walkers.isEmpty()) {
         m_lock.lock();
         m_updatesList.append(walkers);
+        m_priorityOrderDirty = true;
         m_lock.unlock();
     }
 }
@@ -274,6 +367,124 @@ qint32 KisSimpleUpdateQueue::sizeMetric() const
     return m_updatesList.size() + m_spontaneousJobsList.size();
 }
 
+namespace {
+inline int tileIndex(int x, int tileSize) {
+    return x >= 0 ? x / tileSize : (x + 1) / tileSize - 1;
+}
+
+inline quint64 tileKey(int col, int row) {
+    return (quint64(quint32(col)) << 32) | quint32(row);
+}
+}
+
+int KisSimpleUpdateQueue::estimateWalkerNodes(KisNodeSP node)
+{
+    /**
+     * The walker recomposes all the children of every parent
+     * of the changed node
+     */
+    int numNodes = 1;
+
+    for (KisNodeSP parent = node->parent(); parent; parent = parent->parent()) {
+        numNodes += parent->childCount();
+    }
+
+    return numNodes;
+}
+
+bool KisSimpleUpdateQueue::tryCoalesceRects(QRect &baseRect, const QRect &newRect, int numNodes) const
+{
+    const QRect unitedRect = baseRect | newRect;
+    if (unitedRect.width() > m_patchWidth || unitedRect.height() > m_patchHeight)
+        return false;
+
+    /**
+     * cost(base) + cost(new) vs. cost(base | new), where
+     * cost(rc) = walkerOverhead + numNodes * (nodeOverhead + area(rc))
+     */
+    const qint64 extraArea =
+        qint64(unitedRect.width()) * unitedRect.height() -
+        qint64(baseRect.width()) * baseRect.height() -
+        qint64(newRect.width()) * newRect.height();
+
+    if (numNodes * extraArea > m_walkerOverhead + numNodes * m_nodeOverhead)
+        return false;
+
+    DEBUG_JOIN(baseRect, newRect, numNodes * extraArea);
+
+    baseRect = unitedRect;
+    return true;
+}
+
+QVector<QRect> KisSimpleUpdateQueue::coalesceRects(KisNodeSP node, const QVector<QRect> &rects) const
+{
+    /**
+     * Scattered dabs (spray, particles) produce thousands of tiny
+     * rects, and the overhead of a walker for every rect is much
+     * higher than the cost of compositing a few extra pixels. The rects
+     * are bucketed into the image tiles they cover, and every rect is
+     * coalesced with the rects started in the same tiles, if the cost
+     * model says it is cheaper.
+     */
+    const int numNodes = estimateWalkerNodes(node);
+
+    QVector<QRect> result;
+    result.reserve(rects.size());
+
+    QHash<quint64, int> tileToRect;
+
+    Q_FOREACH (const QRect &rc, rects) {
+        if (rc.isEmpty()) continue;
+
+        if (rc.width() > m_patchWidth || rc.height() > m_patchHeight) {
+            result.append(rc);
+            continue;
+        }
+
+        const int firstCol = tileIndex(rc.left(), KisTileData::WIDTH);
+        const int lastCol = tileIndex(rc.right(), KisTileData::WIDTH);
+        const int firstRow = tileIndex(rc.top(), KisTileData::HEIGHT);
+        const int lastRow = tileIndex(rc.bottom(), KisTileData::HEIGHT);
+
+        int index = -1;
+
+        for (int row = firstRow; row <= lastRow && index < 0; row++) {
+            for (int col = firstCol; col <= lastCol && index < 0; col++) {
+                auto it = tileToRect.constFind(tileKey(col, row));
+                if (it != tileToRect.constEnd() &&
+                    tryCoalesceRects(result[*it], rc, numNodes)) {
+
+                    index = *it;
+                }
+            }
+        }
+
+        if (index < 0) {
+            index = result.size();
+            result.append(rc);
+        }
+
+        /**
+         * The coalesced rect may have grown beyond the tiles of \p rc,
+         * so all the tiles of the resulting rect are bucketed
+         */
+        const QRect &bucketRect = result[index];
+
+        const int bucketFirstCol = tileIndex(bucketRect.left(), KisTileData::WIDTH);
+        const int bucketLastCol = tileIndex(bucketRect.right(), KisTileData::WIDTH);
+        const int bucketFirstRow = tileIndex(bucketRect.top(), KisTileData::HEIGHT);
+        const int bucketLastRow = tileIndex(bucketRect.bottom(), KisTileData::HEIGHT);
+
+        for (int row = bucketFirstRow; row <= bucketLastRow; row++) {
+            for (int col = bucketFirstCol; col <= bucketLastCol; col++) {
+                tileToRect.insert(tileKey(col, row), index);
+            }
+        }
+    }
+
+    return result;
+}
+
 bool KisSimpleUpdateQueue::trySplitJob(KisNodeSP node, const QRect& rc,
                                        const QRect& cropRect,
                                        int levelOfDetail,
@@ -386,6 +597,7 @@ void KisSimpleUpdateQueue::collectJobs(KisBaseRectsWalkerSP &baseWalker,
 
     if(baseWalker->requestedRect() != baseRect) {
         baseWalker->collectRects(baseWalker->startNode(), baseRect);
+        m_priorityOrderDirty = true;
     }
 }
 
@@ -10,6 +10,7 @@
 #include <QMutex>
 #include "kis_updater_context.h"
 #include <KisProjectionUpdateFlags.h>
+#include "KisUpdatesViewportHint.h"
 
 typedef QList<KisBaseRectsWalkerSP> KisWalkersList;
 typedef QListIterator<KisBaseRectsWalkerSP> KisWalkersListIterator;
@@ -49,11 +50,32 @@ public:
 
     int overrideLevelOfDetail() const;
 
+    /**
+     * Sets the areas of the image visible in all the views and the
+     * points the user is focused on in them. When the hints are set,
+     * the merge jobs intersecting any visible area are started first,
+     * nearest to any of the focus points first. The offscreen jobs are
+     * deferred until no visible job can be started.
+     *
+     * Passing empty \p hints returns the queue to the plain FIFO order.
+     */
+    void setViewportHints(const KisUpdatesViewportHints &hints);
+
+    /**
+     * \return true if the viewport hints are set and \p rc, defined
+     * on \p levelOfDetail, intersects the visible area
+     */
+    bool intersectsVisibleArea(const QRect &rc, int levelOfDetail) const;
+
 protected:
     void addJob(KisNodeSP node, const QVector<QRect> &rects, const QRect& cropRect, int levelOfDetail, KisBaseRectsWalker::UpdateType type, bool dontInvalidateFrames);
 
     bool processOneJob(KisUpdaterContext &updaterContext);
 
+    QVector<QRect> coalesceRects(KisNodeSP node, const QVector<QRect> &rects) const;
+    bool tryCoalesceRects(QRect &baseRect, const QRect &newRect, int numNodes) const;
+    static int estimateWalkerNodes(KisNodeSP node);
+
     bool trySplitJob(KisNodeSP node, const QRect& rc, const QRect& cropRect, int levelOfDetail, KisBaseRectsWalker::UpdateType type, bool dontInvalidateFrames);
     bool tryMergeJob(KisNodeSP node, const QRect& rc, const QRect& cropRect, int levelOfDetail, KisBaseRectsWalker::UpdateType type, bool dontInvalidateFrames);
 
@@ -61,6 +83,9 @@ protected:
                      const qreal maxAlpha);
     bool joinRects(QRect& baseRect, const QRect& newRect, qreal maxAlpha);
 
+    void sortByViewportPriority();
+    bool intersectsVisibleAreaImpl(const QRect &rc, int levelOfDetail) const;
+
 protected:
 
     mutable QMutex m_lock;
@@ -96,7 +121,25 @@ protected:
      */
     qreal m_maxMergeCollectAlpha;
 
+    /**
+     * The cost model of a walker used for coalescing small rects
+     * in coalesceRects(), \see KisImageConfig::updateWalkerOverhead()
+     */
+    qint64 m_walkerOverhead;
+    qint64 m_nodeOverhead;
+
     int m_overrideLevelOfDetail;
+
+    /**
+     * Viewport hints, \see setViewportHints()
+     */
+    KisUpdatesViewportHints m_viewportHints;
+
+    /**
+     * Set when the updates list has been changed after the last
+     * sorting by the viewport priority
+     */
+    bool m_priorityOrderDirty = false;
 };
 
 class KRITAIMAGE_EXPORT KisTestableSimpleUpdateQueue : public KisSimpleUpdateQueue
@@ -6,11 +6,14 @@
 
 #include "kis_stroke.h"
 
+#include <QThread>
+
 #include "kis_stroke_strategy.h"
 
 
 KisStroke::KisStroke(KisStrokeStrategy *strokeStrategy, Type type, int levelOfDetail)
     : m_strokeStrategy(strokeStrategy),
+      m_numPushingThreads(0),
       m_strokeInitialized(false),
       m_strokeEnded(false),
       m_strokeSuspended(false),
@@ -39,6 +42,12 @@ KisStroke::~KisStroke()
 {
     Q_ASSERT(m_strokeEnded);
     Q_ASSERT(m_jobsQueue.isEmpty());
+    Q_ASSERT(m_incomingJobs.isEmpty());
+
+    KisStrokeJob *job = 0;
+    while (m_incomingJobs.pop(job)) {
+        delete job;
+    }
 }
 
 bool KisStroke::supportsSuspension()
@@ -70,7 +79,61 @@ void KisStroke::suspendStroke(KisStrokeSP recipient)
 void KisStroke::addJob(KisStrokeJobData *data)
 {
     KIS_SAFE_ASSERT_RECOVER_NOOP(!m_strokeEnded);
-    enqueue(m_dabStrategy.data(), data);
+
+    // factory methods can return null, if no action is needed
+    if(!m_dabStrategy) {
+        delete data;
+        return;
+    }
+
+    KisStrokeJob *job = new KisStrokeJob(m_dabStrategy.data(), data, worksOnLevelOfDetail(), true);
+
+    /**
+     * The stroke may be ended or cancelled by another thread right
+     * now. Register ourselves first and check the flag only then, so
+     * that either closeIncomingJobs() waits for our job and moves it
+     * into the queue before the finish/cancel job, or we see the flag
+     * and discard the job. Both operations are sequentially consistent.
+     */
+    m_numPushingThreads.fetch_add(1);
+
+    if (m_strokeEnded.load()) {
+        m_numPushingThreads.fetch_sub(1);
+        delete job;
+        return;
+    }
+
+    m_incomingJobs.push(job);
+    m_numPushingThreads.fetch_sub(1);
+}
+
+void KisStroke::fetchIncomingJobs() const
+{
+    KisStrokeJob *job = 0;
+    while (m_incomingJobs.pop(job)) {
+        m_jobsQueue.enqueue(job);
+    }
+}
+
+/**
+ * Marks the stroke as ended and moves all the jobs added by addJob()
+ * into the main queue. The jobs added after that are discarded, so
+ * nothing can get behind the finish/cancel job or be left in the
+ * incoming queue when the stroke is removed.
+ */
+void KisStroke::closeIncomingJobs()
+{
+    m_strokeEnded.store(true);
+
+    /**
+     * The push itself is just a few instructions, so there is no
+     * point in doing anything more clever than spinning here
+     */
+    while (m_numPushingThreads.load() > 0) {
+        QThread::yieldCurrentThread();
+    }
+
+    fetchIncomingJobs();
 }
 
 void KisStroke::addMutatedJobs(const QVector<KisStrokeJobData *> list)
@@ -81,6 +144,8 @@ void KisStroke::addMutatedJobs(const QVector<KisStrokeJobData *> list)
         return;
     }
 
+    fetchIncomingJobs();
+
     // Find first non-alien (non-suspend/non-resume) job
     //
     // Please note that this algorithm will stop working at the day we start
@@ -121,18 +186,20 @@ QString KisStroke::id() const
 
 bool KisStroke::hasJobs() const
 {
+    fetchIncomingJobs();
     return !m_jobsQueue.isEmpty();
 }
 
 qint32 KisStroke::numJobs() const
 {
+    fetchIncomingJobs();
     return m_jobsQueue.size();
 }
 
 void KisStroke::endStroke()
 {
     KIS_SAFE_ASSERT_RECOVER_RETURN(!m_strokeEnded);
-    m_strokeEnded = true;
+    closeIncomingJobs();
 
     enqueue(m_finishStrategy.data(), m_strokeStrategy->createFinishData());
     m_strokeStrategy->notifyUserEndedStroke();
@@ -159,6 +226,9 @@ void KisStroke::cancelStroke()
     // case 6
     if (m_isCancelled) return;
 
+    const bool wasEnded = m_strokeEnded;
+    closeIncomingJobs();
+
     const bool effectivelyInitialized =
         m_strokeInitialized || m_strokeStrategy->needsExplicitCancel();
 
@@ -178,7 +248,7 @@ void KisStroke::cancelStroke()
         clearQueueOnCancel();
     }
     else if(effectivelyInitialized &&
-            (!m_jobsQueue.isEmpty() || !m_strokeEnded)) {
+            (!m_jobsQueue.isEmpty() || !wasEnded)) {
 
         m_strokeStrategy->tryCancelCurrentStrokeJobAsync();
 
@@ -191,11 +261,12 @@ void KisStroke::cancelStroke()
     // }
 
     m_isCancelled = true;
-    m_strokeEnded = true;
 }
 
 bool KisStroke::canCancel() const
 {
+    fetchIncomingJobs();
+
     return m_isCancelled || !m_strokeInitialized ||
         !m_jobsQueue.isEmpty() || !m_strokeEnded;
 }
@@ -212,6 +283,8 @@ bool KisStroke::sanityCheckAllJobsAreCancellable() const
 
 void KisStroke::clearQueueOnCancel()
 {
+    fetchIncomingJobs();
+
     QQueue<KisStrokeJob*>::iterator it = m_jobsQueue.begin();
 
     while (it != m_jobsQueue.end()) {
@@ -276,12 +349,16 @@ qreal KisStroke::balancingRatioOverride() const
 
 KisStrokeJobData::Sequentiality KisStroke::nextJobSequentiality() const
 {
+    fetchIncomingJobs();
+
     return !m_jobsQueue.isEmpty() ?
         m_jobsQueue.head()->sequentiality() : KisStrokeJobData::SEQUENTIAL;
 }
 
 int KisStroke::nextJobLevelOfDetail() const
 {
+    fetchIncomingJobs();
+
     return !m_jobsQueue.isEmpty() ?
                 m_jobsQueue.head()->levelOfDetail() : worksOnLevelOfDetail();
 }
@@ -295,6 +372,7 @@ void KisStroke::enqueue(KisStrokeJobStrategy *strategy,
         return;
     }
 
+    fetchIncomingJobs();
     m_jobsQueue.enqueue(new KisStrokeJob(strategy, data, worksOnLevelOfDetail(), true));
 }
 
@@ -312,11 +390,13 @@ void KisStroke::prepend(KisStrokeJobStrategy *strategy,
     // LOG_MERGE_FIXME:
     Q_UNUSED(levelOfDetail);
 
+    fetchIncomingJobs();
     m_jobsQueue.prepend(new KisStrokeJob(strategy, data, worksOnLevelOfDetail(), isOwnJob));
 }
 
 KisStrokeJob* KisStroke::dequeue()
 {
+    fetchIncomingJobs();
     return !m_jobsQueue.isEmpty() ? m_jobsQueue.dequeue() : 0;
 }
 
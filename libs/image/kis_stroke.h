@@ -10,7 +10,10 @@
 #include <QQueue>
 #include <QScopedPointer>
 
+#include <atomic>
+
 #include <kis_types.h>
+#include <KisLocklessMpscQueue.h>
 #include "kritaimage_export.h"
 #include "kis_stroke_job.h"
 
@@ -18,6 +21,15 @@ class KisStrokeStrategy;
 class KUndo2MagicString;
 
 
+/**
+ * LOCKING: all the methods of the stroke are expected to be called
+ *          under the lock of KisStrokesQueue, except addJob(), which
+ *          is lock-free and can be called from any thread. The jobs
+ *          added by addJob() are moved into the main queue of the
+ *          stroke by any other method that looks into it. The jobs
+ *          added after the stroke has been ended or cancelled are
+ *          discarded.
+ */
 class KRITAIMAGE_EXPORT KisStroke
 {
 public:
@@ -84,6 +96,9 @@ private:
 
     KisStrokeJob* dequeue();
 
+    void fetchIncomingJobs() const;
+    void closeIncomingJobs();
+
     void clearQueueOnCancel();
     bool sanityCheckAllJobsAreCancellable() const;
 
@@ -92,6 +107,7 @@ private:
     friend class KisStrokeTest;
     friend class KisStrokeStrategyUndoCommandBasedTest;
     QQueue<KisStrokeJob*>& testingGetQueue() {
+        fetchIncomingJobs();
         return m_jobsQueue;
     }
 
@@ -105,9 +121,23 @@ private:
     QScopedPointer<KisStrokeJobStrategy> m_suspendStrategy;
     QScopedPointer<KisStrokeJobStrategy> m_resumeStrategy;
 
-    QQueue<KisStrokeJob*> m_jobsQueue;
+    /**
+     * The dab jobs are pushed into m_incomingJobs by addJob() without
+     * taking any locks, so that the input thread never waits for the
+     * workers. Both queues are mutable, since even const methods
+     * should see the freshly added jobs.
+     */
+    mutable QQueue<KisStrokeJob*> m_jobsQueue;
+    mutable KisLocklessMpscQueue<KisStrokeJob*> m_incomingJobs;
+
+    /**
+     * The number of addJob() calls that are pushing a job into
+     * m_incomingJobs right now, \see closeIncomingJobs()
+     */
+    std::atomic<int> m_numPushingThreads;
+
     bool m_strokeInitialized;
-    bool m_strokeEnded;
+    std::atomic<bool> m_strokeEnded;
     bool m_strokeSuspended;
     bool m_isCancelled; // cancelled strokes are always 'ended' as well
 
@@ -6,9 +6,11 @@
 
 #include "kis_strokes_queue.h"
 
+#include <algorithm>
 #include <QQueue>
 #include <QMutex>
 #include <QMutexLocker>
+#include <QAtomicInt>
 #include "kis_stroke.h"
 #include "kis_updater_context.h"
 #include "kis_stroke_job_strategy.h"
@@ -75,7 +77,7 @@ struct Q_DECL_HIDDEN KisStrokesQueue::Private {
 
     KisStrokesQueue *q;
     StrokesQueue strokesQueue;
-    int openedStrokesCounter;
+    QAtomicInt openedStrokesCounter;
     bool needsExclusiveAccess;
     bool wrapAroundModeSupported;
     qreal balancingRatioOverride;
@@ -94,8 +96,29 @@ struct Q_DECL_HIDDEN KisStrokesQueue::Private {
     KisPostExecutionUndoAdapter lodNPostExecutionUndoAdapter;
     KisLodPreferences lodPreferences;
 
+    /**
+     * The forgettable sync stroke started by warmUpLevelOfDetail().
+     * Since it can be cancelled at any moment, lodNNeedsSynchronization
+     * is reset only when it completes and nothing has invalidated LoDN
+     * planes while it was running.
+     */
+    KisStrokeWSP lodNWarmUpStroke;
+    KisStrokeStrategy *lodNWarmUpStrategy = nullptr;
+    int lodNWarmUpSeqNo = 0;
+    int lodNInvalidationSeqNo = 0;
+
+    /**
+     * True if LoDN planes have been fully regenerated and no LoDN
+     * stroke has painted on them since then
+     */
+    bool lodNPlanesAreFresh = false;
+
     void cancelForgettableStrokes();
     void startLod0ToNStroke(int levelOfDetail, bool forgettable);
+    void invalidateLodN();
+    bool startLodNWarmUpStroke();
+    bool tryAdoptLodNWarmUpStroke(bool adopt);
+    void completeLodNWarmUpStroke(KisStrokeSP stroke);
 
 
     std::pair<StrokesQueueIterator, StrokesQueueIterator> currentLodRange();
@@ -150,10 +173,11 @@ void KisStrokesQueue::Private::startLod0ToNStroke(int levelOfDetail, bool forget
 
     {
         // sanity check: there should be no open LoD range now!
+        // (a cancelled warm-up stroke might still be waiting for removal)
         StrokesQueueIterator it;
         StrokesQueueIterator end;
         std::tie(it, end) = currentLodRange();
-        KIS_SAFE_ASSERT_RECOVER_NOOP(it == end);
+        KIS_SAFE_ASSERT_RECOVER_NOOP(std::all_of(it, end, [] (KisStrokeSP stroke) { return stroke->isCancelled(); }));
     }
 
     if (!this->lod0ToNStrokeStrategyFactory) return;
@@ -164,6 +188,86 @@ void KisStrokesQueue::Private::startLod0ToNStroke(int levelOfDetail, bool forget
     this->lodNNeedsSynchronization = false;
 }
 
+void KisStrokesQueue::Private::invalidateLodN()
+{
+    lodNNeedsSynchronization = true;
+    lodNPlanesAreFresh = false;
+    lodNInvalidationSeqNo++;
+}
+
+bool KisStrokesQueue::Private::startLodNWarmUpStroke()
+{
+    if (!lod0ToNStrokeStrategyFactory || !lodPreferences.lodPreferred()) return false;
+
+    switchDesiredLevelOfDetail(false);
+
+    if (!desiredLevelOfDetail || !lodNNeedsSynchronization || !lodNWarmUpStroke.isNull()) return false;
+
+    /**
+     * Warm-up is started only when there are no LoD-capable strokes
+     * in the queue, so it never opens a LoD range in the middle of
+     * the user's actions
+     */
+    Q_FOREACH (KisStrokeSP stroke, strokesQueue) {
+        if (stroke->type() != KisStroke::LEGACY || !stroke->isEnded()) {
+            return false;
+        }
+    }
+
+    KisLodSyncPair syncPair = lod0ToNStrokeStrategyFactory(true);
+    KisStrokeStrategy *strategy = syncPair.first;
+
+    StrokesQueueIterator it =
+        executeStrokePair(syncPair, strokesQueue, strokesQueue.end(), KisStroke::LODN, desiredLevelOfDetail, q);
+
+    lodNWarmUpStroke = *it;
+    lodNWarmUpStrategy = strategy;
+    lodNWarmUpSeqNo = lodNInvalidationSeqNo;
+
+    return true;
+}
+
+bool KisStrokesQueue::Private::tryAdoptLodNWarmUpStroke(bool adopt)
+{
+    KisStrokeSP stroke = lodNWarmUpStroke.toStrongRef();
+    if (!stroke || stroke->isCancelled() || lodNWarmUpSeqNo != lodNInvalidationSeqNo) return false;
+
+    /**
+     * Forgettable strokes don't need to adopt the warm-up: if it is
+     * cancelled, they will be cancelled as well.
+     */
+    if (!adopt) return true;
+
+    /**
+     * A LoDN stroke is going to be painted on top of the planes
+     * generated by the warm-up, so the warm-up should not be
+     * cancelled anymore. It becomes a usual sync stroke.
+     */
+    lodNWarmUpStrategy->setCanForgetAboutMe(false);
+    lodNNeedsSynchronization = false;
+
+    lodNWarmUpStroke.clear();
+    lodNWarmUpStrategy = nullptr;
+
+    return true;
+}
+
+void KisStrokesQueue::Private::completeLodNWarmUpStroke(KisStrokeSP stroke)
+{
+    if (lodNWarmUpStroke.toStrongRef() != stroke) return;
+
+    if (!stroke->isCancelled() &&
+        lodNWarmUpSeqNo == lodNInvalidationSeqNo &&
+        stroke->worksOnLevelOfDetail() == desiredLevelOfDetail) {
+
+        lodNNeedsSynchronization = false;
+        lodNPlanesAreFresh = true;
+    }
+
+    lodNWarmUpStroke.clear();
+    lodNWarmUpStrategy = nullptr;
+}
+
 void KisStrokesQueue::Private::cancelForgettableStrokes()
 {
     if (!strokesQueue.isEmpty() && !hasUnfinishedStrokes()) {
@@ -273,7 +377,7 @@ KisStrokeId KisStrokesQueue::startLodNUndoStroke(KisStrokeStrategy *strokeStrate
     m_d->strokesQueue.insert(m_d->findNewLodNPos(buddy), buddy);
 
     KisStrokeId id(buddy);
-    m_d->openedStrokesCounter++;
+    m_d->openedStrokesCounter.ref();
 
     return id;
 }
@@ -285,22 +389,39 @@ KisStrokeId KisStrokesQueue::startStroke(KisStrokeStrategy *strokeStrategy)
     KisStrokeSP stroke;
     KisStrokeStrategy* lodBuddyStrategy;
 
+    const bool lodNStrokeRequested =
+        m_d->desiredLevelOfDetail &&
+        (m_d->lodPreferences.lodPreferred() || strokeStrategy->forceLodModeIfPossible());
+
+    /**
+     * If LoDN planes are being warmed up right now, the new stroke
+     * should wait for the warm-up instead of cancelling it and
+     * starting the sync from scratch
+     */
+    const bool lodNWarmUpPending =
+        lodNStrokeRequested && m_d->lodNNeedsSynchronization &&
+        m_d->tryAdoptLodNWarmUpStroke(!strokeStrategy->canForgetAboutMe());
+
     // we should let forgettable strokes to queue up
     if (!strokeStrategy->canForgetAboutMe()) {
         m_d->cancelForgettableStrokes();
     }
 
-    if (m_d->desiredLevelOfDetail &&
-        (m_d->lodPreferences.lodPreferred() || strokeStrategy->forceLodModeIfPossible()) &&
+    if (lodNStrokeRequested &&
         (lodBuddyStrategy =
          strokeStrategy->createLodClone(m_d->desiredLevelOfDetail))) {
 
-        if (m_d->lodNNeedsSynchronization) {
+        if (m_d->lodNNeedsSynchronization && !lodNWarmUpPending) {
             m_d->startLod0ToNStroke(m_d->desiredLevelOfDetail, false);
         }
 
         stroke = KisStrokeSP(new KisStroke(strokeStrategy, KisStroke::LOD0, 0));
 
+        // forgettable strokes never modify the image
+        if (!strokeStrategy->canForgetAboutMe()) {
+            m_d->lodNPlanesAreFresh = false;
+        }
+
         KisStrokeSP buddy(new KisStroke(lodBuddyStrategy, KisStroke::LODN, m_d->desiredLevelOfDetail));
         lodBuddyStrategy->setMutatedJobsInterface(this, buddy);
         stroke->setLodBuddy(buddy);
@@ -330,10 +451,10 @@ KisStrokeId KisStrokesQueue::startStroke(KisStrokeStrategy *strokeStrategy)
     KisStrokeId id(stroke);
     strokeStrategy->setMutatedJobsInterface(this, id);
 
-    m_d->openedStrokesCounter++;
+    m_d->openedStrokesCounter.ref();
 
     if (stroke->type() == KisStroke::LEGACY) {
-        m_d->lodNNeedsSynchronization = true;
+        m_d->invalidateLodN();
     }
 
     return id;
@@ -341,7 +462,18 @@ KisStrokeId KisStrokesQueue::startStroke(KisStrokeStrategy *strokeStrategy)
 
 void KisStrokesQueue::addJob(KisStrokeId id, KisStrokeJobData *data)
 {
-    QMutexLocker locker(&m_d->mutex);
+    /**
+     * Adding jobs is the hottest path of the queue: the dabs of a
+     * freehand stroke come here with the rate of the tablet events,
+     * while the workers are processing the queue. The jobs are pushed
+     * into the lock-free incoming queue of the stroke, so we don't take
+     * the queue's lock here. The buddy of the stroke is assigned before
+     * the stroke id is published, so it is safe to read it as well.
+     *
+     * If the stroke is being ended or cancelled concurrently, the job
+     * either gets into the queue before the finish/cancel job or is
+     * discarded, \see KisStroke::closeIncomingJobs()
+     */
 
     KisStrokeSP stroke = id.toStrongRef();
     KIS_SAFE_ASSERT_RECOVER_RETURN(stroke);
@@ -375,7 +507,7 @@ void KisStrokesQueue::endStroke(KisStrokeId id)
     KisStrokeSP stroke = id.toStrongRef();
     KIS_SAFE_ASSERT_RECOVER_RETURN(stroke);
     stroke->endStroke();
-    m_d->openedStrokesCounter--;
+    m_d->openedStrokesCounter.deref();
 
     KisStrokeSP buddy = stroke->lodBuddy();
     if (buddy) {
@@ -390,7 +522,7 @@ bool KisStrokesQueue::cancelStroke(KisStrokeId id)
     KisStrokeSP stroke = id.toStrongRef();
     if(stroke) {
         stroke->cancelStroke();
-        m_d->openedStrokesCounter--;
+        m_d->openedStrokesCounter.deref();
 
         KisStrokeSP buddy = stroke->lodBuddy();
         if (buddy) {
@@ -575,7 +707,7 @@ void KisStrokesQueue::Private::tryClearUndoOnStrokeCompletion(KisStrokeSP finish
 
 void KisStrokesQueue::Private::forceResetLodAndCloseCurrentLodRange()
 {
-    lodNNeedsSynchronization = true;
+    invalidateLodN();
 
     if (!strokesQueue.isEmpty() && strokesQueue.last()->type() != KisStroke::LEGACY) {
 
@@ -668,7 +800,10 @@ void KisStrokesQueue::Private::switchDesiredLevelOfDetail(bool forced)
             desiredLevelOfDetail == nextDesiredLevelOfDetail;
 
         desiredLevelOfDetail = nextDesiredLevelOfDetail;
-        lodNNeedsSynchronization |= !forgettable;
+
+        if (!forgettable) {
+            invalidateLodN();
+        }
 
         if (desiredLevelOfDetail && lodPreferences.lodPreferred()) {
             startLod0ToNStroke(desiredLevelOfDetail, forgettable);
@@ -679,9 +814,26 @@ void KisStrokesQueue::Private::switchDesiredLevelOfDetail(bool forced)
 void KisStrokesQueue::explicitRegenerateLevelOfDetail()
 {
     QMutexLocker locker(&m_d->mutex);
+
+    /**
+     * The planes have just been regenerated by the warm-up, there
+     * is no need to do that once again
+     */
+    if (m_d->lodNPlanesAreFresh &&
+        m_d->nextDesiredLevelOfDetail == m_d->desiredLevelOfDetail) {
+
+        return;
+    }
+
     m_d->switchDesiredLevelOfDetail(true);
 }
 
+bool KisStrokesQueue::warmUpLevelOfDetail()
+{
+    QMutexLocker locker(&m_d->mutex);
+    return m_d->startLodNWarmUpStroke();
+}
+
 void KisStrokesQueue::notifyUFOChangedImage()
 {
     QMutexLocker locker(&m_d->mutex);
@@ -735,8 +887,7 @@ KUndo2MagicString KisStrokesQueue::currentStrokeName() const
 
 bool KisStrokesQueue::hasOpenedStrokes() const
 {
-    QMutexLocker locker(&m_d->mutex);
-    return m_d->openedStrokesCounter;
+    return m_d->openedStrokesCounter.loadAcquire();
 }
 
 bool KisStrokesQueue::processOneJob(KisUpdaterContext &updaterContext,
@@ -832,6 +983,7 @@ bool KisStrokesQueue::checkStrokeState(bool hasStrokeJobsRunning,
     }
     else if(stroke->isEnded() && !hasJobs && !hasStrokeJobsRunning) {
         m_d->tryClearUndoOnStrokeCompletion(stroke);
+        m_d->completeLodNWarmUpStroke(stroke);
 
         const bool needsSyncLod0PlaneToGUI =
                 stroke->type() == KisStroke::LOD0 &&
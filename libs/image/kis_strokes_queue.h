@@ -56,6 +56,7 @@ public:
     KisLodPreferences lodPreferences() const override;
     void setLodPreferences(const KisLodPreferences &value);
     void explicitRegenerateLevelOfDetail();
+    bool warmUpLevelOfDetail();
     void setLod0ToNStrokeStrategyFactory(const KisLodSyncStrokeStrategyFactory &factory);
     void setSuspendResumeUpdatesStrokeStrategyFactory(const KisSuspendResumeStrategyPairFactory &factory);
     void setPurgeRedoStateCallback(const std::function<void()> &callback);
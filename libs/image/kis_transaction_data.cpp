@@ -152,6 +152,27 @@ void KisTransactionData::endTransaction()
     }
 }
 
+qint64 KisTransactionData::memoryUsage() const
+{
+    qint64 result = KUndo2Command::memoryUsage() + m_d->memento->memorySize();
+
+    if (m_d->flattenUndoCommand) {
+        result += m_d->flattenUndoCommand->memoryUsage();
+    }
+
+    if (m_d->interstrokeInfo) {
+        if (m_d->interstrokeInfo->beginTransactionCommand) {
+            result += m_d->interstrokeInfo->beginTransactionCommand->memoryUsage();
+        }
+
+        if (m_d->interstrokeInfo->endTransactionCommand) {
+            result += m_d->interstrokeInfo->endTransactionCommand->memoryUsage();
+        }
+    }
+
+    return result;
+}
+
 void KisTransactionData::startUpdates()
 {
     if (m_d->suppressUpdates) return;
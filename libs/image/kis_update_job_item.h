@@ -11,6 +11,7 @@
 
 #include <QRunnable>
 #include <QReadWriteLock>
+#include <QThread>
 
 #include "kis_stroke_job.h"
 #include "kis_spontaneous_job.h"
@@ -18,6 +19,7 @@
 #include "kis_async_merger.h"
 #include "kis_updater_context.h"
 #include <KoAlwaysInline.h>
+#include <KisTracer.h>
 
 //#define DEBUG_JOBS_SEQUENCE
 
@@ -46,8 +48,12 @@ public:
     }
 
     void run() override {
+        m_workerThread = QThread::currentThreadId();
+
         runImpl();
 
+        m_workerThread = nullptr;
+
         // notify that the job is exiting and wake everybody
         // waiting on wakeForDone()
         m_updaterContext->jobThreadExited();
@@ -97,6 +103,8 @@ private:
                     }
 #endif
 
+                    KisTraceScope traceScope(KisTracer::StrokeJob,
+                                             m_atomicType == Type::STROKE ? "stroke job" : "spontaneous job");
                     m_runnableJob->run();
                 }
             }
@@ -132,7 +140,10 @@ public:
 
 #endif
 
-        m_merger.startMerge(*m_walker);
+        {
+            KIS_TRACE_SCOPE(MergeWalker, "merge job");
+            m_merger.startMerge(*m_walker);
+        }
 
         QRect changeRect = m_walker->changeRect();
         m_updaterContext->continueUpdate(changeRect);
@@ -193,6 +204,14 @@ public:
         return m_atomicType >= Type::MERGE;
     }
 
+    /**
+     * \return true if the item is being executed by the calling
+     * thread, i.e. the job is added from inside jobFinished()
+     */
+    inline bool isOwnedByCurrentThread() const {
+        return m_workerThread == QThread::currentThreadId();
+    }
+
     inline Type type() const {
         return m_atomicType;
     }
@@ -239,6 +258,7 @@ private:
     KisUpdaterContext *m_updaterContext {0};
     bool m_exclusive {false};
     std::atomic<Type> m_atomicType {Type::EMPTY};
+    std::atomic<Qt::HANDLE> m_workerThread {nullptr};
     volatile KisStrokeJobData::Sequentiality m_strokeJobSequentiality {KisStrokeJobData::SEQUENTIAL};
 
     /**
@@ -19,6 +19,7 @@
 #include "KisImageConfigNotifier.h"
 
 #include <QReadWriteLock>
+#include <QElapsedTimer>
 #include "kis_lazy_wait_condition.h"
 #include <mutex>
 
@@ -34,6 +35,15 @@
 #define DEBUG_BALANCING_METRICS(decidedFirst, excl)
 #endif
 
+//#define DEBUG_VISIBLE_UPDATES
+
+#ifdef DEBUG_VISIBLE_UPDATES
+#define DEBUG_TIME_TO_FIRST_VISIBLE_PIXEL(time)                         \
+    dbgKrita << "Time to first visible pixel:" << time << "ms"
+#else
+#define DEBUG_TIME_TO_FIRST_VISIBLE_PIXEL(time)
+#endif
+
 
 struct Q_DECL_HIDDEN KisUpdateScheduler::Private {
     Private(KisUpdateScheduler *_q, KisProjectionUpdateListener *p)
@@ -56,10 +66,39 @@ struct Q_DECL_HIDDEN KisUpdateScheduler::Private {
     QReadWriteLock updatesStartLock;
     KisLazyWaitCondition updatesFinishedCondition;
 
+    QMutex visiblePixelLock;
+    QElapsedTimer visiblePixelTimer;
+    bool waitingForVisiblePixel = false;
+    qint64 lastTimeToFirstVisiblePixel = -1;
+
     qreal balancingRatio() const {
         const qreal strokeRatioOverride = strokesQueue.balancingRatioOverride();
         return strokeRatioOverride > 0 ? strokeRatioOverride : defaultBalancingRatio;
     }
+
+    void startVisiblePixelTimer(const QVector<QRect> &rects, int levelOfDetail) {
+        QMutexLocker l(&visiblePixelLock);
+        if (waitingForVisiblePixel) return;
+
+        Q_FOREACH (const QRect &rc, rects) {
+            if (updatesQueue.intersectsVisibleArea(rc, levelOfDetail)) {
+                visiblePixelTimer.start();
+                waitingForVisiblePixel = true;
+                break;
+            }
+        }
+    }
+
+    void tryStopVisiblePixelTimer(const QRect &rc, int levelOfDetail) {
+        QMutexLocker l(&visiblePixelLock);
+        if (!waitingForVisiblePixel) return;
+
+        if (updatesQueue.intersectsVisibleArea(rc, levelOfDetail)) {
+            lastTimeToFirstVisiblePixel = visiblePixelTimer.elapsed();
+            waitingForVisiblePixel = false;
+            DEBUG_TIME_TO_FIRST_VISIBLE_PIXEL(lastTimeToFirstVisiblePixel);
+        }
+    }
 };
 
 KisUpdateScheduler::KisUpdateScheduler(KisProjectionUpdateListener *projectionUpdateListener, QObject *parent)
@@ -140,16 +179,36 @@ void KisUpdateScheduler::progressUpdate()
 
 void KisUpdateScheduler::updateProjection(KisNodeSP node, const QVector<QRect> &rects, const QRect &cropRect, KisProjectionUpdateFlags flags)
 {
-    m_d->updatesQueue.addUpdateJob(node, rects, cropRect, currentLevelOfDetail(), flags);
+    const int levelOfDetail = currentLevelOfDetail();
+    m_d->startVisiblePixelTimer(rects, levelOfDetail);
+    m_d->updatesQueue.addUpdateJob(node, rects, cropRect, levelOfDetail, flags);
     processQueues();
 }
 
 void KisUpdateScheduler::fullRefreshAsync(KisNodeSP root, const QVector<QRect>& rects, const QRect &cropRect, KisProjectionUpdateFlags flags)
 {
-    m_d->updatesQueue.addFullRefreshJob(root, rects, cropRect, currentLevelOfDetail(), flags);
+    const int levelOfDetail = currentLevelOfDetail();
+    m_d->startVisiblePixelTimer(rects, levelOfDetail);
+    m_d->updatesQueue.addFullRefreshJob(root, rects, cropRect, levelOfDetail, flags);
     processQueues();
 }
 
+void KisUpdateScheduler::setViewportHints(const KisUpdatesViewportHints &hints)
+{
+    m_d->updatesQueue.setViewportHints(hints);
+
+    if (hints.isEmpty()) {
+        QMutexLocker l(&m_d->visiblePixelLock);
+        m_d->waitingForVisiblePixel = false;
+    }
+}
+
+qint64 KisUpdateScheduler::lastTimeToFirstVisiblePixel() const
+{
+    QMutexLocker l(&m_d->visiblePixelLock);
+    return m_d->lastTimeToFirstVisiblePixel;
+}
+
 void KisUpdateScheduler::updateProjection(KisNodeSP node, const QRect &rc, const QRect &cropRect)
 {
     updateProjection(node, {rc}, cropRect, KisProjectionUpdateFlag::None);
@@ -237,6 +296,18 @@ void KisUpdateScheduler::explicitRegenerateLevelOfDetail()
     processQueues();
 }
 
+bool KisUpdateScheduler::warmUpLevelOfDetail()
+{
+    const bool result = m_d->strokesQueue.warmUpLevelOfDetail();
+
+    if (result) {
+        // \see a comment in setDesiredLevelOfDetail()
+        processQueues();
+    }
+
+    return result;
+}
+
 int KisUpdateScheduler::currentLevelOfDetail() const
 {
     int levelOfDetail = m_d->updaterContext.currentLevelOfDetail();
@@ -430,6 +501,8 @@ bool KisUpdateScheduler::haveUpdatesRunning()
 
 void KisUpdateScheduler::continueUpdate(const QRect &rect)
 {
+    m_d->tryStopVisiblePixelTimer(rect, currentLevelOfDetail());
+
     Q_ASSERT(m_d->projectionUpdateListener);
     m_d->projectionUpdateListener->notifyProjectionUpdated(rect);
 }
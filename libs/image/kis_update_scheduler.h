@@ -16,8 +16,10 @@
 #include "kis_strokes_queue_undo_result.h"
 #include "KisLodPreferences.h"
 #include "KisProjectionUpdateFlags.h"
+#include "KisUpdatesViewportHint.h"
 
 class QRect;
+class QPointF;
 class KoProgressProxy;
 class KisProjectionUpdateListener;
 class KisSpontaneousJob;
@@ -136,6 +138,23 @@ public:
 
     void addSpontaneousJob(KisSpontaneousJob *spontaneousJob);
 
+    /**
+     * Tells the scheduler which areas of the image are visible in the
+     * views and where the user's cursor is, so that the visible areas
+     * could be updated first.
+     *
+     * \see KisSimpleUpdateQueue::setViewportHints()
+     */
+    void setViewportHints(const KisUpdatesViewportHints &hints);
+
+    /**
+     * \return the time (in milliseconds) passed between the request
+     * of the last update touching the visible area and the moment the
+     * first visible pixels of it have been written into the
+     * projection. Returns -1 if there have been no such updates yet.
+     */
+    qint64 lastTimeToFirstVisiblePixel() const;
+
     bool hasUpdatesRunning() const;
 
     KisStrokeId startStroke(KisStrokeStrategy *strokeStrategy) override;
@@ -163,6 +182,16 @@ public:
      */
     void explicitRegenerateLevelOfDetail();
 
+    /**
+     * Start regeneration of LoD planes in the background if some legacy
+     * stroke has made them outdated. Unlike explicitRegenerateLevelOfDetail(),
+     * the regeneration is cancelled by any new user's action, so it can be
+     * started as soon as the image becomes idle.
+     *
+     * \return true if the regeneration has been started
+     */
+    bool warmUpLevelOfDetail();
+
     /**
      * Install a factory of a stroke strategy, that will be started
      * every time when the scheduler needs to synchronize LOD caches
@@ -229,11 +229,30 @@ bool KisUpdaterContext::walkerIntersectsJob(KisBaseRectsWalkerSP walker,
 
 qint32 KisUpdaterContext::findSpareThread()
 {
-    for(qint32 i=0; i < m_jobs.size(); i++)
-        if(!m_jobs[i]->isRunning())
-            return i;
+    /**
+     * Prefer the items whose threads are still alive. When the job
+     * is added from inside jobFinished(), the calling thread takes
+     * it itself and continues its loop in KisUpdateJobItem::runImpl().
+     * Otherwise, the items that are just finishing their jobs go
+     * next, since they can pick up a new job without waking up a
+     * thread from the pool. The parked items are used last.
+     */
+    qint32 waitingIndex = -1;
+    qint32 emptyIndex = -1;
+
+    for(qint32 i=0; i < m_jobs.size(); i++) {
+        const KisUpdateJobItem *item = m_jobs[i];
+        const KisUpdateJobItem::Type type = item->type();
+
+        if (type == KisUpdateJobItem::Type::WAITING) {
+            if (item->isOwnedByCurrentThread()) return i;
+            if (waitingIndex < 0) waitingIndex = i;
+        } else if (type == KisUpdateJobItem::Type::EMPTY) {
+            if (emptyIndex < 0) emptyIndex = i;
+        }
+    }
 
-    return -1;
+    return waitingIndex >= 0 ? waitingIndex : emptyIndex;
 }
 
 void KisUpdaterContext::lock()
@@ -21,6 +21,7 @@
 #include "kis_filter_mask.h"
 #include "kis_selection.h"
 #include "kis_paint_device_debug_utils.h"
+#include "kis_flattened_below_cache.h"
 #include <KisGlobalResourcesInterface.h>
 
 #include "filter/kis_filter.h"
@@ -497,5 +498,96 @@ void KisAsyncMergerTest::testFilterMaskOnFilterLayer()
 }
 
 
-SIMPLE_TEST_MAIN(KisAsyncMergerTest)
 
+    /*
+      +-----------+
+      |root       |
+      | paint 4   |
+      | paint 3   |
+      | paint 2   |
+      | paint 1   |
+      +-----------+
+     */
+
+void KisAsyncMergerTest::testFlattenedBelowCache()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, 64, 64, cs, "flattened below cache test");
+
+    const QRect fillRect(0, 0, 64, 64);
+    const QRect strokeRect(0, 0, 16, 16);
+    const QPoint samplePoint(32, 32);
+
+    KisPaintLayerSP paintLayer1 = new KisPaintLayer(image, "paint1", OPACITY_OPAQUE_U8);
+    KisPaintLayerSP paintLayer2 = new KisPaintLayer(image, "paint2", 128);
+    KisPaintLayerSP paintLayer3 = new KisPaintLayer(image, "paint3", 128);
+    KisPaintLayerSP paintLayer4 = new KisPaintLayer(image, "paint4", OPACITY_OPAQUE_U8);
+
+    paintLayer1->paintDevice()->fill(fillRect, KoColor(Qt::red, cs));
+    paintLayer2->paintDevice()->fill(fillRect, KoColor(Qt::green, cs));
+    paintLayer3->paintDevice()->fill(fillRect, KoColor(Qt::yellow, cs));
+    paintLayer4->paintDevice()->fill(strokeRect, KoColor(Qt::white, cs));
+
+    image->addNode(paintLayer1, image->rootLayer());
+    image->addNode(paintLayer2, image->rootLayer());
+    image->addNode(paintLayer3, image->rootLayer());
+    image->addNode(paintLayer4, image->rootLayer());
+
+    KisFlattenedBelowCache *cache = paintLayer4->projectionLeaf()->flattenedBelowCache();
+    KisPaintDeviceSP projection = image->rootLayer()->projection();
+
+    KisMergeWalker walker(image->bounds());
+    KisAsyncMerger merger;
+
+    // the first merge of the top layer fills the cache
+    walker.collectRects(paintLayer4, image->bounds());
+    merger.startMerge(walker);
+
+    QVERIFY(cache->memoryMetric() > 0);
+    QVERIFY(KisFlattenedBelowCache::totalMemoryMetric() >= cache->memoryMetric());
+
+    QColor originalColor;
+    projection->pixel(samplePoint.x(), samplePoint.y(), &originalColor);
+
+    /**
+     * Change the bottom layer without merging it. The cache doesn't
+     * know about the change, so the next merge of the top layer should
+     * still take the lower layers from the cache.
+     */
+    paintLayer1->paintDevice()->fill(fillRect, KoColor(Qt::blue, cs));
+
+    walker.collectRects(paintLayer4, image->bounds());
+    merger.startMerge(walker);
+
+    QColor color;
+    projection->pixel(samplePoint.x(), samplePoint.y(), &color);
+    QCOMPARE(color, originalColor);
+
+    // the merge of the bottom layer changes its revision
+    walker.collectRects(paintLayer1, image->bounds());
+    merger.startMerge(walker);
+
+    QColor changedColor;
+    projection->pixel(samplePoint.x(), samplePoint.y(), &changedColor);
+    QVERIFY(changedColor != originalColor);
+
+    // ...so the cached data is not used anymore
+    walker.collectRects(paintLayer4, image->bounds());
+    merger.startMerge(walker);
+
+    projection->pixel(samplePoint.x(), samplePoint.y(), &color);
+    QCOMPARE(color, changedColor);
+
+    // the stroke area is still composed correctly
+    projection->pixel(strokeRect.x(), strokeRect.y(), &color);
+    QCOMPARE(color, QColor(Qt::white));
+
+    QVERIFY(cache->memoryMetric() > 0);
+
+    KisFlattenedBelowCache::testingEvictAll();
+
+    QCOMPARE(cache->memoryMetric(), qint64(0));
+    QCOMPARE(KisFlattenedBelowCache::totalMemoryMetric(), qint64(0));
+}
+
+SIMPLE_TEST_MAIN(KisAsyncMergerTest)
@@ -29,6 +29,8 @@ private Q_SLOTS:
 
     void testFilterMaskOnFilterLayer();
 
+    void testFlattenedBelowCache();
+
 };
 
 #endif /* KIS_ASYNC_MERGER_TEST_H */
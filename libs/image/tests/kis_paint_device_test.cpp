@@ -285,6 +285,38 @@ void KisPaintDeviceTest::testColorSpaceConversion()
     delete cmd;
 }
 
+void KisPaintDeviceTest::testColorSpaceConversionTiles()
+{
+    QImage image(QString(FILES_DATA_DIR) + '/' + "hakonepa.png");
+    const KoColorSpace* srcCs = KoColorSpaceRegistry::instance()->rgb8();
+    const KoColorSpace* dstCs = KoColorSpaceRegistry::instance()->lab16();
+    KisPaintDeviceSP dev = new KisPaintDevice(srcCs);
+    dev->convertFromQImage(image, 0, -70, -30); // cover tiles with negative indexes
+
+    const QRect rc = dev->exactBounds();
+    QCOMPARE(rc, QRect(-70, -30, image.width(), image.height()));
+
+    QVector<quint8> srcPixels(rc.width() * rc.height() * srcCs->pixelSize());
+    dev->readBytes(srcPixels.data(), rc);
+
+    QVector<quint8> expectedPixels(rc.width() * rc.height() * dstCs->pixelSize());
+    srcCs->convertPixelsTo(srcPixels.data(), expectedPixels.data(), dstCs,
+                           rc.width() * rc.height(),
+                           KoColorConversionTransformation::internalRenderingIntent(),
+                           KoColorConversionTransformation::internalConversionFlags());
+
+    dev->convertTo(dstCs,
+                   KoColorConversionTransformation::internalRenderingIntent(),
+                   KoColorConversionTransformation::internalConversionFlags());
+
+    QVERIFY(*dev->colorSpace() == *dstCs);
+    QCOMPARE(dev->exactBounds(), rc);
+
+    QVector<quint8> dstPixels(rc.width() * rc.height() * dstCs->pixelSize());
+    dev->readBytes(dstPixels.data(), rc);
+
+    QVERIFY(dstPixels == expectedPixels);
+}
 
 void KisPaintDeviceTest::testRoundtripConversion()
 {
@@ -278,5 +278,182 @@ void KisSimpleUpdateQueueTest::testSpontaneousJobsCompression()
     QCOMPARE(jobsList[0], job3);
 }
 
+void KisSimpleUpdateQueueTest::testViewportPriority()
+{
+    KisTestableUpdaterContext context(2);
+
+    QRect imageRect(0,0,1000,1000);
+
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, imageRect.width(), imageRect.height(), cs, "merge test");
+
+    KisPaintLayerSP paintLayer = new KisPaintLayer(image, "test", OPACITY_OPAQUE_U8);
+
+    image->barrierLock();
+    image->addNode(paintLayer);
+    image->unlock();
+
+    QRect offscreenRect(600,600,50,50);
+    QRect farVisibleRect(0,0,50,50);
+    QRect nearVisibleRect(380,380,50,50);
+
+    KisTestableSimpleUpdateQueue queue;
+    queue.setViewportHints({{QRect(0,0,500,500), QPointF(400,400)}});
+
+    QVERIFY(queue.intersectsVisibleArea(farVisibleRect, 0));
+    QVERIFY(!queue.intersectsVisibleArea(offscreenRect, 0));
+
+    // the visible area is scaled down together with the image
+    QVERIFY(queue.intersectsVisibleArea(QRect(200,200,10,10), 1));
+    QVERIFY(!queue.intersectsVisibleArea(QRect(300,300,10,10), 1));
+
+    queue.addUpdateJob(paintLayer, offscreenRect, imageRect, 0);
+    queue.addUpdateJob(paintLayer, farVisibleRect, imageRect, 0);
+    queue.addUpdateJob(paintLayer, nearVisibleRect, imageRect, 0);
+
+    queue.processQueue(context);
+
+    QVector<KisUpdateJobItem*> jobs = context.getJobs();
+
+    QCOMPARE(jobs.size(), 2);
+    QVERIFY(checkWalker(jobs[0]->walker(), nearVisibleRect));
+    QVERIFY(checkWalker(jobs[1]->walker(), farVisibleRect));
+
+    KisWalkersList &walkersList = queue.getWalkersList();
+    QCOMPARE(walkersList.size(), 1);
+    QVERIFY(checkWalker(walkersList[0], offscreenRect));
+
+    // without the hints the queue returns to FIFO order
+    context.clear();
+    queue.setViewportHints({});
+
+    queue.addUpdateJob(paintLayer, nearVisibleRect, imageRect, 0);
+    queue.processQueue(context);
+
+    jobs = context.getJobs();
+    QCOMPARE(jobs.size(), 2);
+    QVERIFY(checkWalker(jobs[0]->walker(), offscreenRect));
+    QVERIFY(checkWalker(jobs[1]->walker(), nearVisibleRect));
+}
+
+void KisSimpleUpdateQueueTest::testViewportPriorityMultipleViews()
+{
+    KisTestableUpdaterContext context(2);
+
+    QRect imageRect(0,0,1000,1000);
+
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, imageRect.width(), imageRect.height(), cs, "merge test");
+
+    KisPaintLayerSP paintLayer = new KisPaintLayer(image, "test", OPACITY_OPAQUE_U8);
+
+    image->barrierLock();
+    image->addNode(paintLayer);
+    image->unlock();
+
+    QRect offscreenRect(900,100,50,50);
+    QRect cornerRect(0,0,50,50);
+    QRect middleRect(380,380,50,50);
+
+    /**
+     * The first view is focused on the origin, which must not be
+     * mistaken for an unset focus point, the second one has no focus
+     * point, so the center of its visible area is used.
+     */
+    KisTestableSimpleUpdateQueue queue;
+    queue.setViewportHints({{QRect(0,0,500,500), QPointF(0,0)},
+                            {QRect(500,500,500,500), std::nullopt}});
+
+    QVERIFY(queue.intersectsVisibleArea(cornerRect, 0));
+    QVERIFY(queue.intersectsVisibleArea(QRect(800,800,10,10), 0));
+    QVERIFY(!queue.intersectsVisibleArea(offscreenRect, 0));
+
+    queue.addUpdateJob(paintLayer, offscreenRect, imageRect, 0);
+    queue.addUpdateJob(paintLayer, middleRect, imageRect, 0);
+    queue.addUpdateJob(paintLayer, cornerRect, imageRect, 0);
+
+    queue.processQueue(context);
+
+    QVector<KisUpdateJobItem*> jobs = context.getJobs();
+
+    QCOMPARE(jobs.size(), 2);
+    QVERIFY(checkWalker(jobs[0]->walker(), cornerRect));
+    QVERIFY(checkWalker(jobs[1]->walker(), middleRect));
+
+    KisWalkersList &walkersList = queue.getWalkersList();
+    QCOMPARE(walkersList.size(), 1);
+    QVERIFY(checkWalker(walkersList[0], offscreenRect));
+}
+
+void KisSimpleUpdateQueueTest::testCoalesceSmallRects()
+{
+    QRect imageRect(0,0,1024,1024);
+
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, imageRect.width(), imageRect.height(), cs, "merge test");
+
+    KisPaintLayerSP paintLayer = new KisPaintLayer(image, "test", OPACITY_OPAQUE_U8);
+
+    image->barrierLock();
+    image->addNode(paintLayer);
+    image->unlock();
+
+    {
+        KisTestableSimpleUpdateQueue queue;
+        KisWalkersList& walkersList = queue.getWalkersList();
+
+        // the dabs near each other are coalesced, the distant one is not
+        queue.addUpdateJob(paintLayer,
+                           {QRect(10,10,4,4), QRect(20,12,4,4),
+                            QRect(300,300,4,4), QRect(14,24,4,4)},
+                           imageRect, 0, KisProjectionUpdateFlag::None);
+
+        QCOMPARE(walkersList.size(), 2);
+        QVERIFY(checkWalker(walkersList[0], QRect(10,10,14,18)));
+        QVERIFY(checkWalker(walkersList[1], QRect(300,300,4,4)));
+    }
+
+    {
+        KisTestableSimpleUpdateQueue queue;
+        KisWalkersList& walkersList = queue.getWalkersList();
+
+        // the dabs are in the same tile, but merging them costs too much
+        queue.addUpdateJob(paintLayer,
+                           {QRect(0,0,4,4), QRect(60,60,4,4)},
+                           imageRect, 0, KisProjectionUpdateFlag::None);
+
+        QCOMPARE(walkersList.size(), 2);
+        QVERIFY(checkWalker(walkersList[0], QRect(0,0,4,4)));
+        QVERIFY(checkWalker(walkersList[1], QRect(60,60,4,4)));
+    }
+
+    {
+        KisTestableSimpleUpdateQueue queue;
+        KisWalkersList& walkersList = queue.getWalkersList();
+
+        // the dabs crossing the tile border are coalesced as well
+        queue.addUpdateJob(paintLayer,
+                           {QRect(60,10,8,8), QRect(66,12,8,8)},
+                           imageRect, 0, KisProjectionUpdateFlag::None);
+
+        QCOMPARE(walkersList.size(), 1);
+        QVERIFY(checkWalker(walkersList[0], QRect(60,10,14,10)));
+    }
+
+    {
+        KisTestableSimpleUpdateQueue queue;
+        KisWalkersList& walkersList = queue.getWalkersList();
+
+        // the first two dabs grow into the tile (1,1), which neither
+        // of them touches, the third dab should still find them
+        queue.addUpdateJob(paintLayer,
+                           {QRect(56,60,4,8), QRect(58,56,8,4), QRect(64,64,4,4)},
+                           imageRect, 0, KisProjectionUpdateFlag::None);
+
+        QCOMPARE(walkersList.size(), 1);
+        QVERIFY(checkWalker(walkersList[0], QRect(56,56,12,12)));
+    }
+}
+
 KISTEST_MAIN(KisSimpleUpdateQueueTest)
 
@@ -24,6 +24,9 @@ private Q_SLOTS:
     void testChecksum();
     void testMixingTypes();
     void testSpontaneousJobsCompression();
+    void testViewportPriority();
+    void testViewportPriorityMultipleViews();
+    void testCoalesceSmallRects();
 };
 
 #endif /* KIS_SIMPLE_UPDATE_QUEUE_TEST_H */
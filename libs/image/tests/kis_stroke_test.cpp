@@ -13,25 +13,27 @@
 void KisStrokeTest::testRegularStroke()
 {
     KisStroke stroke(new KisTestingStrokeStrategy());
-    QQueue<KisStrokeJob*> &queue = stroke.testingGetQueue();
+    auto queue = [&stroke] () -> QQueue<KisStrokeJob*>& {
+        return stroke.testingGetQueue();
+    };
 
-    QCOMPARE(queue.size(), 1);
-    SCOMPARE(getJobName(queue[0]), "init");
+    QCOMPARE(queue().size(), 1);
+    SCOMPARE(getJobName(queue()[0]), "init");
     QCOMPARE(stroke.isEnded(), false);
 
     stroke.addJob(0);
 
-    QCOMPARE(queue.size(), 2);
-    SCOMPARE(getJobName(queue[0]), "init");
-    SCOMPARE(getJobName(queue[1]), "dab");
+    QCOMPARE(queue().size(), 2);
+    SCOMPARE(getJobName(queue()[0]), "init");
+    SCOMPARE(getJobName(queue()[1]), "dab");
     QCOMPARE(stroke.isEnded(), false);
 
     stroke.endStroke();
 
-    QCOMPARE(queue.size(), 3);
-    SCOMPARE(getJobName(queue[0]), "init");
-    SCOMPARE(getJobName(queue[1]), "dab");
-    SCOMPARE(getJobName(queue[2]), "finish");
+    QCOMPARE(queue().size(), 3);
+    SCOMPARE(getJobName(queue()[0]), "init");
+    SCOMPARE(getJobName(queue()[1]), "dab");
+    SCOMPARE(getJobName(queue()[2]), "finish");
     QCOMPARE(stroke.isEnded(), true);
 
     // uncomment this line to catch an assert:
@@ -41,18 +43,18 @@ void KisStrokeTest::testRegularStroke()
 
     job = stroke.popOneJob();
     delete job;
-    QCOMPARE(queue.size(), 2);
-    SCOMPARE(getJobName(queue[0]), "dab");
-    SCOMPARE(getJobName(queue[1]), "finish");
+    QCOMPARE(queue().size(), 2);
+    SCOMPARE(getJobName(queue()[0]), "dab");
+    SCOMPARE(getJobName(queue()[1]), "finish");
 
     job = stroke.popOneJob();
     delete job;
-    QCOMPARE(queue.size(), 1);
-    SCOMPARE(getJobName(queue[0]), "finish");
+    QCOMPARE(queue().size(), 1);
+    SCOMPARE(getJobName(queue()[0]), "finish");
 
     job = stroke.popOneJob();
     delete job;
-    QCOMPARE(queue.size(), 0);
+    QCOMPARE(queue().size(), 0);
 
     job = stroke.popOneJob();
     QCOMPARE(job, (KisStrokeJob*)0);
@@ -61,20 +63,22 @@ void KisStrokeTest::testRegularStroke()
 void KisStrokeTest::testCancelStrokeCase1()
 {
     KisStroke stroke(new KisTestingStrokeStrategy());
-    QQueue<KisStrokeJob*> &queue = stroke.testingGetQueue();
+    auto queue = [&stroke] () -> QQueue<KisStrokeJob*>& {
+        return stroke.testingGetQueue();
+    };
 
     stroke.addJob(0);
 
     // "not initialized, has jobs"
 
-    QCOMPARE(queue.size(), 2);
-    SCOMPARE(getJobName(queue[0]), "init");
-    SCOMPARE(getJobName(queue[1]), "dab");
+    QCOMPARE(queue().size(), 2);
+    SCOMPARE(getJobName(queue()[0]), "init");
+    SCOMPARE(getJobName(queue()[1]), "dab");
     QCOMPARE(stroke.isEnded(), false);
 
     stroke.cancelStroke();
 
-    QCOMPARE(queue.size(), 0);
+    QCOMPARE(queue().size(), 0);
     QCOMPARE(stroke.isEnded(), true);
 
     stroke.clearQueueOnCancel();
@@ -83,21 +87,23 @@ void KisStrokeTest::testCancelStrokeCase1()
 void KisStrokeTest::testCancelStrokeCase2and3()
 {
     KisStroke stroke(new KisTestingStrokeStrategy());
-    QQueue<KisStrokeJob*> &queue = stroke.testingGetQueue();
+    auto queue = [&stroke] () -> QQueue<KisStrokeJob*>& {
+        return stroke.testingGetQueue();
+    };
 
     stroke.addJob(0);
     delete stroke.popOneJob();
 
     // "initialized, has jobs"
 
-    QCOMPARE(queue.size(), 1);
-    SCOMPARE(getJobName(queue[0]), "dab");
+    QCOMPARE(queue().size(), 1);
+    SCOMPARE(getJobName(queue()[0]), "dab");
     QCOMPARE(stroke.isEnded(), false);
 
     stroke.cancelStroke();
 
-    QCOMPARE(queue.size(), 1);
-    SCOMPARE(getJobName(queue[0]), "cancel");
+    QCOMPARE(queue().size(), 1);
+    SCOMPARE(getJobName(queue()[0]), "cancel");
     QCOMPARE(stroke.isEnded(), true);
 
     stroke.clearQueueOnCancel();
@@ -106,7 +112,9 @@ void KisStrokeTest::testCancelStrokeCase2and3()
 void KisStrokeTest::testCancelStrokeCase5()
 {
     KisStroke stroke(new KisTestingStrokeStrategy());
-    QQueue<KisStrokeJob*> &queue = stroke.testingGetQueue();
+    auto queue = [&stroke] () -> QQueue<KisStrokeJob*>& {
+        return stroke.testingGetQueue();
+    };
 
     // initialized, no jobs, not finished
 
@@ -117,8 +125,8 @@ void KisStrokeTest::testCancelStrokeCase5()
     QCOMPARE(stroke.isEnded(), false);
 
     stroke.cancelStroke();
-    QCOMPARE(queue.size(), 1);
-    SCOMPARE(getJobName(queue[0]), "cancel");
+    QCOMPARE(queue().size(), 1);
+    SCOMPARE(getJobName(queue()[0]), "cancel");
     QCOMPARE(stroke.isEnded(), true);
 
     delete stroke.popOneJob(); // cancel
@@ -127,7 +135,9 @@ void KisStrokeTest::testCancelStrokeCase5()
 void KisStrokeTest::testCancelStrokeCase4()
 {
     KisStroke stroke(new KisTestingStrokeStrategy());
-    QQueue<KisStrokeJob*> &queue = stroke.testingGetQueue();
+    auto queue = [&stroke] () -> QQueue<KisStrokeJob*>& {
+        return stroke.testingGetQueue();
+    };
 
     stroke.addJob(0);
     stroke.endStroke();
@@ -138,42 +148,44 @@ void KisStrokeTest::testCancelStrokeCase4()
     QCOMPARE(stroke.isEnded(), true);
 
     stroke.cancelStroke();
-    QCOMPARE(queue.size(), 0);
+    QCOMPARE(queue().size(), 0);
     QCOMPARE(stroke.isEnded(), true);
 }
 
 void KisStrokeTest::testCancelStrokeCase6()
 {
     KisStroke stroke(new KisTestingStrokeStrategy());
-    QQueue<KisStrokeJob*> &queue = stroke.testingGetQueue();
+    auto queue = [&stroke] () -> QQueue<KisStrokeJob*>& {
+        return stroke.testingGetQueue();
+    };
 
     stroke.addJob(0);
     delete stroke.popOneJob();
 
     // "initialized, has jobs"
 
-    QCOMPARE(queue.size(), 1);
-    SCOMPARE(getJobName(queue[0]), "dab");
+    QCOMPARE(queue().size(), 1);
+    SCOMPARE(getJobName(queue()[0]), "dab");
     QCOMPARE(stroke.isEnded(), false);
 
     // "cancelled"
 
     stroke.cancelStroke();
 
-    QCOMPARE(queue.size(), 1);
-    SCOMPARE(getJobName(queue[0]), "cancel");
+    QCOMPARE(queue().size(), 1);
+    SCOMPARE(getJobName(queue()[0]), "cancel");
     QCOMPARE(stroke.isEnded(), true);
 
-    int seqNo = cancelSeqNo(queue.head());
+    int seqNo = cancelSeqNo(queue().head());
 
     // try cancel once more...
 
     stroke.cancelStroke();
 
-    QCOMPARE(queue.size(), 1);
-    SCOMPARE(getJobName(queue[0]), "cancel");
+    QCOMPARE(queue().size(), 1);
+    SCOMPARE(getJobName(queue()[0]), "cancel");
     QCOMPARE(stroke.isEnded(), true);
-    QCOMPARE(cancelSeqNo(queue.head()), seqNo);
+    QCOMPARE(cancelSeqNo(queue().head()), seqNo);
 
     stroke.clearQueueOnCancel();
 }
@@ -771,6 +771,90 @@ void KisStrokesQueueTest::testMultipleLevelOfDetailMixedLegacy()
     t.checkOnlyJob("resu_u_init");
 }
 
+void KisStrokesQueueTest::testLevelOfDetailWarmUp()
+{
+    LodStrokesQueueTester t;
+    KisStrokesQueue &queue = t.queue;
+
+    queue.setLodPreferences(KisLodPreferences(2));
+
+    KisStrokeId id0 = queue.startStroke(new KisTestingStrokeStrategy(QLatin1String("leg0_"), false, true, false, false, true));
+    queue.addJob(id0, new KisTestingStrokeJobData(KisStrokeJobData::CONCURRENT));
+    queue.endStroke(id0);
+
+    t.processQueue();
+    t.checkOnlyJob("sync_u_init");
+
+    t.processQueue();
+    t.checkOnlyJob("leg0_dab");
+
+    t.processQueue();
+    t.checkNothing();
+
+    // the legacy stroke has made LoDN planes outdated
+    QVERIFY(queue.warmUpLevelOfDetail());
+
+    // the warm-up is already running
+    QVERIFY(!queue.warmUpLevelOfDetail());
+
+    t.processQueue();
+    t.checkOnlyJob("sync_u_init");
+
+    t.processQueue();
+    t.checkNothing();
+
+    // the planes are up-to-date, no sync is needed
+    QVERIFY(!queue.warmUpLevelOfDetail());
+
+    KisStrokeId id1 = queue.startStroke(new KisTestingStrokeStrategy(QLatin1String("lod1_"), false, true));
+    queue.addJob(id1, new KisTestingStrokeJobData(KisStrokeJobData::CONCURRENT));
+    queue.endStroke(id1);
+
+    t.processQueue();
+    t.checkOnlyJob("clone2_lod1_dab");
+
+    t.processQueue();
+    t.checkOnlyJob("susp_u_init");
+
+    t.processQueue();
+    t.checkOnlyJob("lod1_dab");
+
+    t.processQueue();
+    t.checkOnlyJob("resu_u_init");
+
+    KisStrokeId id2 = queue.startStroke(new KisTestingStrokeStrategy(QLatin1String("leg2_"), false, true, false, false, true));
+    queue.addJob(id2, new KisTestingStrokeJobData(KisStrokeJobData::CONCURRENT));
+    queue.endStroke(id2);
+
+    t.processQueue();
+    t.checkOnlyJob("leg2_dab");
+
+    t.processQueue();
+    t.checkNothing();
+
+    QVERIFY(queue.warmUpLevelOfDetail());
+
+    // the LoDN stroke started while warming-up doesn't start a new sync
+    KisStrokeId id3 = queue.startStroke(new KisTestingStrokeStrategy(QLatin1String("lod3_"), false, true));
+    queue.addJob(id3, new KisTestingStrokeJobData(KisStrokeJobData::CONCURRENT));
+    queue.endStroke(id3);
+
+    t.processQueue();
+    t.checkOnlyJob("sync_u_init");
+
+    t.processQueue();
+    t.checkOnlyJob("clone2_lod3_dab");
+
+    t.processQueue();
+    t.checkOnlyJob("susp_u_init");
+
+    t.processQueue();
+    t.checkOnlyJob("lod3_dab");
+
+    t.processQueue();
+    t.checkOnlyJob("resu_u_init");
+}
+
 void KisStrokesQueueTest::testCancelBetweenLodNStrokes()
 {
     LodStrokesQueueTester t;
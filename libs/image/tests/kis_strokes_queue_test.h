@@ -29,6 +29,7 @@ private Q_SLOTS:
     void testMultipleLevelOfDetailStrokes();
     void testMultipleLevelOfDetailAfterLegacy();
     void testMultipleLevelOfDetailMixedLegacy();
+    void testLevelOfDetailWarmUp();
     void testCancelBetweenLodNStrokes();
     void testUFOVisitBetweenLodNStrokes();
     void testLodUndoBase();
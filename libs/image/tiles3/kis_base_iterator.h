@@ -36,6 +36,13 @@ protected:
             tile->lockForWrite();
         else
             tile->lockForRead();
+
+        /**
+         * The prefetcher works for the iterators, so the prefetch hits
+         * are counted here, once per tile switch, rather than on every
+         * lock of a tile.
+         */
+        KisTileDataStore::instance()->notifyTileDataAccessed(tile->tileData());
     }
     inline void lockOldTile(KisTileSP &tile) {
         // Doesn't depend on current access type
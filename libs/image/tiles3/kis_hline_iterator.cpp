@@ -49,6 +49,8 @@ KisHLineIterator2::KisHLineIterator2(KisDataManager *dataManager, qint32 x, qint
     for (quint32 i = 0; i < m_tilesCacheSize; i++){
         fetchTileDataForCache(m_tilesCache[i], m_leftCol + i, m_row);
     }
+    prefetchNextRow();
+
     m_index = 0;
     switchToTile(m_leftInLeftmostTile);
 }
@@ -206,6 +208,18 @@ void KisHLineIterator2::preallocateTiles()
         unlockOldTile(m_tilesCache[i].oldtile);
         fetchTileDataForCache(m_tilesCache[i], m_leftCol + i, m_row);
     }
+    prefetchNextRow();
+}
+
+void KisHLineIterator2::prefetchNextRow()
+{
+    /**
+     * We don't know how many rows the user is going to read, so
+     * just read ahead the next row of tiles while the current one
+     * is being processed
+     */
+    m_dataManager->prefetchRect(QRect(m_left, (m_row + 1) * KisTileData::HEIGHT,
+                                      m_right - m_left + 1, KisTileData::HEIGHT));
 }
 
 qint32 KisHLineIterator2::x() const
@@ -34,6 +34,8 @@ public:
 
         m_oldDefaultPixel = 0;
         m_newDefaultPixel = 0;
+
+        m_memorySize = 0;
     }
 
     inline ~KisMemento() {
@@ -82,6 +84,16 @@ public:
         return m_newDefaultPixel;
     }
 
+    /**
+     * The size of the old versions of the tiles changed in the
+     * transaction, in bytes, that is the tile data the history
+     * keeps for undoing it. It is known only after the transaction
+     * has been committed.
+     */
+    qint64 memorySize() const {
+        return m_memorySize;
+    }
+
 private:
     friend class KisMementoManager;
 
@@ -116,6 +128,8 @@ private:
     qint32 m_extentMaxX;
     qint32 m_extentMinY;
     qint32 m_extentMaxY;
+
+    qint64 m_memorySize;
 };
 
 #endif // KIS_MEMENTO_H_
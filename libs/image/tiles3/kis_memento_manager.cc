@@ -55,6 +55,12 @@
  *       is purged.
  */
 
+/**
+ * The undo data of the latest revisions is kept uncompressed,
+ * because the user is likely to undo them soon
+ */
+#define NUM_UNCOMPRESSED_REVISIONS 2
+
 #define blockRegistration() (m_registrationBlocked = true)
 #define unblockRegistration() (m_registrationBlocked = false)
 #define registrationBlocked() (m_registrationBlocked)
@@ -183,6 +189,7 @@ void KisMementoManager::commit()
     KisMementoItemSP mi;
     KisMementoItemSP parentMI;
     bool newTile;
+    qint64 memorySize = 0;
 
     KisMementoItemHashTableIterator iter(&m_index);
     while ((mi = iter.tile())) {
@@ -192,6 +199,15 @@ void KisMementoManager::commit()
         mi->commit();
         revisionList.append(mi);
 
+        /**
+         * The memento keeps the old version of the tile alive,
+         * the new one is owned by the device anyway. The tiles
+         * that didn't exist before share the default tile data.
+         */
+        if (parentMI->type() == KisMementoItem::CHANGED) {
+            memorySize += qint64(parentMI->tileData()->pixelSize()) * KisTileData::WIDTH * KisTileData::HEIGHT;
+        }
+
         m_headsHashTable.deleteTile(mi->col(), mi->row());
 
         iter.moveCurrentToHashTable(&m_headsHashTable);
@@ -203,9 +219,17 @@ void KisMementoManager::commit()
     hItem.memento = m_currentMemento.data();
     m_revisions.append(hItem);
 
+    if (m_currentMemento) {
+        m_currentMemento->m_memorySize = memorySize;
+    }
+
     m_currentMemento = 0;
     KIS_ASSERT(m_index.isEmpty());
 
+    if (m_revisions.size() > NUM_UNCOMPRESSED_REVISIONS) {
+        compressRevisionHistory(m_revisions[m_revisions.size() - 1 - NUM_UNCOMPRESSED_REVISIONS].itemList);
+    }
+
     DEBUG_DUMP_MESSAGE("COMMIT_DONE");
 
     // Waking up pooler to prepare copies for us
@@ -398,6 +422,31 @@ void KisMementoManager::resetRevisionHistory(KisMementoItemList list)
     }
 }
 
+void KisMementoManager::compressRevisionHistory(const KisMementoItemList &list)
+{
+    /**
+     * Undoing the revision brings back the tile data of the parents,
+     * the data of the items themselves is either used by the image
+     * or is needed for undoing the later revisions
+     */
+    QVector<KisTileData*> tileDataList;
+    tileDataList.reserve(list.size());
+
+    Q_FOREACH (KisMementoItemSP mi, list) {
+        KisMementoItemSP parentMI = mi->parent();
+        if (!parentMI) continue;
+
+        KisTileData *td = parentMI->tileData();
+        if (td && td->historical() && td->data()) {
+            tileDataList.append(td);
+        }
+    }
+
+    if (!tileDataList.isEmpty()) {
+        KisTileDataStore::instance()->compressHistoricalTileData(tileDataList);
+    }
+}
+
 void KisMementoManager::setDefaultTileData(KisTileData *defaultTileData)
 {
     m_headsHashTable.setDefaultTileData(defaultTileData);
@@ -118,6 +118,12 @@ protected:
     qint32 findRevisionByMemento(KisMementoSP memento) const;
     void resetRevisionHistory(KisMementoItemList list);
 
+    /**
+     * Asks the tile data store to compress the undo data
+     * of the revision \p list in the background
+     */
+    void compressRevisionHistory(const KisMementoItemList &list);
+
 protected:
     /**
      * INDEX of tiles to be committed with next commit()
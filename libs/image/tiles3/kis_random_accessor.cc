@@ -19,6 +19,7 @@ KisRandomAccessor2::KisRandomAccessor2(KisTiledDataManager *ktm, qint32 offsetX,
         m_pixelSize(m_ktm->pixelSize()),
         m_data(0),
         m_oldData(0),
+        m_isUniform(false),
         m_writable(writable),
         m_lastX(0),
         m_lastY(0),
@@ -60,6 +61,7 @@ void KisRandomAccessor2::moveTo(qint32 x, qint32 y)
             offset *= m_pixelSize;
             m_data = kti->data + offset;
             m_oldData = kti->oldData + offset;
+            m_isUniform = kti->isUniform;
             if (i > 0) {
                 memmove(m_tilesCache + 1, m_tilesCache, i * sizeof(KisTileInfo*));
                 m_tilesCache[0] = kti;
@@ -82,6 +84,7 @@ void KisRandomAccessor2::moveTo(qint32 x, qint32 y)
     offset *= m_pixelSize;
     m_data = kti->data + offset;
     m_oldData = kti->oldData + offset;
+    m_isUniform = kti->isUniform;
     memmove(m_tilesCache + 1, m_tilesCache, (KisRandomAccessor2::CACHESIZE - 1) * sizeof(KisTileInfo*));
     m_tilesCache[0] = kti;
 }
@@ -115,6 +118,12 @@ KisRandomAccessor2::KisTileInfo* KisRandomAccessor2::fetchTileData(qint32 col, q
     lockTile(kti->tile);
     kti->data = kti->tile->data();
 
+    /**
+     * The writable tiles have already lost their uniform
+     * state in lockForWrite()
+     */
+    kti->isUniform = kti->tile->tileData()->isUniform();
+
     lockOldTile(kti->oldtile);
     kti->oldData = kti->oldtile->data();
 
@@ -141,6 +150,11 @@ qint32 KisRandomAccessor2::rowStride(qint32 x, qint32 y) const
     return m_ktm->rowStride(x - m_offsetX, y - m_offsetY);
 }
 
+bool KisRandomAccessor2::isUniformArea() const
+{
+    return m_isUniform;
+}
+
 qint32 KisRandomAccessor2::x() const
 {
     return m_lastX;
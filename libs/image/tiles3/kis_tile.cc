@@ -167,8 +167,9 @@ inline void KisTile::blockSwapping() const
     QMutexLocker locker(&m_swapBarrierLock);
     Q_ASSERT(m_lockCounter >= 0);
 
-    if(!m_lockCounter++)
+    if(!m_lockCounter++) {
         m_tileData->blockSwapping();
+    }
 
     Q_ASSERT(data());
 }
@@ -205,6 +206,31 @@ inline void KisTile::safeReleaseOldTileData(KisTileData *td)
     }
 }
 
+void KisTile::prefetchSwappedData() const
+{
+    QMutexLocker locker(&m_swapBarrierLock);
+
+    /**
+     * If the tile is locked, its data is already in memory
+     */
+    if (!m_lockCounter && !m_tileData->data()) {
+        m_tileData->m_store->prefetchTileData(m_tileData);
+    }
+}
+
+bool KisTile::tryReadSwappedData(const std::function<void(const quint8*)> &reader) const
+{
+    QMutexLocker locker(&m_swapBarrierLock);
+
+    /**
+     * While we hold the barrier lock and the tile is not locked by
+     * anyone, m_tileData cannot be changed or released by COW
+     */
+    if (m_lockCounter || m_tileData->data()) return false;
+
+    return m_tileData->m_store->tryReadSwappedTileData(m_tileData, reader);
+}
+
 void KisTile::lockForRead() const
 {
 #ifdef DEAD_TILES_SANITY_CHECK
@@ -258,6 +284,14 @@ void KisTile::lockForWrite()
 #endif
     }
 
+    if (m_tileData->readOnlySinceSwapIn()) {
+        m_tileData->setReadOnlySinceSwapIn(false);
+    }
+
+    if (m_tileData->isUniform()) {
+        m_tileData->setUniform(false);
+    }
+
     DEBUG_LOG_ACTION("lock [W]");
 }
 
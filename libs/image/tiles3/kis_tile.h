@@ -14,6 +14,7 @@
 
 #include <QRect>
 #include <QStack>
+#include <functional>
 
 #include <kis_shared.h>
 #include <kis_shared_ptr.h>
@@ -80,6 +81,25 @@ public:
     void unlockForWrite();
     void unlockForRead() const;
 
+    /**
+     * Loads the tile data from swap if it is swapped out and
+     * nobody is currently holding the tile locked. Used by
+     * KisTileDataPrefetcher.
+     */
+    void prefetchSwappedData() const;
+
+    /**
+     * If the tile is swapped out and its data is stored in the swap
+     * file uncompressed, calls \p reader with the pointer to the
+     * tile's data right inside the swap file mapping. The pointer
+     * is valid during the call only. The tile is not loaded into
+     * memory in this case.
+     *
+     * \return false if the data is not available that way, then
+     *         the caller should lock the tile in a usual way
+     */
+    bool tryReadSwappedData(const std::function<void(const quint8*)> &reader) const;
+
 
     /* this allows us work directly on tile's data */
     inline quint8 *data() const {
@@ -11,44 +11,12 @@
 
 #include <kis_debug.h>
 
-#include <boost/pool/singleton_pool.hpp>
 #include "kis_tile_data_store_iterators.h"
-
-// BPP == bytes per pixel
-#define TILE_SIZE_4BPP (4 * __TILE_DATA_WIDTH * __TILE_DATA_HEIGHT)
-#define TILE_SIZE_8BPP (8 * __TILE_DATA_WIDTH * __TILE_DATA_HEIGHT)
-
-typedef boost::singleton_pool<KisTileData, TILE_SIZE_4BPP, boost::default_user_allocator_new_delete, boost::details::pool::default_mutex, 256, 4096> BoostPool4BPP;
-typedef boost::singleton_pool<KisTileData, TILE_SIZE_8BPP, boost::default_user_allocator_new_delete, boost::details::pool::default_mutex, 128, 2048> BoostPool8BPP;
+#include "kis_tile_memory_arena.h"
 
 const qint32 KisTileData::WIDTH = __TILE_DATA_WIDTH;
 const qint32 KisTileData::HEIGHT = __TILE_DATA_HEIGHT;
 
-SimpleCache KisTileData::m_cache;
-
-SimpleCache::~SimpleCache()
-{
-    clear();
-}
-
-void SimpleCache::clear()
-{
-    QWriteLocker l(&m_cacheLock);
-    quint8 *ptr = 0;
-
-    while (m_4Pool.pop(ptr)) {
-        BoostPool4BPP::free(ptr);
-    }
-
-    while (m_8Pool.pop(ptr)) {
-        BoostPool8BPP::free(ptr);
-    }
-
-    while (m_16Pool.pop(ptr)) {
-        free(ptr);
-    }
-}
-
 
 KisTileData::KisTileData(qint32 pixelSize, const quint8 *defPixel, KisTileDataStore *store, bool checkFreeMemory)
     : m_state(NORMAL),
@@ -65,6 +33,7 @@ KisTileData::KisTileData(qint32 pixelSize, const quint8 *defPixel, KisTileDataSt
     m_data = allocateData(m_pixelSize);
 
     fillWithPixel(defPixel);
+    m_isUniform.storeRelaxed(true);
 }
 
 
@@ -94,6 +63,7 @@ KisTileData::KisTileData(const KisTileData& rhs, bool checkFreeMemory)
     m_data = allocateData(m_pixelSize);
 
     memcpy(m_data, rhs.data(), m_pixelSize * WIDTH * HEIGHT);
+    m_isUniform.storeRelaxed(rhs.m_isUniform.loadRelaxed());
 }
 
 
@@ -119,7 +89,7 @@ void KisTileData::releaseMemory()
     }
 
     KisTileData *clone = 0;
-    while (m_clonesStack.pop(clone)) {
+    while (popClone(clone)) {
         delete clone;
     }
 
@@ -134,40 +104,12 @@ void KisTileData::allocateMemory()
 
 quint8* KisTileData::allocateData(const qint32 pixelSize)
 {
-    quint8 *ptr = 0;
-
-    if (!m_cache.pop(pixelSize, ptr)) {
-        switch (pixelSize) {
-        case 4:
-            ptr = (quint8*)BoostPool4BPP::malloc();
-            break;
-        case 8:
-            ptr = (quint8*)BoostPool8BPP::malloc();
-            break;
-        default:
-            ptr = (quint8*) malloc(pixelSize * WIDTH * HEIGHT);
-            break;
-        }
-    }
-
-    return ptr;
+    return KisTileMemoryArena::instance()->allocate(pixelSize);
 }
 
 void KisTileData::freeData(quint8* ptr, const qint32 pixelSize)
 {
-    if (!m_cache.push(pixelSize, ptr)) {
-        switch (pixelSize) {
-        case 4:
-            BoostPool4BPP::free(ptr);
-            break;
-        case 8:
-            BoostPool8BPP::free(ptr);
-            break;
-        default:
-            free(ptr);
-            break;
-        }
-    }
+    KisTileMemoryArena::instance()->release(ptr, pixelSize);
 }
 
 //#define DEBUG_POOL_RELEASE
@@ -178,89 +120,31 @@ void KisTileData::freeData(quint8* ptr, const qint32 pixelSize)
 
 void KisTileData::releaseInternalPools()
 {
-    const int maxMigratedTiles = 100;
-
-    if (KisTileDataStore::instance()->numTilesInMemory() < maxMigratedTiles) {
-
-        QVector<KisTileData*> dataObjects;
-        QVector<QByteArray> memoryChunks;
-        bool failedToLock = false;
-
-        KisTileDataStoreIterator *iter = KisTileDataStore::instance()->beginIteration();
-
-        while (iter->hasNext()) {
-            KisTileData *item = iter->next();
-
-            // first release all the clones
-            KisTileData *clone = 0;
-            while (item->m_clonesStack.pop(clone)) {
-                delete clone;
-            }
-
-            // check if the tile data has actually been pooled
-            if (item->m_pixelSize != 4 &&
-                item->m_pixelSize != 8 &&
-                item->m_pixelSize != 16) {
-
-                continue;
-            }
-
-            // check if the tile has been swapped out
-            if (item->m_data) {
-                const bool locked = item->m_swapLock.tryLockForWrite();
-                if (!locked) {
-                    failedToLock = true;
-                    break;
-                }
+    KisTileDataStoreIterator *iter = KisTileDataStore::instance()->beginIteration();
 
-                const int chunkSize = item->m_pixelSize * WIDTH * HEIGHT;
-                dataObjects << item;
-                memoryChunks << QByteArray((const char*)item->m_data, chunkSize);
-            }
+    while (iter->hasNext()) {
+        KisTileData *item = iter->next();
 
+        KisTileData *clone = 0;
+        while (item->popClone(clone)) {
+            delete clone;
         }
+    }
 
-        if (!failedToLock) {
-            // purge the pools memory
-            m_cache.clear();
-            BoostPool4BPP::purge_memory();
-            BoostPool8BPP::purge_memory();
-
-            auto it = dataObjects.begin();
-            auto chunkIt = memoryChunks.constBegin();
-
-            for (; it != dataObjects.end(); ++it, ++chunkIt) {
-                KisTileData *item = *it;
-                const int chunkSize = item->m_pixelSize * WIDTH * HEIGHT;
-
-                item->m_data = allocateData(item->m_pixelSize);
-                memcpy(item->m_data, chunkIt->data(), chunkSize);
-
-                item->m_swapLock.unlock();
-            }
-        } else {
-            Q_FOREACH (KisTileData *item, dataObjects) {
-                item->m_swapLock.unlock();
-            }
-
-            warnKrita << "WARNING: Failed to lock the tiles while trying to release the pooled memory";
-        }
+    KisTileDataStore::instance()->endIteration(iter);
 
-        KisTileDataStore::instance()->endIteration(iter);
+    /**
+     * Discard the pages of all the free buffers in the arena. The
+     * slabs that end up completely free are returned to the system.
+     */
+    KisTileMemoryArena::instance()->trimAllMemory();
 
 #ifdef DEBUG_POOL_RELEASE
-        dbgKrita << "After purging unused memory:";
+    dbgKrita << "After purging unused memory:";
 
-        char command[256];
-        sprintf(command, "cat /proc/%d/status | grep -i vm", (int)getpid());
-        printf("--- %s ---\n", command);
-        (void)system(command);
+    char command[256];
+    sprintf(command, "cat /proc/%d/status | grep -i vm", (int)getpid());
+    printf("--- %s ---\n", command);
+    (void)system(command);
 #endif /* DEBUG_POOL_RELEASE */
-
-    } else {
-        dbgKrita << "DEBUG: releasing of the pooled memory has been cancelled:"
-                 << "there are still"
-                 << KisTileDataStore::instance()->numTilesInMemory()
-                 << "tiles in memory";
-    }
 }
@@ -26,6 +26,7 @@ inline quint8* KisTileData::data() const {
 void KisTileData::setData(const quint8 *data) {
     Q_ASSERT(m_data);
     memcpy(m_data, data, m_pixelSize*WIDTH*HEIGHT);
+    m_isUniform.storeRelaxed(false);
 }
 
 inline quint32 KisTileData::pixelSize() const {
@@ -42,18 +43,20 @@ inline bool KisTileData::acquire() {
      */
     if(m_usersCount == 1) {
         KisTileData *clone = 0;
-        while(m_clonesStack.pop(clone)) {
+        while(popClone(clone)) {
             delete clone;
         }
     }
 
     bool _ref = ref();
     m_usersCount.ref();
+    m_store->updateAccountedState(this);
     return _ref;
 }
 
 inline bool KisTileData::release() {
     m_usersCount.deref();
+    m_store->updateAccountedState(this);
     bool _ref = deref();
     return _ref;
 }
@@ -72,6 +75,18 @@ inline bool KisTileData::deref() {
     return _ref;
 }
 
+inline void KisTileData::pushClone(KisTileData *clone) {
+    m_clonesStack.push(clone);
+    m_store->m_poolMemoryMetric.fetchAndAddOrdered(m_pixelSize);
+}
+
+inline bool KisTileData::popClone(KisTileData *&clone) {
+    if (!m_clonesStack.pop(clone)) return false;
+
+    m_store->m_poolMemoryMetric.fetchAndAddOrdered(-qint32(m_pixelSize));
+    return true;
+}
+
 inline KisTileData* KisTileData::clone() {
     return m_store->duplicateTileData(this);
 }
@@ -96,11 +111,33 @@ inline void KisTileData::setSwapChunk(KisChunk chunk) {
     m_swapChunk = chunk;
 }
 
+inline bool KisTileData::swapUncompressed() const {
+    return m_swapUncompressed;
+}
+inline void KisTileData::setSwapUncompressed(bool value) {
+    m_swapUncompressed = value;
+}
+
+inline bool KisTileData::readOnlySinceSwapIn() const {
+    return m_readOnlySinceSwapIn.loadRelaxed();
+}
+inline void KisTileData::setReadOnlySinceSwapIn(bool value) {
+    m_readOnlySinceSwapIn.storeRelaxed(value);
+}
+
+inline bool KisTileData::isUniform() const {
+    return m_isUniform.loadRelaxed();
+}
+inline void KisTileData::setUniform(bool value) {
+    m_isUniform.storeRelaxed(value);
+}
+
 inline bool KisTileData::mementoed() const {
     return m_mementoFlag;
 }
 inline void KisTileData::setMementoed(bool value) {
     m_mementoFlag += value ? 1 : -1;
+    m_store->updateAccountedState(this);
 }
 
 inline bool KisTileData::historical() const {
@@ -121,5 +158,41 @@ inline qint32 KisTileData::numUsers() const {
     return m_usersCount;
 }
 
+inline void KisTileDataStore::updateAccountedState(KisTileData *td, int inMemory)
+{
+    const int countedState =
+        KisTileData::ACCOUNTED_IN_MEMORY | KisTileData::ACCOUNTED_HISTORICAL;
+
+    int oldState = td->m_accountedState.loadAcquire();
+    int newState;
+
+    /**
+     * Several threads may change the users count of the same tile
+     * data concurrently. The compare-and-swap guarantees that every
+     * transition of the accounted state is counted exactly once, and
+     * the last thread always leaves the state matching the tile data.
+     */
+    do {
+        newState =
+            inMemory < 0 ? oldState & KisTileData::ACCOUNTED_IN_MEMORY :
+            inMemory ? KisTileData::ACCOUNTED_IN_MEMORY : 0;
+
+        if (td->historical()) {
+            newState |= KisTileData::ACCOUNTED_HISTORICAL;
+        }
+
+        if (newState == oldState) return;
+
+    } while (!td->m_accountedState.testAndSetOrdered(oldState, newState, oldState));
+
+    const bool wasCounted = oldState == countedState;
+    const bool isCounted = newState == countedState;
+
+    if (wasCounted != isCounted) {
+        m_historicalMemoryMetric.fetchAndAddOrdered(
+            isCounted ? qint32(td->pixelSize()) : -qint32(td->pixelSize()));
+    }
+}
+
 #endif /* KIS_TILE_DATA_H_ */
 
@@ -13,6 +13,7 @@
 
 #include "kis_lockless_stack.h"
 #include "swap/kis_chunk_allocator.h"
+#include "config-tile-size.h"
 
 class KisTileData;
 class KisTileDataStore;
@@ -20,9 +21,12 @@ class KisTileDataStore;
 /**
  * WARNING: Those definitions for internal use only!
  * Please use KisTileData::WIDTH/HEIGHT instead
+ *
+ * The edge of the tiles is selected at build time with
+ * KRITA_TILE_SIZE CMake option.
  */
-#define __TILE_DATA_WIDTH 64
-#define __TILE_DATA_HEIGHT 64
+#define __TILE_DATA_WIDTH KRITA_TILE_SIZE
+#define __TILE_DATA_HEIGHT KRITA_TILE_SIZE
 
 typedef KisLocklessStack<KisTileData*> KisTileDataCache;
 
@@ -31,57 +35,6 @@ typedef KisTileDataList::iterator KisTileDataListIterator;
 typedef KisTileDataList::const_iterator KisTileDataListConstIterator;
 
 
-class SimpleCache
-{
-public:
-    SimpleCache() = default;
-    ~SimpleCache();
-
-    bool push(int pixelSize, quint8 *&ptr)
-    {
-        QReadLocker l(&m_cacheLock);
-        switch (pixelSize) {
-        case 4:
-            m_4Pool.push(ptr);
-            break;
-        case 8:
-            m_8Pool.push(ptr);
-            break;
-        case 16:
-            m_16Pool.push(ptr);
-            break;
-        default:
-            return false;
-        }
-
-        return true;
-    }
-
-    bool pop(int pixelSize, quint8 *&ptr)
-    {
-        QReadLocker l(&m_cacheLock);
-        switch (pixelSize) {
-        case 4:
-            return m_4Pool.pop(ptr);
-        case 8:
-            return m_8Pool.pop(ptr);
-        case 16:
-            return m_16Pool.pop(ptr);
-        default:
-            return false;
-        }
-    }
-
-    void clear();
-
-private:
-    QReadWriteLock m_cacheLock;
-    KisLocklessStack<quint8*> m_4Pool;
-    KisLocklessStack<quint8*> m_8Pool;
-    KisLocklessStack<quint8*> m_16Pool;
-};
-
-
 /**
  * Stores actual tile's data
  */
@@ -153,6 +106,31 @@ public:
     inline KisChunk swapChunk() const;
     inline void setSwapChunk(KisChunk chunk);
 
+    /**
+     * Shows whether the swap chunk keeps the data uncompressed,
+     * so that it could be read right from the swap file.
+     * Used by KisSwappedDataStore.
+     */
+    inline bool swapUncompressed() const;
+    inline void setSwapUncompressed(bool value);
+
+    /**
+     * Is true when the tile data has been loaded from swap and
+     * nobody has locked it for writing since then. Such tile data
+     * is considered read-mostly by the swapped data store.
+     */
+    inline bool readOnlySinceSwapIn() const;
+    inline void setReadOnlySinceSwapIn(bool value);
+
+    /**
+     * Is true when all the pixels of the tile data are known to
+     * have the same value, e.g. when it has been created by the
+     * filling constructor and nobody has written into it since
+     * then. The flag is reset by KisTile::lockForWrite().
+     */
+    inline bool isUniform() const;
+    inline void setUniform(bool value);
+
     /**
      * Show whether a tile data is a part of history
      */
@@ -201,10 +179,10 @@ public:
     /**
      * Releases internal pools, which keep blobs where the tiles are
      * stored.  The point is that we don't allocate the tiles from
-     * glibc directly, but use pools (implemented via boost) to
-     * allocate bigger chunks. This method should be called when one
-     * knows that we have just free'd quite a lot of memory and we
-     * won't need it anymore. E.g. when a document has been closed.
+     * glibc directly, but use KisTileMemoryArena to allocate bigger
+     * slabs. This method should be called when one knows that we
+     * have just free'd quite a lot of memory and we won't need it
+     * anymore. E.g. when a document has been closed.
      */
     static void releaseInternalPools();
 
@@ -216,6 +194,15 @@ private:
 private:
     friend class KisTileDataPooler;
     friend class KisTileDataPoolerTest;
+
+    /**
+     * Access to m_clonesStack. All the clones should be
+     * added and removed via these methods, because they
+     * keep the pool memory metric of the store in sync.
+     */
+    inline void pushClone(KisTileData *clone);
+    inline bool popClone(KisTileData *&clone);
+
     /**
      * A list of pre-duplicated tiledatas.
      * To make a COW faster, KisTileDataPooler thread duplicates
@@ -245,12 +232,36 @@ private:
      */
     int m_tileNumber = -1;
 
+    /**
+     * Set when the data has been loaded from swap by
+     * KisTileDataPrefetcher and nobody has accessed it yet.
+     * Used for collecting prefetcher statistics only.
+     */
+    QAtomicInt m_prefetched;
+
+    enum AccountedStateFlag {
+        ACCOUNTED_IN_MEMORY = 0x1,
+        ACCOUNTED_HISTORICAL = 0x2
+    };
+
+    /**
+     * The state of the tile data as it is currently accounted
+     * in the memory metrics of the store: a combination of
+     * AccountedStateFlag values.
+     * \see KisTileDataStore::updateAccountedState()
+     */
+    QAtomicInt m_accountedState;
+
 private:
     /**
      * The chunk of the swap file, that corresponds
      * to this tile data. Used by KisSwappedDataStore.
      */
     KisChunk m_swapChunk;
+    bool m_swapUncompressed = false;
+    QAtomicInt m_readOnlySinceSwapIn;
+
+    QAtomicInt m_isUniform;
 
 
     /**
@@ -305,7 +316,6 @@ private:
     //qint32 m_timeStamp;
 
     KisTileDataStore *m_store;
-    static SimpleCache m_cache;
 
 public:
     static const qint32 WIDTH;
@@ -11,6 +11,7 @@
 #include "kis_tile_data_store_iterators.h"
 #include "kis_debug.h"
 #include "kis_tile_data_pooler.h"
+#include "kis_tile_memory_arena.h"
 #include "kis_image_config.h"
 
 
@@ -84,9 +85,6 @@ KisTileDataPooler::KisTileDataPooler(KisTileDataStore *store, qint32 memoryLimit
     m_store = store;
     m_timeout = MIN_TIMEOUT;
     m_lastCycleHadWork = false;
-    m_lastPoolMemoryMetric = 0;
-    m_lastRealMemoryMetric = 0;
-    m_lastHistoricalMemoryMetric = 0;
 
     if(memoryLimit >= 0) {
         m_memoryLimit = memoryLimit;
@@ -129,7 +127,7 @@ void KisTileDataPooler::cloneTileData(KisTileData *td, qint32 numClones) const
     if (numClones > 0) {
         td->blockSwapping();
         for (qint32 i = 0; i < numClones; i++) {
-            td->m_clonesStack.push(new KisTileData(*td, false));
+            td->pushClone(new KisTileData(*td, false));
         }
         td->unblockSwapping();
     } else {
@@ -137,7 +135,7 @@ void KisTileDataPooler::cloneTileData(KisTileData *td, qint32 numClones) const
         for (qint32 i = 0; i < numUnneededClones; i++) {
             KisTileData *clone = 0;
 
-            bool result = td->m_clonesStack.pop(clone);
+            bool result = td->popClone(clone);
             if(!result) break;
 
             delete clone;
@@ -188,71 +186,27 @@ void KisTileDataPooler::run()
         KisTileDataStoreReverseIterator *iter = m_store->beginReverseIteration();
         QList<KisTileData*> beggars;
         QList<KisTileData*> donors;
-        qint32 memoryOccupied;
 
-        qint32 statRealMemory;
-        qint32 statHistoricalMemory;
+        getLists(iter, beggars, donors);
 
-
-        getLists(iter, beggars, donors,
-                 memoryOccupied,
-                 statRealMemory,
-                 statHistoricalMemory);
+        /**
+         * The store keeps the volume of the clones up to date,
+         * so there is no need to sum it up while walking the list
+         */
+        qint32 memoryOccupied = m_store->poolMemoryMetric();
 
         m_lastCycleHadWork =
             processLists(beggars, donors, memoryOccupied);
 
-        m_lastPoolMemoryMetric = memoryOccupied;
-        m_lastRealMemoryMetric = statRealMemory;
-        m_lastHistoricalMemoryMetric = statHistoricalMemory;
-
         m_store->endIteration(iter);
 
+        KisTileMemoryArena::instance()->trimIdleMemory();
+
         DEBUG_TILE_STATISTICS();
         DEBUG_SIMPLE_ACTION("cycle finished");
     }
 }
 
-void KisTileDataPooler::forceUpdateMemoryStats()
-{
-    KIS_SAFE_ASSERT_RECOVER_RETURN(!isRunning());
-
-    KisTileDataStoreReverseIterator *iter = m_store->beginReverseIteration();
-    QList<KisTileData*> beggars;
-    QList<KisTileData*> donors;
-    qint32 memoryOccupied;
-
-    qint32 statRealMemory;
-    qint32 statHistoricalMemory;
-
-
-    getLists(iter, beggars, donors,
-             memoryOccupied,
-             statRealMemory,
-             statHistoricalMemory);
-
-    m_lastPoolMemoryMetric = memoryOccupied;
-    m_lastRealMemoryMetric = statRealMemory;
-    m_lastHistoricalMemoryMetric = statHistoricalMemory;
-
-    m_store->endIteration(iter);
-}
-
-qint64 KisTileDataPooler::lastPoolMemoryMetric() const
-{
-    return m_lastPoolMemoryMetric;
-}
-
-qint64 KisTileDataPooler::lastRealMemoryMetric() const
-{
-    return m_lastRealMemoryMetric;
-}
-
-qint64 KisTileDataPooler::lastHistoricalMemoryMetric() const
-{
-    return m_lastHistoricalMemoryMetric;
-}
-
 inline int KisTileDataPooler::clonesMetric(KisTileData *td, int numClones) {
     return numClones * td->pixelSize();
 }
@@ -284,15 +238,8 @@ inline qint32 KisTileDataPooler::canDonorMemory(KisTileData *td)
 template<class Iter>
 void KisTileDataPooler::getLists(Iter *iter,
                                  QList<KisTileData*> &beggars,
-                                 QList<KisTileData*> &donors,
-                                 qint32 &memoryOccupied,
-                                 qint32 &statRealMemory,
-                                 qint32 &statHistoricalMemory)
+                                 QList<KisTileData*> &donors)
 {
-    memoryOccupied = 0;
-    statRealMemory = 0;
-    statHistoricalMemory = 0;
-
     qint32 needMemoryTotal = 0;
     qint32 canDonorMemoryTotal = 0;
 
@@ -314,18 +261,9 @@ void KisTileDataPooler::getLists(Iter *iter,
             canDonorMemoryTotal += donoredMemory;
             donors.append(item);
         }
-
-        memoryOccupied += clonesMetric(item);
-
-        // statistics gathering
-        if (item->historical()) {
-            statHistoricalMemory += item->pixelSize();
-        } else {
-            statRealMemory += item->pixelSize();
-        }
     }
 
-    DEBUG_LISTS(memoryOccupied,
+    DEBUG_LISTS(m_store->poolMemoryMetric(),
                 beggars, needMemoryTotal,
                 donors, canDonorMemoryTotal);
 }
@@ -30,17 +30,6 @@ public:
 
     void testingRereadConfig();
 
-    qint64 lastPoolMemoryMetric() const;
-    qint64 lastRealMemoryMetric() const;
-    qint64 lastHistoricalMemoryMetric() const;
-
-
-    /**
-     * Is case the pooler thread is not running, the user might force
-     * recalculation of the memory statistics explicitly.
-     */
-    void forceUpdateMemoryStats();
-
 protected:
     static const qint32 MAX_NUM_CLONES;
     static const qint32 MAX_TIMEOUT;
@@ -62,10 +51,7 @@ protected:
 
     template<class Iter>
         void getLists(Iter *iter, QList<KisTileData*> &beggars,
-                      QList<KisTileData*> &donors,
-                      qint32 &memoryOccupied,
-                      qint32 &statRealMemory,
-                      qint32 &statHistoricalMemory);
+                      QList<KisTileData*> &donors);
 
     bool processLists(QList<KisTileData*> &beggars,
                       QList<KisTileData*> &donors,
@@ -80,9 +66,6 @@ protected:
     qint32 m_timeout;
     bool m_lastCycleHadWork;
     qint32 m_memoryLimit;
-    qint32 m_lastPoolMemoryMetric;
-    qint32 m_lastRealMemoryMetric;
-    qint32 m_lastHistoricalMemoryMetric;
 };
 
 
@@ -58,17 +58,29 @@ qint64 __preclone_miss_age = 0;
 KisTileDataStore::KisTileDataStore()
     : m_pooler(this),
       m_swapper(this),
+      m_prefetcher(this),
+      m_historyCompressor(this),
       m_numTiles(0),
       m_memoryMetric(0),
+      m_historicalMemoryMetric(0),
+      m_poolMemoryMetric(0),
       m_counter(1),
-      m_clockIndex(1)
+      m_clockIndex(1),
+      m_prefetchedTiles(0),
+      m_prefetchHits(0),
+      m_swapInMisses(0),
+      m_swapDirectReads(0)
 {
     m_pooler.start();
     m_swapper.start();
+    m_prefetcher.start();
+    m_historyCompressor.start();
 }
 
 KisTileDataStore::~KisTileDataStore()
 {
+    m_prefetcher.terminatePrefetcher();
+    m_historyCompressor.terminateCompressor();
     m_pooler.terminatePooler();
     m_swapper.terminateSwapper();
 
@@ -92,24 +104,41 @@ KisTileDataStore::MemoryStatistics KisTileDataStore::memoryStatistics()
 
     const qint64 metricCoeff = qint64(KisTileData::WIDTH) * KisTileData::HEIGHT;
 
-    stats.realMemorySize = m_pooler.lastRealMemoryMetric() * metricCoeff;
-    stats.historicalMemorySize = m_pooler.lastHistoricalMemoryMetric() * metricCoeff;
-    stats.poolSize = m_pooler.lastPoolMemoryMetric() * metricCoeff;
+    const qint64 memoryMetric = this->memoryMetric();
+    const qint64 historicalMemoryMetric = this->historicalMemoryMetric();
 
-    stats.totalMemorySize = memoryMetric() * metricCoeff + stats.poolSize;
+    stats.realMemorySize = (memoryMetric - historicalMemoryMetric) * metricCoeff;
+    stats.historicalMemorySize = historicalMemoryMetric * metricCoeff;
+    stats.poolSize = poolMemoryMetric() * metricCoeff;
+
+    stats.compressedHistorySize = m_compressedStore.compressedSize();
+    stats.compressedHistoryOriginalSize = m_compressedStore.originalSize();
+    stats.compressedHistoryLimit = m_compressedStore.limit();
+
+    stats.totalMemorySize = memoryMetric * metricCoeff + stats.poolSize + stats.compressedHistorySize;
 
     stats.swapSize = m_swappedStore.totalSwapMemoryUsed();
 
-    return stats;
-}
+    stats.swapFileSize = m_swappedStore.swapFileSize();
+    stats.swapFragmentation = m_swappedStore.fragmentation();
 
-void KisTileDataStore::tryForceUpdateMemoryStatisticsWhileIdle()
-{
-    // in case the pooler is disabled, we should force it
-    // to update the stats
-    if (!m_pooler.isRunning()) {
-        m_pooler.forceUpdateMemoryStats();
-    }
+    const KisChunkAllocator::Statistics allocatorStats = m_swappedStore.allocatorStatistics();
+    stats.swapChunkAllocationTime =
+        allocatorStats.numAllocations ?
+        allocatorStats.totalAllocationTime / allocatorStats.numAllocations : 0;
+    stats.swapChunkFreeTime =
+        allocatorStats.numFrees ?
+        allocatorStats.totalFreeTime / allocatorStats.numFrees : 0;
+
+    stats.swapPrefetchedTiles = m_prefetchedTiles.loadRelaxed();
+    stats.swapPrefetchHits = m_prefetchHits.loadRelaxed();
+    stats.swapInMisses = m_swapInMisses.loadRelaxed();
+    stats.swapDirectReads = m_swapDirectReads.loadRelaxed();
+
+    stats.swapDeduplicatedTiles = m_swappedStore.numDeduplicatedTiles();
+    stats.swapDeduplicatedSize = m_swappedStore.deduplicatedSize();
+
+    return stats;
 }
 
 inline void KisTileDataStore::registerTileDataImp(KisTileData *td)
@@ -127,6 +156,7 @@ inline void KisTileDataStore::registerTileDataImp(KisTileData *td)
 
     m_numTiles.ref();
     m_memoryMetric += td->pixelSize();
+    updateAccountedState(td, 1);
 }
 
 void KisTileDataStore::registerTileData(KisTileData *td)
@@ -153,6 +183,7 @@ inline void KisTileDataStore::unregisterTileDataImp(KisTileData *td)
     m_tileDataMap.erase(index);
     m_numTiles.deref();
     m_memoryMetric -= td->pixelSize();
+    updateAccountedState(td, 0);
 
     m_tileDataMap.getGC().unlockRawPointerAccess();
     m_tileDataMap.getGC().update();
@@ -175,7 +206,7 @@ KisTileData *KisTileDataStore::duplicateTileData(KisTileData *rhs)
 {
     KisTileData *td = 0;
 
-    if (rhs->m_clonesStack.pop(td)) {
+    if (rhs->popClone(td)) {
         DEBUG_PRECLONE_ACTION("+ Pre-clone HIT", rhs, td);
         DEBUG_COUNT_PRECLONE_HIT(rhs);
     } else {
@@ -200,7 +231,11 @@ void KisTileDataStore::freeTileData(KisTileData *td)
     td->m_swapLock.lockForWrite();
 
     if (!td->data()) {
-        m_swappedStore.forgetTileData(td);
+        if (td->m_state == KisTileData::COMPRESSED) {
+            m_compressedStore.forgetTileData(td);
+        } else {
+            m_swappedStore.forgetTileData(td);
+        }
     } else {
         unregisterTileDataImp(td);
     }
@@ -211,6 +246,18 @@ void KisTileDataStore::freeTileData(KisTileData *td)
     delete td;
 }
 
+inline void KisTileDataStore::loadTileDataImp(KisTileData *td)
+{
+    if (td->m_state == KisTileData::COMPRESSED) {
+        m_compressedStore.decompressTileData(td);
+        td->m_state = KisTileData::NORMAL;
+    } else {
+        m_swappedStore.swapInTileData(td);
+    }
+
+    registerTileDataImp(td);
+}
+
 void KisTileDataStore::ensureTileDataLoaded(KisTileData *td)
 {
 //    dbgKrita << "#### SWAP MISS! ####" << td << ppVar(td->mementoed()) << ppVar(td->age()) << ppVar(td->numUsers());
@@ -224,32 +271,36 @@ void KisTileDataStore::ensureTileDataLoaded(KisTileData *td)
         /**
          * The order of this heavy locking is very important.
          * Change it only in case, you really know what you are doing.
+         *
+         * We take the swap lock of the tile data *before*
+         * m_iteratorLock and take the latter in read mode only, so
+         * the tiles living in different shards of the swapped store
+         * are loaded in parallel. The only lock shared by the loads
+         * is the lock of the shard.
+         *
+         * COW mechanism takes m_iteratorLock while the swap lock is
+         * held in read mode (see duplicateTileData()), so we never
+         * wait for the swap lock with m_iteratorLock held. The
+         * iterators hold m_iteratorLock in write mode and may block
+         * on the swap lock of a registered tile data (the pooler
+         * does that), so we touch m_iteratorLock only if the tile
+         * data is still swapped out, that is, not registered in the
+         * store. Nobody can register or unregister it while we hold
+         * its swap lock.
          */
-        m_iteratorLock.lockForWrite();
-
-        /**
-         * If someone has managed to load the td from swap, then, most
-         * probably, they have already taken the swap lock. This may
-         * lead to a deadlock, because COW mechanism breaks lock
-         * ordering rules in duplicateTileData() (it takes m_listLock
-         * while the swap lock is held). In our case it is enough just
-         * to check whether the other thread has already fetched the
-         * data. Please notice that we do not take both of the locks
-         * while checking this, because holding m_listLock is
-         * enough. Nothing can happen to the tile while we hold
-         * m_listLock.
-         */
+        td->m_swapLock.lockForWrite();
 
         if (!td->data()) {
-            td->m_swapLock.lockForWrite();
-
-            m_swappedStore.swapInTileData(td);
-            registerTileDataImp(td);
+            if (td->m_state != KisTileData::COMPRESSED) {
+                m_swapInMisses.ref();
+            }
 
-            td->m_swapLock.unlock();
+            m_iteratorLock.lockForRead();
+            loadTileDataImp(td);
+            m_iteratorLock.unlock();
         }
 
-        m_iteratorLock.unlock();
+        td->m_swapLock.unlock();
 
         /**
          * <-- In theory, livelock is possible here...
@@ -259,6 +310,50 @@ void KisTileDataStore::ensureTileDataLoaded(KisTileData *td)
     }
 }
 
+bool KisTileDataStore::tryReadSwappedTileData(KisTileData *td, const std::function<void(const quint8*)> &reader)
+{
+    /**
+     * Holding the swap lock in read mode guarantees that nobody
+     * will swap the tile data in while we are reading it
+     */
+    if (!td->m_swapLock.tryLockForRead()) return false;
+
+    bool result = false;
+
+    if (!td->data()) {
+        result = m_swappedStore.tryReadUncompressedTileData(td, reader);
+    }
+
+    td->m_swapLock.unlock();
+
+    if (result) {
+        m_swapDirectReads.ref();
+    }
+
+    return result;
+}
+
+void KisTileDataStore::prefetchTileData(KisTileData *td)
+{
+    /**
+     * We never block on the swap lock while holding m_iteratorLock
+     * (see ensureTileDataLoaded()). If the swap lock is busy,
+     * someone is already loading the tile.
+     */
+    QReadLocker locker(&m_iteratorLock);
+
+    if (!td->data() && td->m_swapLock.tryLockForWrite()) {
+        if (!td->data()) {
+            loadTileDataImp(td);
+            td->resetAge();
+            td->m_prefetched = 1;
+            m_prefetchedTiles.ref();
+        }
+
+        td->m_swapLock.unlock();
+    }
+}
+
 bool KisTileDataStore::trySwapTileData(KisTileData *td)
 {
     /**
@@ -271,6 +366,35 @@ bool KisTileDataStore::trySwapTileData(KisTileData *td)
     if (td->data()) {
         if (m_swappedStore.trySwapOutTileData(td)) {
             unregisterTileDataImp(td);
+            td->m_prefetched = 0;
+            result = true;
+        }
+    }
+    td->m_swapLock.unlock();
+
+    return result;
+}
+
+bool KisTileDataStore::tryCompressTileData(KisTileData *td)
+{
+    /**
+     * The locking rules are the same as in prefetchTileData(): we
+     * never block on the swap lock while holding m_iteratorLock
+     */
+    QReadLocker locker(&m_iteratorLock);
+
+    bool result = false;
+    if (!td->m_swapLock.tryLockForWrite()) return result;
+
+    /**
+     * The tile data could have been brought back to the
+     * image by undo/redo while it was waiting in the queue
+     */
+    if (td->data() && td->historical()) {
+        if (m_compressedStore.tryCompressTileData(td)) {
+            unregisterTileDataImp(td);
+            td->m_state = KisTileData::COMPRESSED;
+            td->m_prefetched = 0;
             result = true;
         }
     }
@@ -279,6 +403,23 @@ bool KisTileDataStore::trySwapTileData(KisTileData *td)
     return result;
 }
 
+void KisTileDataStore::compressHistoricalTileData(const QVector<KisTileData*> &tileDataList)
+{
+    if (m_compressedStore.compressedSize() >= m_compressedStore.limit()) return;
+
+    m_historyCompressor.compressTileData(tileDataList);
+}
+
+bool KisTileDataStore::swapNeedsCompaction()
+{
+    return m_swappedStore.needsCompaction();
+}
+
+qint32 KisTileDataStore::compactSwap()
+{
+    return m_swappedStore.compactSwap();
+}
+
 KisTileDataStoreIterator* KisTileDataStore::beginIteration()
 {
     m_iteratorLock.lockForWrite();
@@ -361,15 +502,34 @@ void KisTileDataStore::debugClear()
     m_clockIndex = 1;
     m_numTiles = 0;
     m_memoryMetric = 0;
+    m_historicalMemoryMetric = 0;
+    m_poolMemoryMetric = 0;
+
+    m_prefetchedTiles = 0;
+    m_prefetchHits = 0;
+    m_swapInMisses = 0;
+    m_swapDirectReads = 0;
 }
 
 void KisTileDataStore::testingRereadConfig()
 {
     m_pooler.testingRereadConfig();
     m_swapper.testingRereadConfig();
+    m_prefetcher.testingRereadConfig();
+    m_compressedStore.testingRereadConfig();
     kickPooler();
 }
 
+void KisTileDataStore::testingWaitForPrefetcher()
+{
+    m_prefetcher.testingWaitForIdle();
+}
+
+void KisTileDataStore::testingWaitForHistoryCompressor()
+{
+    m_historyCompressor.testingWaitForIdle();
+}
+
 void KisTileDataStore::testingSuspendPooler()
 {
     m_pooler.terminatePooler();
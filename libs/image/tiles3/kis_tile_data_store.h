@@ -11,11 +11,15 @@
 #include "kritaimage_export.h"
 
 #include <QReadWriteLock>
+#include <functional>
 #include "kis_tile_data_interface.h"
 
 #include "kis_tile_data_pooler.h"
 #include "swap/kis_tile_data_swapper.h"
+#include "swap/kis_tile_data_prefetcher.h"
+#include "swap/kis_tile_data_history_compressor.h"
 #include "swap/kis_swapped_data_store.h"
+#include "swap/kis_compressed_history_store.h"
 #include "3rdparty/lock_free_map/concurrent_map.h"
 
 class KisTileDataStoreIterator;
@@ -42,22 +46,42 @@ public:
         qint64 poolSize;
 
         qint64 swapSize;
+
+        qint64 swapFileSize;
+        qreal swapFragmentation;
+        qint64 swapChunkAllocationTime; // average, in nanoseconds
+        qint64 swapChunkFreeTime; // average, in nanoseconds
+
+        qint64 swapPrefetchedTiles;
+        qint64 swapPrefetchHits;
+        qint64 swapInMisses;
+        qint64 swapDirectReads;
+
+        qint64 swapDeduplicatedTiles;
+        qint64 swapDeduplicatedSize;
+
+        qint64 compressedHistorySize;
+        qint64 compressedHistoryOriginalSize; // the size before compression
+        qint64 compressedHistoryLimit;
     };
 
+    /**
+     * All the memory metrics are maintained incrementally,
+     * so the call is cheap and doesn't walk the tile data.
+     */
     MemoryStatistics memoryStatistics();
-    void tryForceUpdateMemoryStatisticsWhileIdle();
 
     /**
      * Returns total number of tiles present: in memory
-     * or in a swap file
+     * (compressed or not) or in a swap file
      */
     inline qint32 numTiles() const
     {
-        return m_numTiles.loadAcquire() + m_swappedStore.numTiles();
+        return m_numTiles.loadAcquire() + m_swappedStore.numTiles() + m_compressedStore.numTiles();
     }
 
     /**
-     * Returns the number of tiles present in memory only
+     * Returns the number of uncompressed tiles present in memory only
      */
     inline qint32 numTilesInMemory() const
     {
@@ -77,6 +101,22 @@ public:
         return m_memoryMetric.loadAcquire();
     }
 
+    /**
+     * \see m_historicalMemoryMetric
+     */
+    inline qint64 historicalMemoryMetric() const
+    {
+        return m_historicalMemoryMetric.loadAcquire();
+    }
+
+    /**
+     * \see m_poolMemoryMetric
+     */
+    inline qint64 poolMemoryMetric() const
+    {
+        return m_poolMemoryMetric.loadAcquire();
+    }
+
     KisTileDataStoreIterator* beginIteration();
     void endIteration(KisTileDataStoreIterator* iterator);
 
@@ -107,6 +147,65 @@ public:
      */
     bool trySwapTileData(KisTileData *td);
 
+    /**
+     * Try to compress the tile data, which is referenced by
+     * the undo history only. It may fail in case the tile is
+     * being accessed at the same moment of time.
+     * \see KisCompressedHistoryStore
+     */
+    bool tryCompressTileData(KisTileData *td);
+
+    /**
+     * Asks the history compressor thread to compress the data of
+     * \p tileDataList. Called by the Memento Manager, when the
+     * revision these tile data objects belong to gets old enough.
+     */
+    void compressHistoricalTileData(const QVector<KisTileData*> &tileDataList);
+
+    /**
+     * \see KisSwappedDataStore::needsCompaction()
+     */
+    bool swapNeedsCompaction();
+
+    /**
+     * Compacts a portion of the swap file.
+     * \see KisSwappedDataStore::compactSwap()
+     * \return the number of relocated tiles
+     */
+    qint32 compactSwap();
+
+    /**
+     * Returns true if there is at least one tile in the swap file,
+     * that is, if prefetching can have any effect at all
+     */
+    inline bool hasSwappedTiles() const
+    {
+        return m_swappedStore.numTiles() > 0;
+    }
+
+    /**
+     * Asks the prefetcher thread to load the \p tiles from swap
+     * before anyone actually accesses them
+     */
+    inline void prefetchTiles(const QVector<KisTileSP> &tiles)
+    {
+        m_prefetcher.prefetchTiles(tiles);
+    }
+
+    /**
+     * Counts the access to a tile data which has been loaded from
+     * swap by the prefetcher. Called by the iterators when they
+     * switch to a new tile.
+     */
+    inline void notifyTileDataAccessed(KisTileData *td)
+    {
+        if (td->m_prefetched.loadRelaxed() &&
+            td->m_prefetched.testAndSetRelaxed(1, 0)) {
+
+            m_prefetchHits.ref();
+        }
+    }
+
 
     /**
      * WARN: The following three method are only for usage
@@ -129,6 +228,19 @@ public:
      */
     void ensureTileDataLoaded(KisTileData *td);
 
+    /**
+     * Calls \p reader with the pointer to the uncompressed data of
+     * \p td right in the swap file, if it is available.
+     * \see KisTile::tryReadSwappedData()
+     */
+    bool tryReadSwappedTileData(KisTileData *td, const std::function<void(const quint8*)> &reader);
+
+    /**
+     * The same as ensureTileDataLoaded(), but doesn't block swapping
+     * of the tile data afterwards. Used by the prefetcher thread.
+     */
+    void prefetchTileData(KisTileData *td);
+
     void registerTileData(KisTileData *td);
     void unregisterTileData(KisTileData *td);
 
@@ -137,8 +249,29 @@ private:
 
     inline void registerTileDataImp(KisTileData *td);
     inline void unregisterTileDataImp(KisTileData *td);
+
+    /**
+     * Brings the data of \p td back from the swap file or from the
+     * compressed history.
+     * LOCKING: td->m_swapLock should be locked for write and
+     *          m_iteratorLock should be locked for read
+     */
+    inline void loadTileDataImp(KisTileData *td);
     void freeRegisteredTiles();
 
+    friend class KisTileData;
+
+    /**
+     * Brings the contribution of \p td into m_historicalMemoryMetric
+     * in line with its current state. Should be called after every
+     * change of the users count or the memento flag of the tile data.
+     *
+     * \p inMemory is 1 when the tile data has just been registered,
+     * 0 when it has just been unregistered, and -1 if its residency
+     * has not changed.
+     */
+    inline void updateAccountedState(KisTileData *td, int inMemory = -1);
+
     friend class DeadlockyThread;
     friend class KisLowMemoryTests;
     void debugSwapAll();
@@ -150,13 +283,20 @@ private:
 
     friend class KisLowMemoryBenchmark;
     void testingRereadConfig();
+
+    void testingWaitForPrefetcher();
+    void testingWaitForHistoryCompressor();
 private:
     KisTileDataPooler m_pooler;
     KisTileDataSwapper m_swapper;
+    KisTileDataPrefetcher m_prefetcher;
+    KisTileDataHistoryCompressor m_historyCompressor;
 
     friend class KisTileDataStoreTest;
     friend class KisTileDataPoolerTest;
+    friend class KisSwappedDataStoreBenchmark;
     KisSwappedDataStore m_swappedStore;
+    KisCompressedHistoryStore m_compressedStore;
 
     /**
      * This metric is used for computing the volume
@@ -165,8 +305,27 @@ private:
      */
     QAtomicInt m_numTiles;
     QAtomicInt m_memoryMetric;
+
+    /**
+     * The part of m_memoryMetric occupied by the tile data
+     * objects, which are referenced by the undo history only,
+     * that is, KisTileData::historical() is true for them.
+     */
+    QAtomicInt m_historicalMemoryMetric;
+
+    /**
+     * The volume of the clones pre-duplicated by
+     * KisTileDataPooler. It is not included into
+     * m_memoryMetric.
+     */
+    QAtomicInt m_poolMemoryMetric;
     QAtomicInt m_counter;
     QAtomicInt m_clockIndex;
+
+    QAtomicInt m_prefetchedTiles;
+    QAtomicInt m_prefetchHits;
+    QAtomicInt m_swapInMisses;
+    QAtomicInt m_swapDirectReads;
     ConcurrentMap<int, KisTileData*> m_tileDataMap;
     QReadWriteLock m_iteratorLock;
 };
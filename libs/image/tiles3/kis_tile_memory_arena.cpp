@@ -0,0 +1,468 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_tile_memory_arena.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#elif defined(Q_OS_UNIX)
+#include <sys/mman.h>
+#endif
+
+#include "kis_tile_data_interface.h"
+#include "kis_debug.h"
+
+namespace {
+
+const int NUM_SIZE_CLASSES = 3;
+const int MAGAZINE_CAPACITY = 16;
+const qint64 SLAB_SIZE = 2 * (1 << 20);
+
+/**
+ * The magazine should stay in the depot for this number of calls
+ * to trimIdleMemory() before its memory is discarded
+ */
+const int IDLE_TRIM_CYCLES = 4;
+
+/**
+ * The number of completely free slabs every size class keeps
+ * for reuse, the rest of them are returned to the system
+ */
+const int MAX_FREE_SLABS = 2;
+
+inline int sizeClassForPixelSize(qint32 pixelSize)
+{
+    switch (pixelSize) {
+    case 4:
+        return 0;
+    case 8:
+        return 1;
+    case 16:
+        return 2;
+    default:
+        return -1;
+    }
+}
+
+inline qint32 bufferSizeForPixelSize(qint32 pixelSize)
+{
+    return pixelSize * __TILE_DATA_WIDTH * __TILE_DATA_HEIGHT;
+}
+
+quint8* allocateSlab()
+{
+#if defined(Q_OS_WIN)
+    return (quint8*) VirtualAlloc(0, SLAB_SIZE, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#elif defined(Q_OS_UNIX)
+    void *ptr = mmap(0, SLAB_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return ptr != MAP_FAILED ? (quint8*) ptr : 0;
+#else
+    return (quint8*) qMallocAligned(SLAB_SIZE, 4096);
+#endif
+}
+
+void freeSlab(quint8 *slab)
+{
+#if defined(Q_OS_WIN)
+    VirtualFree(slab, 0, MEM_RELEASE);
+#elif defined(Q_OS_UNIX)
+    munmap(slab, SLAB_SIZE);
+#else
+    qFreeAligned(slab);
+#endif
+}
+
+/**
+ * The buffers are page-aligned, because all the pooled
+ * sizes are multiples of the page size
+ */
+void discardMemory(quint8 *ptr, qint32 size)
+{
+#if defined(Q_OS_WIN)
+    VirtualAlloc(ptr, size, MEM_RESET, PAGE_READWRITE);
+#elif defined(Q_OS_UNIX)
+    madvise(ptr, size, MADV_DONTNEED);
+#else
+    Q_UNUSED(ptr);
+    Q_UNUSED(size);
+#endif
+}
+
+struct Magazine
+{
+    inline bool isEmpty() const {
+        return !size;
+    }
+
+    inline bool isFull() const {
+        return size == MAGAZINE_CAPACITY;
+    }
+
+    inline quint8* pop() {
+        return items[--size];
+    }
+
+    inline void push(quint8 *ptr) {
+        items[size++] = ptr;
+    }
+
+    int size = 0;
+    int idleCycles = 0;
+    bool isTrimmed = false;
+    quint8 *items[MAGAZINE_CAPACITY];
+};
+
+struct Depot
+{
+    QMutex lock;
+    qint32 bufferSize = 0;
+
+    std::vector<Magazine*> filledMagazines;
+    std::vector<Magazine*> emptyMagazines;
+
+    /**
+     * The slabs sorted by their address
+     */
+    std::vector<quint8*> slabs;
+    quint8 *currentSlab = 0;
+    quint8 *slabCursor = 0;
+    quint8 *slabEnd = 0;
+
+    Magazine* takeFilledMagazine() {
+        if (filledMagazines.empty()) return 0;
+
+        Magazine *magazine = filledMagazines.back();
+        filledMagazines.pop_back();
+
+        magazine->idleCycles = 0;
+        magazine->isTrimmed = false;
+        return magazine;
+    }
+
+    Magazine* takeEmptyMagazine() {
+        if (emptyMagazines.empty()) return new Magazine();
+
+        Magazine *magazine = emptyMagazines.back();
+        emptyMagazines.pop_back();
+        return magazine;
+    }
+
+    void putMagazine(Magazine *magazine) {
+        if (magazine->isEmpty()) {
+            emptyMagazines.push_back(magazine);
+        } else {
+            filledMagazines.push_back(magazine);
+        }
+    }
+
+    quint8* allocateFromSlab() {
+        if (slabCursor == slabEnd) {
+            quint8 *slab = allocateSlab();
+
+            /**
+             * None of the users of the tile data can handle a null
+             * buffer, so just crash here instead of somewhere deep
+             * inside the pixel operations
+             */
+            if (!slab) {
+                qFatal("KisTileMemoryArena: failed to allocate a slab of %lld bytes", SLAB_SIZE);
+            }
+
+            slabs.insert(std::upper_bound(slabs.begin(), slabs.end(), slab), slab);
+            currentSlab = slab;
+            slabCursor = slab;
+            slabEnd = slab + (SLAB_SIZE / bufferSize) * bufferSize;
+        }
+
+        quint8 *ptr = slabCursor;
+        slabCursor += bufferSize;
+        return ptr;
+    }
+
+    void trim(bool onlyIdle) {
+        QMutexLocker l(&lock);
+
+        for (Magazine *magazine : filledMagazines) {
+            if (magazine->isTrimmed) continue;
+            if (onlyIdle && magazine->idleCycles++ < IDLE_TRIM_CYCLES) continue;
+
+            for (int i = 0; i < magazine->size; i++) {
+                discardMemory(magazine->items[i], bufferSize);
+            }
+            magazine->isTrimmed = true;
+        }
+
+        releaseFreeSlabs();
+    }
+
+    int slabIndex(quint8 *ptr) const {
+        return std::distance(slabs.begin(), std::upper_bound(slabs.begin(), slabs.end(), ptr)) - 1;
+    }
+
+    /**
+     * Returns the slabs, which have all their buffers lying trimmed
+     * in the depot, to the system, except MAX_FREE_SLABS of them.
+     * The slab that is still being carved is never released.
+     */
+    void releaseFreeSlabs() {
+        const int buffersPerSlab = SLAB_SIZE / bufferSize;
+
+        std::vector<int> numFreeBuffers(slabs.size(), 0);
+
+        for (Magazine *magazine : filledMagazines) {
+            if (!magazine->isTrimmed) continue;
+
+            for (int i = 0; i < magazine->size; i++) {
+                numFreeBuffers[slabIndex(magazine->items[i])]++;
+            }
+        }
+
+        std::vector<quint8*> releasedSlabs;
+        int numKeptFreeSlabs = 0;
+
+        for (size_t i = 0; i < slabs.size(); i++) {
+            if (slabs[i] == currentSlab || numFreeBuffers[i] < buffersPerSlab) continue;
+
+            if (numKeptFreeSlabs < MAX_FREE_SLABS) {
+                numKeptFreeSlabs++;
+            } else {
+                releasedSlabs.push_back(slabs[i]);
+            }
+        }
+
+        if (releasedSlabs.empty()) return;
+
+        auto isReleased = [&] (quint8 *ptr) {
+            return std::binary_search(releasedSlabs.begin(), releasedSlabs.end(), slabs[slabIndex(ptr)]);
+        };
+
+        /**
+         * Remove the buffers of the released slabs from the trimmed
+         * magazines and pack the rest of them into full magazines
+         */
+        std::vector<quint8*> trimmedBuffers;
+        std::vector<Magazine*> untrimmedMagazines;
+
+        for (Magazine *magazine : filledMagazines) {
+            if (!magazine->isTrimmed) {
+                untrimmedMagazines.push_back(magazine);
+                continue;
+            }
+
+            for (int i = 0; i < magazine->size; i++) {
+                if (!isReleased(magazine->items[i])) {
+                    trimmedBuffers.push_back(magazine->items[i]);
+                }
+            }
+
+            magazine->size = 0;
+            magazine->idleCycles = 0;
+            magazine->isTrimmed = false;
+            emptyMagazines.push_back(magazine);
+        }
+
+        filledMagazines.swap(untrimmedMagazines);
+
+        Magazine *magazine = 0;
+        for (quint8 *ptr : trimmedBuffers) {
+            if (!magazine || magazine->isFull()) {
+                magazine = takeEmptyMagazine();
+                magazine->isTrimmed = true;
+                filledMagazines.push_back(magazine);
+            }
+            magazine->push(ptr);
+        }
+
+        for (quint8 *slab : releasedSlabs) {
+            freeSlab(slab);
+            slabs.erase(std::lower_bound(slabs.begin(), slabs.end(), slab));
+        }
+    }
+};
+
+}
+
+struct Q_DECL_HIDDEN KisTileMemoryArena::Private
+{
+    Depot depots[NUM_SIZE_CLASSES];
+};
+
+namespace {
+
+/**
+ * Per-thread magazines. When the thread exits, the magazines
+ * are returned to the depots.
+ */
+struct ThreadCache
+{
+    ThreadCache(Depot *_depots)
+        : depots(_depots)
+    {
+        for (int i = 0; i < NUM_SIZE_CLASSES; i++) {
+            loaded[i] = new Magazine();
+            previous[i] = new Magazine();
+        }
+    }
+
+    ~ThreadCache() {
+        for (int i = 0; i < NUM_SIZE_CLASSES; i++) {
+            QMutexLocker l(&depots[i].lock);
+            depots[i].putMagazine(loaded[i]);
+            depots[i].putMagazine(previous[i]);
+        }
+    }
+
+    Depot *depots;
+    Magazine *loaded[NUM_SIZE_CLASSES];
+    Magazine *previous[NUM_SIZE_CLASSES];
+};
+
+}
+
+KisTileMemoryArena::KisTileMemoryArena()
+    : m_d(new Private)
+{
+    m_d->depots[0].bufferSize = bufferSizeForPixelSize(4);
+    m_d->depots[1].bufferSize = bufferSizeForPixelSize(8);
+    m_d->depots[2].bufferSize = bufferSizeForPixelSize(16);
+}
+
+KisTileMemoryArena::~KisTileMemoryArena()
+{
+    delete m_d;
+}
+
+KisTileMemoryArena* KisTileMemoryArena::instance()
+{
+    /**
+     * The arena is never destroyed: the thread caches return their
+     * magazines to it on thread exit, which may happen after the
+     * destruction of static objects.
+     */
+    static KisTileMemoryArena *s_instance = new KisTileMemoryArena();
+    return s_instance;
+}
+
+namespace {
+inline ThreadCache& threadCache(Depot *depots)
+{
+    thread_local ThreadCache cache(depots);
+    return cache;
+}
+}
+
+quint8* KisTileMemoryArena::allocate(qint32 pixelSize)
+{
+    const int sizeClass = sizeClassForPixelSize(pixelSize);
+    if (sizeClass < 0) {
+        quint8 *ptr = (quint8*) malloc(bufferSizeForPixelSize(pixelSize));
+        if (!ptr) {
+            qFatal("KisTileMemoryArena: failed to allocate a tile of %d bytes", bufferSizeForPixelSize(pixelSize));
+        }
+        return ptr;
+    }
+
+    ThreadCache &cache = threadCache(m_d->depots);
+    Magazine *&loaded = cache.loaded[sizeClass];
+    Magazine *&previous = cache.previous[sizeClass];
+
+    if (!loaded->isEmpty()) {
+        return loaded->pop();
+    }
+
+    if (!previous->isEmpty()) {
+        std::swap(loaded, previous);
+        return loaded->pop();
+    }
+
+    Depot &depot = m_d->depots[sizeClass];
+    QMutexLocker l(&depot.lock);
+
+    Magazine *filled = depot.takeFilledMagazine();
+    if (filled) {
+        depot.putMagazine(loaded);
+        loaded = filled;
+        return loaded->pop();
+    }
+
+    return depot.allocateFromSlab();
+}
+
+void KisTileMemoryArena::release(quint8 *ptr, qint32 pixelSize)
+{
+    const int sizeClass = sizeClassForPixelSize(pixelSize);
+    if (sizeClass < 0) {
+        free(ptr);
+        return;
+    }
+
+    ThreadCache &cache = threadCache(m_d->depots);
+    Magazine *&loaded = cache.loaded[sizeClass];
+    Magazine *&previous = cache.previous[sizeClass];
+
+    if (!loaded->isFull()) {
+        loaded->push(ptr);
+        return;
+    }
+
+    if (!previous->isFull()) {
+        std::swap(loaded, previous);
+        loaded->push(ptr);
+        return;
+    }
+
+    Depot &depot = m_d->depots[sizeClass];
+    QMutexLocker l(&depot.lock);
+
+    depot.putMagazine(previous);
+    previous = loaded;
+    loaded = depot.takeEmptyMagazine();
+    loaded->push(ptr);
+}
+
+void KisTileMemoryArena::trimIdleMemory()
+{
+    for (int i = 0; i < NUM_SIZE_CLASSES; i++) {
+        m_d->depots[i].trim(true);
+    }
+}
+
+void KisTileMemoryArena::trimAllMemory()
+{
+    for (int i = 0; i < NUM_SIZE_CLASSES; i++) {
+        m_d->depots[i].trim(false);
+    }
+}
+
+KisTileMemoryArena::Statistics KisTileMemoryArena::statistics()
+{
+    Statistics stats;
+
+    for (int i = 0; i < NUM_SIZE_CLASSES; i++) {
+        Depot &depot = m_d->depots[i];
+        QMutexLocker l(&depot.lock);
+
+        stats.reservedSize += qint64(depot.slabs.size()) * SLAB_SIZE;
+
+        for (Magazine *magazine : depot.filledMagazines) {
+            const qint64 size = qint64(magazine->size) * depot.bufferSize;
+
+            stats.depotSize += size;
+            if (magazine->isTrimmed) {
+                stats.trimmedSize += size;
+            }
+        }
+    }
+
+    return stats;
+}
@@ -0,0 +1,74 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KIS_TILE_MEMORY_ARENA_H
+#define KIS_TILE_MEMORY_ARENA_H
+
+#include <QtGlobal>
+
+#include "kritaimage_export.h"
+
+/**
+ * Allocates the memory for the tile data buffers.
+ *
+ * The buffers of the most common sizes (4, 8 and 16 bytes per pixel)
+ * are carved from big page-aligned slabs. Every size class has a
+ * central depot of free buffers guarded by a mutex, and every thread
+ * keeps two small "magazines" of free buffers per size class, so
+ * most of the allocations and deallocations don't take any locks.
+ * The magazines are exchanged with the depot as a whole, when the
+ * thread runs out of free buffers or has too many of them.
+ *
+ * The physical memory of the buffers that have been lying in the
+ * depot for a while is discarded with madvise(MADV_DONTNEED) by
+ * trimIdleMemory(). When all the buffers of a slab are discarded
+ * this way, the slab itself is returned to the system, unless it
+ * is one of the few free slabs kept for reuse.
+ *
+ * Buffers of all the other sizes are allocated with malloc().
+ *
+ * allocate() never returns null: if the system refuses to give
+ * more memory, the application is aborted with qFatal().
+ */
+class KRITAIMAGE_EXPORT KisTileMemoryArena
+{
+public:
+    struct Statistics {
+        qint64 reservedSize = 0; ///< the size of all the slabs
+        qint64 depotSize = 0; ///< free buffers in the depots
+        qint64 trimmedSize = 0; ///< free buffers with discarded memory
+    };
+
+public:
+    static KisTileMemoryArena* instance();
+
+    quint8* allocate(qint32 pixelSize);
+    void release(quint8 *ptr, qint32 pixelSize);
+
+    /**
+     * Discards the physical memory of the free buffers, which have
+     * not been used for a few calls of this method. It is called
+     * periodically by KisTileDataPooler.
+     */
+    void trimIdleMemory();
+
+    /**
+     * Discards the physical memory of all the free buffers in
+     * the depots
+     */
+    void trimAllMemory();
+
+    Statistics statistics();
+
+private:
+    KisTileMemoryArena();
+    ~KisTileMemoryArena();
+    Q_DISABLE_COPY(KisTileMemoryArena)
+
+    struct Private;
+    Private * const m_d;
+};
+
+#endif // KIS_TILE_MEMORY_ARENA_H
@@ -8,6 +8,7 @@
 
 #include <QRect>
 #include <QVector>
+#include <QHash>
 
 #include "kis_tile.h"
 #include "kis_tiled_data_manager.h"
@@ -148,6 +149,8 @@ bool KisTiledDataManager::read(QIODevice *stream)
 
     quint32 numTiles;
     qint32 tilesVersion = LEGACY_VERSION;
+    qint32 tileWidth = KisTileData::WIDTH;
+    qint32 tileHeight = KisTileData::HEIGHT;
 
     if (line[0] == 'V') {
         QList<QByteArray> lineItems = line.split(' ');
@@ -157,7 +160,7 @@ bool KisTiledDataManager::read(QIODevice *stream)
 
         tilesVersion = lineItems.takeFirst().toInt();
 
-        if(!processTilesHeader(stream, numTiles))
+        if(!processTilesHeader(stream, numTiles, tileWidth, tileHeight))
             return false;
     }
     else {
@@ -166,6 +169,7 @@ bool KisTiledDataManager::read(QIODevice *stream)
 
     KisAbstractTileCompressorSP compressor =
         KisTileCompressorFactory::create(tilesVersion);
+    compressor->setStreamTileSize(tileWidth, tileHeight);
 
     bool readSuccess = true;
     for (quint32 i = 0; i < numTiles; i++) {
@@ -206,7 +210,8 @@ bool KisTiledDataManager::writeTilesHeader(KisPaintDeviceWriter &store, quint32
     } while(0)                                                  \
 
 
-bool KisTiledDataManager::processTilesHeader(QIODevice *stream, quint32 &numTiles)
+bool KisTiledDataManager::processTilesHeader(QIODevice *stream, quint32 &numTiles,
+                                             qint32 &tileWidth, qint32 &tileHeight)
 {
     /**
      * We assume that there is only one version of this header
@@ -225,13 +230,20 @@ bool KisTiledDataManager::processTilesHeader(QIODevice *stream, quint32 &numTile
     while(!foundDataMark && stream->canReadLine()) {
         takeOneLine(stream, maxLineLength, keyword, value);
 
+        /**
+         * The file may have been saved by a build with
+         * a different tile size, the compressor will
+         * handle that
+         */
         if (keyword == "TILEWIDTH") {
-            if(value != KisTileData::WIDTH)
+            if(!KisAbstractTileCompressor::isValidStreamTileSize(value, 1))
                 goto wrongString;
+            tileWidth = value;
         }
         else if (keyword == "TILEHEIGHT") {
-            if(value != KisTileData::HEIGHT)
+            if(!KisAbstractTileCompressor::isValidStreamTileSize(1, value))
                 goto wrongString;
+            tileHeight = value;
         }
         else if (keyword == "PIXELSIZE") {
             if((quint32)value != pixelSize())
@@ -263,8 +275,10 @@ wrongString:
 void KisTiledDataManager::purge(const QRect& area)
 {
     QList<KisTileSP> tilesToDelete;
+    QHash<QByteArray, QList<KisTileSP>> uniformTiles;
     {
-        const qint32 tileDataSize = KisTileData::HEIGHT * KisTileData::WIDTH * pixelSize();
+        const qint32 pixelSize = this->pixelSize();
+        const qint32 tileDataSize = KisTileData::HEIGHT * KisTileData::WIDTH * pixelSize;
         KisTileData *tileData = m_hashTable->refAndFetchDefaultTileData();
         tileData->blockSwapping();
         const quint8 *defaultData = tileData->data();
@@ -277,6 +291,11 @@ void KisTiledDataManager::purge(const QRect& area)
                 tile->lockForRead();
                 if(memcmp(defaultData, tile->data(), tileDataSize) == 0) {
                     tilesToDelete.push_back(tile);
+                } else if (!(tile->tileData()->isUniform() && tile->tileData()->numUsers() > 1) &&
+                           isUniformData(tile->data(), tileDataSize, pixelSize)) {
+
+                    const QByteArray pixel((const char*)tile->data(), pixelSize);
+                    uniformTiles[pixel].push_back(tile);
                 }
                 tile->unlockForRead();
             }
@@ -291,6 +310,42 @@ void KisTiledDataManager::purge(const QRect& area)
             m_extentManager.notifyTileRemoved(tile->col(), tile->row());
         }
     }
+
+    /**
+     * The tiles filled with the same color are collapsed into
+     * a single tile data shared via copy-on-write. There is no
+     * point in doing that for a lonely tile.
+     */
+    for (auto it = uniformTiles.constBegin(); it != uniformTiles.constEnd(); ++it) {
+        if (it.value().size() < 2) continue;
+
+        KisTileData *td =
+            KisTileDataStore::instance()->createDefaultTileData(pixelSize(), (const quint8*)it.key().constData());
+        td->acquire();
+
+        Q_FOREACH (KisTileSP tile, it.value()) {
+            if (m_hashTable->deleteTile(tile)) {
+                m_extentManager.notifyTileRemoved(tile->col(), tile->row());
+
+                KisTileSP uniformTile = KisTileSP(new KisTile(tile->col(), tile->row(), td, m_mementoManager));
+                m_hashTable->addTile(uniformTile);
+                m_extentManager.notifyTileAdded(tile->col(), tile->row());
+            }
+        }
+
+        td->release();
+    }
+}
+
+bool KisTiledDataManager::isUniformData(const quint8 *data, qint32 dataSize, qint32 pixelSize)
+{
+    for (qint32 i = pixelSize; i < dataSize; i += pixelSize) {
+        if (memcmp(data, data + i, pixelSize) != 0) {
+            return false;
+        }
+    }
+
+    return true;
 }
 
 quint8* KisTiledDataManager::duplicatePixel(qint32 num, const quint8 *pixel)
@@ -675,6 +730,59 @@ KisRegion KisTiledDataManager::region() const
     return KisRegion(std::move(rects));
 }
 
+QVector<KisTileSP> KisTiledDataManager::tiles() const
+{
+    QVector<KisTileSP> result;
+    result.reserve(m_hashTable->numTiles());
+
+    KisTileHashTableConstIterator iter(m_hashTable);
+    KisTileSP tile;
+
+    while ((tile = iter.tile())) {
+        result << tile;
+        iter.next();
+    }
+
+    return result;
+}
+
+void KisTiledDataManager::prefetchRect(const QRect &rect)
+{
+    KisTileDataStore *store = KisTileDataStore::instance();
+    if (rect.isEmpty() || !store->hasSwappedTiles()) return;
+
+    /**
+     * The prefetcher's queue is bounded anyway, so there is no
+     * reason to scan the hash table further. The rest of the
+     * tiles will be requested by the iterators' read-ahead.
+     */
+    const int maxTiles = 256;
+
+    const qint32 firstColumn = xToCol(rect.left());
+    const qint32 lastColumn = xToCol(rect.right());
+    const qint32 firstRow = yToRow(rect.top());
+    const qint32 lastRow = yToRow(rect.bottom());
+
+    QVector<KisTileSP> tiles;
+
+    for (qint32 row = firstRow; row <= lastRow; ++row) {
+        for (qint32 column = firstColumn; column <= lastColumn; ++column) {
+            KisTileSP tile = m_hashTable->getExistingTile(column, row);
+
+            // the check is racy, but it is only a hint for the prefetcher
+            if (tile && !tile->data()) {
+                tiles.append(tile);
+                if (tiles.size() >= maxTiles) goto done;
+            }
+        }
+    }
+
+done:
+    if (!tiles.isEmpty()) {
+        store->prefetchTiles(tiles);
+    }
+}
+
 void KisTiledDataManager::setPixel(qint32 x, qint32 y, const quint8 * data)
 {
     KisTileDataWrapper tw(this, x, y, KisTileDataWrapper::WRITE);
@@ -199,6 +199,10 @@ protected:
     bool write(KisPaintDeviceWriter &store);
     bool read(QIODevice *stream);
 
+    /**
+     * Removes the tiles filled with the default pixel and makes the
+     * tiles filled with the same color share a single tile data
+     */
     void purge(const QRect& area);
 
     inline quint32 pixelSize() const {
@@ -216,6 +220,19 @@ public:
 
     KisRegion region() const;
 
+    /**
+     * @return all the tiles of the data manager, in no particular
+     * order. The tiles should be accessed in read-only mode.
+     */
+    QVector<KisTileSP> tiles() const;
+
+    /**
+     * Asks the tile data store to load the swapped-out tiles
+     * covering \p rect in background. The call is cheap when
+     * nothing is swapped out.
+     */
+    void prefetchRect(const QRect &rect);
+
     void clear(QRect clearRect, quint8 clearValue);
     void clear(QRect clearRect, const quint8 *clearPixel);
     void clear(qint32 x, qint32 y, qint32 w, qint32 h, quint8 clearValue);
@@ -358,7 +375,8 @@ private:
     void setDefaultPixelImpl(const quint8 *defPixel);
 
     bool writeTilesHeader(KisPaintDeviceWriter &store, quint32 numTiles);
-    bool processTilesHeader(QIODevice *stream, quint32 &numTiles);
+    bool processTilesHeader(QIODevice *stream, quint32 &numTiles,
+                            qint32 &tileWidth, qint32 &tileHeight);
 
     inline qint32 divideRoundDown(qint32 x, const qint32 y) const
     {
@@ -373,6 +391,7 @@ private:
     void recalculateExtent();
 
     quint8* duplicatePixel(qint32 num, const quint8 *pixel);
+    static bool isUniformData(const quint8 *data, qint32 dataSize, qint32 pixelSize);
 
     template<bool useOldSrcData>
         void bitBltImpl(KisTiledDataManager *srcDM, const QRect &rect);
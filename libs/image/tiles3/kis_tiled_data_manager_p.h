@@ -94,6 +94,8 @@ void KisTiledDataManager::readBytesBody(quint8 *data,
         dataRowStride = pixelSize * width;
     }
 
+    const bool checkSwappedTiles = KisTileDataStore::instance()->hasSwappedTiles();
+
     while (rowsRemaining > 0) {
 
         qint32 dataX = 0;
@@ -112,11 +114,6 @@ void KisTiledDataManager::readBytesBody(quint8 *data,
             qint32 columnsToWork = qMin(numContiguousImageColumns,
                                         columnsRemaining);
 
-            // XXX: Ugly const cast because of the old pixelPtr design copied from tiles1.
-            KisTileDataWrapper tw(const_cast<KisTiledDataManager*>(this), imageX, imageY, KisTileDataWrapper::READ);
-            quint8 *tileIt = tw.data();
-
-
             const qint32 tileRowStride = rowStride(imageX, imageY);
 
             quint8 *dataIt = data +
@@ -124,10 +121,39 @@ void KisTiledDataManager::readBytesBody(quint8 *data,
 
             const qint32 lineSize = columnsToWork * pixelSize;
 
-            for (qint32 row = 0; row < rowsToWork; row++) {
-                memcpy(dataIt, tileIt, lineSize);
-                tileIt += tileRowStride;
-                dataIt += dataRowStride;
+            auto copyRows = [&] (const quint8 *tileIt) {
+                for (qint32 row = 0; row < rowsToWork; row++) {
+                    memcpy(dataIt, tileIt, lineSize);
+                    tileIt += tileRowStride;
+                    dataIt += dataRowStride;
+                }
+            };
+
+            bool dataIsRead = false;
+
+            /**
+             * The tiles stored in the uncompressed tier of the swap
+             * can be read without loading them into memory
+             */
+            if (checkSwappedTiles) {
+                const qint32 tileCol = xToCol(imageX);
+                const qint32 tileRow = yToRow(imageY);
+                KisTileSP tile = m_hashTable->getExistingTile(tileCol, tileRow);
+
+                if (tile && !tile->data()) {
+                    const qint32 offset =
+                        ((imageX - tileCol * KisTileData::WIDTH) +
+                         (imageY - tileRow * KisTileData::HEIGHT) * KisTileData::WIDTH) * pixelSize;
+
+                    dataIsRead = tile->tryReadSwappedData(
+                        [&] (const quint8 *tileData) { copyRows(tileData + offset); });
+                }
+            }
+
+            if (!dataIsRead) {
+                // XXX: Ugly const cast because of the old pixelPtr design copied from tiles1.
+                KisTileDataWrapper tw(const_cast<KisTiledDataManager*>(this), imageX, imageY, KisTileDataWrapper::READ);
+                copyRows(tw.data());
             }
 
             imageX += columnsToWork;
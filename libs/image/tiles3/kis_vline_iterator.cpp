@@ -54,6 +54,8 @@ KisVLineIterator2::KisVLineIterator2(KisDataManager *dataManager, qint32 x, qint
     for (int i = 0; i < m_tilesCacheSize; i++){
         fetchTileDataForCache(m_tilesCache[i], m_column, m_topRow + i);
     }
+    prefetchNextColumn();
+
     m_index = 0;
     switchToTile(m_topInTopmostTile);
 }
@@ -209,6 +211,13 @@ void KisVLineIterator2::preallocateTiles()
         unlockOldTile(m_tilesCache[i].oldtile);
         fetchTileDataForCache(m_tilesCache[i], m_column, m_topRow + i );
     }
+    prefetchNextColumn();
+}
+
+void KisVLineIterator2::prefetchNextColumn()
+{
+    m_dataManager->prefetchRect(QRect((m_column + 1) * KisTileData::WIDTH, m_top,
+                                      KisTileData::WIDTH, m_bottom - m_top + 1));
 }
 
 qint32 KisVLineIterator2::x() const
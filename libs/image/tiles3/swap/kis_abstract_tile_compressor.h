@@ -43,6 +43,27 @@ public:
      */
     virtual bool readTile(QIODevice *stream, KisTiledDataManager *dm) = 0;
 
+    /**
+     * Sets the size of the tiles stored in the stream passed to
+     * readTile(). The file might have been saved by a build with a
+     * different tile size, in such a case the tiles are split or
+     * merged while reading.
+     *
+     * \see isValidStreamTileSize()
+     */
+    void setStreamTileSize(qint32 width, qint32 height);
+
+    /**
+     * The biggest tile edge a build can have. The tile size read
+     * from a file is checked against it before allocating anything.
+     */
+    static const qint32 MAX_STREAM_TILE_SIZE = 256;
+
+    static inline bool isValidStreamTileSize(qint32 width, qint32 height) {
+        return width > 0 && width <= MAX_STREAM_TILE_SIZE &&
+            height > 0 && height <= MAX_STREAM_TILE_SIZE;
+    }
+
     /**
      * Compresses a \p tileData and writes it into the \p buffer.
      * The buffer must be at least tileDataBufferSize() bytes long.
@@ -90,6 +111,24 @@ protected:
     inline qint32 pixelSize(KisTiledDataManager *dm) {
         return dm->pixelSize();
     }
+
+    inline bool streamHasNativeTileSize() const {
+        return m_streamTileWidth == KisTileData::WIDTH &&
+            m_streamTileHeight == KisTileData::HEIGHT;
+    }
+
+    /**
+     * Writes the pixels of a stream tile, whose size is not native,
+     * into the data manager. The lock of the data manager is
+     * expected to be held by the caller.
+     */
+    inline void writeStreamTile(KisTiledDataManager *dm, const quint8 *data, qint32 x, qint32 y) {
+        dm->writeBytesBody(data, x, y, m_streamTileWidth, m_streamTileHeight);
+    }
+
+protected:
+    qint32 m_streamTileWidth;
+    qint32 m_streamTileHeight;
 };
 
 #endif /* __KIS_ABSTRACT_TILE_COMPRESSOR_H */
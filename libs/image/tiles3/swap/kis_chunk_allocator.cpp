@@ -7,111 +7,210 @@
 #include "kis_debug.h"
 #include "kis_chunk_allocator.h"
 
+#include <QElapsedTimer>
 
-#define GAP_SIZE(low, high) ((high) - (low) > 0 ? (high) - (low) - 1 : 0)
-
-#define HAS_NEXT(list,iter) ((iter)!=(list).end())
-#define HAS_PREVIOUS(list,iter) ((iter)!=(list).begin())
-
-#define PEEK_NEXT(iter) (*(iter))
-#define PEEK_PREVIOUS(iter) (*((iter)-1))
-#define WRAP_PREVIOUS_CHUNK_DATA(iter) (KisChunk((iter)-1))
+/**
+ * The number of free extents tryRelocateChunk() checks before giving
+ * up. It limits the time the caller holds the swap lock.
+ */
+#define MAX_RELOCATION_LOOKUP_STEPS 64
 
 
-KisChunkAllocator::KisChunkAllocator(quint64 slabSize, quint64 storeSize)
+KisChunkAllocator::KisChunkAllocator(quint64 slabSize, quint64 storeSize,
+                                     QAtomicInteger<qint64> *totalStoreSize)
 {
     m_storeMaxSize = storeSize;
     m_storeSlabSize = slabSize;
+    m_totalStoreSize = totalStoreSize;
 
-    m_iterator = m_list.begin();
     m_storeSize = m_storeSlabSize;
+
+    if (m_totalStoreSize) {
+        m_totalStoreSize->fetchAndAddOrdered(qint64(m_storeSize));
+    }
+
+    m_numChunks = 0;
+    m_allocatedSize = 0;
+    m_freeSize = 0;
+
+    insertFreeExtent(0, m_storeSize);
     INIT_FAIL_COUNTER();
 }
 
 KisChunkAllocator::~KisChunkAllocator()
 {
+    if (m_totalStoreSize) {
+        m_totalStoreSize->fetchAndAddOrdered(-qint64(m_storeSize));
+    }
 }
 
 KisChunk KisChunkAllocator::getChunk(quint64 size)
 {
-    KisChunkDataListIterator startPosition = m_iterator;
-    START_COUNTING();
+    QElapsedTimer timer;
+    timer.start();
 
-    forever {
-        if(tryInsertChunk(m_list, m_iterator, size))
-            return WRAP_PREVIOUS_CHUNK_DATA(m_iterator);
+    FreeExtentsBySize::iterator it =
+        m_freeBySize.lower_bound(std::make_pair(size, quint64(0)));
 
-        if(m_iterator == m_list.end())
-            break;
+    while (it == m_freeBySize.end()) {
+        REGISTER_FAIL();
 
-        m_iterator++;
-        REGISTER_STEP();
+        if (!growStore()) {
+            qFatal("KisChunkAllocator: out of swap space");
+        }
+
+        it = m_freeBySize.lower_bound(std::make_pair(size, quint64(0)));
     }
 
-    REGISTER_FAIL();
-    m_iterator = m_list.begin();
+    KisChunk chunk = allocateFromExtent(m_freeByOffset.find(it->second), size);
 
-    forever {
-        if(tryInsertChunk(m_list, m_iterator, size))
-            return WRAP_PREVIOUS_CHUNK_DATA(m_iterator);
+    const quint64 elapsed = timer.nsecsElapsed();
+    m_statistics.numAllocations++;
+    m_statistics.totalAllocationTime += elapsed;
+    m_statistics.maxAllocationTime = qMax(m_statistics.maxAllocationTime, elapsed);
 
-        if(m_iterator == m_list.end() || m_iterator == startPosition)
-            break;
+    return chunk;
+}
 
-        m_iterator++;
-        REGISTER_STEP();
-    }
+void KisChunkAllocator::freeChunk(KisChunk chunk)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN(!chunk.isNull());
+
+    m_numChunks--;
+    m_allocatedSize -= chunk.size();
+    insertFreeExtent(chunk.begin(), chunk.size());
 
-    REGISTER_FAIL();
-    m_iterator = m_list.end();
+    const quint64 elapsed = timer.nsecsElapsed();
+    m_statistics.numFrees++;
+    m_statistics.totalFreeTime += elapsed;
+    m_statistics.maxFreeTime = qMax(m_statistics.maxFreeTime, elapsed);
+}
+
+bool KisChunkAllocator::tryRelocateChunk(KisChunk chunk, KisChunk *newChunk)
+{
+    FreeExtentsBySize::iterator it =
+        m_freeBySize.lower_bound(std::make_pair(chunk.size(), quint64(0)));
 
-    while ((m_storeSize += m_storeSlabSize) <= m_storeMaxSize) {
-        if(tryInsertChunk(m_list, m_iterator, size))
-            return WRAP_PREVIOUS_CHUNK_DATA(m_iterator);
+    for (int i = 0; it != m_freeBySize.end() && i < MAX_RELOCATION_LOOKUP_STEPS; ++it, ++i) {
+        if (it->second < chunk.begin()) {
+            *newChunk = allocateFromExtent(m_freeByOffset.find(it->second), chunk.size());
+            return true;
+        }
     }
 
-    qFatal("KisChunkAllocator: out of swap space");
+    return false;
+}
+
+quint64 KisChunkAllocator::usedStoreSize() const
+{
+    return m_storeSize - tailFreeSize();
+}
+
+qreal KisChunkAllocator::fragmentation() const
+{
+    const quint64 tailSize = tailFreeSize();
+    const quint64 usedSize = m_storeSize - tailSize;
 
-    // just let gcc be happy! :)
-    return KisChunk(m_list.end());
+    return usedSize ? qreal(m_freeSize - tailSize) / usedSize : 0.0;
 }
 
-bool KisChunkAllocator::tryInsertChunk(KisChunkDataList &list,
-                                       KisChunkDataListIterator &iterator,
-                                       quint64 size)
+KisChunkAllocator::Statistics KisChunkAllocator::statistics() const
 {
-    bool result = false;
-    quint64 highBound = m_storeSize;
-    quint64 lowBound = 0;
-    quint64 shift = 0;
+    return m_statistics;
+}
 
-    if(HAS_NEXT(list, iterator))
-        highBound = PEEK_NEXT(iterator).m_begin;
+void KisChunkAllocator::insertFreeExtent(quint64 begin, quint64 size)
+{
+    FreeExtentsByOffset::iterator next = m_freeByOffset.lower_bound(begin);
 
-    if(HAS_PREVIOUS(list, iterator)) {
-        lowBound = PEEK_PREVIOUS(iterator).m_end;
-        shift = 1;
+    if (next != m_freeByOffset.end() && begin + size == next->first) {
+        size += next->second;
+        FreeExtentsByOffset::iterator it = next++;
+        eraseFreeExtent(it);
     }
 
-    if(GAP_SIZE(lowBound, highBound) >= size) {
-        list.insert(iterator, KisChunkData(lowBound + shift, size));
-        result = true;
+    if (next != m_freeByOffset.begin()) {
+        FreeExtentsByOffset::iterator prev = next;
+        --prev;
+
+        KIS_SAFE_ASSERT_RECOVER_NOOP(prev->first + prev->second <= begin);
+
+        if (prev->first + prev->second == begin) {
+            begin = prev->first;
+            size += prev->second;
+            eraseFreeExtent(prev);
+        }
     }
 
-    return result;
+    m_freeByOffset.insert(std::make_pair(begin, size));
+    m_freeBySize.insert(std::make_pair(size, begin));
+    m_freeSize += size;
 }
 
-void KisChunkAllocator::freeChunk(KisChunk chunk)
+void KisChunkAllocator::eraseFreeExtent(FreeExtentsByOffset::iterator it)
+{
+    m_freeSize -= it->second;
+    m_freeBySize.erase(std::make_pair(it->second, it->first));
+    m_freeByOffset.erase(it);
+}
+
+KisChunk KisChunkAllocator::allocateFromExtent(FreeExtentsByOffset::iterator it, quint64 size)
+{
+    const quint64 begin = it->first;
+    const quint64 extentSize = it->second;
+
+    KIS_ASSERT_RECOVER_NOOP(extentSize >= size);
+
+    eraseFreeExtent(it);
+
+    if (extentSize > size) {
+        // the tail of the extent cannot have free neighbours,
+        // so we can skip the coalescing step
+        m_freeByOffset.insert(std::make_pair(begin + size, extentSize - size));
+        m_freeBySize.insert(std::make_pair(extentSize - size, begin + size));
+        m_freeSize += extentSize - size;
+    }
+
+    m_numChunks++;
+    m_allocatedSize += size;
+
+    return KisChunk(KisChunkData(begin, size));
+}
+
+bool KisChunkAllocator::growStore()
 {
-    if(m_iterator != m_list.end() && m_iterator == chunk.position()) {
-        m_iterator = m_list.erase(m_iterator);
-        return;
+    if (m_totalStoreSize) {
+        qint64 totalSize = m_totalStoreSize->loadAcquire();
+
+        do {
+            if (quint64(totalSize) + m_storeSlabSize > m_storeMaxSize) {
+                return false;
+            }
+        } while (!m_totalStoreSize->testAndSetOrdered(totalSize, totalSize + qint64(m_storeSlabSize), totalSize));
+
+    } else if (m_storeSize + m_storeSlabSize > m_storeMaxSize) {
+        return false;
     }
 
-    Q_ASSERT(chunk.position()->m_begin == chunk.begin());
-    m_list.erase(chunk.position());
+    const quint64 oldSize = m_storeSize;
+    m_storeSize += m_storeSlabSize;
+    insertFreeExtent(oldSize, m_storeSlabSize);
+
+    return true;
 }
 
+quint64 KisChunkAllocator::tailFreeSize() const
+{
+    if (m_freeByOffset.empty()) return 0;
+
+    FreeExtentsByOffset::const_iterator last = m_freeByOffset.end();
+    --last;
+
+    return last->first + last->second == m_storeSize ? last->second : 0;
+}
 
 
 /**************************************************************/
@@ -122,34 +221,57 @@ void KisChunkAllocator::freeChunk(KisChunk chunk)
 void KisChunkAllocator::debugChunks()
 {
     quint64 idx = 0;
-    KisChunkDataListIterator i;
+    FreeExtentsByOffset::const_iterator i;
 
-    for(i = m_list.begin(); i != m_list.end(); ++i) {
-        qInfo("chunk #%lld: [%lld %lld]", idx++, i->m_begin, i->m_end);
+    qInfo("allocated chunks: %lld", m_numChunks);
+
+    for(i = m_freeByOffset.begin(); i != m_freeByOffset.end(); ++i) {
+        qInfo("free extent #%lld: [%lld %lld]", idx++, i->first, i->first + i->second - 1);
     }
 }
 
 bool KisChunkAllocator::sanityCheck(bool pleaseCrash)
 {
     bool failed = false;
-    KisChunkDataListIterator i;
-
-    for(i = m_list.begin(); i != m_list.end(); ++i) {
-        if(HAS_PREVIOUS(m_list, i)) {
-            if(PEEK_PREVIOUS(i).m_end >= i->m_begin) {
-                qWarning("Chunks overlapped: [%lld %lld], [%lld %lld]", PEEK_PREVIOUS(i).m_begin, PEEK_PREVIOUS(i).m_end, i->m_begin, i->m_end);
+    quint64 freeSize = 0;
+    FreeExtentsByOffset::const_iterator i;
+    FreeExtentsByOffset::const_iterator prev = m_freeByOffset.end();
+
+    for(i = m_freeByOffset.begin(); i != m_freeByOffset.end(); ++i) {
+        if (prev != m_freeByOffset.end()) {
+            if(prev->first + prev->second >= i->first) {
+                qWarning("Free extents overlapped or not coalesced: [%lld %lld], [%lld %lld]",
+                         prev->first, prev->first + prev->second - 1,
+                         i->first, i->first + i->second - 1);
                 failed = true;
                 break;
             }
         }
-    }
 
-    i = m_list.end();
-    if(HAS_PREVIOUS(m_list, i)) {
-        if(PEEK_PREVIOUS(i).m_end >= m_storeSize) {
-            warnKrita << "Last chunk exceeds the store size!";
+        if (!m_freeBySize.count(std::make_pair(i->second, i->first))) {
+            qWarning("Free extent is not present in the size index: [%lld %lld]",
+                     i->first, i->first + i->second - 1);
             failed = true;
+            break;
         }
+
+        freeSize += i->second;
+        prev = i;
+    }
+
+    if (m_freeBySize.size() != m_freeByOffset.size()) {
+        warnKrita << "Free extents indexes are inconsistent!";
+        failed = true;
+    }
+
+    if (prev != m_freeByOffset.end() && prev->first + prev->second > m_storeSize) {
+        warnKrita << "Last free extent exceeds the store size!";
+        failed = true;
+    }
+
+    if (!failed && (freeSize != m_freeSize || m_freeSize + m_allocatedSize != m_storeSize)) {
+        warnKrita << "Store space is leaked!" << ppVar(freeSize) << ppVar(m_freeSize) << ppVar(m_allocatedSize) << ppVar(m_storeSize);
+        failed = true;
     }
 
     if(failed && pleaseCrash)
@@ -160,28 +282,9 @@ bool KisChunkAllocator::sanityCheck(bool pleaseCrash)
 
 qreal KisChunkAllocator::debugFragmentation(bool toStderr)
 {
-    KisChunkDataListIterator i;
-
-    quint64 totalSize = 0;
-    quint64 allocated = 0;
-    quint64 free = 0;
-    qreal fragmentation = 0;
-
-    for(i = m_list.begin(); i != m_list.end(); ++i) {
-        allocated += i->m_end - i->m_begin + 1;
-
-        if(HAS_PREVIOUS(m_list, i))
-            free += GAP_SIZE(PEEK_PREVIOUS(i).m_end, i->m_begin);
-        else
-            free += i->m_begin;
-    }
-
-    i = m_list.end();
-    if(HAS_PREVIOUS(m_list, i))
-        totalSize = PEEK_PREVIOUS(i).m_end + 1;
-
-    if(totalSize)
-        fragmentation = qreal(free) / totalSize;
+    const quint64 totalSize = usedStoreSize();
+    const quint64 free = totalSize - m_allocatedSize;
+    const qreal fragmentation = this->fragmentation();
 
     if(toStderr) {
         qInfo() << "Hard store limit:\t" << m_storeMaxSize;
@@ -189,13 +292,18 @@ qreal KisChunkAllocator::debugFragmentation(bool toStderr)
         qInfo() << "Num slabs:\t\t" << m_storeSize / m_storeSlabSize;
         qInfo() << "Store size:\t\t" << m_storeSize;
         qInfo() << "Total used:\t\t" << totalSize;
-        qInfo() << "Allocated:\t\t" << allocated;
+        qInfo() << "Allocated:\t\t" << m_allocatedSize;
         qInfo() << "Free:\t\t\t" << free;
+        qInfo() << "Free extents:\t\t" << m_freeByOffset.size();
         qInfo() << "Fragmentation:\t\t" << fragmentation;
+        qInfo() << "Allocations:\t\t" << m_statistics.numAllocations
+                << "avg" << (m_statistics.numAllocations ? m_statistics.totalAllocationTime / m_statistics.numAllocations : 0) << "ns"
+                << "max" << m_statistics.maxAllocationTime << "ns";
+        qInfo() << "Frees:\t\t\t" << m_statistics.numFrees
+                << "avg" << (m_statistics.numFrees ? m_statistics.totalFreeTime / m_statistics.numFrees : 0) << "ns"
+                << "max" << m_statistics.maxFreeTime << "ns";
         DEBUG_FAIL_COUNTER();
     }
 
-    Q_ASSERT(totalSize == allocated + free);
-
     return fragmentation;
 }
@@ -7,7 +7,10 @@
 #ifndef __KIS_CHUNK_LIST_H
 #define __KIS_CHUNK_LIST_H
 
-#include <QLinkedList>
+#include <QtGlobal>
+#include <QAtomicInteger>
+#include <map>
+#include <set>
 #include "kritaimage_export.h"
 
 #define MiB (1ULL << 20)
@@ -20,11 +23,8 @@
 
 #ifdef DEBUG_SLAB_FAILS
 
-#define WINDOW_SIZE 2000
 #define DECLARE_FAIL_COUNTER() quint64 __failCount
 #define INIT_FAIL_COUNTER() __failCount = 0
-#define START_COUNTING() quint64 __numSteps = 0
-#define REGISTER_STEP() if(++__numSteps > WINDOW_SIZE) {__numSteps=0; __failCount++;}
 #define REGISTER_FAIL() __failCount++
 #define DEBUG_FAIL_COUNTER() qInfo() << "Slab fail count:\t" << __failCount
 
@@ -32,8 +32,6 @@
 
 #define DECLARE_FAIL_COUNTER()
 #define INIT_FAIL_COUNTER()
-#define START_COUNTING()
-#define REGISTER_STEP()
 #define REGISTER_FAIL()
 #define DEBUG_FAIL_COUNTER()
 
@@ -41,11 +39,6 @@
 
 
 
-class KisChunkData;
-
-typedef QLinkedList<KisChunkData> KisChunkDataList;
-typedef KisChunkDataList::iterator KisChunkDataListIterator;
-
 class KRITAIMAGE_EXPORT KisChunkData
 {
 public:
@@ -81,71 +74,171 @@ public:
 class KRITAIMAGE_EXPORT KisChunk
 {
 public:
-    KisChunk() {}
+    KisChunk()
+        : m_data(0, 0)
+    {
+    }
 
-    KisChunk(KisChunkDataListIterator iterator)
-        : m_iterator(iterator)
+    KisChunk(const KisChunkData &data)
+        : m_data(data)
     {
     }
 
     inline quint64 begin() const {
-        return m_iterator->m_begin;
+        return m_data.m_begin;
     }
 
     inline quint64 end() const {
-        return m_iterator->m_end;
+        return m_data.m_end;
     }
 
     inline quint64 size() const {
-        return m_iterator->size();
+        return m_data.size();
     }
 
-    inline KisChunkDataListIterator position() {
-        return m_iterator;
+    inline bool isNull() const {
+        return !size();
     }
 
-    inline const KisChunkData& data() {
-        return *m_iterator;
+    inline const KisChunkData& data() const {
+        return m_data;
     }
 
 private:
-    KisChunkDataListIterator m_iterator;
+    KisChunkData m_data;
 };
 
 
+/**
+ * Manages the layout of the swap file.
+ *
+ * The allocator does not keep the list of the allocated chunks at
+ * all. Instead, it keeps an index of free extents of the store,
+ * sorted both by offset and by size. Allocation is done in a best-fit
+ * manner (the smallest free extent that can hold the chunk wins) and
+ * freed chunks are coalesced with their free neighbours immediately,
+ * so both operations are O(log(N)) of the number of free extents.
+ *
+ * The free space at the end of the store is represented by a usual
+ * free extent, so growing the store by a slab just extends (or
+ * creates) the last extent.
+ *
+ * Several allocators may share the same store size limit. In such a
+ * case, they are passed a common counter of the total size of their
+ * stores, and a store can grow while the sum stays within the limit.
+ */
 class KRITAIMAGE_EXPORT KisChunkAllocator
 {
 public:
+    struct Statistics {
+        Statistics()
+            : numAllocations(0),
+              numFrees(0),
+              totalAllocationTime(0),
+              maxAllocationTime(0),
+              totalFreeTime(0),
+              maxFreeTime(0)
+        {
+        }
+
+        quint64 numAllocations;
+        quint64 numFrees;
+
+        /// all the times are measured in nanoseconds
+        quint64 totalAllocationTime;
+        quint64 maxAllocationTime;
+        quint64 totalFreeTime;
+        quint64 maxFreeTime;
+    };
+
+public:
+    /**
+     * \param storeSize the maximum size of the store, or of all the
+     *                  stores sharing \p totalStoreSize
+     * \param totalStoreSize if not null, the counter of the total size
+     *                       of the stores sharing the limit
+     */
     KisChunkAllocator(quint64 slabSize = DEFAULT_SLAB_SIZE,
-                      quint64 storeSize = DEFAULT_STORE_SIZE);
+                      quint64 storeSize = DEFAULT_STORE_SIZE,
+                      QAtomicInteger<qint64> *totalStoreSize = nullptr);
     ~KisChunkAllocator();
 
     inline quint64 numChunks() const {
-        return m_list.size();
+        return m_numChunks;
     }
 
     KisChunk getChunk(quint64 size);
     void freeChunk(KisChunk chunk);
 
+    /**
+     * Tries to find a free extent for the data of \p chunk, which is
+     * located closer to the beginning of the store than the chunk
+     * itself. On success, a new chunk is allocated there and returned
+     * in \p newChunk. The original chunk is *not* freed, the caller
+     * should copy the data and free it manually.
+     */
+    bool tryRelocateChunk(KisChunk chunk, KisChunk *newChunk);
+
+    /**
+     * The amount of space that has been reserved for the store
+     */
+    inline quint64 storeSize() const {
+        return m_storeSize;
+    }
+
+    /**
+     * The offset of the end of the last allocated chunk, that is
+     * the amount of the store that is actually in use
+     */
+    quint64 usedStoreSize() const;
+
+    /**
+     * The amount of space in the allocated chunks
+     */
+    inline quint64 allocatedSize() const {
+        return m_allocatedSize;
+    }
+
+    /**
+     * A ratio of the free space lying between the allocated chunks
+     * to the used size of the store. The value is calculated in O(1).
+     */
+    qreal fragmentation() const;
+
+    Statistics statistics() const;
+
     void debugChunks();
     bool sanityCheck(bool pleaseCrash = true);
     qreal debugFragmentation(bool toStderr = true);
 
 private:
-    bool tryInsertChunk(KisChunkDataList &list,
-                        KisChunkDataListIterator &iterator,
-                        quint64 size);
+    typedef std::map<quint64, quint64> FreeExtentsByOffset;
+    typedef std::set<std::pair<quint64, quint64>> FreeExtentsBySize;
+
+    void insertFreeExtent(quint64 begin, quint64 size);
+    void eraseFreeExtent(FreeExtentsByOffset::iterator it);
+    KisChunk allocateFromExtent(FreeExtentsByOffset::iterator it, quint64 size);
+    bool growStore();
+    quint64 tailFreeSize() const;
 
 private:
     quint64 m_storeMaxSize;
     quint64 m_storeSlabSize;
+    quint64 m_storeSize;
+    QAtomicInteger<qint64> *m_totalStoreSize;
 
+    /// begin -> size
+    FreeExtentsByOffset m_freeByOffset;
 
-    KisChunkDataList m_list;
-    KisChunkDataListIterator m_iterator;
-    quint64 m_storeSize;
+    /// (size, begin)
+    FreeExtentsBySize m_freeBySize;
+
+    quint64 m_numChunks;
+    quint64 m_allocatedSize;
+    quint64 m_freeSize;
+
+    Statistics m_statistics;
     DECLARE_FAIL_COUNTER()
 };
 
 #endif /* __KIS_CHUNK_ALLOCATOR_H */
-
@@ -0,0 +1,163 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_compressed_history_store.h"
+
+#include <QAtomicInteger>
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include "kis_image_config.h"
+#include "kis_assert.h"
+#include "tiles3/kis_tile_data.h"
+
+#include "kis_tile_compressor_factory.h"
+
+/**
+ * The data is stored only if the compression saves
+ * at least 1/N of the memory
+ */
+#define MIN_COMPRESSION_GAIN 4
+
+
+struct Q_DECL_HIDDEN KisCompressedHistoryStore::Private
+{
+    Private()
+        : compressor(createCompressor())
+    {
+        readConfig();
+    }
+
+    static KisAbstractTileCompressorSP createCompressor() {
+        /**
+         * The history is decompressed right in the painting threads,
+         * so prefer the fastest codec over the best ratio
+         */
+        const QString compressionId =
+            KisTileCompressorFactory::availableSwapCompressions().contains("LZ4") ?
+            "LZ4" : KisTileCompressorFactory::defaultSwapCompression();
+
+        return KisTileCompressorFactory::createForSwap(compressionId);
+    }
+
+    void readConfig() {
+        KisImageConfig config(true);
+        limit = qint64(config.historyCompressionLimit()) * MiB;
+    }
+
+    QMutex lock;
+    KisAbstractTileCompressorSP compressor;
+    QByteArray buffer;
+    QHash<KisTileData*, QByteArray> compressedData;
+
+    QAtomicInteger<qint64> numTiles {0};
+    QAtomicInteger<qint64> compressedSize {0};
+    QAtomicInteger<qint64> originalSize {0};
+    qint64 limit = 0;
+};
+
+KisCompressedHistoryStore::KisCompressedHistoryStore()
+    : m_d(new Private())
+{
+}
+
+KisCompressedHistoryStore::~KisCompressedHistoryStore()
+{
+    delete m_d;
+}
+
+bool KisCompressedHistoryStore::tryCompressTileData(KisTileData *td)
+{
+    Q_ASSERT(td->data());
+
+    if (m_d->compressedSize.loadAcquire() >= m_d->limit) return false;
+
+    QMutexLocker locker(&m_d->lock);
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(!m_d->compressedData.contains(td), false);
+
+    const qint32 rawDataSize = td->pixelSize() * KisTileData::WIDTH * KisTileData::HEIGHT;
+
+    const qint32 expectedBufferSize = m_d->compressor->tileDataBufferSize(td);
+    if (m_d->buffer.size() < expectedBufferSize) {
+        m_d->buffer.resize(expectedBufferSize);
+    }
+
+    qint32 bytesWritten = 0;
+    m_d->compressor->compressTileData(td, (quint8*) m_d->buffer.data(), m_d->buffer.size(), bytesWritten);
+
+    if (bytesWritten > rawDataSize - rawDataSize / MIN_COMPRESSION_GAIN ||
+        m_d->compressedSize.loadAcquire() + bytesWritten > m_d->limit) {
+
+        return false;
+    }
+
+    m_d->compressedData.insert(td, QByteArray(m_d->buffer.constData(), bytesWritten));
+    td->releaseMemory();
+
+    m_d->numTiles.ref();
+    m_d->compressedSize.fetchAndAddOrdered(bytesWritten);
+    m_d->originalSize.fetchAndAddOrdered(rawDataSize);
+
+    return true;
+}
+
+void KisCompressedHistoryStore::decompressTileData(KisTileData *td)
+{
+    Q_ASSERT(!td->data());
+
+    QMutexLocker locker(&m_d->lock);
+
+    QByteArray data = m_d->compressedData.take(td);
+    KIS_SAFE_ASSERT_RECOVER_RETURN(!data.isEmpty());
+
+    td->allocateMemory();
+    m_d->compressor->decompressTileData((quint8*) data.data(), data.size(), td);
+
+    m_d->numTiles.deref();
+    m_d->compressedSize.fetchAndAddOrdered(-qint64(data.size()));
+    m_d->originalSize.fetchAndAddOrdered(-qint64(td->pixelSize()) * KisTileData::WIDTH * KisTileData::HEIGHT);
+}
+
+void KisCompressedHistoryStore::forgetTileData(KisTileData *td)
+{
+    QMutexLocker locker(&m_d->lock);
+
+    const QByteArray data = m_d->compressedData.take(td);
+    KIS_SAFE_ASSERT_RECOVER_RETURN(!data.isEmpty());
+
+    m_d->numTiles.deref();
+    m_d->compressedSize.fetchAndAddOrdered(-qint64(data.size()));
+    m_d->originalSize.fetchAndAddOrdered(-qint64(td->pixelSize()) * KisTileData::WIDTH * KisTileData::HEIGHT);
+}
+
+qint64 KisCompressedHistoryStore::numTiles() const
+{
+    return m_d->numTiles.loadAcquire();
+}
+
+qint64 KisCompressedHistoryStore::compressedSize() const
+{
+    return m_d->compressedSize.loadAcquire();
+}
+
+qint64 KisCompressedHistoryStore::originalSize() const
+{
+    return m_d->originalSize.loadAcquire();
+}
+
+qint64 KisCompressedHistoryStore::limit() const
+{
+    return m_d->limit;
+}
+
+void KisCompressedHistoryStore::testingRereadConfig()
+{
+    QMutexLocker locker(&m_d->lock);
+    m_d->readConfig();
+}
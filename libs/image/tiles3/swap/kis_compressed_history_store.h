@@ -0,0 +1,88 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_COMPRESSED_HISTORY_STORE_H
+#define __KIS_COMPRESSED_HISTORY_STORE_H
+
+#include "kritaimage_export.h"
+
+#include <QtGlobal>
+
+
+class KisTileData;
+
+/**
+ * Keeps the data of the tiles that are referenced by the undo
+ * history only, compressed in memory with a fast codec (LZ4, when
+ * available). Undo data of the older revisions is rarely needed,
+ * but, unlike swapping, compressing it in memory doesn't make
+ * undo wait for the disk.
+ *
+ * The total size of the compressed data is limited by
+ * KisImageConfig::historyCompressionLimit(). When the limit is
+ * reached, the remaining history stays uncompressed and is handled
+ * by the swapper as usual.
+ *
+ * The tiles, whose data doesn't compress well, are not stored.
+ */
+class KRITAIMAGE_EXPORT KisCompressedHistoryStore
+{
+public:
+    KisCompressedHistoryStore();
+    ~KisCompressedHistoryStore();
+
+    /**
+     * Compresses the data of the \a td and frees memory occupied
+     * by td->data().
+     * LOCKING: the lock on the tile data should be taken
+     *          by the caller before making a call.
+     * \return false if the limit is reached or the data
+     *         doesn't compress well enough
+     */
+    bool tryCompressTileData(KisTileData *td);
+
+    /**
+     * Restores the data of a \a td and drops its compressed copy.
+     * LOCKING: the lock on the tile data should be taken
+     *          by the caller before making a call.
+     */
+    void decompressTileData(KisTileData *td);
+
+    /**
+     * Drops the compressed copy of the \a td
+     * LOCKING: the lock on the tile data should be taken
+     *          by the caller before making a call.
+     */
+    void forgetTileData(KisTileData *td);
+
+    /**
+     * Returns the number of compressed tile data objects
+     */
+    qint64 numTiles() const;
+
+    /**
+     * The memory occupied by the compressed data, in bytes
+     */
+    qint64 compressedSize() const;
+
+    /**
+     * The size of the data before compression, in bytes
+     */
+    qint64 originalSize() const;
+
+    /**
+     * The maximum value of compressedSize(), in bytes
+     */
+    qint64 limit() const;
+
+    void testingRereadConfig();
+
+private:
+    struct Private;
+    Private * const m_d;
+};
+
+#endif /* __KIS_COMPRESSED_HISTORY_STORE_H */
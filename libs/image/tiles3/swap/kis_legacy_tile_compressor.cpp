@@ -45,13 +45,30 @@ bool KisLegacyTileCompressor::readTile(QIODevice *stream, KisTiledDataManager *d
     const qint32 tileDataSize = TILE_DATA_SIZE(pixelSize(dm));
 
     const qint32 bufferSize = maxHeaderLength() + 1;
-    quint8 *headerBuffer = new quint8[bufferSize];
+    QScopedArrayPointer<quint8> headerBuffer(new quint8[bufferSize]);
 
     qint32 x, y;
     qint32 width, height;
 
-    stream->readLine((char *)headerBuffer, bufferSize);
-    sscanf((char *) headerBuffer, "%d,%d,%d,%d", &x, &y, &width, &height);
+    if (stream->readLine((char *)headerBuffer.data(), bufferSize) <= 0 ||
+        sscanf((char *) headerBuffer.data(), "%d,%d,%d,%d", &x, &y, &width, &height) != 4) {
+
+        return false;
+    }
+
+    if (width != KisTileData::WIDTH || height != KisTileData::HEIGHT) {
+        if (!isValidStreamTileSize(width, height)) {
+            warnFile << "Wrong size of the legacy tile:" << width << height;
+            return false;
+        }
+
+        QByteArray buffer(pixelSize(dm) * width * height, Qt::Uninitialized);
+        if (stream->read(buffer.data(), buffer.size()) != buffer.size()) return false;
+
+        setStreamTileSize(width, height);
+        writeStreamTile(dm, (const quint8*)buffer.constData(), x, y);
+        return true;
+    }
 
     qint32 row = yToRow(dm, y);
     qint32 col = xToCol(dm, x);
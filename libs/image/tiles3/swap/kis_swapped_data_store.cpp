@@ -5,49 +5,152 @@
  */
 
 #include <QMutexLocker>
+#include <QByteArray>
+#include <QThread>
+#include <QHash>
+#include <QSet>
+
+#include <map>
+
 //#include "kis_debug.h"
 #include "kis_swapped_data_store.h"
 #include "kis_memory_window.h"
 #include "kis_image_config.h"
+#include "kis_assert.h"
+
+#include "kis_tile_compressor_factory.h"
+
+/**
+ * The swap file is compacted when the free holes between the chunks
+ * take more than this share of the used part of the file...
+ */
+#define COMPACTION_FRAGMENTATION_THRESHOLD 0.25
+
+/**
+ * ...and the holes are big enough to be worth the effort
+ */
+#define COMPACTION_MIN_FREE_SPACE (4 * MiB)
+
+/**
+ * The uncompressed tier may take up to 1/N of the maximum swap size
+ */
+#define UNCOMPRESSED_TIER_SHARE 4
+
+/**
+ * The mapping window of a shard is never made smaller than that
+ */
+#define MIN_WINDOW_SIZE (1 * MiB)
+
+const int KisSwappedDataStore::MAX_SHARDS = 8;
+
+
+struct Q_DECL_HIDDEN KisSwappedDataStore::SwappedChunk
+{
+    KisChunk chunk;
+    uint hash = 0;
+    bool isUncompressed = false;
+    QSet<KisTileData*> users;
+};
+
+struct Q_DECL_HIDDEN KisSwappedDataStore::Shard
+{
+    Shard(KisImageConfig &config, quint64 maxSwapSize, QAtomicInteger<qint64> *totalSwapFileSize, quint64 windowSize)
+        : allocator(config.swapSlabSize() * MiB, maxSwapSize, totalSwapFileSize),
+          swapSpace(config.swapDir(), windowSize),
+          compressor(KisTileCompressorFactory::createForSwap(config.swapCompression()))
+    {
+    }
+
+    QMutex lock;
+
+    KisChunkAllocator allocator;
+    KisMemoryWindow swapSpace;
 
-#include "kis_tile_compressor_2.h"
+    QByteArray buffer;
+    KisSharedPtr<KisAbstractTileCompressor> compressor;
 
-//#define COMPRESSOR_VERSION 2
+    /**
+     * The chunks of the swap file sorted by their offset. A chunk
+     * may be shared by several tile data objects with equal content.
+     */
+    std::map<quint64, SwappedChunk> swappedChunks;
+
+    /**
+     * Maps the hash of the stored bytes to the offset of a chunk
+     * holding them. Only one chunk per hash is indexed, the
+     * collisions are just not deduplicated.
+     */
+    QHash<uint, quint64> chunksByHash;
+};
 
-KisSwappedDataStore::KisSwappedDataStore()
-    : m_totalSwapMemoryUsed(0)
+
+KisSwappedDataStore::KisSwappedDataStore(int numShards)
+    : m_totalSwapFileSize(0),
+      m_numTiles(0),
+      m_totalSwapMemoryUsed(0),
+      m_uncompressedTierSize(0),
+      m_numDeduplicatedTiles(0),
+      m_deduplicatedSize(0)
 {
+    if (numShards <= 0) {
+        /**
+         * The tiles are swapped in by the update threads, so there
+         * is no need to have more shards than there are threads
+         * competing for them
+         */
+        numShards = QThread::idealThreadCount() / 2;
+    }
+    numShards = qBound(1, numShards, MAX_SHARDS);
+
     KisImageConfig config(true);
-    const quint64 maxSwapSize = config.maxSwapSize() * MiB;
-    const quint64 swapSlabSize = config.swapSlabSize() * MiB;
-    const quint64 swapWindowSize = config.swapWindowSize() * MiB;
 
-    m_allocator = new KisChunkAllocator(swapSlabSize, maxSwapSize);
-    m_swapSpace = new KisMemoryWindow(config.swapDir(), swapWindowSize);
+    /**
+     * The swap size limit is common for all the shards, so a busy
+     * shard can take the space the others don't need. The mapped
+     * memory is split between the shards evenly.
+     */
+    const quint64 maxSwapSize = quint64(config.maxSwapSize()) * MiB;
+    const quint64 windowSize =
+        qMax(quint64(config.swapWindowSize()) * MiB / numShards, MIN_WINDOW_SIZE);
+
+    for (int i = 0; i < numShards; i++) {
+        m_shards.append(new Shard(config, maxSwapSize, &m_totalSwapFileSize, windowSize));
+    }
 
-    // FIXME: use a factory after the patch is committed
-    m_compressor = new KisTileCompressor2();
+    m_useUncompressedTier = config.swapUncompressedTier();
+    m_uncompressedTierLimit = qint64(config.maxSwapSize()) * MiB / UNCOMPRESSED_TIER_SHARE;
 }
 
 KisSwappedDataStore::~KisSwappedDataStore()
 {
-    delete m_compressor;
-    delete m_swapSpace;
-    delete m_allocator;
+    qDeleteAll(m_shards);
 }
 
-quint64 KisSwappedDataStore::numTiles() const
+int KisSwappedDataStore::numShards() const
 {
-    // We are not acquiring the lock here...
-    // Hope QLinkedList will ensure atomic access to it's size...
+    return m_shards.size();
+}
 
-    return m_allocator->numChunks();
+inline KisSwappedDataStore::Shard* KisSwappedDataStore::shardForTileData(KisTileData *td) const
+{
+    /**
+     * The tile data objects are aligned in memory, so the lower bits
+     * of the pointer are useless. Mix the bits with a Fibonacci hash.
+     */
+    const quint64 key = (quint64(quintptr(td)) >> 4) * Q_UINT64_C(0x9E3779B97F4A7C15);
+    return m_shards[int((key >> 32) % quint64(m_shards.size()))];
+}
+
+quint64 KisSwappedDataStore::numTiles() const
+{
+    return m_numTiles.loadAcquire();
 }
 
 bool KisSwappedDataStore::trySwapOutTileData(KisTileData *td)
 {
     Q_ASSERT(td->data());
-    QMutexLocker locker(&m_lock);
+    Shard *shard = shardForTileData(td);
+    QMutexLocker locker(&shard->lock);
 
     /**
      * We are expecting that the lock of KisTileData
@@ -55,65 +158,356 @@ bool KisSwappedDataStore::trySwapOutTileData(KisTileData *td)
      * So we can modify the tile data freely.
      */
 
-    const qint32 expectedBufferSize = m_compressor->tileDataBufferSize(td);
-    if(m_buffer.size() < expectedBufferSize)
-        m_buffer.resize(expectedBufferSize);
+    const qint32 rawDataSize = td->pixelSize() * KisTileData::WIDTH * KisTileData::HEIGHT;
+
+    /**
+     * The tiles that were only read since they had been swapped in,
+     * are likely to be read again, so we store them as is
+     */
+    const bool storeUncompressed =
+        m_useUncompressedTier &&
+        td->readOnlySinceSwapIn() &&
+        m_uncompressedTierSize.loadAcquire() + rawDataSize <= m_uncompressedTierLimit;
+
+    const quint8 *srcData = td->data();
+    qint32 bytesWritten = rawDataSize;
+
+    if (!storeUncompressed) {
+        const qint32 expectedBufferSize = shard->compressor->tileDataBufferSize(td);
+        if(shard->buffer.size() < expectedBufferSize)
+            shard->buffer.resize(expectedBufferSize);
+
+        shard->compressor->compressTileData(td, (quint8*) shard->buffer.data(), shard->buffer.size(), bytesWritten);
+        srcData = (const quint8*) shard->buffer.data();
+    }
+
+    /**
+     * Flat fills, transparent areas and the tiles duplicated
+     * by the history often have exactly the same content, so
+     * they can share a single chunk of the swap file
+     */
+    const uint hash = qHashBits(srcData, bytesWritten, uint(storeUncompressed));
+
+    KisChunk chunk;
+    SwappedChunk *record = findEqualChunk(shard, hash, srcData, bytesWritten, storeUncompressed);
+
+    if (record) {
+        chunk = record->chunk;
 
-    qint32 bytesWritten;
-    m_compressor->compressTileData(td, (quint8*) m_buffer.data(), m_buffer.size(), bytesWritten);
+        m_numDeduplicatedTiles.ref();
+        m_deduplicatedSize.fetchAndAddOrdered(chunk.size());
+    } else {
+        chunk = shard->allocator.getChunk(bytesWritten);
+        quint8 *ptr = shard->swapSpace.getWriteChunkPtr(chunk);
+        if (!ptr) {
+            qWarning() << "swap out of tile failed";
+            shard->allocator.freeChunk(chunk);
+            return false;
+        }
+        memcpy(ptr, srcData, bytesWritten);
 
-    KisChunk chunk = m_allocator->getChunk(bytesWritten);
-    quint8 *ptr = m_swapSpace->getWriteChunkPtr(chunk);
-    if (!ptr) {
-        qWarning() << "swap out of tile failed";
-        return false;
+        record = &shard->swappedChunks[chunk.begin()];
+        record->chunk = chunk;
+        record->hash = hash;
+        record->isUncompressed = storeUncompressed;
+        shard->chunksByHash.insert(hash, chunk.begin());
+
+        if (storeUncompressed) {
+            m_uncompressedTierSize.fetchAndAddOrdered(chunk.size());
+        }
     }
-    memcpy(ptr, m_buffer.data(), bytesWritten);
+
+    record->users.insert(td);
 
     td->releaseMemory();
     td->setSwapChunk(chunk);
+    td->setSwapUncompressed(storeUncompressed);
 
-    m_totalSwapMemoryUsed += chunk.size();
+    m_totalSwapMemoryUsed.fetchAndAddOrdered(chunk.size());
+    m_numTiles.ref();
 
     return true;
 }
 
+KisSwappedDataStore::SwappedChunk*
+KisSwappedDataStore::findEqualChunk(Shard *shard, uint hash, const quint8 *data, qint32 size, bool isUncompressed)
+{
+    QHash<uint, quint64>::const_iterator hashIt = shard->chunksByHash.constFind(hash);
+    if (hashIt == shard->chunksByHash.constEnd()) return 0;
+
+    std::map<quint64, SwappedChunk>::iterator it = shard->swappedChunks.find(*hashIt);
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(it != shard->swappedChunks.end(), 0);
+
+    SwappedChunk &record = it->second;
+    if (record.isUncompressed != isUncompressed ||
+        qint32(record.chunk.size()) != size) {
+
+        return 0;
+    }
+
+    /**
+     * The hash is only a hint, the content is always compared
+     */
+    const quint8 *ptr = shard->swapSpace.getReadChunkPtr(record.chunk);
+    if (!ptr || memcmp(ptr, data, size) != 0) return 0;
+
+    return &record;
+}
+
+void KisSwappedDataStore::detachTileData(Shard *shard, KisTileData *td)
+{
+    const KisChunk chunk = td->swapChunk();
+
+    m_totalSwapMemoryUsed.fetchAndAddOrdered(-qint64(chunk.size()));
+    m_numTiles.deref();
+
+    td->setSwapChunk(KisChunk());
+    td->setSwapUncompressed(false);
+
+    std::map<quint64, SwappedChunk>::iterator it = shard->swappedChunks.find(chunk.begin());
+    KIS_SAFE_ASSERT_RECOVER_RETURN(it != shard->swappedChunks.end());
+
+    SwappedChunk &record = it->second;
+    record.users.remove(td);
+
+    if (!record.users.isEmpty()) {
+        m_numDeduplicatedTiles.deref();
+        m_deduplicatedSize.fetchAndAddOrdered(-qint64(chunk.size()));
+        return;
+    }
+
+    if (record.isUncompressed) {
+        m_uncompressedTierSize.fetchAndAddOrdered(-qint64(chunk.size()));
+    }
+
+    QHash<uint, quint64>::iterator hashIt = shard->chunksByHash.find(record.hash);
+    if (hashIt != shard->chunksByHash.end() && *hashIt == chunk.begin()) {
+        shard->chunksByHash.erase(hashIt);
+    }
+
+    shard->swappedChunks.erase(it);
+    shard->allocator.freeChunk(chunk);
+}
+
 void KisSwappedDataStore::swapInTileData(KisTileData *td)
 {
     Q_ASSERT(!td->data());
-    QMutexLocker locker(&m_lock);
+    Shard *shard = shardForTileData(td);
+    QMutexLocker locker(&shard->lock);
 
     // see comment in swapOutTileData()
 
     KisChunk chunk = td->swapChunk();
-    m_totalSwapMemoryUsed -= chunk.size();
 
     td->allocateMemory();
-    td->setSwapChunk(KisChunk());
 
-    quint8 *ptr = m_swapSpace->getReadChunkPtr(chunk);
+    quint8 *ptr = shard->swapSpace.getReadChunkPtr(chunk);
     Q_ASSERT(ptr);
-    m_compressor->decompressTileData(ptr, chunk.size(), td);
-    m_allocator->freeChunk(chunk);
+
+    if (td->swapUncompressed()) {
+        memcpy(td->data(), ptr, chunk.size());
+    } else {
+        shard->compressor->decompressTileData(ptr, chunk.size(), td);
+    }
+
+    detachTileData(shard, td);
+    td->setReadOnlySinceSwapIn(true);
 }
 
-void KisSwappedDataStore::forgetTileData(KisTileData *td)
+bool KisSwappedDataStore::tryReadUncompressedTileData(KisTileData *td, const std::function<void(const quint8*)> &reader)
 {
-    QMutexLocker locker(&m_lock);
+    Shard *shard = shardForTileData(td);
+    QMutexLocker locker(&shard->lock);
 
-    m_totalSwapMemoryUsed -= td->swapChunk().size();
+    if (!td->swapUncompressed()) return false;
 
-    m_allocator->freeChunk(td->swapChunk());
-    td->setSwapChunk(KisChunk());
+    quint8 *ptr = shard->swapSpace.getReadChunkPtr(td->swapChunk());
+    if (!ptr) return false;
+
+    reader(ptr);
+    return true;
+}
+
+void KisSwappedDataStore::forgetTileData(KisTileData *td)
+{
+    Shard *shard = shardForTileData(td);
+    QMutexLocker locker(&shard->lock);
+
+    detachTileData(shard, td);
 }
 
 qint64 KisSwappedDataStore::totalSwapMemoryUsed() const
 {
-    return m_totalSwapMemoryUsed;
+    return m_totalSwapMemoryUsed.loadAcquire();
+}
+
+qint64 KisSwappedDataStore::numDeduplicatedTiles() const
+{
+    return m_numDeduplicatedTiles.loadAcquire();
+}
+
+qint64 KisSwappedDataStore::deduplicatedSize() const
+{
+    return m_deduplicatedSize.loadAcquire();
+}
+
+bool KisSwappedDataStore::needsCompaction()
+{
+    Q_FOREACH (Shard *shard, m_shards) {
+        QMutexLocker locker(&shard->lock);
+
+        const quint64 usedSize = shard->allocator.usedStoreSize();
+        const quint64 holesSize = usedSize - shard->allocator.allocatedSize();
+
+        if (holesSize > COMPACTION_MIN_FREE_SPACE / m_shards.size() &&
+            shard->allocator.fragmentation() > COMPACTION_FRAGMENTATION_THRESHOLD) {
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+qint32 KisSwappedDataStore::compactSwap(qint32 maxRelocations)
+{
+    qint32 numRelocated = 0;
+
+    Q_FOREACH (Shard *shard, m_shards) {
+        if (numRelocated >= maxRelocations) break;
+        numRelocated += compactShard(shard, maxRelocations - numRelocated);
+    }
+
+    return numRelocated;
+}
+
+qint32 KisSwappedDataStore::compactShard(Shard *shard, qint32 maxRelocations)
+{
+    QMutexLocker locker(&shard->lock);
+
+    /**
+     * All the accesses to td->swapChunk() happen under the lock of
+     * its shard, so we can relocate the chunks without taking the
+     * tile data locks. The tile data cannot be deleted while we hold
+     * the lock either, since forgetTileData() needs it.
+     */
+
+    KisChunkAllocator &allocator = shard->allocator;
+    std::map<quint64, SwappedChunk> &swappedChunks = shard->swappedChunks;
+
+    qint32 numRelocated = 0;
+
+    while (numRelocated < maxRelocations &&
+           !swappedChunks.empty() &&
+           allocator.fragmentation() > COMPACTION_FRAGMENTATION_THRESHOLD) {
+
+        std::map<quint64, SwappedChunk>::iterator it = swappedChunks.end();
+        --it;
+
+        const KisChunk oldChunk = it->second.chunk;
+        KisChunk newChunk;
+
+        if (!allocator.tryRelocateChunk(oldChunk, &newChunk)) break;
+
+        if (shard->buffer.size() < qint32(oldChunk.size())) {
+            shard->buffer.resize(oldChunk.size());
+        }
+
+        /**
+         * The read and write windows may be remapped independently
+         * (e.g. on Windows), so we copy the data via a buffer
+         */
+        quint8 *readPtr = shard->swapSpace.getReadChunkPtr(oldChunk);
+        if (readPtr) {
+            memcpy(shard->buffer.data(), readPtr, oldChunk.size());
+        }
+
+        quint8 *writePtr = readPtr ? shard->swapSpace.getWriteChunkPtr(newChunk) : 0;
+        if (!writePtr) {
+            qWarning() << "compaction of the swap file failed";
+            allocator.freeChunk(newChunk);
+            break;
+        }
+
+        memcpy(writePtr, shard->buffer.data(), oldChunk.size());
+
+        SwappedChunk record = it->second;
+        swappedChunks.erase(it);
+        allocator.freeChunk(oldChunk);
+
+        /**
+         * All the users of a shared chunk live in the same shard,
+         * so they are protected by our lock as well
+         */
+        Q_FOREACH (KisTileData *td, record.users) {
+            td->setSwapChunk(newChunk);
+        }
+
+        QHash<uint, quint64>::iterator hashIt = shard->chunksByHash.find(record.hash);
+        if (hashIt != shard->chunksByHash.end() && *hashIt == oldChunk.begin()) {
+            *hashIt = newChunk.begin();
+        }
+
+        record.chunk = newChunk;
+        swappedChunks[newChunk.begin()] = record;
+
+        numRelocated++;
+    }
+
+    return numRelocated;
+}
+
+qint64 KisSwappedDataStore::swapFileSize()
+{
+    qint64 size = 0;
+
+    Q_FOREACH (Shard *shard, m_shards) {
+        QMutexLocker locker(&shard->lock);
+        size += shard->allocator.usedStoreSize();
+    }
+
+    return size;
+}
+
+qreal KisSwappedDataStore::fragmentation()
+{
+    qreal holesSize = 0;
+    qreal usedSize = 0;
+
+    Q_FOREACH (Shard *shard, m_shards) {
+        QMutexLocker locker(&shard->lock);
+
+        const qreal shardUsedSize = shard->allocator.usedStoreSize();
+        holesSize += shard->allocator.fragmentation() * shardUsedSize;
+        usedSize += shardUsedSize;
+    }
+
+    return usedSize > 0 ? holesSize / usedSize : 0.0;
+}
+
+KisChunkAllocator::Statistics KisSwappedDataStore::allocatorStatistics()
+{
+    KisChunkAllocator::Statistics stats;
+
+    Q_FOREACH (Shard *shard, m_shards) {
+        QMutexLocker locker(&shard->lock);
+        const KisChunkAllocator::Statistics shardStats = shard->allocator.statistics();
+
+        stats.numAllocations += shardStats.numAllocations;
+        stats.numFrees += shardStats.numFrees;
+        stats.totalAllocationTime += shardStats.totalAllocationTime;
+        stats.maxAllocationTime = qMax(stats.maxAllocationTime, shardStats.maxAllocationTime);
+        stats.totalFreeTime += shardStats.totalFreeTime;
+        stats.maxFreeTime = qMax(stats.maxFreeTime, shardStats.maxFreeTime);
+    }
+
+    return stats;
 }
 
 void KisSwappedDataStore::debugStatistics()
 {
-    m_allocator->sanityCheck();
-    m_allocator->debugFragmentation();
+    Q_FOREACH (Shard *shard, m_shards) {
+        shard->allocator.sanityCheck();
+        shard->allocator.debugFragmentation();
+    }
 }
@@ -9,22 +9,46 @@
 
 #include "kritaimage_export.h"
 
-#include <QMutex>
-#include <QByteArray>
+#include <QAtomicInteger>
+#include <QVector>
+#include <functional>
+
+#include "kis_chunk_allocator.h"
 
 
-class QMutex;
 class KisTileData;
-class KisAbstractTileCompressor;
-class KisChunkAllocator;
-class KisMemoryWindow;
 
+/**
+ * Stores the data of the swapped-out tiles.
+ *
+ * The store is split into a few independent shards, each having its
+ * own lock, swap file, memory window, compression buffer and chunk
+ * allocator. The shard of a tile data is selected by the hash of its
+ * address, so independent tiles can be swapped in and out by
+ * different threads in parallel. The swap size limit is shared by
+ * all the shards, the mapped memory is split between them.
+ *
+ * The tiles with equal content share the same chunk of the swap
+ * file. The chunks are indexed by the hash of their bytes, and the
+ * deduplication happens within a shard only.
+ *
+ * Optionally, the tiles which were only read since they had been
+ * loaded from swap are stored uncompressed ("uncompressed tier").
+ * Swapping them in does not need decompression, and read-only
+ * users can access them right in the swap file mapping.
+ */
 class KRITAIMAGE_EXPORT KisSwappedDataStore
 {
 public:
-    KisSwappedDataStore();
+    /**
+     * \param numShards the number of shards the store is split into.
+     *                  By default, it depends on the number of CPU cores.
+     */
+    KisSwappedDataStore(int numShards = -1);
     ~KisSwappedDataStore();
 
+    int numShards() const;
+
     /**
      * Returns number of swapped out tile data objects
      */
@@ -46,6 +70,17 @@ public:
      */
     void swapInTileData(KisTileData *td);
 
+    /**
+     * If the data of \a td is stored in the uncompressed tier of
+     * the swap, calls \p reader with a pointer to it right inside
+     * the swap file mapping. The pointer is valid only during the
+     * call. The tile data itself stays swapped out.
+     * LOCKING: the caller should hold the lock on the tile data
+     *          in read mode
+     * \return false if the data is compressed
+     */
+    bool tryReadUncompressedTileData(KisTileData *td, const std::function<void(const quint8*)> &reader);
+
     /**
      * Forget all the information linked with the tile data.
      * This should be done before deleting of the tile data,
@@ -59,21 +94,87 @@ public:
      */
     qint64 totalSwapMemoryUsed() const;
 
+    /**
+     * The number of swapped-out tile data objects sharing their
+     * chunk with some other tile data
+     */
+    qint64 numDeduplicatedTiles() const;
+
+    /**
+     * The size of the swap file saved by sharing the chunks
+     */
+    qint64 deduplicatedSize() const;
+
+    /**
+     * Returns true if the free space between the swapped chunks
+     * has become too big and the swap file should be compacted
+     */
+    bool needsCompaction();
+
+    /**
+     * Moves the data of the tiles lying at the end of the swap file
+     * into the free holes closer to its beginning. The process stops
+     * when the fragmentation drops below the threshold or when
+     * \p maxRelocations tiles have been moved.
+     *
+     * The lock of the shard being compacted is held during the whole
+     * operation, so the number of relocations per call should be
+     * kept small.
+     *
+     * \return the number of relocated tiles
+     */
+    qint32 compactSwap(qint32 maxRelocations = 64);
+
+    /**
+     * Returns the size of the part of the swap file that is
+     * actually in use (compressed size)
+     */
+    qint64 swapFileSize();
+
+    /**
+     * The fragmentation of all the shards taken together
+     * \see KisChunkAllocator::fragmentation()
+     */
+    qreal fragmentation();
+
+    /**
+     * Statistics of the allocators of all the shards merged together
+     */
+    KisChunkAllocator::Statistics allocatorStatistics();
+
     /**
      * Some debugging output
      */
     void debugStatistics();
 
 private:
-    QByteArray m_buffer;
-    KisAbstractTileCompressor *m_compressor;
+    struct Shard;
+    struct SwappedChunk;
+    inline Shard* shardForTileData(KisTileData *td) const;
+    static SwappedChunk* findEqualChunk(Shard *shard, uint hash, const quint8 *data, qint32 size, bool isUncompressed);
+    void detachTileData(Shard *shard, KisTileData *td);
+    static qint32 compactShard(Shard *shard, qint32 maxRelocations);
+
+private:
+    static const int MAX_SHARDS;
+
+    /**
+     * The total size of the swap files of all the shards,
+     * \see KisChunkAllocator::storeSize()
+     */
+    QAtomicInteger<qint64> m_totalSwapFileSize;
+
+    QVector<Shard*> m_shards;
 
-    KisChunkAllocator *m_allocator;
-    KisMemoryWindow *m_swapSpace;
+    QAtomicInt m_numTiles;
+    QAtomicInteger<qint64> m_totalSwapMemoryUsed;
 
-    QMutex m_lock;
+    bool m_useUncompressedTier;
+    qint64 m_uncompressedTierLimit;
+    QAtomicInteger<qint64> m_uncompressedTierSize;
 
-    qint64 m_totalSwapMemoryUsed;
+    QAtomicInt m_numDeduplicatedTiles;
+    QAtomicInteger<qint64> m_deduplicatedSize;
 };
 
 #endif /* __KIS_SWAPPED_DATA_STORE_H */
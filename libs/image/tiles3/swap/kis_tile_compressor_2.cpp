@@ -10,12 +10,17 @@
 #include "kis_paint_device_writer.h"
 #define TILE_DATA_SIZE(pixelSize) ((pixelSize) * KisTileData::WIDTH * KisTileData::HEIGHT)
 
-const QString KisTileCompressor2::m_compressionName = "LZF";
-
 
 KisTileCompressor2::KisTileCompressor2()
+    : m_compression(new KisLzfCompression()),
+      m_compressionName("LZF")
+{
+}
+
+KisTileCompressor2::KisTileCompressor2(KisAbstractCompression *compression, const QString &compressionName)
+    : m_compression(compression),
+      m_compressionName(compressionName)
 {
-    m_compression = new KisLzfCompression();
 }
 
 KisTileCompressor2::~KisTileCompressor2()
@@ -65,12 +70,45 @@ bool KisTileCompressor2::readTile(QIODevice *stream, KisTiledDataManager *dm)
         Q_ASSERT(headerItems.isEmpty());
         Q_ASSERT(compressionName == m_compressionName);
 
+        /**
+         * The stream tile size has been checked by the data manager,
+         * so the size of its data fits into 32 bits. The compressed
+         * data is never bigger than the raw one plus the flag byte.
+         */
+        KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(isValidStreamTileSize(m_streamTileWidth, m_streamTileHeight), false);
+        const qint32 streamTileDataSize =
+            qint32(qint64(pixelSize(dm)) * m_streamTileWidth * m_streamTileHeight);
+
+        if (dataSize <= 0 || dataSize > streamTileDataSize + 1) {
+            warnFile << "Wrong size of the tile data:" << dataSize;
+            return false;
+        }
+
+        if (!streamHasNativeTileSize()) {
+            prepareStreamingBuffer(streamTileDataSize);
+            if (stream->read(m_streamingBuffer.data(), dataSize) != dataSize) {
+                warnFile << "Failed to read the tile data";
+                return false;
+            }
+
+            QByteArray pixels(streamTileDataSize, Qt::Uninitialized);
+            bool res = decompressData((quint8*)m_streamingBuffer.data(), dataSize,
+                                      (quint8*)pixels.data(), streamTileDataSize, pixelSize(dm));
+            if (res) {
+                writeStreamTile(dm, (const quint8*)pixels.constData(), x, y);
+            }
+            return res;
+        }
+
         qint32 row = yToRow(dm, y);
         qint32 col = xToCol(dm, x);
 
         KisTileSP tile = dm->getTile(col, row, true);
 
-        stream->read(m_streamingBuffer.data(), dataSize);
+        if (stream->read(m_streamingBuffer.data(), dataSize) != dataSize) {
+            warnFile << "Failed to read the tile data";
+            return false;
+        }
 
         tile->lockForWrite();
         bool res = decompressTileData((quint8*)m_streamingBuffer.data(), dataSize, tile->tileData());
@@ -139,24 +177,29 @@ bool KisTileCompressor2::decompressTileData(quint8 *buffer,
                                             KisTileData *tileData)
 {
     const qint32 pixelSize = tileData->pixelSize();
-    const qint32 tileDataSize = TILE_DATA_SIZE(pixelSize);
+    return decompressData(buffer, bufferSize, tileData->data(), TILE_DATA_SIZE(pixelSize), pixelSize);
+}
 
+bool KisTileCompressor2::decompressData(quint8 *buffer, qint32 bufferSize,
+                                        quint8 *data, qint32 dataSize,
+                                        qint32 pixelSize)
+{
     if(buffer[0] == COMPRESSED_DATA_FLAG) {
-        prepareWorkBuffers(tileDataSize);
+        prepareWorkBuffers(dataSize);
 
         qint32 bytesWritten;
         bytesWritten = m_compression->decompress(buffer + 1, bufferSize - 1,
-                                                 (quint8*)m_linearizationBuffer.data(), tileDataSize);
-        if (bytesWritten == tileDataSize) {
+                                                 (quint8*)m_linearizationBuffer.data(), dataSize);
+        if (bytesWritten == dataSize) {
             KisAbstractCompression::delinearizeColors((quint8*)m_linearizationBuffer.data(),
-                                                      tileData->data(),
-                                                      tileDataSize, pixelSize);
+                                                      data,
+                                                      dataSize, pixelSize);
             return true;
         }
         return false;
     }
-    else {
-        memcpy(tileData->data(), buffer + 1, tileDataSize);
+    else if (bufferSize - 1 >= dataSize) {
+        memcpy(data, buffer + 1, dataSize);
         return true;
     }
     return false;
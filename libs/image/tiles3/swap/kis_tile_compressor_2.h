@@ -15,6 +15,14 @@ class KRITAIMAGE_EXPORT KisTileCompressor2 : public KisAbstractTileCompressor
 {
 public:
     KisTileCompressor2();
+
+    /**
+     * Creates a compressor that uses \p compression codec for the
+     * tile data. The compressor takes the ownership of the codec.
+     * \p compressionName is written into the header of every tile
+     * when the tiles are stored into a file.
+     */
+    KisTileCompressor2(KisAbstractCompression *compression, const QString &compressionName);
     ~KisTileCompressor2() override;
 
     bool writeTile(KisTileSP tile, KisPaintDeviceWriter &store) override;
@@ -37,6 +45,10 @@ private:
     void prepareWorkBuffers(qint32 tileDataSize);
     void prepareStreamingBuffer(qint32 tileDataSize);
 
+    bool decompressData(quint8 *buffer, qint32 bufferSize,
+                        quint8 *data, qint32 dataSize,
+                        qint32 pixelSize);
+
 private:
     static const qint8 RAW_DATA_FLAG = 0;
     static const qint8 COMPRESSED_DATA_FLAG = 1;
@@ -46,7 +58,7 @@ private:
     QByteArray m_compressionBuffer;
     QByteArray m_streamingBuffer;
     KisAbstractCompression *m_compression;
-    static const QString m_compressionName;
+    QString m_compressionName;
 };
 
 #endif /* __KIS_TILE_COMPRESSOR_2_H */
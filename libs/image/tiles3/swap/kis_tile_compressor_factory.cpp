@@ -0,0 +1,73 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_tile_compressor_factory.h"
+
+#include <config-swap-compression.h>
+
+#include "kis_debug.h"
+#include "kis_lzf_compression.h"
+
+#ifdef HAVE_LZ4
+#include "kis_lz4_compression.h"
+#endif
+
+#ifdef HAVE_ZSTD
+#include "kis_zstd_compression.h"
+#endif
+
+
+QStringList KisTileCompressorFactory::availableSwapCompressions()
+{
+    QStringList result;
+    result << "LZF";
+#ifdef HAVE_LZ4
+    result << "LZ4";
+#endif
+#ifdef HAVE_ZSTD
+    result << "ZSTD";
+#endif
+    return result;
+}
+
+QString KisTileCompressorFactory::defaultSwapCompression()
+{
+    return "LZF";
+}
+
+KisAbstractCompression* KisTileCompressorFactory::createCompression(const QString &compressionId)
+{
+    if (compressionId == "LZF") {
+        return new KisLzfCompression();
+    }
+#ifdef HAVE_LZ4
+    if (compressionId == "LZ4") {
+        return new KisLz4Compression();
+    }
+#endif
+#ifdef HAVE_ZSTD
+    if (compressionId == "ZSTD") {
+        return new KisZstdCompression();
+    }
+#endif
+    return nullptr;
+}
+
+KisAbstractTileCompressorSP KisTileCompressorFactory::createForSwap(const QString &compressionId)
+{
+    QString effectiveId = compressionId;
+    KisAbstractCompression *compression = createCompression(effectiveId);
+
+    if (!compression) {
+        warnKrita << "Swap compression" << compressionId
+                  << "is not available, falling back to" << defaultSwapCompression();
+
+        effectiveId = defaultSwapCompression();
+        compression = createCompression(effectiveId);
+    }
+
+    return KisAbstractTileCompressorSP(new KisTileCompressor2(compression, effectiveId));
+}
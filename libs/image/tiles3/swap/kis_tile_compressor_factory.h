@@ -10,6 +10,8 @@
 #include "tiles3/swap/kis_legacy_tile_compressor.h"
 #include "tiles3/swap/kis_tile_compressor_2.h"
 
+#include <QStringList>
+
 class KRITAIMAGE_EXPORT KisTileCompressorFactory
 {
 public:
@@ -27,6 +29,31 @@ public:
         };
     }
 
+    /**
+     * Returns the ids of the codecs that can be used for compressing
+     * the tiles in the swap file. The list depends on the libraries
+     * Krita has been built with, but "LZF" is always available.
+     */
+    static QStringList availableSwapCompressions();
+
+    /**
+     * The codec used for the swap file when nothing else is configured
+     */
+    static QString defaultSwapCompression();
+
+    /**
+     * Creates a raw codec with id \p compressionId. If the codec is not
+     * available in the current build, returns nullptr.
+     */
+    static KisAbstractCompression* createCompression(const QString &compressionId);
+
+    /**
+     * Creates a tile compressor for the swap file that uses codec with id
+     * \p compressionId. If the codec is not available in the current
+     * build, falls back to the default one.
+     */
+    static KisAbstractTileCompressorSP createForSwap(const QString &compressionId);
+
 private:
     KisTileCompressorFactory();
 };
@@ -0,0 +1,126 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <QMutex>
+#include <QQueue>
+#include <QSemaphore>
+#include <QWaitCondition>
+
+#include "tiles3/swap/kis_tile_data_history_compressor.h"
+#include "tiles3/kis_tile_data.h"
+#include "tiles3/kis_tile_data_store.h"
+#include "kis_debug.h"
+
+
+struct Q_DECL_HIDDEN KisTileDataHistoryCompressor::Private
+{
+public:
+    QSemaphore semaphore;
+    QAtomicInt shouldExitFlag;
+    KisTileDataStore *store;
+
+    QMutex queueLock;
+    QWaitCondition idleCondition;
+    QQueue<KisTileData*> queue;
+    bool isBusy = false;
+
+    void clearQueue();
+};
+
+KisTileDataHistoryCompressor::KisTileDataHistoryCompressor(KisTileDataStore *store)
+    : QThread(),
+      m_d(new Private())
+{
+    m_d->shouldExitFlag = 0;
+    m_d->store = store;
+}
+
+KisTileDataHistoryCompressor::~KisTileDataHistoryCompressor()
+{
+    delete m_d;
+}
+
+void KisTileDataHistoryCompressor::compressTileData(const QVector<KisTileData*> &tileDataList)
+{
+    QMutexLocker locker(&m_d->queueLock);
+
+    Q_FOREACH (KisTileData *td, tileDataList) {
+        td->ref();
+        m_d->queue.enqueue(td);
+        m_d->semaphore.release();
+    }
+}
+
+void KisTileDataHistoryCompressor::Private::clearQueue()
+{
+    QQueue<KisTileData*> tileDataList;
+
+    {
+        QMutexLocker locker(&queueLock);
+        tileDataList.swap(queue);
+        idleCondition.wakeAll();
+    }
+
+    /**
+     * The last reference deletes the tile data via the store,
+     * so never deref while holding the queue lock
+     */
+    Q_FOREACH (KisTileData *td, tileDataList) {
+        td->deref();
+    }
+}
+
+void KisTileDataHistoryCompressor::terminateCompressor()
+{
+    m_d->clearQueue();
+
+    unsigned long exitTimeout = 100;
+    do {
+        m_d->shouldExitFlag = true;
+        m_d->semaphore.release();
+    } while(!wait(exitTimeout));
+
+    m_d->clearQueue();
+}
+
+void KisTileDataHistoryCompressor::run()
+{
+    while (1) {
+        m_d->semaphore.acquire();
+
+        if (m_d->shouldExitFlag)
+            return;
+
+        KisTileData *td = 0;
+
+        {
+            QMutexLocker locker(&m_d->queueLock);
+            if (m_d->queue.isEmpty()) continue;
+
+            td = m_d->queue.dequeue();
+            m_d->isBusy = true;
+        }
+
+        m_d->store->tryCompressTileData(td);
+        td->deref();
+
+        {
+            QMutexLocker locker(&m_d->queueLock);
+            m_d->isBusy = false;
+            if (m_d->queue.isEmpty()) {
+                m_d->idleCondition.wakeAll();
+            }
+        }
+    }
+}
+
+void KisTileDataHistoryCompressor::testingWaitForIdle()
+{
+    QMutexLocker locker(&m_d->queueLock);
+    while ((!m_d->queue.isEmpty() || m_d->isBusy) && isRunning()) {
+        m_d->idleCondition.wait(&m_d->queueLock, 100);
+    }
+}
@@ -0,0 +1,59 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KIS_TILE_DATA_HISTORY_COMPRESSOR_H_
+#define KIS_TILE_DATA_HISTORY_COMPRESSOR_H_
+
+#include <QObject>
+#include <QThread>
+#include <QVector>
+
+#include "kritaimage_export.h"
+
+
+class KisTileDataStore;
+class KisTileData;
+
+/**
+ * A background thread that compresses the undo data of the older
+ * revisions of the history. KisMementoManager passes the tile data
+ * objects here when their revision gets old enough, and the thread
+ * moves them into KisCompressedHistoryStore one by one.
+ *
+ * The queue keeps a reference to every tile data, so they cannot
+ * be deleted while they are waiting for compression. The tile data
+ * objects, which have been brought back to life by undo/redo before
+ * the thread reached them, are just skipped.
+ */
+class KRITAIMAGE_EXPORT KisTileDataHistoryCompressor : public QThread
+{
+    Q_OBJECT
+
+public:
+    KisTileDataHistoryCompressor(KisTileDataStore *store);
+    ~KisTileDataHistoryCompressor() override;
+
+    /**
+     * Adds the tile data objects to the compression queue
+     */
+    void compressTileData(const QVector<KisTileData*> &tileDataList);
+
+    void terminateCompressor();
+
+    /**
+     * Blocks until the queue becomes empty.
+     * Used in unittests only.
+     */
+    void testingWaitForIdle();
+
+private:
+    void run() override;
+
+private:
+    struct Private;
+    Private * const m_d;
+};
+
+#endif /* KIS_TILE_DATA_HISTORY_COMPRESSOR_H_ */
@@ -0,0 +1,129 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <QMutex>
+#include <QQueue>
+#include <QSemaphore>
+#include <QWaitCondition>
+
+#include "tiles3/swap/kis_tile_data_prefetcher.h"
+#include "tiles3/swap/kis_tile_data_swapper_p.h"
+#include "tiles3/kis_tile.h"
+#include "tiles3/kis_tile_data_store.h"
+#include "kis_debug.h"
+
+const int KisTileDataPrefetcher::MAX_QUEUE_SIZE = 256;
+
+
+struct Q_DECL_HIDDEN KisTileDataPrefetcher::Private
+{
+public:
+    QSemaphore semaphore;
+    QAtomicInt shouldExitFlag;
+    KisTileDataStore *store;
+    KisStoreLimits limits;
+
+    QMutex queueLock;
+    QWaitCondition idleCondition;
+    QQueue<KisTileSP> queue;
+    bool isBusy = false;
+};
+
+KisTileDataPrefetcher::KisTileDataPrefetcher(KisTileDataStore *store)
+    : QThread(),
+      m_d(new Private())
+{
+    m_d->shouldExitFlag = 0;
+    m_d->store = store;
+}
+
+KisTileDataPrefetcher::~KisTileDataPrefetcher()
+{
+    delete m_d;
+}
+
+void KisTileDataPrefetcher::prefetchTiles(const QVector<KisTileSP> &tiles)
+{
+    QMutexLocker locker(&m_d->queueLock);
+
+    Q_FOREACH (KisTileSP tile, tiles) {
+        /**
+         * Drop the stalest request. The semaphore is not decremented,
+         * the thread will just find the queue shorter than expected.
+         */
+        if (m_d->queue.size() >= MAX_QUEUE_SIZE) {
+            m_d->queue.dequeue();
+        }
+
+        m_d->queue.enqueue(tile);
+        m_d->semaphore.release();
+    }
+}
+
+void KisTileDataPrefetcher::terminatePrefetcher()
+{
+    {
+        QMutexLocker locker(&m_d->queueLock);
+        m_d->queue.clear();
+        m_d->idleCondition.wakeAll();
+    }
+
+    unsigned long exitTimeout = 100;
+    do {
+        m_d->shouldExitFlag = true;
+        m_d->semaphore.release();
+    } while(!wait(exitTimeout));
+}
+
+void KisTileDataPrefetcher::run()
+{
+    while (1) {
+        m_d->semaphore.acquire();
+
+        if (m_d->shouldExitFlag)
+            return;
+
+        KisTileSP tile;
+
+        {
+            QMutexLocker locker(&m_d->queueLock);
+            if (m_d->queue.isEmpty()) continue;
+
+            tile = m_d->queue.dequeue();
+            m_d->isBusy = true;
+        }
+
+        /**
+         * Loading tiles above the hard limit would just make the
+         * swapper push the working set back to disk
+         */
+        if (m_d->store->memoryMetric() < m_d->limits.hardLimit()) {
+            tile->prefetchSwappedData();
+        }
+        tile = 0;
+
+        {
+            QMutexLocker locker(&m_d->queueLock);
+            m_d->isBusy = false;
+            if (m_d->queue.isEmpty()) {
+                m_d->idleCondition.wakeAll();
+            }
+        }
+    }
+}
+
+void KisTileDataPrefetcher::testingRereadConfig()
+{
+    m_d->limits = KisStoreLimits();
+}
+
+void KisTileDataPrefetcher::testingWaitForIdle()
+{
+    QMutexLocker locker(&m_d->queueLock);
+    while ((!m_d->queue.isEmpty() || m_d->isBusy) && isRunning()) {
+        m_d->idleCondition.wait(&m_d->queueLock, 100);
+    }
+}
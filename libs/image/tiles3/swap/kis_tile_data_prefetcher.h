@@ -0,0 +1,67 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KIS_TILE_DATA_PREFETCHER_H_
+#define KIS_TILE_DATA_PREFETCHER_H_
+
+#include <QObject>
+#include <QThread>
+#include <QVector>
+
+#include "kritaimage_export.h"
+#include "kis_shared_ptr.h"
+
+
+class KisTileDataStore;
+class KisTile;
+typedef KisSharedPtr<KisTile> KisTileSP;
+
+/**
+ * A background thread that loads swapped-out tiles back into memory
+ * before the iterators actually reach them. The iterators declare
+ * the area they are going to read via
+ * KisTiledDataManager::prefetchRect(), and the prefetcher swaps the
+ * tiles in while the iterator is still busy with the previous ones.
+ *
+ * The queue is bounded: when the consumers are much faster than the
+ * prefetcher, the oldest requests are dropped, because the iterator
+ * has most probably already loaded them synchronously.
+ */
+class KRITAIMAGE_EXPORT KisTileDataPrefetcher : public QThread
+{
+    Q_OBJECT
+
+public:
+    KisTileDataPrefetcher(KisTileDataStore *store);
+    ~KisTileDataPrefetcher() override;
+
+    /**
+     * Adds the tiles to the prefetching queue. The tiles are
+     * processed in the order they are passed.
+     */
+    void prefetchTiles(const QVector<KisTileSP> &tiles);
+
+    void terminatePrefetcher();
+
+    void testingRereadConfig();
+
+    /**
+     * Blocks until the queue becomes empty.
+     * Used in unittests only.
+     */
+    void testingWaitForIdle();
+
+private:
+    void run() override;
+
+private:
+    static const int MAX_QUEUE_SIZE;
+
+private:
+    struct Private;
+    Private * const m_d;
+};
+
+#endif /* KIS_TILE_DATA_PREFETCHER_H_ */
@@ -86,6 +86,7 @@ void KisTileDataSwapper::run()
         QThread::msleep(DELAY);
 
         doJob();
+        compactSwap();
     }
 }
 
@@ -133,6 +134,18 @@ void KisTileDataSwapper::doJob()
 }
 
 
+void KisTileDataSwapper::compactSwap()
+{
+    /**
+     * Compaction holds the swap lock, so we do it in small
+     * portions to let the other threads swap their tiles in
+     */
+    while (!m_d->shouldExitFlag && m_d->store->swapNeedsCompaction()) {
+        if (!m_d->store->compactSwap()) break;
+    }
+}
+
+
 class SoftSwapStrategy
 {
 public:
@@ -35,6 +35,7 @@ private:
     void run() override;
 
     void doJob();
+    void compactSwap();
     template<class strategy> qint64 pass(qint64 needToFreeMetric);
 
 private:
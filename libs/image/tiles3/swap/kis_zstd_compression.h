@@ -0,0 +1,41 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_ZSTD_COMPRESSION_H
+#define __KIS_ZSTD_COMPRESSION_H
+
+#include "kis_abstract_compression.h"
+
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+
+/**
+ * Zstandard codec for the swap file. It is slower than LZF, but
+ * gives much better compression ratio, so it is the codec of choice
+ * for the systems with small amount of RAM and slow disks.
+ *
+ * The compression contexts are reused between the calls, so the
+ * object must not be used from multiple threads simultaneously
+ * (which is the case for all the other codecs as well).
+ */
+class KRITAIMAGE_EXPORT KisZstdCompression : public KisAbstractCompression
+{
+public:
+    KisZstdCompression(int compressionLevel = 3);
+    ~KisZstdCompression() override;
+
+    qint32 compress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength) override;
+    qint32 decompress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength) override;
+
+    qint32 outputBufferSize(qint32 dataSize) override;
+
+private:
+    ZSTD_CCtx_s *m_compressionContext;
+    ZSTD_DCtx_s *m_decompressionContext;
+    int m_compressionLevel;
+};
+
+#endif /* __KIS_ZSTD_COMPRESSION_H */
@@ -7,6 +7,8 @@
 #include "kis_chunk_allocator_test.h"
 #include <simpletest.h>
 
+#include <QScopedPointer>
+
 #include "kis_debug.h"
 
 #include "../swap/kis_chunk_allocator.h"
@@ -27,7 +29,60 @@ void KisChunkAllocatorTest::testOperations()
 
     allocator.debugChunks();
     allocator.sanityCheck();
-    QVERIFY(qFuzzyCompare(allocator.debugFragmentation(), 1./6));
+
+    // the hole is reused by the best-fit allocation
+    QCOMPARE(chunk3.begin(), 25ULL);
+    QCOMPARE(allocator.numChunks(), 5ULL);
+    QCOMPARE(allocator.debugFragmentation(), 0.0);
+}
+
+void KisChunkAllocatorTest::testCoalescing()
+{
+    KisChunkAllocator allocator;
+
+    KisChunk chunk1 = allocator.getChunk(10);
+    KisChunk chunk2 = allocator.getChunk(15);
+    KisChunk chunk3 = allocator.getChunk(20);
+    allocator.getChunk(25);
+
+    allocator.freeChunk(chunk1);
+    allocator.freeChunk(chunk3);
+    QVERIFY(qFuzzyCompare(allocator.fragmentation(), 30./70));
+
+    // the freed neighbours should merge into a single extent
+    allocator.freeChunk(chunk2);
+    allocator.sanityCheck();
+    QVERIFY(qFuzzyCompare(allocator.fragmentation(), 45./70));
+
+    KisChunk chunk = allocator.getChunk(45);
+    QCOMPARE(chunk.begin(), 0ULL);
+    QCOMPARE(allocator.debugFragmentation(), 0.0);
+    QCOMPARE(allocator.usedStoreSize(), 70ULL);
+}
+
+void KisChunkAllocatorTest::testRelocation()
+{
+    KisChunkAllocator allocator;
+
+    KisChunk chunk1 = allocator.getChunk(10);
+    allocator.getChunk(15);
+    KisChunk chunk3 = allocator.getChunk(10);
+
+    allocator.freeChunk(chunk1);
+
+    KisChunk newChunk;
+    QVERIFY(allocator.tryRelocateChunk(chunk3, &newChunk));
+    QCOMPARE(newChunk.begin(), 0ULL);
+    QCOMPARE(newChunk.size(), 10ULL);
+
+    allocator.freeChunk(chunk3);
+    allocator.sanityCheck();
+
+    QCOMPARE(allocator.usedStoreSize(), 25ULL);
+    QCOMPARE(allocator.debugFragmentation(), 0.0);
+
+    // there is no space below the first chunk
+    QVERIFY(!allocator.tryRelocateChunk(newChunk, &chunk1));
 }
 
 
@@ -107,6 +162,35 @@ void KisChunkAllocatorTest::testFragmentation()
 
 }
 
+void KisChunkAllocatorTest::testSharedStoreLimit()
+{
+    const quint64 slabSize = 100;
+    QAtomicInteger<qint64> totalStoreSize(0);
+
+    QScopedPointer<KisChunkAllocator> idleAllocator(
+        new KisChunkAllocator(slabSize, 4 * slabSize, &totalStoreSize));
+
+    KisChunkAllocator busyAllocator(slabSize, 4 * slabSize, &totalStoreSize);
+
+    QCOMPARE(totalStoreSize.loadAcquire(), qint64(2 * slabSize));
+
+    // the busy allocator takes the space the idle one doesn't use
+    for (int i = 0; i < 3; i++) {
+        busyAllocator.getChunk(slabSize);
+    }
+
+    QCOMPARE(busyAllocator.storeSize(), 3 * slabSize);
+    QCOMPARE(idleAllocator->storeSize(), slabSize);
+    QCOMPARE(totalStoreSize.loadAcquire(), qint64(4 * slabSize));
+
+    // the space is given back to the common limit on destruction
+    idleAllocator.reset();
+    QCOMPARE(totalStoreSize.loadAcquire(), qint64(3 * slabSize));
+
+    busyAllocator.getChunk(slabSize);
+    QCOMPARE(busyAllocator.storeSize(), 4 * slabSize);
+    busyAllocator.sanityCheck();
+}
 
 SIMPLE_TEST_MAIN(KisChunkAllocatorTest)
 
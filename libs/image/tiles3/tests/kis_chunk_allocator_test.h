@@ -20,7 +20,10 @@ qreal measureFragmentation(qint32 transactions, qint32 chunksAlloc,
 
 private Q_SLOTS:
     void testOperations();
+    void testCoalescing();
+    void testRelocation();
     void testFragmentation();
+    void testSharedStoreLimit();
 
 private:
     quint64 getChunkSize();
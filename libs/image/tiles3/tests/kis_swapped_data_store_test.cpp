@@ -121,5 +121,107 @@ void KisSwappedDataStoreTest::testRandomAccess()
         delete tileDataList[i];
 }
 
+void KisSwappedDataStoreTest::testUncompressedTier()
+{
+    const qint32 pixelSize = 1;
+    const quint8 defaultPixel = 128;
+    const quint8 color = 17;
+
+    KisImageConfig config(false);
+    config.setMaxSwapSize(4);
+    config.setSwapSlabSize(1);
+    config.setSwapWindowSize(1);
+    config.setSwapUncompressedTier(true);
+
+    KisSwappedDataStore store;
+
+    KisTileData *td = new KisTileData(pixelSize, &defaultPixel, KisTileDataStore::instance());
+    memset(td->data(), color, TILESIZE);
+
+    bool readerCalled = false;
+    auto reader = [&] (const quint8 *data) {
+        readerCalled = true;
+        QVERIFY(memoryIsFilled(color, const_cast<quint8*>(data), TILESIZE));
+    };
+
+    // the tile has never been in swap, so it is compressed
+    QVERIFY(store.trySwapOutTileData(td));
+    QVERIFY(!td->swapUncompressed());
+    QVERIFY(!store.tryReadUncompressedTileData(td, reader));
+    QVERIFY(!readerCalled);
+
+    store.swapInTileData(td);
+    QVERIFY(td->readOnlySinceSwapIn());
+    QVERIFY(memoryIsFilled(color, td->data(), TILESIZE));
+
+    // nobody has written into the tile, so it goes uncompressed
+    QVERIFY(store.trySwapOutTileData(td));
+    QVERIFY(td->swapUncompressed());
+    QCOMPARE(qint32(td->swapChunk().size()), TILESIZE);
+    QVERIFY(store.tryReadUncompressedTileData(td, reader));
+    QVERIFY(readerCalled);
+    QVERIFY(!td->data());
+
+    store.swapInTileData(td);
+    QVERIFY(!td->swapUncompressed());
+    QVERIFY(memoryIsFilled(color, td->data(), TILESIZE));
+
+    // the tile has been modified, so it is compressed again
+    td->setReadOnlySinceSwapIn(false);
+    QVERIFY(store.trySwapOutTileData(td));
+    QVERIFY(!td->swapUncompressed());
+
+    store.forgetTileData(td);
+    delete td;
+
+    config.setSwapUncompressedTier(false);
+}
+
+void KisSwappedDataStoreTest::testDeduplication()
+{
+    const qint32 pixelSize = 1;
+    const quint8 defaultPixel = 128;
+    const qint32 NUM_TILES = 100;
+
+    KisImageConfig config(false);
+    config.setMaxSwapSize(4);
+    config.setSwapSlabSize(1);
+    config.setSwapWindowSize(1);
+
+    KisSwappedDataStore store(1);
+
+    QList<KisTileData*> tileDataList;
+    for(qint32 i = 0; i < NUM_TILES; i++) {
+        KisTileData *td = new KisTileData(pixelSize, &defaultPixel, KisTileDataStore::instance());
+        memset(td->data(), COLUMN2COLOR(i % 2), TILESIZE);
+        tileDataList.append(td);
+
+        QVERIFY(store.trySwapOutTileData(td));
+    }
+
+    // only two distinct chunks are actually written
+    QCOMPARE(store.numTiles(), quint64(NUM_TILES));
+    QCOMPARE(store.numDeduplicatedTiles(), qint64(NUM_TILES - 2));
+    QVERIFY(store.deduplicatedSize() > 0);
+    QCOMPARE(tileDataList[0]->swapChunk().begin(), tileDataList[2]->swapChunk().begin());
+    QVERIFY(tileDataList[0]->swapChunk().begin() != tileDataList[1]->swapChunk().begin());
+
+    // the shared chunk survives while it has users
+    store.forgetTileData(tileDataList[0]);
+    delete tileDataList.takeFirst();
+
+    for(qint32 i = 0; i < tileDataList.size(); i++) {
+        KisTileData *td = tileDataList[i];
+        store.swapInTileData(td);
+        QVERIFY(memoryIsFilled(COLUMN2COLOR((i + 1) % 2), td->data(), TILESIZE));
+    }
+
+    QCOMPARE(store.numTiles(), quint64(0));
+    QCOMPARE(store.numDeduplicatedTiles(), qint64(0));
+    QCOMPARE(store.deduplicatedSize(), qint64(0));
+
+    qDeleteAll(tileDataList);
+}
+
 SIMPLE_TEST_MAIN(KisSwappedDataStoreTest)
 
@@ -45,7 +45,7 @@ void KisTileDataPoolerTest::testCycles()
         }
 
         if(!((i / 3) & 1)) {
-            td->m_clonesStack.push(new KisTileData(*td));
+            td->pushClone(new KisTileData(*td));
         }
 
         PRETTY_TILE(i, td);
@@ -63,6 +63,7 @@ void KisTileDataPoolerTest::testCycles()
     }
 
     int i = 0;
+    qint64 expectedPoolMetric = 0;
     KisTileData *item;
     KisTileDataStoreIterator *iter =
         KisTileDataStore::instance()->beginIteration();
@@ -91,9 +92,13 @@ void KisTileDataPoolerTest::testCycles()
             QEXPECT_FAIL("", "The clonesStack's size is not as expected", Continue);
         }
         QCOMPARE(item->m_clonesStack.size(), expectedClones);
+
+        expectedPoolMetric += item->m_clonesStack.size() * item->pixelSize();
         i++;
     }
 
+    QCOMPARE(KisTileDataStore::instance()->poolMemoryMetric(), expectedPoolMetric);
+
 
     KisTileDataStore::instance()->endIteration(iter);
     KisTileDataStore::instance()->debugClear();
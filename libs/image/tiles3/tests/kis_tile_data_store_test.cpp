@@ -16,6 +16,7 @@
 
 #include "tiles3/kis_tile_data_store.h"
 #include "tiles3/kis_tile_data_store_iterators.h"
+#include "tiles3/kis_hline_iterator.h"
 
 
 void KisTileDataStoreTest::testClockIterator()
@@ -137,6 +138,60 @@ void KisTileDataStoreTest::testLeaks()
 
 #define COLUMN2COLOR(col) (col%255)
 
+void KisTileDataStoreTest::testPrefetch()
+{
+    KisTileDataStore *store = KisTileDataStore::instance();
+    store->debugClear();
+
+    const qint32 pixelSize = 1;
+    quint8 defaultPixel = 128;
+    KisTiledDataManager dm(pixelSize, &defaultPixel);
+
+    const qint32 numColumns = 16;
+
+    for(qint32 col = 0; col < numColumns; col++) {
+        KisTileSP tile = dm.getTile(col, 0, true);
+        tile->lockForWrite();
+        memset(tile->data(), COLUMN2COLOR(col), TILESIZE);
+        tile->unlockForWrite();
+    }
+
+    store->debugSwapAll();
+
+    for(qint32 col = 0; col < numColumns; col++) {
+        KisTileSP tile = dm.getTile(col, 0, false);
+        QVERIFY(!tile->data());
+    }
+
+    const KisTileDataStore::MemoryStatistics initialStats = store->memoryStatistics();
+
+    dm.prefetchRect(QRect(0, 0, numColumns * KisTileData::WIDTH, KisTileData::HEIGHT));
+    store->testingWaitForPrefetcher();
+
+    KisTileDataStore::MemoryStatistics stats = store->memoryStatistics();
+    QCOMPARE(stats.swapPrefetchedTiles - initialStats.swapPrefetchedTiles, qint64(numColumns));
+    QCOMPARE(stats.swapPrefetchHits - initialStats.swapPrefetchHits, qint64(0));
+
+    for(qint32 col = 0; col < numColumns; col++) {
+        KisTileSP tile = dm.getTile(col, 0, false);
+        QVERIFY(tile->data());
+    }
+
+    // the hits are counted by the iterators
+    {
+        KisHLineIterator2 it(&dm, 0, 0, numColumns * KisTileData::WIDTH, 0, 0, false, 0);
+
+        for(qint32 col = 0; col < numColumns; col++) {
+            QCOMPARE(*it.rawDataConst(), quint8(COLUMN2COLOR(col)));
+            it.nextPixels(KisTileData::WIDTH);
+        }
+    }
+
+    stats = store->memoryStatistics();
+    QCOMPARE(stats.swapPrefetchHits - initialStats.swapPrefetchHits, qint64(numColumns));
+    QCOMPARE(stats.swapInMisses, initialStats.swapInMisses);
+}
+
 void KisTileDataStoreTest::testSwapping()
 {
     KisImageConfig config(false);
@@ -176,5 +231,144 @@ void KisTileDataStoreTest::testSwapping()
     }
 }
 
+void KisTileDataStoreTest::testMemoryMetrics()
+{
+    KisTileDataStore *store = KisTileDataStore::instance();
+    store->debugClear();
+
+    const qint32 pixelSize = 1;
+    quint8 defaultPixel = 128;
+    const qint64 tileSize = qint64(KisTileData::WIDTH) * KisTileData::HEIGHT;
+
+    KisTileData *td = store->createDefaultTileData(pixelSize, &defaultPixel);
+
+    // the tile
+    td->acquire();
+
+    QCOMPARE(store->memoryMetric(), qint64(pixelSize));
+    QCOMPARE(store->historicalMemoryMetric(), qint64(0));
+
+    // the memento item
+    td->acquire();
+    td->setMementoed(true);
+
+    QCOMPARE(store->historicalMemoryMetric(), qint64(0));
+
+    // the tile has been changed, only the history references the data
+    td->release();
+
+    QCOMPARE(store->historicalMemoryMetric(), qint64(pixelSize));
+
+    KisTileDataStore::MemoryStatistics stats = store->memoryStatistics();
+    QCOMPARE(stats.historicalMemorySize, pixelSize * tileSize);
+    QCOMPARE(stats.realMemorySize, qint64(0));
+
+    // swapped tiles are not counted
+    store->debugSwapAll();
+    QVERIFY(!td->data());
+
+    QCOMPARE(store->memoryMetric(), qint64(0));
+    QCOMPARE(store->historicalMemoryMetric(), qint64(0));
+
+    td->blockSwapping();
+    td->unblockSwapping();
+
+    QCOMPARE(store->memoryMetric(), qint64(pixelSize));
+    QCOMPARE(store->historicalMemoryMetric(), qint64(pixelSize));
+
+    // the history has been squashed
+    td->setMementoed(false);
+
+    QCOMPARE(store->historicalMemoryMetric(), qint64(0));
+
+    stats = store->memoryStatistics();
+    QCOMPARE(stats.historicalMemorySize, qint64(0));
+    QCOMPARE(stats.realMemorySize, pixelSize * tileSize);
+
+    td->release();
+
+    QCOMPARE(store->memoryMetric(), qint64(0));
+    QCOMPARE(store->historicalMemoryMetric(), qint64(0));
+    QCOMPARE(store->poolMemoryMetric(), qint64(0));
+
+    store->debugClear();
+}
+
+void KisTileDataStoreTest::testHistoryCompression()
+{
+    KisImageConfig config(false);
+    config.setHistoryCompressionLimitPercent(config.historyCompressionLimitPercent(true));
+
+    KisTileDataStore *store = KisTileDataStore::instance();
+    store->debugClear();
+    store->testingRereadConfig();
+
+    const qint32 pixelSize = 1;
+    quint8 defaultPixel = 128;
+    const qint64 tileSize = qint64(KisTileData::WIDTH) * KisTileData::HEIGHT;
+
+    QByteArray pattern(tileSize, 0);
+    for (qint64 i = 0; i < tileSize; i++) {
+        pattern[int(i)] = (i / 16) % 2 ? 10 : 200;
+    }
+
+    KisTileData *td = store->createDefaultTileData(pixelSize, &defaultPixel);
+    td->acquire();
+    td->setData((const quint8*) pattern.constData());
+
+    // the data is still used by the image
+    QVERIFY(!store->tryCompressTileData(td));
+
+    // the memento item
+    td->acquire();
+    td->setMementoed(true);
+    td->release();
+
+    QVERIFY(store->tryCompressTileData(td));
+    QVERIFY(!td->data());
+
+    QCOMPARE(store->memoryMetric(), qint64(0));
+    QCOMPARE(store->historicalMemoryMetric(), qint64(0));
+    QCOMPARE(store->numTiles(), 1);
+
+    KisTileDataStore::MemoryStatistics stats = store->memoryStatistics();
+    QCOMPARE(stats.compressedHistoryOriginalSize, pixelSize * tileSize);
+    QVERIFY(stats.compressedHistorySize > 0);
+    QVERIFY(stats.compressedHistorySize < stats.compressedHistoryOriginalSize);
+    QCOMPARE(stats.totalMemorySize, stats.compressedHistorySize);
+
+    // undo brings the data back
+    td->blockSwapping();
+    QVERIFY(td->data());
+    QVERIFY(!memcmp(td->data(), pattern.constData(), tileSize));
+    td->unblockSwapping();
+
+    QCOMPARE(store->memoryMetric(), qint64(pixelSize));
+    QCOMPARE(store->historicalMemoryMetric(), qint64(pixelSize));
+
+    stats = store->memoryStatistics();
+    QCOMPARE(stats.compressedHistorySize, qint64(0));
+    QCOMPARE(stats.compressedHistoryOriginalSize, qint64(0));
+
+    // compression in the background
+    store->compressHistoricalTileData({td});
+    store->testingWaitForHistoryCompressor();
+
+    QVERIFY(!td->data());
+    QCOMPARE(store->memoryMetric(), qint64(0));
+
+    // the history has been purged while the data was compressed
+    td->setMementoed(false);
+    td->release();
+
+    QCOMPARE(store->numTiles(), 0);
+
+    stats = store->memoryStatistics();
+    QCOMPARE(stats.compressedHistorySize, qint64(0));
+    QCOMPARE(stats.compressedHistoryOriginalSize, qint64(0));
+
+    store->debugClear();
+}
+
 SIMPLE_TEST_MAIN(KisTileDataStoreTest)
 
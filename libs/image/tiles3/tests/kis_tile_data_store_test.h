@@ -17,7 +17,10 @@ private:
 private Q_SLOTS:
     void testClockIterator();
     void testLeaks();
+    void testPrefetch();
     void testSwapping();
+    void testMemoryMetrics();
+    void testHistoryCompression();
 };
 
 #endif /* KIS_TILE_DATA_STORE_TEST_H */
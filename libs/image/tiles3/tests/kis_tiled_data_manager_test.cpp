@@ -10,6 +10,7 @@
 #include <QRandomGenerator>
 
 #include "tiles3/kis_tiled_data_manager.h"
+#include "kis_datamanager.h"
 
 #include "tiles_test_utils.h"
 #include "config-limit-long-tests.h"
@@ -531,6 +532,122 @@ void KisTiledDataManagerTest::testUndoSetDefaultPixel()
 
 //#include <valgrind/callgrind.h>
 
+void KisTiledDataManagerTest::testUniformTiles()
+{
+    quint8 defaultPixel = 0;
+    KisDataManager dm(1, &defaultPixel);
+
+    const quint8 oddPixel = 128;
+    QByteArray buffer(128 * 128, oddPixel);
+
+    // written pixel by pixel, so the tiles are not shared
+    dm.writeBytes((const quint8*)buffer.constData(), 0, 0, 128, 128);
+
+    KisTileSP tile00 = dm.getTile(0, 0, false);
+    KisTileSP tile11 = dm.getTile(1, 1, false);
+    QVERIFY(!tile00->tileData()->isUniform());
+    QVERIFY(tile00->tileData() != tile11->tileData());
+    tile00 = tile11 = 0;
+
+    dm.purge(dm.extent());
+
+    tile00 = dm.getTile(0, 0, false);
+    tile11 = dm.getTile(1, 1, false);
+    QVERIFY(tile00->tileData()->isUniform());
+    QCOMPARE(tile00->tileData(), tile11->tileData());
+    QVERIFY(memoryIsFilled(oddPixel, tile00->data(), TILESIZE));
+    QCOMPARE(dm.extent(), QRect(0, 0, 128, 128));
+    tile00 = tile11 = 0;
+
+    // writing expands the tile back
+    const quint8 evenPixel = 129;
+    dm.writeBytes(&evenPixel, 0, 0, 1, 1);
+
+    tile00 = dm.getTile(0, 0, false);
+    tile11 = dm.getTile(1, 1, false);
+    QVERIFY(!tile00->tileData()->isUniform());
+    QVERIFY(tile11->tileData()->isUniform());
+    QVERIFY(tile00->tileData() != tile11->tileData());
+    QCOMPARE(tile00->data()[0], evenPixel);
+    QVERIFY(memoryIsFilled(oddPixel, tile11->data(), TILESIZE));
+}
+
+void KisTiledDataManagerTest::testReadForeignTileSize()
+{
+    const qint32 streamTileSize = 32;
+    const qint32 streamTileDataSize = streamTileSize * streamTileSize;
+
+    QByteArray data;
+    data += "VERSION 2\n"
+            "TILEWIDTH 32\n"
+            "TILEHEIGHT 32\n"
+            "PIXELSIZE 1\n"
+            "DATA 2\n";
+
+    // the tiles are stored uncompressed (raw data flag is 0)
+    data += QString("0,0,LZF,%1\n").arg(streamTileDataSize + 1).toLatin1();
+    data += char(0);
+    data += QByteArray(streamTileDataSize, 10);
+
+    data += QString("32,0,LZF,%1\n").arg(streamTileDataSize + 1).toLatin1();
+    data += char(0);
+    data += QByteArray(streamTileDataSize, 20);
+
+    QBuffer stream(&data);
+    stream.open(QIODevice::ReadOnly);
+
+    quint8 defaultPixel = 0;
+    KisDataManager dm(1, &defaultPixel);
+    QVERIFY(dm.read(&stream));
+
+    QByteArray pixels(64 * 32, 0);
+    dm.readBytes((quint8*)pixels.data(), 0, 0, 64, 32);
+
+    QVERIFY(memoryIsFilled(10, (quint8*)pixels.data(), 32));
+    QVERIFY(memoryIsFilled(20, (quint8*)pixels.data() + 32, 32));
+    QVERIFY(memoryIsFilled(10, (quint8*)pixels.data() + 31 * 64, 32));
+    QVERIFY(memoryIsFilled(20, (quint8*)pixels.data() + 31 * 64 + 32, 32));
+}
+
+void KisTiledDataManagerTest::testReadWrongTileSize()
+{
+    quint8 defaultPixel = 0;
+
+    {
+        // a huge tile size is rejected before allocating anything
+        QByteArray data;
+        data += "VERSION 2\n"
+                "TILEWIDTH 100000\n"
+                "TILEHEIGHT 100000\n"
+                "PIXELSIZE 1\n"
+                "DATA 1\n";
+        data += "0,0,LZF,2\n";
+
+        QBuffer stream(&data);
+        stream.open(QIODevice::ReadOnly);
+
+        KisDataManager dm(1, &defaultPixel);
+        QVERIFY(!dm.read(&stream));
+    }
+
+    {
+        // the data size doesn't fit the tile
+        QByteArray data;
+        data += "VERSION 2\n"
+                "TILEWIDTH 32\n"
+                "TILEHEIGHT 32\n"
+                "PIXELSIZE 1\n"
+                "DATA 1\n";
+        data += "0,0,LZF,2000000000\n";
+
+        QBuffer stream(&data);
+        stream.open(QIODevice::ReadOnly);
+
+        KisDataManager dm(1, &defaultPixel);
+        QVERIFY(!dm.read(&stream));
+    }
+}
+
 void KisTiledDataManagerTest::benchmarkReadOnlyTileLazy()
 {
     quint8 defaultPixel = 0;
@@ -40,6 +40,9 @@ private Q_SLOTS:
     void testTransactions();
     void testPurgeHistory();
     void testUndoSetDefaultPixel();
+    void testUniformTiles();
+    void testReadForeignTileSize();
+    void testReadWrongTileSize();
 
     void benchmarkReadOnlyTileLazy();
     void benchmarkSharedPointers();
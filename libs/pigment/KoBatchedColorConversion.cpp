@@ -0,0 +1,215 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KoBatchedColorConversion.h"
+
+#include <memory>
+#include <vector>
+
+#include <QAtomicInt>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+
+#include "KoColorConversionCache.h"
+#include "KoColorSpace.h"
+#include "KoColorSpaceRegistry.h"
+#include "kis_assert.h"
+
+struct Q_DECL_HIDDEN KoBatchedColorConversion::Private
+{
+    const KoColorSpace *srcColorSpace = nullptr;
+    const KoColorSpace *dstColorSpace = nullptr;
+    KoColorConversionTransformation::Intent renderingIntent;
+    KoColorConversionTransformation::ConversionFlags conversionFlags;
+    int maxThreads = 1;
+};
+
+namespace {
+
+struct BatchQueue
+{
+    BatchQueue(const KoColorSpace *_srcColorSpace,
+               const KoColorSpace *_dstColorSpace,
+               KoColorConversionTransformation::Intent _renderingIntent,
+               KoColorConversionTransformation::ConversionFlags _conversionFlags,
+               int _numBatches,
+               const KoBatchedColorConversion::BatchFunction &_func)
+        : srcColorSpace(_srcColorSpace),
+          dstColorSpace(_dstColorSpace),
+          renderingIntent(_renderingIntent),
+          conversionFlags(_conversionFlags),
+          numBatches(_numBatches),
+          func(_func)
+    {
+    }
+
+    /**
+     * Processes the batches until the queue is empty. The transformation
+     * is requested only when the thread has actually got some work, since
+     * creation of a new transformation may be rather expensive.
+     *
+     * \p progress is called after every processed batch if it is set.
+     */
+    void processBatches(const KoBatchedColorConversion::ProgressFunction &progress)
+    {
+        int batch = nextBatch.fetchAndAddOrdered(1);
+        if (batch >= numBatches) return;
+
+        KoCachedColorConversionTransformation cct =
+            KoColorSpaceRegistry::instance()->colorConversionCache()->
+                exclusiveConverter(srcColorSpace, dstColorSpace,
+                                   renderingIntent, conversionFlags);
+
+        do {
+            func(batch, cct.transformation());
+
+            const int processed = numProcessed.fetchAndAddOrdered(1) + 1;
+            if (progress) {
+                progress(processed);
+            }
+
+            batch = nextBatch.fetchAndAddOrdered(1);
+        } while (batch < numBatches);
+    }
+
+    const KoColorSpace *srcColorSpace;
+    const KoColorSpace *dstColorSpace;
+    KoColorConversionTransformation::Intent renderingIntent;
+    KoColorConversionTransformation::ConversionFlags conversionFlags;
+
+    const int numBatches;
+    const KoBatchedColorConversion::BatchFunction &func;
+
+    QAtomicInt nextBatch {0};
+    QAtomicInt numProcessed {0};
+};
+
+class BatchRunnable : public QRunnable
+{
+public:
+    BatchRunnable(BatchQueue *queue, QSemaphore *finishedSemaphore)
+        : m_queue(queue),
+          m_finishedSemaphore(finishedSemaphore)
+    {
+        setAutoDelete(false);
+    }
+
+    void run() override {
+        m_queue->processBatches(KoBatchedColorConversion::ProgressFunction());
+        m_finishedSemaphore->release();
+    }
+
+private:
+    BatchQueue *m_queue;
+    QSemaphore *m_finishedSemaphore;
+};
+
+}
+
+KoBatchedColorConversion::KoBatchedColorConversion(const KoColorSpace *srcColorSpace,
+                                                   const KoColorSpace *dstColorSpace,
+                                                   KoColorConversionTransformation::Intent renderingIntent,
+                                                   KoColorConversionTransformation::ConversionFlags conversionFlags)
+    : m_d(new Private)
+{
+    m_d->srcColorSpace = srcColorSpace;
+    m_d->dstColorSpace = dstColorSpace;
+    m_d->renderingIntent = renderingIntent;
+    m_d->conversionFlags = conversionFlags;
+    m_d->maxThreads = QThread::idealThreadCount();
+}
+
+KoBatchedColorConversion::~KoBatchedColorConversion()
+{
+}
+
+void KoBatchedColorConversion::setMaxThreads(int value)
+{
+    m_d->maxThreads = qMax(1, value);
+}
+
+int KoBatchedColorConversion::maxThreads() const
+{
+    return m_d->maxThreads;
+}
+
+void KoBatchedColorConversion::run(int numBatches, BatchFunction func, ProgressFunction progress) const
+{
+    if (numBatches <= 0) return;
+
+    BatchQueue queue(m_d->srcColorSpace, m_d->dstColorSpace,
+                     m_d->renderingIntent, m_d->conversionFlags,
+                     numBatches, func);
+
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int numWorkers = qMin(qMin(m_d->maxThreads, pool->maxThreadCount() + 1), numBatches) - 1;
+
+    if (numWorkers <= 0) {
+        queue.processBatches(progress);
+        return;
+    }
+
+    /**
+     * The workers are started in the global pool instead of a pool of
+     * our own, so that the conversions running in several threads
+     * (e.g. for several layers at once) don't oversubscribe the CPU.
+     * The calling thread takes part in the conversion, so it is the only
+     * one that reports the progress.
+     */
+    QSemaphore finishedSemaphore;
+    std::vector<std::unique_ptr<BatchRunnable>> workers;
+
+    for (int i = 0; i < numWorkers; i++) {
+        workers.emplace_back(new BatchRunnable(&queue, &finishedSemaphore));
+        pool->start(workers.back().get());
+    }
+
+    queue.processBatches(
+        [&queue, &progress] (int) {
+            if (progress) {
+                progress(queue.numProcessed.loadAcquire());
+            }
+        });
+
+    /**
+     * When the pool is busy with someone else's jobs, some of our workers
+     * may still be waiting in the pool's queue. All the batches are taken
+     * already, so we just cancel them and wait for the started ones only.
+     */
+    int numStartedWorkers = 0;
+    for (const auto &worker : workers) {
+        if (!pool->tryTake(worker.get())) {
+            numStartedWorkers++;
+        }
+    }
+
+    finishedSemaphore.acquire(numStartedWorkers);
+
+    if (progress) {
+        progress(numBatches);
+    }
+}
+
+void KoBatchedColorConversion::convertPixels(const quint8 *src, quint8 *dst, int numPixels, int batchSize) const
+{
+    KIS_ASSERT_RECOVER_RETURN(batchSize > 0);
+
+    const int srcPixelSize = m_d->srcColorSpace->pixelSize();
+    const int dstPixelSize = m_d->dstColorSpace->pixelSize();
+    const int numBatches = (numPixels + batchSize - 1) / batchSize;
+
+    run(numBatches,
+        [=] (int batch, const KoColorConversionTransformation *transformation) {
+            const int offset = batch * batchSize;
+            const int size = qMin(batchSize, numPixels - offset);
+
+            transformation->transform(src + offset * srcPixelSize,
+                                      dst + offset * dstPixelSize,
+                                      size);
+        });
+}
@@ -0,0 +1,82 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOBATCHEDCOLORCONVERSION_H
+#define KOBATCHEDCOLORCONVERSION_H
+
+#include <functional>
+#include <QScopedPointer>
+
+#include "KoColorConversionTransformation.h"
+
+#include "kritapigment_export.h"
+
+class KoColorSpace;
+
+/**
+ * Converts a large amount of pixel data between two color spaces using
+ * several threads.
+ *
+ * The work is split by the caller into independent batches (e.g. rows
+ * of tiles of a paint device). The batches are processed in the calling
+ * thread and in up to maxThreads() - 1 workers of the global thread
+ * pool. Color conversion transformations are not thread-safe, so every
+ * thread gets its own exclusive transformation from KoColorConversionCache.
+ * The transformations are reused by the subsequent conversions.
+ *
+ * The conversion is done with KoColorConversionTransformation::transform(),
+ * so it gives the same result as KoColorSpace::convertPixelsTo().
+ */
+class KRITAPIGMENT_EXPORT KoBatchedColorConversion
+{
+public:
+    /**
+     * Converts batch \p batchIndex using \p transformation. The function
+     * is called concurrently from several threads, the transformation is
+     * owned by the calling thread for the duration of the call.
+     */
+    using BatchFunction = std::function<void(int batchIndex, const KoColorConversionTransformation *transformation)>;
+
+    /**
+     * Reports the number of processed batches. Always called in the
+     * thread that called run().
+     */
+    using ProgressFunction = std::function<void(int numProcessedBatches)>;
+
+public:
+    KoBatchedColorConversion(const KoColorSpace *srcColorSpace,
+                             const KoColorSpace *dstColorSpace,
+                             KoColorConversionTransformation::Intent renderingIntent,
+                             KoColorConversionTransformation::ConversionFlags conversionFlags);
+    ~KoBatchedColorConversion();
+
+    /**
+     * Sets the maximum number of threads used for the conversion,
+     * including the calling one. The default value is
+     * QThread::idealThreadCount().
+     */
+    void setMaxThreads(int value);
+    int maxThreads() const;
+
+    /**
+     * Calls \p func for every batch in range [0, \p numBatches). The order
+     * of the calls is undefined. The function returns when all the batches
+     * have been processed.
+     */
+    void run(int numBatches, BatchFunction func, ProgressFunction progress = ProgressFunction()) const;
+
+    /**
+     * Converts \p numPixels contiguous pixels from \p src into \p dst,
+     * splitting them into batches of \p batchSize pixels.
+     */
+    void convertPixels(const quint8 *src, quint8 *dst, int numPixels, int batchSize) const;
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KOBATCHEDCOLORCONVERSION_H
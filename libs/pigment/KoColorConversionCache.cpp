@@ -61,15 +61,77 @@ struct KoColorConversionCache::CachedTransformation {
     QAtomicInt use;
 };
 
-typedef QPair<KoColorConversionCacheKey, KoCachedColorConversionTransformation> FastPathCacheItem;
+struct FastPathCacheItem {
+    FastPathCacheItem(const KoColorConversionCacheKey &_key,
+                      const KoCachedColorConversionTransformation &_transformation,
+                      int _generation)
+        : key(_key)
+        , transformation(_transformation)
+        , generation(_generation)
+    {
+    }
+
+    KoColorConversionCacheKey key;
+    KoCachedColorConversionTransformation transformation;
+    int generation;
+};
+
+typedef QMultiHash< KoColorConversionCacheKey, KoColorConversionCache::CachedTransformation*> CachedTransformationHash;
 
 struct KoColorConversionCache::Private {
-    QMultiHash< KoColorConversionCacheKey, CachedTransformation*> cache;
+    CachedTransformationHash cache;
+
+    /**
+     * The transformations handed out by exclusiveConverter() are kept
+     * separately, because the ones in the main cache may be shared by
+     * several threads via the fast path storage.
+     */
+    CachedTransformationHash exclusiveCache;
+
+    /**
+     * The transformations dropped by clear() while still being in use.
+     * They are deleted as soon as they are released.
+     */
+    CachedTransformationHash retiredCache;
     QMutex cacheMutex;
 
     QThreadStorage<FastPathCacheItem*> fastStorage;
+
+    /**
+     * Incremented by clear(). The fast path items of the other threads
+     * created before the increment are not used anymore.
+     */
+    QAtomicInt generation;
+
+    static void removeColorSpace(CachedTransformationHash &cache, const KoColorSpace *cs);
+    void purgeRetiredTransformations();
 };
 
+void KoColorConversionCache::Private::removeColorSpace(CachedTransformationHash &cache, const KoColorSpace *cs)
+{
+    CachedTransformationHash::iterator endIt = cache.end();
+    for (CachedTransformationHash::iterator it = cache.begin(); it != endIt;) {
+        if (it.key().src == cs || it.key().dst == cs) {
+            Q_ASSERT(it.value()->isNotInUse()); // That's terribly evil, if that assert fails, that means that someone is using a color transformation with a color space which is currently being deleted
+            delete it.value();
+            it = cache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void KoColorConversionCache::Private::purgeRetiredTransformations()
+{
+    for (CachedTransformationHash::iterator it = retiredCache.begin(); it != retiredCache.end();) {
+        if (it.value()->isNotInUse()) {
+            delete it.value();
+            it = retiredCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
 
 KoColorConversionCache::KoColorConversionCache() : d(new Private)
 {
@@ -80,6 +142,12 @@ KoColorConversionCache::~KoColorConversionCache()
     Q_FOREACH (CachedTransformation* transfo, d->cache) {
         delete transfo;
     }
+    Q_FOREACH (CachedTransformation* transfo, d->exclusiveCache) {
+        delete transfo;
+    }
+    Q_FOREACH (CachedTransformation* transfo, d->retiredCache) {
+        delete transfo;
+    }
     delete d;
 }
 
@@ -94,21 +162,32 @@ KoCachedColorConversionTransformation KoColorConversionCache::cachedConverter(co
         d->fastStorage.localData();
 
     if (cacheItem) {
-        if (cacheItem->first == key) {
-            return cacheItem->second;
+        if (cacheItem->key == key &&
+            cacheItem->generation == d->generation.loadAcquire()) {
+
+            return cacheItem->transformation;
         }
     }
 
+    /**
+     * Release the transformation held by the fast path before
+     * purging the retired ones, it may be one of them
+     */
+    d->fastStorage.setLocalData(0);
     cacheItem = 0;
 
     QMutexLocker lock(&d->cacheMutex);
+    d->purgeRetiredTransformations();
+
+    const int generation = d->generation.loadAcquire();
+
     QList< CachedTransformation* > cachedTransfos = d->cache.values(key);
     if (cachedTransfos.size() != 0) {
         Q_FOREACH (CachedTransformation* ct, cachedTransfos) {
             ct->transfo->setSrcColorSpace(src);
             ct->transfo->setDstColorSpace(dst);
 
-            cacheItem = new FastPathCacheItem(key, KoCachedColorConversionTransformation(ct));
+            cacheItem = new FastPathCacheItem(key, KoCachedColorConversionTransformation(ct), generation);
             break;
         }
     }
@@ -116,11 +195,42 @@ KoCachedColorConversionTransformation KoColorConversionCache::cachedConverter(co
         KoColorConversionTransformation* transfo = src->createColorConverter(dst, _renderingIntent, _conversionFlags);
         CachedTransformation* ct = new CachedTransformation(transfo);
         d->cache.insert(key, ct);
-        cacheItem = new FastPathCacheItem(key, KoCachedColorConversionTransformation(ct));
+        cacheItem = new FastPathCacheItem(key, KoCachedColorConversionTransformation(ct), generation);
     }
 
     d->fastStorage.setLocalData(cacheItem);
-    return cacheItem->second;
+    return cacheItem->transformation;
+}
+
+KoCachedColorConversionTransformation KoColorConversionCache::exclusiveConverter(const KoColorSpace* src,
+                                                                                 const KoColorSpace* dst,
+                                                                                 KoColorConversionTransformation::Intent _renderingIntent,
+                                                                                 KoColorConversionTransformation::ConversionFlags _conversionFlags)
+{
+    KoColorConversionCacheKey key(src, dst, _renderingIntent, _conversionFlags);
+
+    /**
+     * The usage counter is incremented while the mutex is held, so
+     * the transformation cannot be given to two users at the same
+     * time. The counter is decremented without the lock, but it can
+     * only make a transformation free.
+     */
+    QMutexLocker lock(&d->cacheMutex);
+    d->purgeRetiredTransformations();
+
+    QList< CachedTransformation* > cachedTransfos = d->exclusiveCache.values(key);
+    Q_FOREACH (CachedTransformation* ct, cachedTransfos) {
+        if (ct->isNotInUse()) {
+            ct->transfo->setSrcColorSpace(src);
+            ct->transfo->setDstColorSpace(dst);
+            return KoCachedColorConversionTransformation(ct);
+        }
+    }
+
+    KoColorConversionTransformation* transfo = src->createColorConverter(dst, _renderingIntent, _conversionFlags);
+    CachedTransformation* ct = new CachedTransformation(transfo);
+    d->exclusiveCache.insert(key, ct);
+    return KoCachedColorConversionTransformation(ct);
 }
 
 void KoColorConversionCache::colorSpaceIsDestroyed(const KoColorSpace* cs)
@@ -128,16 +238,29 @@ void KoColorConversionCache::colorSpaceIsDestroyed(const KoColorSpace* cs)
     d->fastStorage.setLocalData(0);
 
     QMutexLocker lock(&d->cacheMutex);
-    QMultiHash< KoColorConversionCacheKey, CachedTransformation*>::iterator endIt = d->cache.end();
-    for (QMultiHash< KoColorConversionCacheKey, CachedTransformation*>::iterator it = d->cache.begin(); it != endIt;) {
-        if (it.key().src == cs || it.key().dst == cs) {
-            Q_ASSERT(it.value()->isNotInUse()); // That's terribly evil, if that assert fails, that means that someone is using a color transformation with a color space which is currently being deleted
-            delete it.value();
-            it = d->cache.erase(it);
-        } else {
-            ++it;
-        }
+    Private::removeColorSpace(d->cache, cs);
+    Private::removeColorSpace(d->exclusiveCache, cs);
+    Private::removeColorSpace(d->retiredCache, cs);
+}
+
+void KoColorConversionCache::clear()
+{
+    d->fastStorage.setLocalData(0);
+
+    QMutexLocker lock(&d->cacheMutex);
+
+    d->generation.ref();
+
+    for (auto it = d->cache.begin(); it != d->cache.end(); ++it) {
+        d->retiredCache.insert(it.key(), it.value());
+    }
+    for (auto it = d->exclusiveCache.begin(); it != d->exclusiveCache.end(); ++it) {
+        d->retiredCache.insert(it.key(), it.value());
     }
+    d->cache.clear();
+    d->exclusiveCache.clear();
+
+    d->purgeRetiredTransformations();
 }
 
 //--------- KoCachedColorConversionTransformation ----------//
@@ -38,6 +38,23 @@ public:
                                                           KoColorConversionTransformation::Intent _renderingIntent,
                                                           KoColorConversionTransformation::ConversionFlags conversionFlags);
 
+    /**
+     * This function returns a color transformation that is not shared with
+     * any other user of the cache. Color transformations are not thread-safe,
+     * so this converter should be used when several threads convert pixels
+     * between the same pair of color spaces at the same time (one converter
+     * per thread). The transformation goes back to the pool of free
+     * transformations when the last copy of the returned object is destroyed.
+     * @param src source color space
+     * @param dst destination color space
+     * @param _renderingIntent rendering intent
+     * @param conversionFlags conversion flags
+     */
+    KoCachedColorConversionTransformation exclusiveConverter(const KoColorSpace* src,
+                                                             const KoColorSpace* dst,
+                                                             KoColorConversionTransformation::Intent _renderingIntent,
+                                                             KoColorConversionTransformation::ConversionFlags conversionFlags);
+
     /**
      * This function is called by the destructor of the color space to
      * warn the cache that any pointers to this color space is going to
@@ -45,6 +62,17 @@ public:
      * @param src source color space
      */
     void colorSpaceIsDestroyed(const KoColorSpace* src);
+
+    /**
+     * Drops all the cached transformations, so that the following calls
+     * create new ones. It should be called when the conversion system
+     * starts to create different transformations for the same pair of
+     * color spaces, e.g. when the tolerance of the lookup tables changes.
+     *
+     * The transformations that are still in use are deleted as soon
+     * as they are released.
+     */
+    void clear();
 private:
     struct Private;
     Private* const d;
@@ -0,0 +1,11 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KoColorConversionLut3D.h"
+
+KoColorConversionLut3DEvaluatorBase::~KoColorConversionLut3DEvaluatorBase()
+{
+}
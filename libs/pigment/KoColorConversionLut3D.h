@@ -0,0 +1,94 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOCOLORCONVERSIONLUT3D_H
+#define KOCOLORCONVERSIONLUT3D_H
+
+#include <QtGlobal>
+#include <QByteArray>
+#include <QScopedPointer>
+
+#include "kritapigment_export.h"
+
+struct KoColorConversionLut3D;
+
+/**
+ * Evaluates a 3D lookup table for a row of pixels. The source pixels
+ * are always in BGRA layout (the layout of all the RGB color spaces
+ * in Krita), the destination pixels have KoColorConversionLut3D::numColorChannels
+ * color channels followed by the alpha channel.
+ *
+ * The actual implementation is placed in `KoColorConversionLut3DEvaluator`,
+ * use KoColorConversionLut3DEvaluatorFactoryImpl via createOptimizedClass()
+ * to get a version optimized for the current CPU.
+ */
+class KRITAPIGMENT_EXPORT KoColorConversionLut3DEvaluatorBase
+{
+public:
+    virtual ~KoColorConversionLut3DEvaluatorBase();
+
+    virtual void evaluate(const KoColorConversionLut3D &lut,
+                          const quint8 *src, quint8 *dst,
+                          qint32 nPixels) const = 0;
+};
+
+/**
+ * A sampled version of an RGB color conversion. The table stores the
+ * result of the exact conversion for gridSize^3 equidistant RGB values,
+ * the values in between are found with tetrahedral interpolation.
+ *
+ * The table is immutable after creation and is shared between all the
+ * transformations using it.
+ */
+struct KRITAPIGMENT_EXPORT KoColorConversionLut3D
+{
+    /// number of nodes along every axis of the grid
+    int gridSize = 0;
+
+    /// number of color channels of the destination color space
+    int numColorChannels = 0;
+
+    /**
+     * Destination color channel values stored in the destination channel
+     * type as:
+     *
+     * nodes[((blue * gridSize + green) * gridSize + red) * numColorChannels + channel]
+     *
+     * The exact conversion produces values of that type anyway, so no
+     * precision is lost compared to a float table.
+     */
+    QByteArray table;
+
+    QScopedPointer<KoColorConversionLut3DEvaluatorBase> evaluator;
+
+    template<typename dst_channel_t>
+    inline const dst_channel_t* nodes() const {
+        return reinterpret_cast<const dst_channel_t*>(table.constData());
+    }
+
+    /// the memory occupied by the table in bytes
+    inline int memoryUsage() const {
+        return table.size();
+    }
+
+    inline int redStride() const {
+        return numColorChannels;
+    }
+
+    inline int greenStride() const {
+        return numColorChannels * gridSize;
+    }
+
+    inline int blueStride() const {
+        return numColorChannels * gridSize * gridSize;
+    }
+
+    inline void evaluate(const quint8 *src, quint8 *dst, qint32 nPixels) const {
+        evaluator->evaluate(*this, src, dst, nPixels);
+    }
+};
+
+#endif // KOCOLORCONVERSIONLUT3D_H
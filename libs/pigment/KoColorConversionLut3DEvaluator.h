@@ -0,0 +1,263 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOCOLORCONVERSIONLUT3DEVALUATOR_H
+#define KOCOLORCONVERSIONLUT3DEVALUATOR_H
+
+#include <utility>
+
+#include "KoColorConversionLut3D.h"
+#include "KoColorSpaceMaths.h"
+#include "KoAlwaysInline.h"
+#include "KoMultiArchBuildSupport.h"
+
+/**
+ * Scalar version of the tetrahedral interpolation of KoColorConversionLut3D.
+ *
+ * The cube of the grid containing the source color is split into six
+ * tetrahedra sharing the main diagonal. The tetrahedron is selected by
+ * sorting the fractional parts of the coordinates, so only four nodes
+ * of the grid are fetched per pixel.
+ */
+template<typename src_channel_t, typename dst_channel_t>
+struct KoColorConversionLut3DScalarEvaluator
+{
+    static constexpr int srcChannelsNb = 4;
+    static constexpr int srcBluePos = 0;
+    static constexpr int srcGreenPos = 1;
+    static constexpr int srcRedPos = 2;
+    static constexpr int srcAlphaPos = 3;
+
+    static inline float gridScale(const KoColorConversionLut3D &lut) {
+        return float(lut.gridSize - 1) / float(KoColorSpaceMathsTraits<src_channel_t>::unitValue);
+    }
+
+    static ALWAYS_INLINE dst_channel_t toDstChannel(float value) {
+        const float unit = float(KoColorSpaceMathsTraits<dst_channel_t>::unitValue);
+        return static_cast<dst_channel_t>(qBound(0.0f, value, unit) + 0.5f);
+    }
+
+    static void evaluate(const KoColorConversionLut3D &lut,
+                         const quint8 *srcU8, quint8 *dstU8,
+                         qint32 nPixels)
+    {
+        const src_channel_t *src = reinterpret_cast<const src_channel_t*>(srcU8);
+        dst_channel_t *dst = reinterpret_cast<dst_channel_t*>(dstU8);
+
+        const int numColorChannels = lut.numColorChannels;
+        const int maxCell = lut.gridSize - 2;
+        const float scale = gridScale(lut);
+        const dst_channel_t *table = lut.nodes<dst_channel_t>();
+
+        for (qint32 i = 0; i < nPixels; i++) {
+            const float x = src[srcRedPos] * scale;
+            const float y = src[srcGreenPos] * scale;
+            const float z = src[srcBluePos] * scale;
+
+            const int ix = qMin(int(x), maxCell);
+            const int iy = qMin(int(y), maxCell);
+            const int iz = qMin(int(z), maxCell);
+
+            float f1 = x - ix;
+            float f2 = y - iy;
+            float f3 = z - iz;
+
+            int o1 = lut.redStride();
+            int o2 = lut.greenStride();
+            int o3 = lut.blueStride();
+
+            // sort the fractions in descending order
+            if (f2 > f1) { std::swap(f1, f2); std::swap(o1, o2); }
+            if (f3 > f2) { std::swap(f2, f3); std::swap(o2, o3); }
+            if (f2 > f1) { std::swap(f1, f2); std::swap(o1, o2); }
+
+            const dst_channel_t *p0 = table + ix * lut.redStride() + iy * lut.greenStride() + iz * lut.blueStride();
+            const dst_channel_t *p1 = p0 + o1;
+            const dst_channel_t *p2 = p1 + o2;
+            const dst_channel_t *p3 = p2 + o3;
+
+            const float w0 = 1.0f - f1;
+            const float w1 = f1 - f2;
+            const float w2 = f2 - f3;
+            const float w3 = f3;
+
+            for (int c = 0; c < numColorChannels; c++) {
+                dst[c] = toDstChannel(w0 * p0[c] + w1 * p1[c] + w2 * p2[c] + w3 * p3[c]);
+            }
+            dst[numColorChannels] = KoColorSpaceMaths<src_channel_t, dst_channel_t>::scaleToA(src[srcAlphaPos]);
+
+            src += srcChannelsNb;
+            dst += numColorChannels + 1;
+        }
+    }
+};
+
+template<typename src_channel_t,
+         typename dst_channel_t,
+         typename _impl,
+         typename EnableDummyType = void>
+struct KoColorConversionLut3DEvaluator : public KoColorConversionLut3DEvaluatorBase
+{
+    void evaluate(const KoColorConversionLut3D &lut,
+                  const quint8 *src, quint8 *dst,
+                  qint32 nPixels) const override
+    {
+        KoColorConversionLut3DScalarEvaluator<src_channel_t, dst_channel_t>::evaluate(lut, src, dst, nPixels);
+    }
+};
+
+#if defined(HAVE_XSIMD) && !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE)
+
+#include "KoStreamedMath.h"
+
+template<typename src_channel_t, typename dst_channel_t, typename _impl>
+struct KoColorConversionLut3DEvaluator<
+        src_channel_t, dst_channel_t, _impl,
+        typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value>::type> : public KoColorConversionLut3DEvaluatorBase
+{
+    using float_v = typename KoStreamedMath<_impl>::float_v;
+    using int_v = typename KoStreamedMath<_impl>::int_v;
+    using float_m = typename float_v::batch_bool_type;
+    using ScalarEvaluator = KoColorConversionLut3DScalarEvaluator<src_channel_t, dst_channel_t>;
+
+    static constexpr int vectorSize = static_cast<int>(float_v::size);
+
+    static ALWAYS_INLINE float_v gather(const dst_channel_t *table, const int_v &index)
+    {
+#if XSIMD_VERSION_MAJOR < 10
+        alignas(_impl::alignment()) int indexes[vectorSize];
+        alignas(_impl::alignment()) float values[vectorSize];
+        index.store_aligned(indexes);
+
+        for (int i = 0; i < vectorSize; i++) {
+            values[i] = table[indexes[i]];
+        }
+        return float_v::load_aligned(values);
+#else
+        return float_v::gather(table, index);
+#endif
+    }
+
+    static ALWAYS_INLINE void sortPair(float_v &f1, float_v &o1, float_v &f2, float_v &o2)
+    {
+        const float_m mask = f2 > f1;
+
+        const float_v f = f1;
+        f1 = xsimd::select(mask, f2, f1);
+        f2 = xsimd::select(mask, f, f2);
+
+        const float_v o = o1;
+        o1 = xsimd::select(mask, o2, o1);
+        o2 = xsimd::select(mask, o, o2);
+    }
+
+    void evaluate(const KoColorConversionLut3D &lut,
+                  const quint8 *srcU8, quint8 *dstU8,
+                  qint32 nPixels) const override
+    {
+        const int block1 = nPixels / vectorSize;
+        const int block2 = nPixels % vectorSize;
+
+        const src_channel_t *src = reinterpret_cast<const src_channel_t*>(srcU8);
+        dst_channel_t *dst = reinterpret_cast<dst_channel_t*>(dstU8);
+
+        const int numColorChannels = lut.numColorChannels;
+        const int dstChannelsNb = numColorChannels + 1;
+        const dst_channel_t *table = lut.nodes<dst_channel_t>();
+
+        const float_v scale(ScalarEvaluator::gridScale(lut));
+        const int_v maxCell(lut.gridSize - 2);
+
+        const int_v redStride(lut.redStride());
+        const int_v greenStride(lut.greenStride());
+        const int_v blueStride(lut.blueStride());
+        const int_v diagonalStride(lut.redStride() + lut.greenStride() + lut.blueStride());
+
+        const float_v zero(0.0f);
+        const float_v unit(float(KoColorSpaceMathsTraits<dst_channel_t>::unitValue));
+        const float_v half(0.5f);
+
+        alignas(_impl::alignment()) float red[vectorSize];
+        alignas(_impl::alignment()) float green[vectorSize];
+        alignas(_impl::alignment()) float blue[vectorSize];
+        alignas(_impl::alignment()) int result[4][vectorSize];
+
+        for (int b = 0; b < block1; b++) {
+            for (int i = 0; i < vectorSize; i++) {
+                const src_channel_t *pixel = src + i * ScalarEvaluator::srcChannelsNb;
+                red[i] = pixel[ScalarEvaluator::srcRedPos];
+                green[i] = pixel[ScalarEvaluator::srcGreenPos];
+                blue[i] = pixel[ScalarEvaluator::srcBluePos];
+            }
+
+            const float_v x = float_v::load_aligned(red) * scale;
+            const float_v y = float_v::load_aligned(green) * scale;
+            const float_v z = float_v::load_aligned(blue) * scale;
+
+            const int_v ix = xsimd::min(xsimd::to_int(x), maxCell);
+            const int_v iy = xsimd::min(xsimd::to_int(y), maxCell);
+            const int_v iz = xsimd::min(xsimd::to_int(z), maxCell);
+
+            float_v f1 = x - xsimd::to_float(ix);
+            float_v f2 = y - xsimd::to_float(iy);
+            float_v f3 = z - xsimd::to_float(iz);
+
+            /**
+             * The offsets are tracked in floats to be able to swap
+             * them with the same float masks. They are small enough
+             * to be represented exactly.
+             */
+            float_v o1(float(lut.redStride()));
+            float_v o2(float(lut.greenStride()));
+            float_v o3(float(lut.blueStride()));
+
+            sortPair(f1, o1, f2, o2);
+            sortPair(f2, o2, f3, o3);
+            sortPair(f1, o1, f2, o2);
+
+            const int_v index0 = ix * redStride + iy * greenStride + iz * blueStride;
+            const int_v index1 = index0 + xsimd::to_int(o1);
+            const int_v index2 = index1 + xsimd::to_int(o2);
+            const int_v index3 = index0 + diagonalStride;
+
+            const float_v w0 = float_v(1.0f) - f1;
+            const float_v w1 = f1 - f2;
+            const float_v w2 = f2 - f3;
+            const float_v w3 = f3;
+
+            for (int c = 0; c < numColorChannels; c++) {
+                const int_v channel(c);
+
+                const float_v value =
+                    w0 * gather(table, index0 + channel) +
+                    w1 * gather(table, index1 + channel) +
+                    w2 * gather(table, index2 + channel) +
+                    w3 * gather(table, index3 + channel);
+
+                xsimd::to_int(xsimd::max(xsimd::min(value, unit), zero) + half).store_aligned(result[c]);
+            }
+
+            for (int i = 0; i < vectorSize; i++) {
+                for (int c = 0; c < numColorChannels; c++) {
+                    dst[c] = static_cast<dst_channel_t>(result[c][i]);
+                }
+                dst[numColorChannels] = KoColorSpaceMaths<src_channel_t, dst_channel_t>::scaleToA(src[ScalarEvaluator::srcAlphaPos]);
+
+                src += ScalarEvaluator::srcChannelsNb;
+                dst += dstChannelsNb;
+            }
+        }
+
+        ScalarEvaluator::evaluate(lut,
+                                  reinterpret_cast<const quint8*>(src),
+                                  reinterpret_cast<quint8*>(dst),
+                                  block2);
+    }
+};
+
+#endif /* HAVE_XSIMD */
+
+#endif // KOCOLORCONVERSIONLUT3DEVALUATOR_H
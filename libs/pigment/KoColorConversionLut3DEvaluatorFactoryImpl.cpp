@@ -0,0 +1,25 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KoColorConversionLut3DEvaluatorFactoryImpl.h"
+
+#if XSIMD_UNIVERSAL_BUILD_PASS
+#include "KoColorConversionLut3DEvaluator.h"
+
+template<typename src_channel_t, typename dst_channel_t>
+template<typename _impl>
+KoColorConversionLut3DEvaluatorBase *
+KoColorConversionLut3DEvaluatorFactoryImpl<src_channel_t, dst_channel_t>::create()
+{
+    return new KoColorConversionLut3DEvaluator<src_channel_t, dst_channel_t, _impl>();
+}
+
+template KoColorConversionLut3DEvaluatorBase* KoColorConversionLut3DEvaluatorFactoryImpl<quint8,  quint8>::create<xsimd::current_arch>();
+template KoColorConversionLut3DEvaluatorBase* KoColorConversionLut3DEvaluatorFactoryImpl<quint8,  quint16>::create<xsimd::current_arch>();
+template KoColorConversionLut3DEvaluatorBase* KoColorConversionLut3DEvaluatorFactoryImpl<quint16, quint8>::create<xsimd::current_arch>();
+template KoColorConversionLut3DEvaluatorBase* KoColorConversionLut3DEvaluatorFactoryImpl<quint16, quint16>::create<xsimd::current_arch>();
+
+#endif // XSIMD_UNIVERSAL_BUILD_PASS
@@ -0,0 +1,21 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOCOLORCONVERSIONLUT3DEVALUATORFACTORYIMPL_H
+#define KOCOLORCONVERSIONLUT3DEVALUATORFACTORYIMPL_H
+
+#include <KoColorConversionLut3D.h>
+#include <KoMultiArchBuildSupport.h>
+
+template<typename src_channel_t, typename dst_channel_t>
+class KRITAPIGMENT_EXPORT KoColorConversionLut3DEvaluatorFactoryImpl
+{
+public:
+    template<typename _impl>
+    static KoColorConversionLut3DEvaluatorBase *create();
+};
+
+#endif // KOCOLORCONVERSIONLUT3DEVALUATORFACTORYIMPL_H
@@ -8,19 +8,52 @@
 #include "KoColorConversionSystem_p.h"
 
 #include <QHash>
+#include <QMutexLocker>
 #include <QString>
 
+#include <kconfiggroup.h>
+#include <ksharedconfig.h>
+
 #include "KoColorConversionAlphaTransformation.h"
 #include "KoColorConversionTransformation.h"
 #include "KoColorProfile.h"
 #include "KoColorSpace.h"
 #include "KoCopyColorConversionTransformation.h"
+#include "KoLutColorConversionTransformation.h"
 #include "KoMultipleColorConversionTransformation.h"
 
+namespace {
+
+/**
+ * The profiles are identified by their unique id, because different
+ * profiles may have the same name (e.g. the sRGB profiles embedded into
+ * the images). Empty string means that the conversion cannot be cached.
+ */
+QString lutCacheKey(const KoColorSpace *srcColorSpace, const KoColorSpace *dstColorSpace,
+                    KoColorConversionTransformation::Intent renderingIntent,
+                    KoColorConversionTransformation::ConversionFlags conversionFlags)
+{
+    const QByteArray srcProfileId = srcColorSpace->profile() ? srcColorSpace->profile()->uniqueId() : QByteArray();
+    const QByteArray dstProfileId = dstColorSpace->profile() ? dstColorSpace->profile()->uniqueId() : QByteArray();
+
+    if (srcProfileId.isEmpty() || dstProfileId.isEmpty()) {
+        return QString();
+    }
+
+    return QString("%1/%2 -> %3/%4 [%5 %6]")
+        .arg(srcColorSpace->id(), QString::fromLatin1(srcProfileId.toHex()))
+        .arg(dstColorSpace->id(), QString::fromLatin1(dstProfileId.toHex()))
+        .arg(int(renderingIntent))
+        .arg(int(conversionFlags));
+}
+
+}
 
 KoColorConversionSystem::KoColorConversionSystem(RegistryInterface *registryInterface)
     : d(new Private(registryInterface))
 {
+    KConfigGroup cfg = KSharedConfig::openConfig()->group("");
+    d->lutConversionTolerance = cfg.readEntry("lutColorConversionTolerance", 0.0);
 }
 
 KoColorConversionSystem::~KoColorConversionSystem()
@@ -224,6 +257,41 @@ KoColorConversionTransformation* KoColorConversionSystem::createColorConverter(c
     if (*srcColorSpace == *dstColorSpace) {
         return new KoCopyColorConversionTransformation(srcColorSpace);
     }
+
+    /**
+     * Only the tables that have already been built are used here. Building
+     * a table is expensive, so it is done by approximateWithLut(), which is
+     * called by the registry after releasing its lock.
+     */
+    if (KoLutColorConversionTransformation::canUseLut(srcColorSpace, dstColorSpace, conversionFlags)) {
+        const QString key = lutCacheKey(srcColorSpace, dstColorSpace, renderingIntent, conversionFlags);
+
+        QSharedPointer<const KoColorConversionLut3D> lut;
+
+        if (!key.isEmpty()) {
+            QMutexLocker l(&d->lutCacheMutex);
+
+            if (d->lutConversionTolerance > 0.0) {
+                QSharedPointer<const KoColorConversionLut3D> *cachedLut = d->lutCache.object(key);
+                if (cachedLut) {
+                    lut = *cachedLut;
+                }
+            }
+        }
+
+        if (lut) {
+            return new KoLutColorConversionTransformation(srcColorSpace, dstColorSpace, renderingIntent, conversionFlags, lut);
+        }
+    }
+
+    return createExactColorConverter(srcColorSpace, dstColorSpace, renderingIntent, conversionFlags);
+}
+
+KoColorConversionTransformation* KoColorConversionSystem::createExactColorConverter(const KoColorSpace * srcColorSpace, const KoColorSpace * dstColorSpace, KoColorConversionTransformation::Intent renderingIntent, KoColorConversionTransformation::ConversionFlags conversionFlags) const
+{
+    if (*srcColorSpace == *dstColorSpace) {
+        return new KoCopyColorConversionTransformation(srcColorSpace);
+    }
     dbgPigmentCCS << srcColorSpace->id() << (srcColorSpace->profile() ? srcColorSpace->profile()->name() : "default");
     dbgPigmentCCS << dstColorSpace->id() << (dstColorSpace->profile() ? dstColorSpace->profile()->name() : "default");
     Path path = findBestPath(
@@ -237,6 +305,133 @@ KoColorConversionTransformation* KoColorConversionSystem::createColorConverter(c
     return transfo;
 }
 
+bool KoColorConversionSystem::canApproximateWithLut(const KoColorConversionTransformation *transformation) const
+{
+    if (dynamic_cast<const KoLutColorConversionTransformation*>(transformation)) {
+        return false;
+    }
+
+    const KoColorSpace *srcColorSpace = transformation->srcColorSpace();
+    const KoColorSpace *dstColorSpace = transformation->dstColorSpace();
+
+    if (!KoLutColorConversionTransformation::canUseLut(srcColorSpace, dstColorSpace, transformation->conversionFlags())) {
+        return false;
+    }
+
+    const QString key = lutCacheKey(srcColorSpace, dstColorSpace,
+                                    transformation->renderingIntent(),
+                                    transformation->conversionFlags());
+    if (key.isEmpty()) {
+        return false;
+    }
+
+    QMutexLocker l(&d->lutCacheMutex);
+    return d->lutConversionTolerance > 0.0 && !d->lutCache.contains(key);
+}
+
+KoColorConversionTransformation* KoColorConversionSystem::createLutValidationConverter(const KoColorConversionTransformation *transformation) const
+{
+    /**
+     * We cannot use KoColorSpace::toLabA16() while building the table,
+     * because it asks the registry for a converter. So we create the
+     * exact conversion into LabA U16 beforehand.
+     */
+    const KoColorSpace *labColorSpace =
+        d->registryInterface->colorSpace(LABAColorModelID.id(), Integer16BitsColorDepthID.id(), QString());
+
+    if (!labColorSpace) {
+        return 0;
+    }
+
+    return createExactColorConverter(transformation->dstColorSpace(), labColorSpace,
+                                     KoColorConversionTransformation::internalRenderingIntent(),
+                                     KoColorConversionTransformation::internalConversionFlags());
+}
+
+KoColorConversionTransformation* KoColorConversionSystem::approximateWithLut(KoColorConversionTransformation *transformation, const KoColorConversionTransformation *toLabTransformation) const
+{
+    const KoColorSpace *srcColorSpace = transformation->srcColorSpace();
+    const KoColorSpace *dstColorSpace = transformation->dstColorSpace();
+
+    const QString key = lutCacheKey(srcColorSpace, dstColorSpace,
+                                    transformation->renderingIntent(),
+                                    transformation->conversionFlags());
+
+    /**
+     * Two threads asking for the same conversion should not build
+     * the same table twice.
+     */
+    QMutexLocker buildLocker(&d->lutBuildMutex);
+
+    QSharedPointer<const KoColorConversionLut3D> lut;
+    bool isCached = false;
+    qreal tolerance = 0.0;
+    int generation = 0;
+
+    {
+        QMutexLocker l(&d->lutCacheMutex);
+
+        tolerance = d->lutConversionTolerance;
+        generation = d->lutCacheGeneration;
+
+        QSharedPointer<const KoColorConversionLut3D> *cachedLut = d->lutCache.object(key);
+        if (cachedLut) {
+            lut = *cachedLut;
+            isCached = true;
+        }
+    }
+
+    if (!isCached && tolerance > 0.0 && !key.isEmpty()) {
+        lut = KoLutColorConversionTransformation::createLut(transformation, toLabTransformation, tolerance);
+
+        dbgPigmentCCS << "LUT for" << key << (lut ? QString("grid size %1").arg(lut->gridSize) : QString("is not available"));
+
+        QMutexLocker l(&d->lutCacheMutex);
+
+        if (generation == d->lutCacheGeneration) {
+            d->lutCache.insert(key,
+                               new QSharedPointer<const KoColorConversionLut3D>(lut),
+                               lut ? lut->memoryUsage() : 1);
+        }
+    }
+
+    if (!lut) {
+        return transformation;
+    }
+
+    KoColorConversionTransformation *result =
+        new KoLutColorConversionTransformation(srcColorSpace, dstColorSpace,
+                                               transformation->renderingIntent(),
+                                               transformation->conversionFlags(),
+                                               lut);
+    delete transformation;
+    return result;
+}
+
+void KoColorConversionSystem::setLutConversionTolerance(qreal maxDeltaE)
+{
+    {
+        QMutexLocker l(&d->lutCacheMutex);
+
+        d->lutConversionTolerance = maxDeltaE;
+        d->lutCacheGeneration++;
+        d->lutCache.clear();
+    }
+
+    /**
+     * The converters cached by the registry were created with the old
+     * tolerance. The cache holds its own mutex while creating new
+     * converters, which may lock ours, so release ours first.
+     */
+    d->registryInterface->colorConvertersInvalidated();
+}
+
+qreal KoColorConversionSystem::lutConversionTolerance() const
+{
+    QMutexLocker l(&d->lutCacheMutex);
+    return d->lutConversionTolerance;
+}
+
 void KoColorConversionSystem::createColorConverters(const KoColorSpace* colorSpace, const QList< QPair<KoID, KoID> >& possibilities, KoColorConversionTransformation*& fromCS, KoColorConversionTransformation*& toCS) const
 {
     // TODO This function currently only select the best conversion only based on the transformation
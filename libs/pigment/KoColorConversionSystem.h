@@ -12,11 +12,13 @@ class KoColorSpace;
 class KoColorSpaceFactory;
 class KoColorSpaceEngine;
 class KoID;
+struct KoColorConversionLut3D;
 
 #include "KoColorConversionTransformation.h"
 
 #include <QList>
 #include <QPair>
+#include <QSharedPointer>
 
 #include "kritapigment_export.h"
 
@@ -39,6 +41,12 @@ public:
         virtual const KoColorSpaceFactory* colorSpaceFactory(const QString &colorModelId, const QString &colorDepthId) const = 0;
         virtual QList<const KoColorProfile *>  profilesFor(const KoColorSpaceFactory * csf) const = 0;
         virtual QList<const KoColorSpaceFactory*> colorSpacesFor(const KoColorProfile* profile) const = 0;
+
+        /**
+         * Called when createColorConverter() starts to create different
+         * transformations than before, so the cached ones should be dropped
+         */
+        virtual void colorConvertersInvalidated() = 0;
     };
 
 public:
@@ -85,6 +93,57 @@ public:
      *             variable
      */
     void createColorConverters(const KoColorSpace* colorSpace, const QList< QPair<KoID, KoID> >& possibilities, KoColorConversionTransformation*& fromCS, KoColorConversionTransformation*& toCS) const;
+
+    /**
+     * Set the maximum color difference (CIE76 delta E) allowed for the
+     * conversions approximated with a 3D lookup table. If the value is
+     * positive, createColorConverter() returns a KoLutColorConversionTransformation
+     * for the conversions from RGBA U8/U16 color spaces, whenever a table
+     * fitting into the tolerance has been built by approximateWithLut().
+     * Zero or negative value disables the approximation.
+     *
+     * The initial value is read from the "lutColorConversionTolerance"
+     * config option, the approximation is disabled by default. Changing
+     * the value drops the cached tables and the converters cached by
+     * KoColorConversionCache, the converters that are already in use
+     * are not affected.
+     *
+     * NOTE: the table for a pair of color spaces is built by the first
+     * createColorConverter() call of the registry asking for this
+     * conversion, in the calling thread. It samples the exact conversion
+     * on grids of up to 86^3 nodes and validates every grid, which is a
+     * noticeable one-time pause when it happens in the GUI thread. The
+     * following calls reuse the cached table.
+     */
+    void setLutConversionTolerance(qreal maxDeltaE);
+    qreal lutConversionTolerance() const;
+
+    /**
+     * @return true if the exact \p transformation could be replaced by
+     * a lookup table, which has not been built yet
+     */
+    bool canApproximateWithLut(const KoColorConversionTransformation *transformation) const;
+
+    /**
+     * Create the exact conversion from the destination color space of
+     * \p transformation into LabA U16. It is used by approximateWithLut()
+     * to measure the error of the table. Should be called with the
+     * registry locked, like createColorConverter().
+     */
+    KoColorConversionTransformation* createLutValidationConverter(const KoColorConversionTransformation *transformation) const;
+
+    /**
+     * Build (or fetch from the cache) the lookup table for \p transformation.
+     * It doesn't access the registry, so it should be called without
+     * the registry lock held: building a table may take a while.
+     *
+     * Takes the ownership of \p transformation.
+     *
+     * @return the approximated transformation or \p transformation itself
+     *         if it doesn't fit into the tolerance
+     */
+    KoColorConversionTransformation* approximateWithLut(KoColorConversionTransformation *transformation,
+                                                        const KoColorConversionTransformation *toLabTransformation) const;
 public:
     /**
      * This function return a text that can be compiled using dot to display
@@ -125,6 +184,11 @@ private:
      * Insert an engine.
      */
     Node* insertEngine(const KoColorSpaceEngine* engine);
+    /**
+     * Create the exact conversion between two color spaces, without any
+     * lookup table approximation.
+     */
+    KoColorConversionTransformation* createExactColorConverter(const KoColorSpace * srcColorSpace, const KoColorSpace * dstColorSpace, KoColorConversionTransformation::Intent renderingIntent, KoColorConversionTransformation::ConversionFlags conversionFlags) const;
     KoColorConversionTransformation* createTransformationFromPath(const KoColorConversionSystem::Path& path, const KoColorSpace* srcColorSpace, const KoColorSpace* dstColorSpace, KoColorConversionTransformation::Intent renderingIntent, KoColorConversionTransformation::ConversionFlags conversionFlags) const;
     /**
      * Query the registry to get the color space associated with this
@@ -13,9 +13,12 @@
 #include "KoColorConversionTransformationFactory.h"
 #include "KoColorSpaceEngine.h"
 #include "KoColorConversionSystem.h"
+#include "KoColorConversionLut3D.h"
 #include <boost/operators.hpp>
 
+#include <QCache>
 #include <QList>
+#include <QMutex>
 
 enum NodeCapability {
     None = 0x0,
@@ -323,11 +326,35 @@ uint qHash(const KoColorConversionSystem::NodeKey &key)
 
 struct Q_DECL_HIDDEN KoColorConversionSystem::Private {
 
-    Private(RegistryInterface *_registryInterface) : registryInterface(_registryInterface) {}
+    /**
+     * The memory budget of the cached lookup tables. The largest table
+     * (86^3 nodes with four 16-bit channels) takes about 5 MiB.
+     */
+    static const int lutCacheMaxCost = 32 * 1024 * 1024;
+
+    Private(RegistryInterface *_registryInterface)
+        : registryInterface(_registryInterface),
+          lutCache(lutCacheMaxCost)
+    {}
 
     QHash<NodeKey, Node*> graph;
     QList<Vertex*> vertexes;
     RegistryInterface *registryInterface;
+
+    /**
+     * Guards the tolerance and the cache of the lookup tables. The lookup
+     * tables are built without holding the registry lock, so these members
+     * may be accessed by several threads at once.
+     */
+    QMutex lutCacheMutex;
+    qreal lutConversionTolerance = 0.0;
+    /// incremented on every change of the tolerance, drops the tables built with the old one
+    int lutCacheGeneration = 0;
+    /// null values mark the conversions that don't fit into the tolerance
+    QCache<QString, QSharedPointer<const KoColorConversionLut3D>> lutCache;
+
+    /// serializes building of the tables, never taken together with the registry lock
+    QMutex lutBuildMutex;
 };
 
 struct PathQualityChecker {
@@ -22,6 +22,7 @@
 #include "KoConvolutionOpImpl.h"
 #include "KoInvertColorTransformation.h"
 #include "KoAlphaMaskApplicatorFactory.h"
+#include "KoOptimizedMixColorsOpFactory.h"
 #include "KoColorModelStandardIdsUtils.h"
 
 /**
@@ -42,7 +43,7 @@ public:
 
 public:
     KoColorSpaceAbstract(const QString &id, const QString &name)
-        : KoColorSpace(id, name, new KoMixColorsOpImpl< _CSTrait>(), new KoConvolutionOpImpl< _CSTrait>()),
+        : KoColorSpace(id, name, createMixColorsOp(), new KoConvolutionOpImpl< _CSTrait>()),
           m_alphaMaskApplicator(KoAlphaMaskApplicatorFactory::create(colorDepthIdForChannelType<typename _CSTrait::channels_type>(), _CSTrait::channels_nb, _CSTrait::alpha_pos))
     {
     }
@@ -214,6 +215,14 @@ public:
         }
     }
 
+private:
+    static KoMixColorsOp* createMixColorsOp() {
+        KoMixColorsOp *op =
+            KoOptimizedMixColorsOpFactory::create(colorDepthIdForChannelType<typename _CSTrait::channels_type>(),
+                                                  _CSTrait::channels_nb, _CSTrait::alpha_pos);
+        return op ? op : new KoMixColorsOpImpl<_CSTrait>();
+    }
+
 private:
     QScopedPointer<KoAlphaMaskApplicatorBase> m_alphaMaskApplicator;
 };
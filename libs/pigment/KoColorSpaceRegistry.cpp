@@ -10,6 +10,7 @@
 #include <QHash>
 
 #include <QReadWriteLock>
+#include <QScopedPointer>
 #include <QDir>
 #include <QGlobalStatic>
 
@@ -130,6 +131,12 @@ struct KoColorSpaceRegistry::Private::ConversionSystemInterface : public KoColor
         return csfs;
     }
 
+    void colorConvertersInvalidated() override {
+        if (q->d->colorConversionCache) {
+            q->d->colorConversionCache->clear();
+        }
+    }
+
 private:
     KoColorSpaceRegistry *q {nullptr};
 };
@@ -357,8 +364,31 @@ QString KoColorSpaceRegistry::defaultProfileForColorSpace(const QString &colorSp
 
 KoColorConversionTransformation *KoColorSpaceRegistry::createColorConverter(const KoColorSpace *srcColorSpace, const KoColorSpace *dstColorSpace, KoColorConversionTransformation::Intent renderingIntent, KoColorConversionTransformation::ConversionFlags conversionFlags) const
 {
-    QWriteLocker l(&d->registrylock);
-    return d->colorConversionSystem->createColorConverter(srcColorSpace, dstColorSpace, renderingIntent, conversionFlags);
+    KoColorConversionTransformation *transformation = 0;
+    QScopedPointer<KoColorConversionTransformation> toLabTransformation;
+
+    {
+        QWriteLocker l(&d->registrylock);
+        transformation = d->colorConversionSystem->createColorConverter(srcColorSpace, dstColorSpace, renderingIntent, conversionFlags);
+
+        if (!d->colorConversionSystem->canApproximateWithLut(transformation)) {
+            return transformation;
+        }
+
+        toLabTransformation.reset(d->colorConversionSystem->createLutValidationConverter(transformation));
+
+        if (!toLabTransformation) {
+            return transformation;
+        }
+    }
+
+    /**
+     * Building a lookup table runs hundreds of thousands of exact
+     * conversions, so it is done without holding the registry lock.
+     * It still happens in the calling thread, see the note in
+     * KoColorConversionSystem::setLutConversionTolerance().
+     */
+    return d->colorConversionSystem->approximateWithLut(transformation, toLabTransformation.data());
 }
 
 void KoColorSpaceRegistry::createColorConverters(const KoColorSpace *colorSpace, const QList<QPair<KoID, KoID> > &possibilities, KoColorConversionTransformation *&fromCS, KoColorConversionTransformation *&toCS) const
@@ -0,0 +1,285 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KoLutColorConversionTransformation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <QVector>
+
+#include "KoColorSpace.h"
+#include "KoColorProfile.h"
+#include "KoColorSpaceMaths.h"
+#include "KoColorModelStandardIds.h"
+#include "KoColorConversionLut3DEvaluatorFactoryImpl.h"
+
+namespace {
+
+/**
+ * The number of nodes along every axis of the grid, starting from the
+ * smallest one. (gridSize - 1) divides both 255 and 65535, so the nodes
+ * of the grid are exactly representable in the source channel type.
+ */
+const int gridSizes[] = {18, 52, 86};
+
+const int numRandomSamples = 16384;
+const int numRampSamples = 256;
+
+/**
+ * The validation set consists of random colors and of the ramps along
+ * the edges and the main diagonal of the RGB cube, where the conversion
+ * is usually the least smooth due to the gamut clipping.
+ */
+template<typename channel_t>
+QVector<channel_t> validationSamples()
+{
+    const int unit = KoColorSpaceMathsTraits<channel_t>::unitValue;
+
+    QVector<channel_t> samples;
+    samples.reserve(4 * (numRandomSamples + 7 * numRampSamples));
+
+    auto addSample = [&samples, unit] (int red, int green, int blue) {
+        samples << channel_t(blue) << channel_t(green) << channel_t(red) << channel_t(unit);
+    };
+
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<int> distribution(0, unit);
+
+    for (int i = 0; i < numRandomSamples; i++) {
+        const int red = distribution(generator);
+        const int green = distribution(generator);
+        const int blue = distribution(generator);
+        addSample(red, green, blue);
+    }
+
+    for (int i = 0; i < numRampSamples; i++) {
+        const int value = i * unit / (numRampSamples - 1);
+
+        addSample(value, value, value);
+
+        addSample(value, 0, 0);
+        addSample(0, value, 0);
+        addSample(0, 0, value);
+
+        addSample(value, unit, unit);
+        addSample(unit, value, unit);
+        addSample(unit, unit, value);
+    }
+
+    return samples;
+}
+
+/**
+ * @return the maximum CIE76 difference between two arrays of LabA U16
+ *         pixels
+ */
+qreal maxDeltaE(const quint16 *lab1, const quint16 *lab2, int nPixels)
+{
+    qreal result = 0.0;
+
+    for (int i = 0; i < nPixels; i++) {
+        const qreal dL = (qreal(lab1[0]) - lab2[0]) * 100.0 / 65535.0;
+        const qreal da = (qreal(lab1[1]) - lab2[1]) / 257.0;
+        const qreal db = (qreal(lab1[2]) - lab2[2]) / 257.0;
+
+        result = qMax(result, std::sqrt(dL * dL + da * da + db * db));
+
+        lab1 += 4;
+        lab2 += 4;
+    }
+
+    return result;
+}
+
+template<typename src_channel_t, typename dst_channel_t>
+QSharedPointer<const KoColorConversionLut3D>
+createLutImpl(const KoColorConversionTransformation *exactTransformation,
+              const KoColorConversionTransformation *toLabTransformation,
+              qreal maxAllowedDeltaE)
+{
+    const int srcUnit = KoColorSpaceMathsTraits<src_channel_t>::unitValue;
+    const int numColorChannels = exactTransformation->dstColorSpace()->colorChannelCount();
+    const int dstChannelsNb = numColorChannels + 1;
+
+    const QVector<src_channel_t> samples = validationSamples<src_channel_t>();
+    const int numSamples = samples.size() / 4;
+
+    QVector<dst_channel_t> exactResult(numSamples * dstChannelsNb);
+    exactTransformation->transform(reinterpret_cast<const quint8*>(samples.constData()),
+                                   reinterpret_cast<quint8*>(exactResult.data()),
+                                   numSamples);
+
+    QVector<quint16> exactLab(numSamples * 4);
+    toLabTransformation->transform(reinterpret_cast<const quint8*>(exactResult.constData()),
+                                   reinterpret_cast<quint8*>(exactLab.data()),
+                                   numSamples);
+
+    QVector<dst_channel_t> lutResult(numSamples * dstChannelsNb);
+    QVector<quint16> lutLab(numSamples * 4);
+
+    for (const int gridSize : gridSizes) {
+        const int numNodes = gridSize * gridSize * gridSize;
+        const int step = srcUnit / (gridSize - 1);
+
+        QVector<src_channel_t> nodes;
+        nodes.reserve(numNodes * 4);
+
+        for (int blue = 0; blue < gridSize; blue++) {
+            for (int green = 0; green < gridSize; green++) {
+                for (int red = 0; red < gridSize; red++) {
+                    nodes << src_channel_t(blue * step)
+                          << src_channel_t(green * step)
+                          << src_channel_t(red * step)
+                          << src_channel_t(srcUnit);
+                }
+            }
+        }
+
+        QVector<dst_channel_t> nodeValues(numNodes * dstChannelsNb);
+        exactTransformation->transform(reinterpret_cast<const quint8*>(nodes.constData()),
+                                       reinterpret_cast<quint8*>(nodeValues.data()),
+                                       numNodes);
+
+        QSharedPointer<KoColorConversionLut3D> lut(new KoColorConversionLut3D());
+        lut->gridSize = gridSize;
+        lut->numColorChannels = numColorChannels;
+        lut->table.resize(numNodes * numColorChannels * int(sizeof(dst_channel_t)));
+        lut->evaluator.reset(
+            createOptimizedClass<KoColorConversionLut3DEvaluatorFactoryImpl<src_channel_t, dst_channel_t>>());
+
+        dst_channel_t *table = reinterpret_cast<dst_channel_t*>(lut->table.data());
+        const dst_channel_t *nodeValue = nodeValues.constData();
+
+        for (int i = 0; i < numNodes; i++) {
+            std::copy(nodeValue, nodeValue + numColorChannels, table);
+            table += numColorChannels;
+            nodeValue += dstChannelsNb;
+        }
+
+        lut->evaluate(reinterpret_cast<const quint8*>(samples.constData()),
+                      reinterpret_cast<quint8*>(lutResult.data()),
+                      numSamples);
+
+        toLabTransformation->transform(reinterpret_cast<const quint8*>(lutResult.constData()),
+                                       reinterpret_cast<quint8*>(lutLab.data()),
+                                       numSamples);
+
+        if (maxDeltaE(exactLab.constData(), lutLab.constData(), numSamples) <= maxAllowedDeltaE) {
+            return lut;
+        }
+    }
+
+    return QSharedPointer<const KoColorConversionLut3D>();
+}
+
+template<typename src_channel_t>
+QSharedPointer<const KoColorConversionLut3D>
+createLutForSrcDepth(const KoColorConversionTransformation *exactTransformation,
+                     const KoColorConversionTransformation *toLabTransformation,
+                     qreal maxAllowedDeltaE)
+{
+    const KoID dstDepth = exactTransformation->dstColorSpace()->colorDepthId();
+
+    if (dstDepth == Integer8BitsColorDepthID) {
+        return createLutImpl<src_channel_t, quint8>(exactTransformation, toLabTransformation, maxAllowedDeltaE);
+    } else if (dstDepth == Integer16BitsColorDepthID) {
+        return createLutImpl<src_channel_t, quint16>(exactTransformation, toLabTransformation, maxAllowedDeltaE);
+    }
+
+    return QSharedPointer<const KoColorConversionLut3D>();
+}
+
+bool isIntegerDepth(const KoColorSpace *cs)
+{
+    return cs->colorDepthId() == Integer8BitsColorDepthID ||
+        cs->colorDepthId() == Integer16BitsColorDepthID;
+}
+
+}
+
+KoLutColorConversionTransformation::KoLutColorConversionTransformation(const KoColorSpace *srcCs,
+                                                                       const KoColorSpace *dstCs,
+                                                                       Intent renderingIntent,
+                                                                       ConversionFlags conversionFlags,
+                                                                       QSharedPointer<const KoColorConversionLut3D> lut)
+    : KoColorConversionTransformation(srcCs, dstCs, renderingIntent, conversionFlags)
+    , m_lut(lut)
+{
+}
+
+void KoLutColorConversionTransformation::transform(const quint8 *src, quint8 *dst, qint32 nPixels) const
+{
+    m_lut->evaluate(src, dst, nPixels);
+}
+
+QSharedPointer<const KoColorConversionLut3D> KoLutColorConversionTransformation::lut() const
+{
+    return m_lut;
+}
+
+bool KoLutColorConversionTransformation::canUseLut(const KoColorSpace *srcCs,
+                                                   const KoColorSpace *dstCs,
+                                                   ConversionFlags conversionFlags)
+{
+    if (conversionFlags & (GamutCheck | SoftProofing)) {
+        return false;
+    }
+
+    if (srcCs->colorModelId() != RGBAColorModelID ||
+        !isIntegerDepth(srcCs) ||
+        srcCs->channelCount() != 4 ||
+        srcCs->alphaPos() != 3) {
+
+        return false;
+    }
+
+    if (!isIntegerDepth(dstCs) ||
+        dstCs->colorChannelCount() > 4 ||
+        dstCs->channelCount() != dstCs->colorChannelCount() + 1 ||
+        dstCs->alphaPos() != dstCs->colorChannelCount()) {
+
+        return false;
+    }
+
+    /**
+     * A conversion that changes the channel depth only is already
+     * cheap, there is no need to approximate it.
+     */
+    const KoColorProfile *srcProfile = srcCs->profile();
+    const KoColorProfile *dstProfile = dstCs->profile();
+
+    if (srcCs->colorModelId() == dstCs->colorModelId() &&
+        (srcProfile == dstProfile ||
+         (srcProfile && dstProfile && *srcProfile == *dstProfile))) {
+
+        return false;
+    }
+
+    return true;
+}
+
+QSharedPointer<const KoColorConversionLut3D>
+KoLutColorConversionTransformation::createLut(const KoColorConversionTransformation *exactTransformation,
+                                              const KoColorConversionTransformation *toLabTransformation,
+                                              qreal maxDeltaE)
+{
+    if (!canUseLut(exactTransformation->srcColorSpace(),
+                   exactTransformation->dstColorSpace(),
+                   exactTransformation->conversionFlags())) {
+
+        return QSharedPointer<const KoColorConversionLut3D>();
+    }
+
+    const KoID srcDepth = exactTransformation->srcColorSpace()->colorDepthId();
+
+    if (srcDepth == Integer8BitsColorDepthID) {
+        return createLutForSrcDepth<quint8>(exactTransformation, toLabTransformation, maxDeltaE);
+    } else {
+        return createLutForSrcDepth<quint16>(exactTransformation, toLabTransformation, maxDeltaE);
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOLUTCOLORCONVERSIONTRANSFORMATION_H
+#define KOLUTCOLORCONVERSIONTRANSFORMATION_H
+
+#include <QSharedPointer>
+
+#include "KoColorConversionTransformation.h"
+#include "KoColorConversionLut3D.h"
+
+#include "kritapigment_export.h"
+
+/**
+ * A color conversion transformation that approximates an exact (usually
+ * ICC-based) conversion from an 8- or 16-bit RGBA color space with a
+ * precomputed 3D lookup table. The color channels are found with
+ * tetrahedral interpolation of the table, the alpha channel is copied
+ * with scaling to the destination channel depth.
+ *
+ * The transformation is created by KoColorConversionSystem when
+ * the LUT conversions are enabled, see
+ * KoColorConversionSystem::setLutConversionTolerance().
+ */
+class KRITAPIGMENT_EXPORT KoLutColorConversionTransformation : public KoColorConversionTransformation
+{
+public:
+    KoLutColorConversionTransformation(const KoColorSpace *srcCs,
+                                       const KoColorSpace *dstCs,
+                                       Intent renderingIntent,
+                                       ConversionFlags conversionFlags,
+                                       QSharedPointer<const KoColorConversionLut3D> lut);
+
+    void transform(const quint8 *src, quint8 *dst, qint32 nPixels) const override;
+
+    QSharedPointer<const KoColorConversionLut3D> lut() const;
+
+    /**
+     * @return true if the conversion from \p srcCs to \p dstCs can be
+     * approximated with a lookup table. The source color space should be
+     * an RGBA U8 or U16 one, the destination one should be U8 or U16 with
+     * at most four color channels followed by the alpha channel. Gamut
+     * check and soft proofing conversions are never approximated.
+     */
+    static bool canUseLut(const KoColorSpace *srcCs,
+                          const KoColorSpace *dstCs,
+                          ConversionFlags conversionFlags);
+
+    /**
+     * Samples \p exactTransformation into a lookup table. The grid size is
+     * selected as the smallest one, for which the approximation differs
+     * from the exact conversion by not more than \p maxDeltaE (CIE76) on
+     * a fixed validation set of colors.
+     *
+     * \p toLabTransformation is used to measure the difference. It should
+     * convert the destination color space of \p exactTransformation into
+     * LabA U16.
+     *
+     * @return the lookup table or null if none of the grid sizes fits
+     *         into the tolerance
+     */
+    static QSharedPointer<const KoColorConversionLut3D>
+    createLut(const KoColorConversionTransformation *exactTransformation,
+              const KoColorConversionTransformation *toLabTransformation,
+              qreal maxDeltaE);
+
+private:
+    QSharedPointer<const KoColorConversionLut3D> m_lut;
+};
+
+#endif // KOLUTCOLORCONVERSIONTRANSFORMATION_H
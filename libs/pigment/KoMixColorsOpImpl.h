@@ -95,7 +95,7 @@ public:
         }
     }
 
-private:
+protected:
     class MixerImpl;
 
     struct ArrayOfPointers {
@@ -290,6 +290,28 @@ private:
             normalizeFactor += weightsWrapper.normalizeFactor();
         }
 
+        /**
+         * Adds the totals calculated outside of accumulateColors(), e.g.
+         * by a vectorized version of it. \p colorTotals is indexed by the
+         * channel position, its alpha slot is ignored.
+         */
+        void accumulateTotals(const mix_type *colorTotals, mix_type alphaTotal, qint64 weightsSum, int nColors) {
+#ifdef SANITY_CHECKS
+            m_numPixels += nColors;
+#else
+            Q_UNUSED(nColors);
+#endif
+
+            for (int i = 0; i < (int)_CSTrait::channels_nb; i++) {
+                if (i != _CSTrait::alpha_pos) {
+                    totals[i] += colorTotals[i];
+                }
+            }
+
+            totalAlpha += alphaTotal;
+            normalizeFactor += weightsSum;
+        }
+
         qint64 currentWeightsSum() const
         {
             return normalizeFactor;
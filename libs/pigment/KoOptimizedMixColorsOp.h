@@ -0,0 +1,436 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOOPTIMIZEDMIXCOLORSOP_H
+#define KOOPTIMIZEDMIXCOLORSOP_H
+
+#include "KoMixColorsOpImpl.h"
+#include "KoColorSpaceTraits.h"
+#include "KoMultiArchBuildSupport.h"
+
+/**
+ * A version of KoMixColorsOpImpl with vectorized accumulation of the
+ * contiguous arrays of pixels. The generic version is just the scalar
+ * implementation, the vectorized one is provided for RGBA-like color
+ * spaces (four channels, alpha in the last one) in U8, U16 and F32.
+ */
+template<typename _CSTrait,
+         typename _impl,
+         typename EnableDummyType = void>
+class KoOptimizedMixColorsOp : public KoMixColorsOpImpl<_CSTrait>
+{
+};
+
+#if defined(HAVE_XSIMD) && !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE)
+
+#include "KoStreamedMath.h"
+
+template<typename channels_type, typename _impl>
+struct KoStreamedMixAccumulator;
+
+/**
+ * Accumulates the totals of KoMixColorsOpImpl::MixDataResult for pixels
+ * with integer channels.
+ *
+ * The product channel * alpha * weight does not fit into a 32-bit lane,
+ * but the product channel * alpha does (as an unsigned value). It is split
+ * into the high and the low 16-bit words, each of them is multiplied by
+ * the weight and summed separately. The lane sums are flushed into 64-bit
+ * totals before they may overflow, so the result is exactly the same as
+ * the one of the scalar version.
+ */
+template<typename channels_type, typename _impl>
+struct KoStreamedMixIntegerAccumulator
+{
+    using int_v = xsimd::batch<int, _impl>;
+    using uint_v = xsimd::batch<unsigned int, _impl>;
+    using mix_type = typename KoColorSpaceMathsTraits<channels_type>::mixtype;
+
+    static constexpr int vectorSize = static_cast<int>(int_v::size);
+    static constexpr int pixelSize = 4 * sizeof(channels_type);
+    static constexpr bool hasHighWord = std::is_same<channels_type, quint16>::value;
+
+    /// the maximum value added to a lane sum per pixel with unit weight
+    static constexpr qint64 maxLaneIncrement = hasHighWord ? 0xFFFF : 255 * 255;
+
+    static ALWAYS_INLINE void read(const quint8 *src, uint_v channels[4])
+    {
+        if constexpr (std::is_same<channels_type, quint8>::value) {
+            const uint_v data = uint_v::load_unaligned(reinterpret_cast<const quint32*>(src));
+            const uint_v mask(0xFF);
+
+            channels[0] = data & mask;
+            channels[1] = (data >> 8) & mask;
+            channels[2] = (data >> 16) & mask;
+            channels[3] = data >> 24;
+        } else {
+#if XSIMD_VERSION_MAJOR < 10
+            uint_v pixelsC1C2;
+            uint_v pixelsC3Alpha;
+            KoRgbaInterleavers<16>::deinterleave(src, pixelsC1C2, pixelsC3Alpha);
+#else
+            const auto *srcPtr = reinterpret_cast<const typename uint_v::value_type *>(src);
+            const auto idx1 = xsimd::detail::make_sequence_as_batch<int_v>() * 2; // stride == 2
+            const auto idx2 = idx1 + 1;
+
+            const uint_v pixelsC1C2 = uint_v::gather(srcPtr, idx1);
+            const uint_v pixelsC3Alpha = uint_v::gather(srcPtr, idx2);
+#endif
+            const uint_v mask(0xFFFF);
+
+            channels[0] = pixelsC1C2 & mask;
+            channels[1] = pixelsC1C2 >> 16;
+            channels[2] = pixelsC3Alpha & mask;
+            channels[3] = pixelsC3Alpha >> 16;
+        }
+    }
+
+    template<bool useWeights>
+    static void accumulate(const quint8 *pixels, const qint16 *weights, int nPixels,
+                           mix_type *colorTotals, mix_type &alphaTotal)
+    {
+        const int block1 = nPixels / vectorSize;
+        const int block2 = nPixels % vectorSize;
+
+        int maxAbsWeight = 1;
+        if (useWeights) {
+            for (int i = 0; i < block1 * vectorSize; i++) {
+                maxAbsWeight = qMax(maxAbsWeight, qAbs(int(weights[i])));
+            }
+        }
+
+        const int iterationsPerFlush =
+            qMax(1, int(std::numeric_limits<int>::max() / (maxLaneIncrement * maxAbsWeight)));
+
+        int_v lowSums[3];
+        int_v highSums[3];
+        int_v alphaSum;
+
+        auto resetSums = [&] () {
+            for (int k = 0; k < 3; k++) {
+                lowSums[k] = int_v(0);
+                highSums[k] = int_v(0);
+            }
+            alphaSum = int_v(0);
+        };
+
+        alignas(_impl::alignment()) int buffer[vectorSize];
+
+        auto addLanes = [&buffer] (const int_v &sum, mix_type &total, mix_type multiplier) {
+            sum.store_aligned(buffer);
+            for (int i = 0; i < vectorSize; i++) {
+                total += mix_type(buffer[i]) * multiplier;
+            }
+        };
+
+        auto flushSums = [&] () {
+            for (int k = 0; k < 3; k++) {
+                addLanes(lowSums[k], colorTotals[k], 1);
+                if (hasHighWord) {
+                    addLanes(highSums[k], colorTotals[k], 0x10000);
+                }
+            }
+            addLanes(alphaSum, alphaTotal, 1);
+            resetSums();
+        };
+
+        resetSums();
+
+        const uint_v lowWordMask(0xFFFF);
+        alignas(_impl::alignment()) int weightsBuffer[vectorSize];
+        int iterationsLeft = iterationsPerFlush;
+
+        for (int b = 0; b < block1; b++) {
+            uint_v channels[4];
+            read(pixels, channels);
+
+            int_v weight(1);
+            if (useWeights) {
+                for (int i = 0; i < vectorSize; i++) {
+                    weightsBuffer[i] = weights[i];
+                }
+                weight = int_v::load_aligned(weightsBuffer);
+                weights += vectorSize;
+            }
+
+            const uint_v alpha = channels[3];
+
+            for (int k = 0; k < 3; k++) {
+                const uint_v product = channels[k] * alpha;
+
+                int_v low = xsimd::bitwise_cast_compat<int>(hasHighWord ? product & lowWordMask : product);
+                if (useWeights) {
+                    low *= weight;
+                }
+                lowSums[k] += low;
+
+                if (hasHighWord) {
+                    int_v high = xsimd::bitwise_cast_compat<int>(product >> 16);
+                    if (useWeights) {
+                        high *= weight;
+                    }
+                    highSums[k] += high;
+                }
+            }
+
+            int_v alphaTimesWeight = xsimd::bitwise_cast_compat<int>(alpha);
+            if (useWeights) {
+                alphaTimesWeight *= weight;
+            }
+            alphaSum += alphaTimesWeight;
+
+            pixels += vectorSize * pixelSize;
+
+            if (--iterationsLeft == 0) {
+                flushSums();
+                iterationsLeft = iterationsPerFlush;
+            }
+        }
+
+        flushSums();
+
+        for (int i = 0; i < block2; i++) {
+            const channels_type *color = reinterpret_cast<const channels_type*>(pixels);
+
+            mix_type alphaTimesWeight = color[3];
+            if (useWeights) {
+                alphaTimesWeight *= weights[i];
+            }
+
+            for (int k = 0; k < 3; k++) {
+                colorTotals[k] += color[k] * alphaTimesWeight;
+            }
+            alphaTotal += alphaTimesWeight;
+
+            pixels += pixelSize;
+        }
+    }
+};
+
+template<typename _impl>
+struct KoStreamedMixAccumulator<quint8, _impl> : KoStreamedMixIntegerAccumulator<quint8, _impl> {};
+
+template<typename _impl>
+struct KoStreamedMixAccumulator<quint16, _impl> : KoStreamedMixIntegerAccumulator<quint16, _impl> {};
+
+/**
+ * Accumulates the totals of KoMixColorsOpImpl::MixDataResult for pixels
+ * with float channels.
+ *
+ * The products are summed in float lanes, which are flushed into the
+ * double totals every few iterations to keep the rounding error small.
+ * Unlike the integer version, the result may differ from the scalar one
+ * in the last bits.
+ */
+template<typename _impl>
+struct KoStreamedMixAccumulator<float, _impl>
+{
+    using int_v = xsimd::batch<int, _impl>;
+    using float_v = xsimd::batch<float, _impl>;
+    using mix_type = typename KoColorSpaceMathsTraits<float>::mixtype;
+
+    static constexpr int vectorSize = static_cast<int>(float_v::size);
+    static constexpr int pixelSize = 4 * sizeof(float);
+    static constexpr int iterationsPerFlush = 64;
+
+    static ALWAYS_INLINE void read(const quint8 *src, float_v channels[4])
+    {
+#if XSIMD_VERSION_MAJOR < 10
+        KoRgbaInterleavers<32>::deinterleave(src, channels[0], channels[1], channels[2], channels[3]);
+#else
+        const auto srcPtr = reinterpret_cast<const typename float_v::value_type *>(src);
+        const auto idx1 = xsimd::detail::make_sequence_as_batch<int_v>() * 4; // stride == 4
+
+        channels[0] = float_v::gather(srcPtr, idx1);
+        channels[1] = float_v::gather(srcPtr, idx1 + 1);
+        channels[2] = float_v::gather(srcPtr, idx1 + 2);
+        channels[3] = float_v::gather(srcPtr, idx1 + 3);
+#endif
+    }
+
+    template<bool useWeights>
+    static void accumulate(const quint8 *pixels, const qint16 *weights, int nPixels,
+                           mix_type *colorTotals, mix_type &alphaTotal)
+    {
+        const int block1 = nPixels / vectorSize;
+        const int block2 = nPixels % vectorSize;
+
+        float_v sums[3];
+        float_v alphaSum;
+
+        auto resetSums = [&] () {
+            for (int k = 0; k < 3; k++) {
+                sums[k] = float_v(0.0f);
+            }
+            alphaSum = float_v(0.0f);
+        };
+
+        alignas(_impl::alignment()) float buffer[vectorSize];
+
+        auto addLanes = [&buffer] (const float_v &sum, mix_type &total) {
+            sum.store_aligned(buffer);
+            for (int i = 0; i < vectorSize; i++) {
+                total += buffer[i];
+            }
+        };
+
+        auto flushSums = [&] () {
+            for (int k = 0; k < 3; k++) {
+                addLanes(sums[k], colorTotals[k]);
+            }
+            addLanes(alphaSum, alphaTotal);
+            resetSums();
+        };
+
+        resetSums();
+
+        alignas(_impl::alignment()) float weightsBuffer[vectorSize];
+        int iterationsLeft = iterationsPerFlush;
+
+        for (int b = 0; b < block1; b++) {
+            float_v channels[4];
+            read(pixels, channels);
+
+            float_v alphaTimesWeight = channels[3];
+            if (useWeights) {
+                for (int i = 0; i < vectorSize; i++) {
+                    weightsBuffer[i] = weights[i];
+                }
+                alphaTimesWeight *= float_v::load_aligned(weightsBuffer);
+                weights += vectorSize;
+            }
+
+            for (int k = 0; k < 3; k++) {
+                sums[k] += channels[k] * alphaTimesWeight;
+            }
+            alphaSum += alphaTimesWeight;
+
+            pixels += vectorSize * pixelSize;
+
+            if (--iterationsLeft == 0) {
+                flushSums();
+                iterationsLeft = iterationsPerFlush;
+            }
+        }
+
+        flushSums();
+
+        for (int i = 0; i < block2; i++) {
+            const float *color = reinterpret_cast<const float*>(pixels);
+
+            mix_type alphaTimesWeight = color[3];
+            if (useWeights) {
+                alphaTimesWeight *= weights[i];
+            }
+
+            for (int k = 0; k < 3; k++) {
+                colorTotals[k] += color[k] * alphaTimesWeight;
+            }
+            alphaTotal += alphaTimesWeight;
+
+            pixels += pixelSize;
+        }
+    }
+};
+
+template<typename _CSTrait, typename _impl>
+class KoOptimizedMixColorsOp<
+        _CSTrait, _impl,
+        typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value>::type> : public KoMixColorsOpImpl<_CSTrait>
+{
+    using base_class = KoMixColorsOpImpl<_CSTrait>;
+    using channels_type = typename _CSTrait::channels_type;
+    using mix_type = typename KoColorSpaceMathsTraits<channels_type>::mixtype;
+    using MixDataResult = typename base_class::MixDataResult;
+    using Accumulator = KoStreamedMixAccumulator<channels_type, _impl>;
+
+    static_assert(_CSTrait::channels_nb == 4 && _CSTrait::alpha_pos == 3,
+                  "only the color spaces with four channels and alpha in the last one are supported");
+
+public:
+    using base_class::mixColors;
+
+    void mixColors(const quint8 *colors, const qint16 *weights, int nColors, quint8 *dst, int weightSum = 255) const override
+    {
+        MixDataResult result;
+        accumulate<true>(result, colors, weights, weightSum, nColors);
+        result.computeMixedColor(dst);
+    }
+
+    void mixColors(const quint8 *colors, int nColors, quint8 *dst) const override
+    {
+        MixDataResult result;
+        accumulate<false>(result, colors, nullptr, nColors, nColors);
+        result.computeMixedColor(dst);
+    }
+
+    KoMixColorsOp::Mixer *createMixer() const override
+    {
+        return new OptimizedMixerImpl();
+    }
+
+private:
+    template<bool useWeights>
+    static void accumulate(MixDataResult &result, const quint8 *colors, const qint16 *weights, int weightSum, int nColors)
+    {
+        /**
+         * The smudge sampler feeds the mixer one pixel at a time, for such
+         * short arrays the setup of the vector sums costs more than it
+         * saves, so just use the scalar version.
+         */
+        if (nColors < Accumulator::vectorSize) {
+            using PointerToArray = typename base_class::PointerToArray;
+
+            if constexpr (useWeights) {
+                result.accumulateColors(PointerToArray(colors, _CSTrait::pixelSize),
+                                        typename base_class::WeightsWrapper(weights, weightSum),
+                                        nColors);
+            } else {
+                result.accumulateColors(PointerToArray(colors, _CSTrait::pixelSize),
+                                        typename base_class::NoWeightsSurrogate(nColors),
+                                        nColors);
+            }
+            return;
+        }
+
+        mix_type colorTotals[_CSTrait::channels_nb] = {};
+        mix_type alphaTotal = 0;
+
+        Accumulator::template accumulate<useWeights>(colors, weights, nColors, colorTotals, alphaTotal);
+        result.accumulateTotals(colorTotals, alphaTotal, weightSum, nColors);
+    }
+
+    class OptimizedMixerImpl : public KoMixColorsOp::Mixer
+    {
+    public:
+        void accumulate(const quint8 *data, const qint16 *weights, int weightSum, int nPixels) override
+        {
+            KoOptimizedMixColorsOp::template accumulate<true>(result, data, weights, weightSum, nPixels);
+        }
+
+        void accumulateAverage(const quint8 *data, int nPixels) override
+        {
+            KoOptimizedMixColorsOp::template accumulate<false>(result, data, nullptr, nPixels, nPixels);
+        }
+
+        void computeMixedColor(quint8 *data) override
+        {
+            result.computeMixedColor(data);
+        }
+
+        qint64 currentWeightsSum() const override
+        {
+            return result.currentWeightsSum();
+        }
+
+    private:
+        MixDataResult result;
+    };
+};
+
+#endif /* HAVE_XSIMD */
+
+#endif // KOOPTIMIZEDMIXCOLORSOP_H
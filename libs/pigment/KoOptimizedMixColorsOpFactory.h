@@ -0,0 +1,29 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOOPTIMIZEDMIXCOLORSOPFACTORY_H
+#define KOOPTIMIZEDMIXCOLORSOPFACTORY_H
+
+#include "kritapigment_export.h"
+
+#include <KoID.h>
+
+class KoMixColorsOp;
+
+/**
+ * \see KoOptimizedMixColorsOp
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedMixColorsOpFactory
+{
+public:
+    /**
+     * @return a mix colors op optimized for the current CPU or null if
+     *         there is no optimized version for the specified pixel format
+     */
+    static KoMixColorsOp* create(const KoID &depthId, int numChannels, int alphaPos);
+};
+
+#endif // KOOPTIMIZEDMIXCOLORSOPFACTORY_H
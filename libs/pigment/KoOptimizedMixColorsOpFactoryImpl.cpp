@@ -0,0 +1,24 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KoOptimizedMixColorsOpFactoryImpl.h"
+
+#if XSIMD_UNIVERSAL_BUILD_PASS
+#include "KoOptimizedMixColorsOp.h"
+
+template<typename _channels_type_>
+template<typename _impl>
+KoMixColorsOp *
+KoOptimizedMixColorsOpFactoryImpl<_channels_type_>::create()
+{
+    return new KoOptimizedMixColorsOp<KoColorSpaceTrait<_channels_type_, 4, 3>, _impl>();
+}
+
+template KoMixColorsOp* KoOptimizedMixColorsOpFactoryImpl<quint8>::create<xsimd::current_arch>();
+template KoMixColorsOp* KoOptimizedMixColorsOpFactoryImpl<quint16>::create<xsimd::current_arch>();
+template KoMixColorsOp* KoOptimizedMixColorsOpFactoryImpl<float>::create<xsimd::current_arch>();
+
+#endif // XSIMD_UNIVERSAL_BUILD_PASS
@@ -0,0 +1,23 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOOPTIMIZEDMIXCOLORSOPFACTORYIMPL_H
+#define KOOPTIMIZEDMIXCOLORSOPFACTORYIMPL_H
+
+#include <KoMixColorsOp.h>
+#include <KoMultiArchBuildSupport.h>
+
+#include "kritapigment_export.h"
+
+template<typename _channels_type_>
+class KRITAPIGMENT_EXPORT KoOptimizedMixColorsOpFactoryImpl
+{
+public:
+    template<typename _impl>
+    static KoMixColorsOp *create();
+};
+
+#endif // KOOPTIMIZEDMIXCOLORSOPFACTORYIMPL_H
@@ -0,0 +1,212 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KoColorConversionBenchmark.h"
+
+#include <simpletest.h>
+
+#include <QDebug>
+#include <QRandomGenerator>
+#include <QThread>
+
+#include <KoBatchedColorConversion.h>
+#include <KoColorModelStandardIds.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoLutColorConversionTransformation.h>
+
+namespace {
+
+// the size of one tile of a paint device
+const int TILE_PIXELS = 64 * 64;
+const int NB_PIXELS = 2048 * 2048;
+
+struct ConversionInfo {
+    const char *name;
+    KoID srcModel;
+    KoID srcDepth;
+    KoID dstModel;
+    KoID dstDepth;
+};
+
+QVector<ConversionInfo> conversions()
+{
+    return {
+        {"rgb16-cmyk16", RGBAColorModelID, Integer16BitsColorDepthID, CMYKAColorModelID, Integer16BitsColorDepthID},
+        {"rgb16-cmyk8", RGBAColorModelID, Integer16BitsColorDepthID, CMYKAColorModelID, Integer8BitsColorDepthID},
+        {"rgb8-lab16", RGBAColorModelID, Integer8BitsColorDepthID, LABAColorModelID, Integer16BitsColorDepthID}
+    };
+}
+
+void addColorSpacesColumns()
+{
+    QTest::addColumn<QString>("srcModelID");
+    QTest::addColumn<QString>("srcDepthID");
+    QTest::addColumn<QString>("dstModelID");
+    QTest::addColumn<QString>("dstDepthID");
+}
+
+QTestData &addColorSpacesRow(const ConversionInfo &info, const QString &suffix = QString())
+{
+    return QTest::addRow("%s%s", info.name, suffix.toLatin1().data())
+        << info.srcModel.id() << info.srcDepth.id() << info.dstModel.id() << info.dstDepth.id();
+}
+
+struct ConversionData
+{
+    ConversionData(const KoColorSpace *_srcCs, const KoColorSpace *_dstCs)
+        : srcCs(_srcCs),
+          dstCs(_dstCs),
+          src(NB_PIXELS * _srcCs->pixelSize()),
+          dst(NB_PIXELS * _dstCs->pixelSize())
+    {
+        QRandomGenerator rnd(1);
+        for (int i = 0; i < src.size(); i++) {
+            src[i] = quint8(rnd.bounded(256));
+        }
+    }
+
+    const KoColorSpace *srcCs;
+    const KoColorSpace *dstCs;
+    QVector<quint8> src;
+    QVector<quint8> dst;
+};
+
+#define FETCH_COLOR_SPACES \
+    QFETCH(QString, srcModelID); \
+    QFETCH(QString, srcDepthID); \
+    QFETCH(QString, dstModelID); \
+    QFETCH(QString, dstDepthID); \
+    \
+    const KoColorSpace *srcCs = KoColorSpaceRegistry::instance()->colorSpace(srcModelID, srcDepthID, 0); \
+    const KoColorSpace *dstCs = KoColorSpaceRegistry::instance()->colorSpace(dstModelID, dstDepthID, 0); \
+    if (!srcCs || !dstCs) { \
+        QSKIP("the color spaces are not available"); \
+    }
+
+}
+
+void KoColorConversionBenchmark::benchmarkConvertPixels_data()
+{
+    addColorSpacesColumns();
+
+    Q_FOREACH (const ConversionInfo &info, conversions()) {
+        addColorSpacesRow(info);
+    }
+}
+
+void KoColorConversionBenchmark::benchmarkConvertPixels()
+{
+    FETCH_COLOR_SPACES
+
+    ConversionData data(srcCs, dstCs);
+
+    // the way KisPaintDevice used to convert its data: one call per tile
+    QBENCHMARK {
+        for (int i = 0; i < NB_PIXELS; i += TILE_PIXELS) {
+            srcCs->convertPixelsTo(data.src.constData() + i * srcCs->pixelSize(),
+                                   data.dst.data() + i * dstCs->pixelSize(),
+                                   dstCs, TILE_PIXELS,
+                                   KoColorConversionTransformation::internalRenderingIntent(),
+                                   KoColorConversionTransformation::internalConversionFlags());
+        }
+    }
+}
+
+void KoColorConversionBenchmark::benchmarkBatchedConversion_data()
+{
+    addColorSpacesColumns();
+    QTest::addColumn<int>("numThreads");
+
+    const int idealThreadCount = QThread::idealThreadCount();
+
+    QVector<int> threadCounts;
+    for (int numThreads : {1, 2, 4}) {
+        if (numThreads < idealThreadCount) {
+            threadCounts << numThreads;
+        }
+    }
+    threadCounts << idealThreadCount;
+
+    Q_FOREACH (const ConversionInfo &info, conversions()) {
+        Q_FOREACH (int numThreads, threadCounts) {
+            addColorSpacesRow(info, QString("-%1-threads").arg(numThreads)) << numThreads;
+        }
+    }
+}
+
+void KoColorConversionBenchmark::benchmarkBatchedConversion()
+{
+    FETCH_COLOR_SPACES
+    QFETCH(int, numThreads);
+
+    ConversionData data(srcCs, dstCs);
+
+    KoBatchedColorConversion conversion(srcCs, dstCs,
+                                        KoColorConversionTransformation::internalRenderingIntent(),
+                                        KoColorConversionTransformation::internalConversionFlags());
+    conversion.setMaxThreads(numThreads);
+
+    QBENCHMARK {
+        conversion.convertPixels(data.src.constData(), data.dst.data(), NB_PIXELS, 8 * TILE_PIXELS);
+    }
+}
+
+void KoColorConversionBenchmark::benchmarkLutConversion_data()
+{
+    addColorSpacesColumns();
+    QTest::addColumn<qreal>("maxDeltaE");
+
+    Q_FOREACH (const ConversionInfo &info, conversions()) {
+        for (qreal maxDeltaE : {0.5, 1.0, 2.0}) {
+            addColorSpacesRow(info, QString("-dE-%1").arg(maxDeltaE)) << maxDeltaE;
+        }
+    }
+}
+
+void KoColorConversionBenchmark::benchmarkLutConversion()
+{
+    FETCH_COLOR_SPACES
+    QFETCH(qreal, maxDeltaE);
+
+    ConversionData data(srcCs, dstCs);
+
+    QScopedPointer<KoColorConversionTransformation> exact(
+        KoColorSpaceRegistry::instance()->createColorConverter(
+            srcCs, dstCs,
+            KoColorConversionTransformation::internalRenderingIntent(),
+            KoColorConversionTransformation::internalConversionFlags()));
+
+    QScopedPointer<KoColorConversionTransformation> toLab(
+        KoColorSpaceRegistry::instance()->createColorConverter(
+            dstCs, KoColorSpaceRegistry::instance()->lab16(),
+            KoColorConversionTransformation::internalRenderingIntent(),
+            KoColorConversionTransformation::internalConversionFlags()));
+
+    QSharedPointer<const KoColorConversionLut3D> lut =
+        KoLutColorConversionTransformation::createLut(exact.data(), toLab.data(), maxDeltaE);
+
+    if (!lut) {
+        QSKIP("the conversion doesn't fit into the tolerance");
+    }
+
+    qDebug() << "Grid size:" << lut->gridSize;
+
+    KoLutColorConversionTransformation transformation(srcCs, dstCs,
+                                                      exact->renderingIntent(),
+                                                      exact->conversionFlags(),
+                                                      lut);
+
+    QBENCHMARK {
+        for (int i = 0; i < NB_PIXELS; i += TILE_PIXELS) {
+            transformation.transform(data.src.constData() + i * srcCs->pixelSize(),
+                                     data.dst.data() + i * dstCs->pixelSize(),
+                                     TILE_PIXELS);
+        }
+    }
+}
+
+SIMPLE_TEST_MAIN(KoColorConversionBenchmark)
@@ -0,0 +1,26 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOCOLORCONVERSIONBENCHMARK_H
+#define KOCOLORCONVERSIONBENCHMARK_H
+
+#include <QObject>
+
+class KoColorConversionBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkConvertPixels_data();
+    void benchmarkConvertPixels();
+
+    void benchmarkBatchedConversion_data();
+    void benchmarkBatchedConversion();
+
+    void benchmarkLutConversion_data();
+    void benchmarkLutConversion();
+};
+
+#endif // KOCOLORCONVERSIONBENCHMARK_H
@@ -8,15 +8,23 @@
 
 #include "../compositeops/KoCompositeOpAlphaDarken.h"
 #include "../compositeops/KoCompositeOpOver.h"
+#include "../compositeops/KoOptimizedCompositeOpGenericSCModes.h"
+#include "../compositeops/KoOptimizedCompositeOpGenericHSLModes.h"
 #include <KoOptimizedCompositeOpFactory.h>
 
 #include <KoColorSpaceTraits.h>
 #include <KoColorSpaceRegistry.h>
+#include <KoCompositeOpRegistry.h>
 
 #include <QRandomGenerator>
+#include <QScopedPointer>
 
 #include <simpletest.h>
 
+Q_DECLARE_METATYPE(KoOptimizedSCMode)
+Q_DECLARE_METATYPE(KoOptimizedHSLMode)
+Q_DECLARE_METATYPE(KoOptimizedHSXType)
+
 const int TILE_WIDTH = 64;
 const int TILE_HEIGHT = 64;
 
@@ -98,5 +106,87 @@ void KoCompositeOpsBenchmark::benchmarkCompositeAlphaDarkenCreamy()
     }
 }
 
+void KoCompositeOpsBenchmark::benchmarkCompositeGenericSC_data()
+{
+    QTest::addColumn<QString>("id");
+    QTest::addColumn<KoOptimizedSCMode>("mode");
+    QTest::addColumn<bool>("optimized");
+
+    const QVector<std::pair<QString, KoOptimizedSCMode>> modes = {
+        {COMPOSITE_MULT, KoOptimizedSCMode::Multiply},
+        {COMPOSITE_SCREEN, KoOptimizedSCMode::Screen},
+        {COMPOSITE_OVERLAY, KoOptimizedSCMode::Overlay},
+        {COMPOSITE_DARKEN, KoOptimizedSCMode::Darken},
+        {COMPOSITE_GRAIN_MERGE, KoOptimizedSCMode::GrainMerge}
+    };
+
+    for (const auto &mode : modes) {
+        QTest::addRow("%s-generic", mode.first.toLatin1().data()) << mode.first << mode.second << false;
+        QTest::addRow("%s-optimized", mode.first.toLatin1().data()) << mode.first << mode.second << true;
+    }
+}
+
+void KoCompositeOpsBenchmark::benchmarkCompositeGenericSC()
+{
+    QFETCH(QString, id);
+    QFETCH(KoOptimizedSCMode, mode);
+    QFETCH(bool, optimized);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    QScopedPointer<KoCompositeOp> compositeOp(
+        optimized ?
+            KoOptimizedCompositeOpFactory::createGenericSCOp32(cs, mode, id, KoCompositeOp::categoryMix()) :
+            KoGenericSCModes::createOptimizedGenericSCOp<quint8, KoGenericSCModes::KoGenericSCScalarOpCreator>(cs, mode, id, KoCompositeOp::categoryMix()));
+
+    QBENCHMARK{
+        COMPOSITE_BENCHMARK
+    }
+}
+
+void KoCompositeOpsBenchmark::benchmarkCompositeGenericHSL_data()
+{
+    QTest::addColumn<QString>("id");
+    QTest::addColumn<KoOptimizedHSLMode>("mode");
+    QTest::addColumn<KoOptimizedHSXType>("hsxType");
+    QTest::addColumn<bool>("optimized");
+
+    struct Mode {
+        QString id;
+        KoOptimizedHSLMode mode;
+        KoOptimizedHSXType hsxType;
+    };
+
+    const QVector<Mode> modes = {
+        {COMPOSITE_COLOR, KoOptimizedHSLMode::Color, KoOptimizedHSXType::HSY},
+        {COMPOSITE_HUE, KoOptimizedHSLMode::Hue, KoOptimizedHSXType::HSY},
+        {COMPOSITE_SATURATION_HSV, KoOptimizedHSLMode::Saturation, KoOptimizedHSXType::HSV},
+        {COMPOSITE_LIGHTNESS, KoOptimizedHSLMode::Lightness, KoOptimizedHSXType::HSL}
+    };
+
+    for (const Mode &mode : modes) {
+        QTest::addRow("%s-generic", mode.id.toLatin1().data()) << mode.id << mode.mode << mode.hsxType << false;
+        QTest::addRow("%s-optimized", mode.id.toLatin1().data()) << mode.id << mode.mode << mode.hsxType << true;
+    }
+}
+
+void KoCompositeOpsBenchmark::benchmarkCompositeGenericHSL()
+{
+    QFETCH(QString, id);
+    QFETCH(KoOptimizedHSLMode, mode);
+    QFETCH(KoOptimizedHSXType, hsxType);
+    QFETCH(bool, optimized);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    QScopedPointer<KoCompositeOp> compositeOp(
+        optimized ?
+            KoOptimizedCompositeOpFactory::createGenericHSLOp32(cs, mode, hsxType, id, KoCompositeOp::categoryHSY()) :
+            KoGenericHSLModes::createOptimizedGenericHSLOp<quint8, KoGenericHSLModes::KoGenericHSLScalarOpCreator>(cs, mode, hsxType, id, KoCompositeOp::categoryHSY()));
+
+    QBENCHMARK{
+        COMPOSITE_BENCHMARK
+    }
+}
 
 QTEST_GUILESS_MAIN(KoCompositeOpsBenchmark)
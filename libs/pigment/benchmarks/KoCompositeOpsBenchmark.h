@@ -22,6 +22,11 @@ private Q_SLOTS:
     void benchmarkCompositeAlphaDarkenHard();
     void benchmarkCompositeAlphaDarkenCreamy();
 
+    void benchmarkCompositeGenericSC_data();
+    void benchmarkCompositeGenericSC();
+    void benchmarkCompositeGenericHSL_data();
+    void benchmarkCompositeGenericHSL();
+
 private:
     quint8 * m_dstBuffer;
     quint8 * m_srcBuffer;
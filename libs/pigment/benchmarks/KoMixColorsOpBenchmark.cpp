@@ -0,0 +1,192 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KoMixColorsOpBenchmark.h"
+
+#include <simpletest.h>
+
+#include <algorithm>
+#include <numeric>
+
+#include <QRandomGenerator>
+#include <QScopedPointer>
+
+#include <KoColorModelStandardIds.h>
+#include <KoColorSpaceTraits.h>
+#include <KoMixColorsOpImpl.h>
+#include <KoOptimizedMixColorsOpFactory.h>
+
+namespace {
+
+/// the number of dabs mixed in every benchmark iteration
+const int NB_DABS = 64;
+
+/**
+ * RowSampling accumulates the whole dab row by row, PixelSampling feeds
+ * the mixer one pixel per call in a scattered order, the way
+ * KisColorSmudgeSampleUtils samples the canvas.
+ */
+enum SamplingMode {
+    RowSampling,
+    PixelSampling
+};
+
+KoMixColorsOp *createScalarOp(const KoID &depthId)
+{
+    if (depthId == Integer8BitsColorDepthID) {
+        return new KoMixColorsOpImpl<KoBgrU8Traits>();
+    } else if (depthId == Integer16BitsColorDepthID) {
+        return new KoMixColorsOpImpl<KoBgrU16Traits>();
+    } else {
+        return new KoMixColorsOpImpl<KoRgbF32Traits>();
+    }
+}
+
+int pixelSizeForDepth(const KoID &depthId)
+{
+    if (depthId == Integer8BitsColorDepthID) {
+        return 4;
+    } else if (depthId == Integer16BitsColorDepthID) {
+        return 8;
+    } else {
+        return 16;
+    }
+}
+
+void addMixerColumns()
+{
+    QTest::addColumn<QString>("depthId");
+    QTest::addColumn<int>("dabSize");
+    QTest::addColumn<bool>("useOptimized");
+    QTest::addColumn<int>("samplingMode");
+
+    for (const KoID &depthId : {Integer8BitsColorDepthID, Integer16BitsColorDepthID, Float32BitsColorDepthID}) {
+        for (int dabSize : {16, 64, 256}) {
+            for (SamplingMode samplingMode : {RowSampling, PixelSampling}) {
+                for (bool useOptimized : {false, true}) {
+                    QTest::addRow("%s-%dpx-%s-%s",
+                                  depthId.id().toLatin1().data(),
+                                  dabSize,
+                                  samplingMode == RowSampling ? "rows" : "pixels",
+                                  useOptimized ? "optimized" : "scalar")
+                        << depthId.id() << dabSize << useOptimized << int(samplingMode);
+                }
+            }
+        }
+    }
+}
+
+struct MixerData
+{
+    MixerData(const KoID &depthId, int dabSize)
+        : pixelSize(pixelSizeForDepth(depthId)),
+          pixels(dabSize * dabSize * pixelSize),
+          weights(dabSize * dabSize),
+          sampleOrder(dabSize * dabSize)
+    {
+        QRandomGenerator rnd(1);
+
+        if (depthId == Float32BitsColorDepthID) {
+            float *channels = reinterpret_cast<float*>(pixels.data());
+            for (int i = 0; i < dabSize * dabSize * 4; i++) {
+                channels[i] = float(rnd.generateDouble());
+            }
+        } else {
+            for (int i = 0; i < pixels.size(); i++) {
+                pixels[i] = quint8(rnd.bounded(256));
+            }
+        }
+
+        for (int i = 0; i < weights.size(); i++) {
+            weights[i] = qint16(rnd.bounded(256));
+        }
+
+        std::iota(sampleOrder.begin(), sampleOrder.end(), 0);
+        std::shuffle(sampleOrder.begin(), sampleOrder.end(), rnd);
+    }
+
+    int pixelSize;
+    QVector<quint8> pixels;
+    QVector<qint16> weights;
+    QVector<int> sampleOrder;
+};
+
+#define FETCH_MIXER_DATA \
+    QFETCH(QString, depthId); \
+    QFETCH(int, dabSize); \
+    QFETCH(bool, useOptimized); \
+    QFETCH(int, samplingMode); \
+    \
+    const KoID depth(depthId); \
+    QScopedPointer<KoMixColorsOp> op(useOptimized ? \
+        KoOptimizedMixColorsOpFactory::create(depth, 4, 3) : \
+        createScalarOp(depth)); \
+    QVERIFY(op); \
+    \
+    MixerData data(depth, dabSize); \
+    quint8 result[16];
+
+}
+
+void KoMixColorsOpBenchmark::benchmarkWeightedMixer_data()
+{
+    addMixerColumns();
+}
+
+void KoMixColorsOpBenchmark::benchmarkWeightedMixer()
+{
+    FETCH_MIXER_DATA
+
+    QBENCHMARK {
+        for (int dab = 0; dab < NB_DABS; dab++) {
+            QScopedPointer<KoMixColorsOp::Mixer> mixer(op->createMixer());
+
+            if (samplingMode == RowSampling) {
+                for (int row = 0; row < dabSize; row++) {
+                    mixer->accumulate(data.pixels.constData() + row * dabSize * data.pixelSize,
+                                      data.weights.constData() + row * dabSize,
+                                      255, dabSize);
+                }
+            } else {
+                for (int index : data.sampleOrder) {
+                    const qint16 weight = data.weights[index];
+                    mixer->accumulate(data.pixels.constData() + index * data.pixelSize,
+                                      &weight, weight, 1);
+                }
+            }
+            mixer->computeMixedColor(result);
+        }
+    }
+}
+
+void KoMixColorsOpBenchmark::benchmarkAverageMixer_data()
+{
+    addMixerColumns();
+}
+
+void KoMixColorsOpBenchmark::benchmarkAverageMixer()
+{
+    FETCH_MIXER_DATA
+
+    QBENCHMARK {
+        for (int dab = 0; dab < NB_DABS; dab++) {
+            QScopedPointer<KoMixColorsOp::Mixer> mixer(op->createMixer());
+
+            if (samplingMode == RowSampling) {
+                for (int row = 0; row < dabSize; row++) {
+                    mixer->accumulateAverage(data.pixels.constData() + row * dabSize * data.pixelSize, dabSize);
+                }
+            } else {
+                for (int index : data.sampleOrder) {
+                    mixer->accumulateAverage(data.pixels.constData() + index * data.pixelSize, 1);
+                }
+            }
+            mixer->computeMixedColor(result);
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(KoMixColorsOpBenchmark)
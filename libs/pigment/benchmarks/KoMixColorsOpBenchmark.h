@@ -0,0 +1,23 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOMIXCOLORSOPBENCHMARK_H
+#define KOMIXCOLORSOPBENCHMARK_H
+
+#include <QObject>
+
+class KoMixColorsOpBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkWeightedMixer_data();
+    void benchmarkWeightedMixer();
+
+    void benchmarkAverageMixer_data();
+    void benchmarkAverageMixer();
+};
+
+#endif // KOMIXCOLORSOPBENCHMARK_H
@@ -30,6 +30,8 @@
 #include "compositeops/KoColorSpaceBlendingPolicy.h"
 #include "compositeops/KoCompositeOpClampPolicy.h"
 #include "KoOptimizedCompositeOpFactory.h"
+#include "KoOptimizedCompositeOpGenericSCModes.h"
+#include "KoOptimizedCompositeOpGenericHSLModes.h"
 
 namespace _Private {
 
@@ -56,6 +58,23 @@ struct OptimizedOpsSelector
     static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
         return new KoCompositeOpCopy2<Traits>(cs);
     }
+
+    static KoCompositeOp* createGenericSCOp(const KoColorSpace *cs, KoOptimizedSCMode mode, const QString &id, const QString &category) {
+        Q_UNUSED(cs);
+        Q_UNUSED(mode);
+        Q_UNUSED(id);
+        Q_UNUSED(category);
+        return nullptr;
+    }
+
+    static KoCompositeOp* createGenericHSLOp(const KoColorSpace *cs, KoOptimizedHSLMode mode, KoOptimizedHSXType hsxType, const QString &id, const QString &category) {
+        Q_UNUSED(cs);
+        Q_UNUSED(mode);
+        Q_UNUSED(hsxType);
+        Q_UNUSED(id);
+        Q_UNUSED(category);
+        return nullptr;
+    }
 };
 
 template<>
@@ -73,6 +92,14 @@ struct OptimizedOpsSelector<KoBgrU8Traits>
     static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
         return KoOptimizedCompositeOpFactory::createCopyOp32(cs);
     }
+
+    static KoCompositeOp* createGenericSCOp(const KoColorSpace *cs, KoOptimizedSCMode mode, const QString &id, const QString &category) {
+        return KoOptimizedCompositeOpFactory::createGenericSCOp32(cs, mode, id, category);
+    }
+
+    static KoCompositeOp* createGenericHSLOp(const KoColorSpace *cs, KoOptimizedHSLMode mode, KoOptimizedHSXType hsxType, const QString &id, const QString &category) {
+        return KoOptimizedCompositeOpFactory::createGenericHSLOp32(cs, mode, hsxType, id, category);
+    }
 };
 
 template<>
@@ -89,6 +116,24 @@ struct OptimizedOpsSelector<KoLabU8Traits>
     static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
         return KoOptimizedCompositeOpFactory::createCopyOp32(cs);
     }
+
+    static KoCompositeOp* createGenericSCOp(const KoColorSpace *cs, KoOptimizedSCMode mode, const QString &id, const QString &category) {
+        // the blend modes are not applicable to Lab
+        Q_UNUSED(cs);
+        Q_UNUSED(mode);
+        Q_UNUSED(id);
+        Q_UNUSED(category);
+        return nullptr;
+    }
+
+    static KoCompositeOp* createGenericHSLOp(const KoColorSpace *cs, KoOptimizedHSLMode mode, KoOptimizedHSXType hsxType, const QString &id, const QString &category) {
+        Q_UNUSED(cs);
+        Q_UNUSED(mode);
+        Q_UNUSED(hsxType);
+        Q_UNUSED(id);
+        Q_UNUSED(category);
+        return nullptr;
+    }
 };
 
 template<>
@@ -106,6 +151,14 @@ struct OptimizedOpsSelector<KoRgbF32Traits>
     static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
         return KoOptimizedCompositeOpFactory::createCopyOp128(cs);
     }
+
+    static KoCompositeOp* createGenericSCOp(const KoColorSpace *cs, KoOptimizedSCMode mode, const QString &id, const QString &category) {
+        return KoOptimizedCompositeOpFactory::createGenericSCOp128(cs, mode, id, category);
+    }
+
+    static KoCompositeOp* createGenericHSLOp(const KoColorSpace *cs, KoOptimizedHSLMode mode, KoOptimizedHSXType hsxType, const QString &id, const QString &category) {
+        return KoOptimizedCompositeOpFactory::createGenericHSLOp128(cs, mode, hsxType, id, category);
+    }
 };
 
 template<>
@@ -123,6 +176,14 @@ struct OptimizedOpsSelector<KoBgrU16Traits>
     static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
         return KoOptimizedCompositeOpFactory::createCopyOpU64(cs);
     }
+
+    static KoCompositeOp* createGenericSCOp(const KoColorSpace *cs, KoOptimizedSCMode mode, const QString &id, const QString &category) {
+        return KoOptimizedCompositeOpFactory::createGenericSCOpU64(cs, mode, id, category);
+    }
+
+    static KoCompositeOp* createGenericHSLOp(const KoColorSpace *cs, KoOptimizedHSLMode mode, KoOptimizedHSXType hsxType, const QString &id, const QString &category) {
+        return KoOptimizedCompositeOpFactory::createGenericHSLOpU64(cs, mode, hsxType, id, category);
+    }
 };
 
 
@@ -143,7 +204,8 @@ struct AddGeneralOps<Traits, true>
                 cs->addCompositeOp(new KoCompositeOpGenericSC<Traits, func, KoAdditiveBlendingPolicy<Traits>>(cs, id, category));
             }
         } else {
-            cs->addCompositeOp(new KoCompositeOpGenericSC<Traits, func, KoAdditiveBlendingPolicy<Traits>>(cs, id, category));
+            KoCompositeOp *op = createOptimizedSCOp<optimizedSCModeForFunction<Arg, func>()>(cs, id, category);
+            cs->addCompositeOp(op ? op : new KoCompositeOpGenericSC<Traits, func, KoAdditiveBlendingPolicy<Traits>>(cs, id, category));
         }
      }
 
@@ -156,7 +218,25 @@ struct AddGeneralOps<Traits, true>
                  cs->addCompositeOp(new KoCompositeOpGenericSCFunctor<Traits, Functor, KoAdditiveBlendingPolicy<Traits>>(cs, id, category));
              }
          } else {
-             cs->addCompositeOp(new KoCompositeOpGenericSCFunctor<Traits, Functor, KoAdditiveBlendingPolicy<Traits>>(cs, id, category));
+             KoCompositeOp *op = createOptimizedSCOp<KoOptimizedSCModeForFunctor<Functor>::value>(cs, id, category);
+             cs->addCompositeOp(op ? op : new KoCompositeOpGenericSCFunctor<Traits, Functor, KoAdditiveBlendingPolicy<Traits>>(cs, id, category));
+         }
+     }
+
+     /**
+      * The optimized version is selected by the functor, not by
+      * the id, so the same functor registered under a different
+      * id gets the same optimized op
+      */
+     template<KoOptimizedSCMode mode>
+     static KoCompositeOp* createOptimizedSCOp(KoColorSpace* cs, const QString& id, const QString& category) {
+         if constexpr (mode != KoOptimizedSCMode::None) {
+             return OptimizedOpsSelector<Traits>::createGenericSCOp(cs, mode, id, category);
+         } else {
+             Q_UNUSED(cs);
+             Q_UNUSED(id);
+             Q_UNUSED(category);
+             return nullptr;
          }
      }
 
@@ -319,7 +399,26 @@ struct AddRGBOps<Traits, true>
 
     template<typename Functor>
     static void add(KoColorSpace* cs, const QString& id, const QString& category) {
-        cs->addCompositeOp(new KoCompositeOpGenericHSLFunctor<Traits, Functor>(cs, id, category));
+        KoCompositeOp *op = createOptimizedHSLOp<Functor>(cs, id, category);
+        cs->addCompositeOp(op ? op : new KoCompositeOpGenericHSLFunctor<Traits, Functor>(cs, id, category));
+    }
+
+    /**
+     * The optimized version is selected by the functor, not by
+     * the id, \see AddGeneralOps::createOptimizedSCOp()
+     */
+    template<typename Functor>
+    static KoCompositeOp* createOptimizedHSLOp(KoColorSpace* cs, const QString& id, const QString& category) {
+        using ModeTraits = KoOptimizedHSLModeForFunctor<Functor>;
+
+        if constexpr (ModeTraits::mode != KoOptimizedHSLMode::None) {
+            return OptimizedOpsSelector<Traits>::createGenericHSLOp(cs, ModeTraits::mode, ModeTraits::hsxType, id, category);
+        } else {
+            Q_UNUSED(cs);
+            Q_UNUSED(id);
+            Q_UNUSED(category);
+            return nullptr;
+        }
     }
 
     static void add(KoColorSpace* cs) {
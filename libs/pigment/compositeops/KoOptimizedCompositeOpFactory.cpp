@@ -78,3 +78,33 @@ KoCompositeOp* KoOptimizedCompositeOpFactory::createCopyOpU64(const KoColorSpace
 {
     return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpCopyU64> >(cs);
 }
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createGenericSCOp32(const KoColorSpace *cs, KoOptimizedSCMode mode, const QString &id, const QString &category)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpGenericSCFactoryPerArch<quint8>>(cs, mode, id, category);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createGenericSCOpU64(const KoColorSpace *cs, KoOptimizedSCMode mode, const QString &id, const QString &category)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpGenericSCFactoryPerArch<quint16>>(cs, mode, id, category);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createGenericSCOp128(const KoColorSpace *cs, KoOptimizedSCMode mode, const QString &id, const QString &category)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpGenericSCFactoryPerArch<float>>(cs, mode, id, category);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createGenericHSLOp32(const KoColorSpace *cs, KoOptimizedHSLMode mode, KoOptimizedHSXType hsxType, const QString &id, const QString &category)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpGenericHSLFactoryPerArch<quint8>>(cs, mode, hsxType, id, category);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createGenericHSLOpU64(const KoColorSpace *cs, KoOptimizedHSLMode mode, KoOptimizedHSXType hsxType, const QString &id, const QString &category)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpGenericHSLFactoryPerArch<quint16>>(cs, mode, hsxType, id, category);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createGenericHSLOp128(const KoColorSpace *cs, KoOptimizedHSLMode mode, KoOptimizedHSXType hsxType, const QString &id, const QString &category)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpGenericHSLFactoryPerArch<float>>(cs, mode, hsxType, id, category);
+}
@@ -11,6 +11,58 @@
 
 class KoCompositeOp;
 class KoColorSpace;
+class QString;
+
+/**
+ * Separable blend modes that have an optimized version, the
+ * scalar functors are mapped to them by KoOptimizedSCModeForFunctor
+ *
+ * \see KoOptimizedCompositeOpGenericSCModes.h
+ */
+enum class KoOptimizedSCMode {
+    None,
+    Multiply,
+    Screen,
+    Overlay,
+    HardLight,
+    Darken,
+    Lighten,
+    Addition,
+    Subtract,
+    Difference,
+    Exclusion,
+    GrainMerge,
+    GrainExtract
+};
+
+/**
+ * Non-separable blend modes that have an optimized version, the
+ * scalar functors are mapped to them by KoOptimizedHSLModeForFunctor
+ *
+ * \see KoOptimizedCompositeOpGenericHSLModes.h
+ */
+enum class KoOptimizedHSLMode {
+    None,
+    Color,
+    Hue,
+    Saturation,
+    IncreaseSaturation,
+    DecreaseSaturation,
+    Lightness,
+    IncreaseLightness,
+    DecreaseLightness
+};
+
+/**
+ * The color model the non-separable blend mode works in, one per
+ * HSYType, HSIType, HSLType and HSVType
+ */
+enum class KoOptimizedHSXType {
+    HSY,
+    HSI,
+    HSL,
+    HSV
+};
 
 /**
  * The creation of the optimized composite ops is moved into a separate
@@ -39,6 +91,24 @@ public:
     static KoCompositeOp* createCopyOp32(const KoColorSpace *cs);
     static KoCompositeOp* createAlphaDarkenOpHardU64(const KoColorSpace *cs);
     static KoCompositeOp* createAlphaDarkenOpCreamyU64(const KoColorSpace *cs);
+
+    /**
+     * Create an optimized version of the separable blend mode \p mode
+     * registered as \p id. Returns nullptr if the mode has no optimized
+     * version.
+     */
+    static KoCompositeOp* createGenericSCOp32(const KoColorSpace *cs, KoOptimizedSCMode mode, const QString &id, const QString &category);
+    static KoCompositeOp* createGenericSCOpU64(const KoColorSpace *cs, KoOptimizedSCMode mode, const QString &id, const QString &category);
+    static KoCompositeOp* createGenericSCOp128(const KoColorSpace *cs, KoOptimizedSCMode mode, const QString &id, const QString &category);
+
+    /**
+     * Create an optimized version of the HSX-based blend mode \p mode
+     * in color model \p hsxType registered as \p id. Returns nullptr
+     * if the mode has no optimized version.
+     */
+    static KoCompositeOp* createGenericHSLOp32(const KoColorSpace *cs, KoOptimizedHSLMode mode, KoOptimizedHSXType hsxType, const QString &id, const QString &category);
+    static KoCompositeOp* createGenericHSLOpU64(const KoColorSpace *cs, KoOptimizedHSLMode mode, KoOptimizedHSXType hsxType, const QString &id, const QString &category);
+    static KoCompositeOp* createGenericHSLOp128(const KoColorSpace *cs, KoOptimizedHSLMode mode, KoOptimizedHSXType hsxType, const QString &id, const QString &category);
 };
 
 #endif /* KOOPTIMIZEDCOMPOSITEOPFACTORY_H */
@@ -13,6 +13,10 @@
 #include "KoOptimizedCompositeOpOver32.h"
 #include "KoOptimizedCompositeOpOver128.h"
 #include "KoOptimizedCompositeOpCopy128.h"
+#include "KoOptimizedCompositeOpGenericSC.h"
+#include "KoOptimizedCompositeOpGenericSCModes.h"
+#include "KoOptimizedCompositeOpGenericHSL.h"
+#include "KoOptimizedCompositeOpGenericHSLModes.h"
 
 #include <KoCompositeOpRegistry.h>
 
@@ -124,4 +128,58 @@ KoCompositeOp *KoOptimizedCompositeOpFactoryPerArch<
     return new KoOptimizedCompositeOpAlphaDarkenCreamyU64<xsimd::current_arch>(param);
 }
 
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpGenericSCFactoryPerArch<quint8>::create<
+    xsimd::current_arch>(const KoColorSpace *param, KoOptimizedSCMode mode, const QString &id, const QString &category)
+{
+    return KoGenericSCModes::createOptimizedGenericSCOp<quint8, KoOptimizedCompositeOpGenericSCCreator<xsimd::current_arch>>(param, mode, id, category);
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpGenericSCFactoryPerArch<quint16>::create<
+    xsimd::current_arch>(const KoColorSpace *param, KoOptimizedSCMode mode, const QString &id, const QString &category)
+{
+    return KoGenericSCModes::createOptimizedGenericSCOp<quint16, KoOptimizedCompositeOpGenericSCCreator<xsimd::current_arch>>(param, mode, id, category);
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpGenericSCFactoryPerArch<float>::create<
+    xsimd::current_arch>(const KoColorSpace *param, KoOptimizedSCMode mode, const QString &id, const QString &category)
+{
+    return KoGenericSCModes::createOptimizedGenericSCOp<float, KoOptimizedCompositeOpGenericSCCreator<xsimd::current_arch>>(param, mode, id, category);
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpGenericHSLFactoryPerArch<quint8>::create<
+    xsimd::current_arch>(const KoColorSpace *param, KoOptimizedHSLMode mode, KoOptimizedHSXType hsxType, const QString &id, const QString &category)
+{
+    return KoGenericHSLModes::createOptimizedGenericHSLOp<quint8, KoOptimizedCompositeOpGenericHSLCreator<xsimd::current_arch>>(param, mode, hsxType, id, category);
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpGenericHSLFactoryPerArch<quint16>::create<
+    xsimd::current_arch>(const KoColorSpace *param, KoOptimizedHSLMode mode, KoOptimizedHSXType hsxType, const QString &id, const QString &category)
+{
+    return KoGenericHSLModes::createOptimizedGenericHSLOp<quint16, KoOptimizedCompositeOpGenericHSLCreator<xsimd::current_arch>>(param, mode, hsxType, id, category);
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpGenericHSLFactoryPerArch<float>::create<
+    xsimd::current_arch>(const KoColorSpace *param, KoOptimizedHSLMode mode, KoOptimizedHSXType hsxType, const QString &id, const QString &category)
+{
+    return KoGenericHSLModes::createOptimizedGenericHSLOp<float, KoOptimizedCompositeOpGenericHSLCreator<xsimd::current_arch>>(param, mode, hsxType, id, category);
+}
+
 #endif // XSIMD_UNIVERSAL_BUILD_PASS
@@ -10,8 +10,11 @@
 
 #include <KoMultiArchBuildSupport.h>
 
+#include "KoOptimizedCompositeOpFactory.h"
+
 class KoCompositeOp;
 class KoColorSpace;
+class QString;
 
 template<typename _impl>
 class KoOptimizedCompositeOpAlphaDarkenCreamy32;
@@ -55,4 +58,30 @@ struct KoOptimizedCompositeOpFactoryPerArch {
     static KoCompositeOp *create(const KoColorSpace *);
 };
 
+/**
+ * Creates an optimized version of a separable blend mode \p mode
+ * for RGBA color space with \p channels_type, returns nullptr
+ * if the mode has no optimized version.
+ *
+ * \see KoOptimizedCompositeOpGenericSCModes.h
+ */
+template<typename channels_type>
+struct KoOptimizedCompositeOpGenericSCFactoryPerArch {
+    template<typename _impl>
+    static KoCompositeOp *create(const KoColorSpace *, KoOptimizedSCMode mode, const QString &id, const QString &category);
+};
+
+/**
+ * Creates an optimized version of a non-separable (HSX-based) blend
+ * mode \p mode for RGBA color space with \p channels_type, returns
+ * nullptr if the mode has no optimized version.
+ *
+ * \see KoOptimizedCompositeOpGenericHSLModes.h
+ */
+template<typename channels_type>
+struct KoOptimizedCompositeOpGenericHSLFactoryPerArch {
+    template<typename _impl>
+    static KoCompositeOp *create(const KoColorSpace *, KoOptimizedHSLMode mode, KoOptimizedHSXType hsxType, const QString &id, const QString &category);
+};
+
 #endif /* KOOPTIMIZEDCOMPOSITEOPFACTORYPERARCH_H */
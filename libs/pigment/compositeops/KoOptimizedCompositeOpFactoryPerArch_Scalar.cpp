@@ -12,6 +12,8 @@
 #include "KoAlphaDarkenParamsWrapper.h"
 #include "KoCompositeOpOver.h"
 #include "KoCompositeOpCopy2.h"
+#include "KoOptimizedCompositeOpGenericSCModes.h"
+#include "KoOptimizedCompositeOpGenericHSLModes.h"
 
 template<>
 template<>
@@ -121,3 +123,56 @@ KoCompositeOp *KoOptimizedCompositeOpFactoryPerArch<
     return new KoCompositeOpAlphaDarken<KoBgrU16Traits, KoAlphaDarkenParamsWrapperCreamy>(param);
 }
 
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpGenericSCFactoryPerArch<quint8>::create<
+    xsimd::generic>(const KoColorSpace *param, KoOptimizedSCMode mode, const QString &id, const QString &category)
+{
+    return KoGenericSCModes::createOptimizedGenericSCOp<quint8, KoGenericSCModes::KoGenericSCScalarOpCreator>(param, mode, id, category);
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpGenericSCFactoryPerArch<quint16>::create<
+    xsimd::generic>(const KoColorSpace *param, KoOptimizedSCMode mode, const QString &id, const QString &category)
+{
+    return KoGenericSCModes::createOptimizedGenericSCOp<quint16, KoGenericSCModes::KoGenericSCScalarOpCreator>(param, mode, id, category);
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpGenericSCFactoryPerArch<float>::create<
+    xsimd::generic>(const KoColorSpace *param, KoOptimizedSCMode mode, const QString &id, const QString &category)
+{
+    return KoGenericSCModes::createOptimizedGenericSCOp<float, KoGenericSCModes::KoGenericSCScalarOpCreator>(param, mode, id, category);
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpGenericHSLFactoryPerArch<quint8>::create<
+    xsimd::generic>(const KoColorSpace *param, KoOptimizedHSLMode mode, KoOptimizedHSXType hsxType, const QString &id, const QString &category)
+{
+    return KoGenericHSLModes::createOptimizedGenericHSLOp<quint8, KoGenericHSLModes::KoGenericHSLScalarOpCreator>(param, mode, hsxType, id, category);
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpGenericHSLFactoryPerArch<quint16>::create<
+    xsimd::generic>(const KoColorSpace *param, KoOptimizedHSLMode mode, KoOptimizedHSXType hsxType, const QString &id, const QString &category)
+{
+    return KoGenericHSLModes::createOptimizedGenericHSLOp<quint16, KoGenericHSLModes::KoGenericHSLScalarOpCreator>(param, mode, hsxType, id, category);
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpGenericHSLFactoryPerArch<float>::create<
+    xsimd::generic>(const KoColorSpace *param, KoOptimizedHSLMode mode, KoOptimizedHSXType hsxType, const QString &id, const QString &category)
+{
+    return KoGenericHSLModes::createOptimizedGenericHSLOp<float, KoGenericHSLModes::KoGenericHSLScalarOpCreator>(param, mode, hsxType, id, category);
+}
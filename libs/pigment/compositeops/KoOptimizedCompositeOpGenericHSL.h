@@ -0,0 +1,189 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOOPTIMIZEDCOMPOSITEOPGENERICHSL_H
+#define KOOPTIMIZEDCOMPOSITEOPGENERICHSL_H
+
+#include <QScopedPointer>
+
+#include "KoCompositeOpRegistry.h"
+#include "KoStreamedMath.h"
+#include "KoStreamedArithmetic.h"
+#include "KoStreamedHSX.h"
+#include "KoOptimizedCompositeOpFactoryPerArch.h"
+#include "KoOptimizedCompositeOpGenericHSLModes.h"
+
+/**
+ * A vectorized version of KoCompositeOpGenericHSLFunctor::composeColorChannels()
+ * for the case when all the channels are enabled.
+ *
+ * The color channels are converted into floats, passed through the
+ * vector version of the HSX functor and converted back, exactly as
+ * the generic version does for every pixel.
+ */
+template<typename Mode>
+struct GenericHSLCompositor {
+    using channels_type = typename Mode::channels_type;
+    using Traits = typename Mode::Traits;
+    static constexpr int pixelSize = Traits::pixelSize;
+
+    struct ParamsWrapper {
+        ParamsWrapper(const KoCompositeOp::ParameterInfo& params)
+            : opacity(Arithmetic::scale<channels_type>(params.opacity))
+        {
+        }
+        channels_type opacity;
+    };
+
+    template<bool haveMask, bool src_aligned, typename _impl>
+    static ALWAYS_INLINE void compositeVector(const quint8 *src, quint8 *dst, const quint8 *mask, float opacity, const ParamsWrapper &oparams)
+    {
+        Q_UNUSED(opacity);
+
+        using A = KoStreamedArithmetic<channels_type, _impl>;
+        using H = KoStreamedHSX<_impl>;
+        using value_v = typename A::value_v;
+        using mask_v = typename A::mask_v;
+        using float_v = typename H::float_v;
+
+        value_v srcColors[3];
+        value_v srcAlpha;
+        A::template read<src_aligned>(src, srcColors, srcAlpha);
+
+        value_v dstColors[3];
+        value_v dstAlpha;
+        A::template read<true>(dst, dstColors, dstAlpha);
+
+        const value_v maskAlpha = haveMask ? A::fetchMask(mask) : A::unitValue();
+        srcAlpha = A::mul(srcAlpha, maskAlpha, A::fromScalar(oparams.opacity));
+
+        /**
+         * Unlike the separable modes, the generic HSL op has no
+         * shortcut for a transparent source: the color channels are
+         * recalculated whenever the resulting alpha is non-zero.
+         */
+        const value_v newDstAlpha = A::unionShapeOpacity(srcAlpha, dstAlpha);
+        const mask_v active = newDstAlpha != A::zeroValue();
+
+        if (xsimd::any(active)) {
+            value_v srcClamped[3];
+            value_v dstClamped[3];
+
+            for (int i = 0; i < 3; i++) {
+                srcClamped[i] = Mode::template clampSourceChannelValue<A>(srcColors[i]);
+                dstClamped[i] = Mode::template clampDestinationChannelValue<A>(dstColors[i]);
+            }
+
+            const float_v srcR = A::toFloat(srcClamped[Traits::red_pos]);
+            const float_v srcG = A::toFloat(srcClamped[Traits::green_pos]);
+            const float_v srcB = A::toFloat(srcClamped[Traits::blue_pos]);
+
+            float_v dstR = A::toFloat(dstClamped[Traits::red_pos]);
+            float_v dstG = A::toFloat(dstClamped[Traits::green_pos]);
+            float_v dstB = A::toFloat(dstClamped[Traits::blue_pos]);
+
+            Mode::template composeChannels<H>(srcR, srcG, srcB, dstR, dstG, dstB);
+
+            value_v cf[3];
+            cf[Traits::red_pos] = A::fromFloat(dstR);
+            cf[Traits::green_pos] = A::fromFloat(dstG);
+            cf[Traits::blue_pos] = A::fromFloat(dstB);
+
+            const value_v divisor = A::select(active, newDstAlpha, A::unitValue());
+
+            for (int i = 0; i < 3; i++) {
+                // the generic op blends raw (unclamped) channel values
+                const value_v blended = A::blend(srcColors[i], srcAlpha, dstColors[i], dstAlpha, cf[i]);
+                dstColors[i] = A::select(active, A::toChannel(A::div(blended, divisor)), dstColors[i]);
+            }
+        }
+
+        A::write(dst, dstColors, newDstAlpha);
+    }
+
+    /**
+     * The unaligned pixels are composed by the same vector code to
+     * guarantee that they get exactly the same values. The pixel is
+     * placed into the first lane, the other lanes are transparent
+     * and their result is discarded.
+     */
+    template <bool haveMask, typename _impl>
+    static ALWAYS_INLINE void compositeOnePixelScalar(const quint8 *src, quint8 *dst, const quint8 *mask, float opacity, const ParamsWrapper &oparams)
+    {
+        using A = KoStreamedArithmetic<channels_type, _impl>;
+        constexpr int vectorSize = A::value_v::size;
+
+        alignas(_impl::alignment()) quint8 srcBuf[pixelSize * vectorSize] = {};
+        alignas(_impl::alignment()) quint8 dstBuf[pixelSize * vectorSize] = {};
+        quint8 maskBuf[vectorSize] = {};
+
+        memcpy(srcBuf, src, pixelSize);
+        memcpy(dstBuf, dst, pixelSize);
+        if (haveMask) {
+            maskBuf[0] = *mask;
+        }
+
+        compositeVector<haveMask, true, _impl>(srcBuf, dstBuf, maskBuf, opacity, oparams);
+
+        memcpy(dst, dstBuf, pixelSize);
+    }
+};
+
+/**
+ * An optimized version of KoCompositeOpGenericHSLFunctor for the blend
+ * modes defined in KoOptimizedCompositeOpGenericHSLModes.h. Works with
+ * RGBA color spaces in U8, U16 and F32.
+ *
+ * When some of the channels are disabled (including the alpha-locked
+ * case), the composition is delegated to the generic op.
+ */
+template<typename _impl, typename Mode>
+class KoOptimizedCompositeOpGenericHSL : public KoCompositeOp
+{
+    using Traits = typename Mode::Traits;
+
+public:
+    KoOptimizedCompositeOpGenericHSL(const KoColorSpace *cs, const QString &id, const QString &category, KoCompositeOp *fallbackOp)
+        : KoCompositeOp(cs, id, category)
+        , m_fallbackOp(fallbackOp)
+    {
+    }
+
+    using KoCompositeOp::composite;
+
+    void composite(const KoCompositeOp::ParameterInfo& params) const override
+    {
+        if (!params.channelFlags.isEmpty() &&
+            params.channelFlags != QBitArray(Traits::channels_nb, true)) {
+
+            m_fallbackOp->composite(params);
+            return;
+        }
+
+        if (params.maskRowStart) {
+            KoStreamedMath<_impl>::template genericComposite<true, false, GenericHSLCompositor<Mode>, Traits::pixelSize>(params);
+        } else {
+            KoStreamedMath<_impl>::template genericComposite<false, false, GenericHSLCompositor<Mode>, Traits::pixelSize>(params);
+        }
+    }
+
+private:
+    QScopedPointer<KoCompositeOp> m_fallbackOp;
+};
+
+template<typename _impl>
+struct KoOptimizedCompositeOpGenericHSLCreator {
+    template<typename Mode>
+    static KoCompositeOp *create(const KoColorSpace *cs, const QString &id, const QString &category)
+    {
+        KoCompositeOp *fallbackOp =
+            KoGenericHSLModes::KoGenericHSLScalarOpCreator::create<Mode>(cs, id, category);
+
+        return new KoOptimizedCompositeOpGenericHSL<_impl, Mode>(cs, id, category, fallbackOp);
+    }
+};
+
+#endif // KOOPTIMIZEDCOMPOSITEOPGENERICHSL_H
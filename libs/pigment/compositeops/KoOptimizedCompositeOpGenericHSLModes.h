@@ -0,0 +1,296 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOOPTIMIZEDCOMPOSITEOPGENERICHSLMODES_H
+#define KOOPTIMIZEDCOMPOSITEOPGENERICHSLMODES_H
+
+#include <KoAlwaysInline.h>
+#include <KoCompositeOpFunctions.h>
+#include <KoCompositeOpRegistry.h>
+
+#include "KoCompositeOpGeneric.h"
+#include "KoOptimizedCompositeOpFactory.h"
+#include "KoOptimizedCompositeOpGenericSCModes.h"
+
+/**
+ * Non-separable (HSX-based) blend modes that have a vectorized
+ * implementation in KoOptimizedCompositeOpGenericHSL.
+ *
+ * Every mode is a copy of the corresponding functor from
+ * KoCompositeOpFunctions.h written in terms of the vector HSX
+ * functions \p H (KoStreamedHSX). The scalar functor it replaces
+ * is available as ScalarFunctor.
+ *
+ * All the modes clamp both, source and destination, to SDR range,
+ * as their scalar counterparts do.
+ */
+namespace KoGenericHSLModes
+{
+
+template<typename HSX, typename T, typename Functor>
+struct ModeBase : KoGenericSCModes::ClampedSourceAndDestinationModeBase<T, Functor> {
+    using HSXType = HSX;
+
+    /// \see possiblyFixNegativeValuesNearZeroPoint()
+    template<class H>
+    static ALWAYS_INLINE void fixNegativeValuesNearZeroPoint(typename H::float_v &r, typename H::float_v &g, typename H::float_v &b)
+    {
+        if constexpr (!std::numeric_limits<T>::is_integer) {
+            using float_v = typename H::float_v;
+            const float_v zero(0.0f);
+
+            r = H::select(r < zero, zero, r);
+            g = H::select(g < zero, zero, g);
+            b = H::select(b < zero, zero, b);
+        }
+    }
+};
+
+/// CFColor
+template<typename HSX, typename T>
+struct Color : ModeBase<HSX, T, CFColor<HSX, T>> {
+    template<class H>
+    static ALWAYS_INLINE void composeChannels(const typename H::float_v &srcR, const typename H::float_v &srcG, const typename H::float_v &srcB,
+                                              typename H::float_v &dstR, typename H::float_v &dstG, typename H::float_v &dstB)
+    {
+        const typename H::float_v lum = H::template getLightness<HSX>(dstR, dstG, dstB);
+        dstR = srcR;
+        dstG = srcG;
+        dstB = srcB;
+        H::template setLightness<HSX>(dstR, dstG, dstB, lum);
+        Color::template fixNegativeValuesNearZeroPoint<H>(dstR, dstG, dstB);
+    }
+};
+
+/// CFHue
+template<typename HSX, typename T>
+struct Hue : ModeBase<HSX, T, CFHue<HSX, T>> {
+    template<class H>
+    static ALWAYS_INLINE void composeChannels(const typename H::float_v &srcR, const typename H::float_v &srcG, const typename H::float_v &srcB,
+                                              typename H::float_v &dstR, typename H::float_v &dstG, typename H::float_v &dstB)
+    {
+        const typename H::float_v sat = H::template getSaturation<HSX>(dstR, dstG, dstB);
+        const typename H::float_v lum = H::template getLightness<HSX>(dstR, dstG, dstB);
+
+        dstR = srcR;
+        dstG = srcG;
+        dstB = srcB;
+
+        H::setSaturation(dstR, dstG, dstB, sat);
+        H::template setLightness<HSX>(dstR, dstG, dstB, lum);
+        Hue::template fixNegativeValuesNearZeroPoint<H>(dstR, dstG, dstB);
+    }
+};
+
+/// CFSaturation
+template<typename HSX, typename T>
+struct Saturation : ModeBase<HSX, T, CFSaturation<HSX, T>> {
+    template<class H>
+    static ALWAYS_INLINE void composeChannels(const typename H::float_v &srcR, const typename H::float_v &srcG, const typename H::float_v &srcB,
+                                              typename H::float_v &dstR, typename H::float_v &dstG, typename H::float_v &dstB)
+    {
+        const typename H::float_v sat = H::template getSaturation<HSX>(srcR, srcG, srcB);
+        const typename H::float_v light = H::template getLightness<HSX>(dstR, dstG, dstB);
+        H::setSaturation(dstR, dstG, dstB, sat);
+        H::template setLightness<HSX>(dstR, dstG, dstB, light);
+        Saturation::template fixNegativeValuesNearZeroPoint<H>(dstR, dstG, dstB);
+    }
+};
+
+/// CFIncreaseSaturation
+template<typename HSX, typename T>
+struct IncreaseSaturation : ModeBase<HSX, T, CFIncreaseSaturation<HSX, T>> {
+    template<class H>
+    static ALWAYS_INLINE void composeChannels(const typename H::float_v &srcR, const typename H::float_v &srcG, const typename H::float_v &srcB,
+                                              typename H::float_v &dstR, typename H::float_v &dstG, typename H::float_v &dstB)
+    {
+        using float_v = typename H::float_v;
+
+        // lerp(dstSat, unitValue, srcSat)
+        const float_v dstSat = H::template getSaturation<HSX>(dstR, dstG, dstB);
+        const float_v sat = (float_v(1.0f) - dstSat) * H::template getSaturation<HSX>(srcR, srcG, srcB) + dstSat;
+        const float_v light = H::template getLightness<HSX>(dstR, dstG, dstB);
+        H::setSaturation(dstR, dstG, dstB, sat);
+        H::template setLightness<HSX>(dstR, dstG, dstB, light);
+        IncreaseSaturation::template fixNegativeValuesNearZeroPoint<H>(dstR, dstG, dstB);
+    }
+};
+
+/// CFDecreaseSaturation
+template<typename HSX, typename T>
+struct DecreaseSaturation : ModeBase<HSX, T, CFDecreaseSaturation<HSX, T>> {
+    template<class H>
+    static ALWAYS_INLINE void composeChannels(const typename H::float_v &srcR, const typename H::float_v &srcG, const typename H::float_v &srcB,
+                                              typename H::float_v &dstR, typename H::float_v &dstG, typename H::float_v &dstB)
+    {
+        using float_v = typename H::float_v;
+
+        // lerp(zeroValue, dstSat, srcSat)
+        const float_v dstSat = H::template getSaturation<HSX>(dstR, dstG, dstB);
+        const float_v sat = (dstSat - float_v(0.0f)) * H::template getSaturation<HSX>(srcR, srcG, srcB) + float_v(0.0f);
+        const float_v light = H::template getLightness<HSX>(dstR, dstG, dstB);
+        H::setSaturation(dstR, dstG, dstB, sat);
+        H::template setLightness<HSX>(dstR, dstG, dstB, light);
+        DecreaseSaturation::template fixNegativeValuesNearZeroPoint<H>(dstR, dstG, dstB);
+    }
+};
+
+/// CFLightness
+template<typename HSX, typename T>
+struct Lightness : ModeBase<HSX, T, CFLightness<HSX, T>> {
+    template<class H>
+    static ALWAYS_INLINE void composeChannels(const typename H::float_v &srcR, const typename H::float_v &srcG, const typename H::float_v &srcB,
+                                              typename H::float_v &dstR, typename H::float_v &dstG, typename H::float_v &dstB)
+    {
+        H::template setLightness<HSX>(dstR, dstG, dstB, H::template getLightness<HSX>(srcR, srcG, srcB));
+        Lightness::template fixNegativeValuesNearZeroPoint<H>(dstR, dstG, dstB);
+    }
+};
+
+/// CFIncreaseLightness
+template<typename HSX, typename T>
+struct IncreaseLightness : ModeBase<HSX, T, CFIncreaseLightness<HSX, T>> {
+    template<class H>
+    static ALWAYS_INLINE void composeChannels(const typename H::float_v &srcR, const typename H::float_v &srcG, const typename H::float_v &srcB,
+                                              typename H::float_v &dstR, typename H::float_v &dstG, typename H::float_v &dstB)
+    {
+        H::template addLightness<HSX>(dstR, dstG, dstB, H::template getLightness<HSX>(srcR, srcG, srcB));
+        IncreaseLightness::template fixNegativeValuesNearZeroPoint<H>(dstR, dstG, dstB);
+    }
+};
+
+/// CFDecreaseLightness
+template<typename HSX, typename T>
+struct DecreaseLightness : ModeBase<HSX, T, CFDecreaseLightness<HSX, T>> {
+    template<class H>
+    static ALWAYS_INLINE void composeChannels(const typename H::float_v &srcR, const typename H::float_v &srcG, const typename H::float_v &srcB,
+                                              typename H::float_v &dstR, typename H::float_v &dstG, typename H::float_v &dstB)
+    {
+        using float_v = typename H::float_v;
+
+        H::template addLightness<HSX>(dstR, dstG, dstB, H::template getLightness<HSX>(srcR, srcG, srcB) - float_v(1.0f));
+        DecreaseLightness::template fixNegativeValuesNearZeroPoint<H>(dstR, dstG, dstB);
+    }
+};
+
+/**
+ * Creates a generic (scalar) version of the \p Mode, exactly the
+ * same op as the one created by KoCompositeOps.h
+ */
+struct KoGenericHSLScalarOpCreator {
+    template<typename Mode>
+    static KoCompositeOp *create(const KoColorSpace *cs, const QString &id, const QString &category)
+    {
+        return new KoCompositeOpGenericHSLFunctor<typename Mode::Traits, typename Mode::ScalarFunctor>(cs, id, category);
+    }
+};
+
+template<typename HSX, typename channels_type, typename OpCreator>
+KoCompositeOp *createHSXModeOp(const KoColorSpace *cs, KoOptimizedHSLMode mode, const QString &id, const QString &category)
+{
+    using T = channels_type;
+
+    switch (mode) {
+    case KoOptimizedHSLMode::Color:
+        return OpCreator::template create<Color<HSX, T>>(cs, id, category);
+    case KoOptimizedHSLMode::Hue:
+        return OpCreator::template create<Hue<HSX, T>>(cs, id, category);
+    case KoOptimizedHSLMode::Saturation:
+        return OpCreator::template create<Saturation<HSX, T>>(cs, id, category);
+    case KoOptimizedHSLMode::IncreaseSaturation:
+        return OpCreator::template create<IncreaseSaturation<HSX, T>>(cs, id, category);
+    case KoOptimizedHSLMode::DecreaseSaturation:
+        return OpCreator::template create<DecreaseSaturation<HSX, T>>(cs, id, category);
+    case KoOptimizedHSLMode::Lightness:
+        return OpCreator::template create<Lightness<HSX, T>>(cs, id, category);
+    case KoOptimizedHSLMode::IncreaseLightness:
+        return OpCreator::template create<IncreaseLightness<HSX, T>>(cs, id, category);
+    case KoOptimizedHSLMode::DecreaseLightness:
+        return OpCreator::template create<DecreaseLightness<HSX, T>>(cs, id, category);
+    case KoOptimizedHSLMode::None:
+        break;
+    }
+
+    return nullptr;
+}
+
+/**
+ * Creates an op for blend mode \p mode in color model \p hsxType
+ * using \p OpCreator, returns nullptr if the mode has no optimized
+ * version
+ */
+template<typename channels_type, typename OpCreator>
+KoCompositeOp *createOptimizedGenericHSLOp(const KoColorSpace *cs, KoOptimizedHSLMode mode, KoOptimizedHSXType hsxType, const QString &id, const QString &category)
+{
+    switch (hsxType) {
+    case KoOptimizedHSXType::HSY:
+        return createHSXModeOp<HSYType, channels_type, OpCreator>(cs, mode, id, category);
+    case KoOptimizedHSXType::HSI:
+        return createHSXModeOp<HSIType, channels_type, OpCreator>(cs, mode, id, category);
+    case KoOptimizedHSXType::HSL:
+        return createHSXModeOp<HSLType, channels_type, OpCreator>(cs, mode, id, category);
+    case KoOptimizedHSXType::HSV:
+        return createHSXModeOp<HSVType, channels_type, OpCreator>(cs, mode, id, category);
+    }
+
+    return nullptr;
+}
+
+} // namespace KoGenericHSLModes
+
+template<typename HSX>
+struct KoOptimizedHSXTypeFor;
+
+template<>
+struct KoOptimizedHSXTypeFor<HSYType> {
+    static constexpr KoOptimizedHSXType value = KoOptimizedHSXType::HSY;
+};
+
+template<>
+struct KoOptimizedHSXTypeFor<HSIType> {
+    static constexpr KoOptimizedHSXType value = KoOptimizedHSXType::HSI;
+};
+
+template<>
+struct KoOptimizedHSXTypeFor<HSLType> {
+    static constexpr KoOptimizedHSXType value = KoOptimizedHSXType::HSL;
+};
+
+template<>
+struct KoOptimizedHSXTypeFor<HSVType> {
+    static constexpr KoOptimizedHSXType value = KoOptimizedHSXType::HSV;
+};
+
+/**
+ * Maps the scalar functor of a non-separable blend mode to its
+ * optimized version. The functors must be the same as the
+ * ScalarFunctor of the corresponding mode in KoGenericHSLModes.
+ */
+template<typename Functor>
+struct KoOptimizedHSLModeForFunctor {
+    static constexpr KoOptimizedHSLMode mode = KoOptimizedHSLMode::None;
+    static constexpr KoOptimizedHSXType hsxType = KoOptimizedHSXType::HSY;
+};
+
+#define DECLARE_OPTIMIZED_HSL_MODE(_functor, _mode)                                      \
+    template<typename HSX, typename T>                                                   \
+    struct KoOptimizedHSLModeForFunctor<_functor<HSX, T>> {                              \
+        static constexpr KoOptimizedHSLMode mode = KoOptimizedHSLMode::_mode;            \
+        static constexpr KoOptimizedHSXType hsxType = KoOptimizedHSXTypeFor<HSX>::value; \
+    };
+
+DECLARE_OPTIMIZED_HSL_MODE(CFColor, Color)
+DECLARE_OPTIMIZED_HSL_MODE(CFHue, Hue)
+DECLARE_OPTIMIZED_HSL_MODE(CFSaturation, Saturation)
+DECLARE_OPTIMIZED_HSL_MODE(CFIncreaseSaturation, IncreaseSaturation)
+DECLARE_OPTIMIZED_HSL_MODE(CFDecreaseSaturation, DecreaseSaturation)
+DECLARE_OPTIMIZED_HSL_MODE(CFLightness, Lightness)
+DECLARE_OPTIMIZED_HSL_MODE(CFIncreaseLightness, IncreaseLightness)
+DECLARE_OPTIMIZED_HSL_MODE(CFDecreaseLightness, DecreaseLightness)
+
+#undef DECLARE_OPTIMIZED_HSL_MODE
+
+#endif // KOOPTIMIZEDCOMPOSITEOPGENERICHSLMODES_H
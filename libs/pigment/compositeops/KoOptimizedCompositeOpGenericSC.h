@@ -0,0 +1,203 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOOPTIMIZEDCOMPOSITEOPGENERICSC_H
+#define KOOPTIMIZEDCOMPOSITEOPGENERICSC_H
+
+#include <QScopedPointer>
+
+#include "KoCompositeOpRegistry.h"
+#include "KoStreamedMath.h"
+#include "KoStreamedArithmetic.h"
+#include "KoOptimizedCompositeOpFactoryPerArch.h"
+#include "KoOptimizedCompositeOpGenericSCModes.h"
+
+/**
+ * A vectorized version of KoCompositeOpGenericSCFunctor::composeColorChannels()
+ * for the case when all the channels are enabled.
+ *
+ * The pixels are processed in the same way as in the generic version,
+ * but all the branches of the generic version are calculated for the
+ * whole vector and then merged using the masks. The branches that
+ * are not used by any pixel of the vector are skipped.
+ */
+template<typename Mode>
+struct GenericSCCompositor {
+    using channels_type = typename Mode::channels_type;
+    static constexpr int pixelSize = Mode::Traits::pixelSize;
+
+    struct ParamsWrapper {
+        ParamsWrapper(const KoCompositeOp::ParameterInfo& params)
+            : opacity(Arithmetic::scale<channels_type>(params.opacity))
+        {
+        }
+        channels_type opacity;
+    };
+
+    template<bool haveMask, bool src_aligned, typename _impl>
+    static ALWAYS_INLINE void compositeVector(const quint8 *src, quint8 *dst, const quint8 *mask, float opacity, const ParamsWrapper &oparams)
+    {
+        Q_UNUSED(opacity);
+
+        using A = KoStreamedArithmetic<channels_type, _impl>;
+        using value_v = typename A::value_v;
+        using mask_v = typename A::mask_v;
+
+        value_v srcColors[3];
+        value_v srcAlpha;
+        A::template read<src_aligned>(src, srcColors, srcAlpha);
+
+        const value_v maskAlpha = haveMask ? A::fetchMask(mask) : A::unitValue();
+        srcAlpha = A::mul(srcAlpha, maskAlpha, A::fromScalar(oparams.opacity));
+
+        const mask_v srcAlphaIsZero = A::isZeroValueFuzzy(srcAlpha);
+
+        // The source cannot change the colors in the destination,
+        // since its fully transparent
+        if (xsimd::all(srcAlphaIsZero)) return;
+
+        value_v dstColors[3];
+        value_v dstAlpha;
+        A::template read<true>(dst, dstColors, dstAlpha);
+
+        const mask_v dstAlphaIsZero = A::isZeroValueFuzzy(dstAlpha);
+        const mask_v dstAlphaIsUnit = A::isUnitValueFuzzy(dstAlpha);
+        const mask_v srcAlphaIsUnit = A::isUnitValueFuzzy(srcAlpha);
+
+        const mask_v active = !srcAlphaIsZero;
+        const mask_v copySource = active && dstAlphaIsZero;
+        const mask_v blendToDst = active && !dstAlphaIsZero && dstAlphaIsUnit;
+        const mask_v blendToSrc = active && !dstAlphaIsZero && !dstAlphaIsUnit && srcAlphaIsUnit;
+        const mask_v blendBothCandidate = active && !dstAlphaIsZero && !dstAlphaIsUnit && !srcAlphaIsUnit;
+
+        const value_v newDstAlpha = A::unionShapeOpacity(srcAlpha, dstAlpha);
+        const mask_v newDstAlphaIsZero = A::isZeroValueFuzzy(newDstAlpha);
+        const mask_v blendBoth = blendBothCandidate && !newDstAlphaIsZero;
+
+        const bool haveCopySource = xsimd::any(copySource);
+        const bool haveBlendToDst = xsimd::any(blendToDst);
+        const bool haveBlendToSrc = xsimd::any(blendToSrc);
+        const bool haveBlendBoth = xsimd::any(blendBoth);
+
+        const value_v divisor = A::select(newDstAlphaIsZero, A::unitValue(), newDstAlpha);
+
+        for (int i = 0; i < 3; i++) {
+            const value_v s = Mode::template clampSourceChannelValue<A>(srcColors[i]);
+            const value_v d = Mode::template clampDestinationChannelValue<A>(dstColors[i]);
+            const value_v cf = Mode::template composeChannel<A>(s, d);
+
+            value_v result = dstColors[i];
+
+            if (haveBlendBoth) {
+                const value_v blended = A::blend(s, srcAlpha, d, dstAlpha, cf);
+                result = A::select(blendBoth, A::toChannel(A::div(blended, divisor)), result);
+            }
+
+            if (haveBlendToSrc) {
+                result = A::select(blendToSrc, A::lerp(s, cf, dstAlpha), result);
+            }
+
+            if (haveBlendToDst) {
+                result = A::select(blendToDst, A::lerp(d, cf, srcAlpha), result);
+            }
+
+            if (haveCopySource) {
+                result = A::select(copySource, s, result);
+            }
+
+            dstColors[i] = result;
+        }
+
+        value_v resultAlpha = A::select(blendBothCandidate, newDstAlpha, dstAlpha);
+        resultAlpha = A::select(blendToDst || blendToSrc, A::unitValue(), resultAlpha);
+        resultAlpha = A::select(copySource, srcAlpha, resultAlpha);
+
+        A::write(dst, dstColors, resultAlpha);
+    }
+
+    /**
+     * The unaligned pixels are composed by the same vector code to
+     * guarantee that they get exactly the same values. The pixel is
+     * placed into the first lane, the other lanes are transparent
+     * and skipped by the compositor.
+     */
+    template <bool haveMask, typename _impl>
+    static ALWAYS_INLINE void compositeOnePixelScalar(const quint8 *src, quint8 *dst, const quint8 *mask, float opacity, const ParamsWrapper &oparams)
+    {
+        using A = KoStreamedArithmetic<channels_type, _impl>;
+        constexpr int vectorSize = A::value_v::size;
+
+        alignas(_impl::alignment()) quint8 srcBuf[pixelSize * vectorSize] = {};
+        alignas(_impl::alignment()) quint8 dstBuf[pixelSize * vectorSize] = {};
+        quint8 maskBuf[vectorSize] = {};
+
+        memcpy(srcBuf, src, pixelSize);
+        memcpy(dstBuf, dst, pixelSize);
+        if (haveMask) {
+            maskBuf[0] = *mask;
+        }
+
+        compositeVector<haveMask, true, _impl>(srcBuf, dstBuf, maskBuf, opacity, oparams);
+
+        memcpy(dst, dstBuf, pixelSize);
+    }
+};
+
+/**
+ * An optimized version of KoCompositeOpGenericSCFunctor for the blend
+ * modes defined in KoOptimizedCompositeOpGenericSCModes.h. Works with
+ * RGBA color spaces in U8, U16 and F32.
+ *
+ * When some of the channels are disabled, the composition is delegated
+ * to the generic op.
+ */
+template<typename _impl, typename Mode>
+class KoOptimizedCompositeOpGenericSC : public KoCompositeOp
+{
+    using Traits = typename Mode::Traits;
+
+public:
+    KoOptimizedCompositeOpGenericSC(const KoColorSpace *cs, const QString &id, const QString &category, KoCompositeOp *fallbackOp)
+        : KoCompositeOp(cs, id, category)
+        , m_fallbackOp(fallbackOp)
+    {
+    }
+
+    using KoCompositeOp::composite;
+
+    void composite(const KoCompositeOp::ParameterInfo& params) const override
+    {
+        if (!params.channelFlags.isEmpty() &&
+            params.channelFlags != QBitArray(Traits::channels_nb, true)) {
+
+            m_fallbackOp->composite(params);
+            return;
+        }
+
+        if (params.maskRowStart) {
+            KoStreamedMath<_impl>::template genericComposite<true, false, GenericSCCompositor<Mode>, Traits::pixelSize>(params);
+        } else {
+            KoStreamedMath<_impl>::template genericComposite<false, false, GenericSCCompositor<Mode>, Traits::pixelSize>(params);
+        }
+    }
+
+private:
+    QScopedPointer<KoCompositeOp> m_fallbackOp;
+};
+
+template<typename _impl>
+struct KoOptimizedCompositeOpGenericSCCreator {
+    template<typename Mode>
+    static KoCompositeOp *create(const KoColorSpace *cs, const QString &id, const QString &category)
+    {
+        KoCompositeOp *fallbackOp =
+            KoGenericSCModes::KoGenericSCScalarOpCreator::create<Mode>(cs, id, category);
+
+        return new KoOptimizedCompositeOpGenericSC<_impl, Mode>(cs, id, category, fallbackOp);
+    }
+};
+
+#endif // KOOPTIMIZEDCOMPOSITEOPGENERICSC_H
@@ -0,0 +1,341 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOOPTIMIZEDCOMPOSITEOPGENERICSCMODES_H
+#define KOOPTIMIZEDCOMPOSITEOPGENERICSCMODES_H
+
+#include <KoAlwaysInline.h>
+#include <KoColorSpaceTraits.h>
+#include <KoCompositeOpFunctions.h>
+#include <KoCompositeOpRegistry.h>
+
+#include "KoCompositeOpGeneric.h"
+#include "KoColorSpaceBlendingPolicy.h"
+#include "KoOptimizedCompositeOpFactory.h"
+
+/**
+ * Separable blend modes that have a vectorized implementation
+ * in KoOptimizedCompositeOpGenericSC.
+ *
+ * Every mode is a copy of the corresponding function from
+ * KoCompositeOpFunctions.h written in terms of an arithmetic
+ * policy \p A, which is either KoStreamedArithmetic or any other
+ * class with the same interface. The mode also defines the scalar
+ * functor it replaces (ScalarFunctor), the vector version must
+ * produce exactly the same result as that functor.
+ *
+ * Only the modes, which are built from the basic arithmetic
+ * operations are here. The modes that use pow(), sqrt() or
+ * division in the composite function itself (soft light, dodge,
+ * burn and friends) cannot be reproduced bit-exactly and are
+ * left to the generic implementation.
+ */
+namespace KoGenericSCModes
+{
+
+template<typename channels_type>
+struct RgbaTraits;
+
+template<>
+struct RgbaTraits<quint8> {
+    using type = KoBgrU8Traits;
+};
+
+template<>
+struct RgbaTraits<quint16> {
+    using type = KoBgrU16Traits;
+};
+
+template<>
+struct RgbaTraits<float> {
+    using type = KoRgbF32Traits;
+};
+
+template<typename T, typename Functor>
+struct ModeBase {
+    using channels_type = T;
+    using Traits = typename RgbaTraits<T>::type;
+    using ScalarFunctor = Functor;
+
+    template<class A>
+    static ALWAYS_INLINE typename A::value_v clampSourceChannelValue(const typename A::value_v &value)
+    {
+        return value;
+    }
+
+    template<class A>
+    static ALWAYS_INLINE typename A::value_v clampDestinationChannelValue(const typename A::value_v &value)
+    {
+        return value;
+    }
+};
+
+/// \see KoClampedSourceCompositeOpGenericFunctorBase
+template<typename T, typename Functor>
+struct ClampedSourceModeBase : ModeBase<T, Functor> {
+    template<class A>
+    static ALWAYS_INLINE typename A::value_v clampSourceChannelValue(const typename A::value_v &value)
+    {
+        return A::clampChannelToSDR(value);
+    }
+};
+
+/// \see KoClampedSourceAndDestinationCompositeOpGenericFunctorBase
+template<typename T, typename Functor>
+struct ClampedSourceAndDestinationModeBase : ModeBase<T, Functor> {
+    template<class A>
+    static ALWAYS_INLINE typename A::value_v clampSourceChannelValue(const typename A::value_v &value)
+    {
+        return A::clampChannelToSDR(value);
+    }
+
+    template<class A>
+    static ALWAYS_INLINE typename A::value_v clampDestinationChannelValue(const typename A::value_v &value)
+    {
+        return A::clampChannelToSDR(value);
+    }
+};
+
+/// cfMultiply()
+template<typename T>
+struct Multiply : ModeBase<T, detail::CompositeFunctionWrapper<typename RgbaTraits<T>::type, &cfMultiply<T>>> {
+    template<class A>
+    static ALWAYS_INLINE typename A::value_v composeChannel(const typename A::value_v &src, const typename A::value_v &dst)
+    {
+        return A::mul(src, dst);
+    }
+};
+
+/// cfScreen()
+template<typename T>
+struct Screen : ModeBase<T, detail::CompositeFunctionWrapper<typename RgbaTraits<T>::type, &cfScreen<T>>> {
+    template<class A>
+    static ALWAYS_INLINE typename A::value_v composeChannel(const typename A::value_v &src, const typename A::value_v &dst)
+    {
+        return A::unionShapeOpacity(src, dst);
+    }
+};
+
+/// cfDarkenOnly()
+template<typename T>
+struct Darken : ModeBase<T, detail::CompositeFunctionWrapper<typename RgbaTraits<T>::type, &cfDarkenOnly<T>>> {
+    template<class A>
+    static ALWAYS_INLINE typename A::value_v composeChannel(const typename A::value_v &src, const typename A::value_v &dst)
+    {
+        return A::min(src, dst);
+    }
+};
+
+/// cfLightenOnly()
+template<typename T>
+struct Lighten : ModeBase<T, detail::CompositeFunctionWrapper<typename RgbaTraits<T>::type, &cfLightenOnly<T>>> {
+    template<class A>
+    static ALWAYS_INLINE typename A::value_v composeChannel(const typename A::value_v &src, const typename A::value_v &dst)
+    {
+        return A::max(src, dst);
+    }
+};
+
+/// cfAddition()
+template<typename T>
+struct Addition : ModeBase<T, detail::CompositeFunctionWrapper<typename RgbaTraits<T>::type, &cfAddition<T>>> {
+    template<class A>
+    static ALWAYS_INLINE typename A::value_v composeChannel(const typename A::value_v &src, const typename A::value_v &dst)
+    {
+        return A::clamp(src + dst);
+    }
+};
+
+/// cfSubtract()
+template<typename T>
+struct Subtract : ModeBase<T, detail::CompositeFunctionWrapper<typename RgbaTraits<T>::type, &cfSubtract<T>>> {
+    template<class A>
+    static ALWAYS_INLINE typename A::value_v composeChannel(const typename A::value_v &src, const typename A::value_v &dst)
+    {
+        return A::clamp(dst - src);
+    }
+};
+
+/// cfDifference()
+template<typename T>
+struct Difference : ModeBase<T, detail::CompositeFunctionWrapper<typename RgbaTraits<T>::type, &cfDifference<T>>> {
+    template<class A>
+    static ALWAYS_INLINE typename A::value_v composeChannel(const typename A::value_v &src, const typename A::value_v &dst)
+    {
+        return A::max(src, dst) - A::min(src, dst);
+    }
+};
+
+/// CFExclusion
+template<typename T>
+struct Exclusion : ClampedSourceAndDestinationModeBase<T, CFExclusion<T>> {
+    template<class A>
+    static ALWAYS_INLINE typename A::value_v composeChannel(const typename A::value_v &src, const typename A::value_v &dst)
+    {
+        const typename A::value_v x = A::mul(src, dst);
+        return A::clamp(dst + src - (x + x));
+    }
+};
+
+/// CFGrainMerge
+template<typename T>
+struct GrainMerge : ClampedSourceAndDestinationModeBase<T, CFGrainMerge<T>> {
+    template<class A>
+    static ALWAYS_INLINE typename A::value_v composeChannel(const typename A::value_v &src, const typename A::value_v &dst)
+    {
+        return A::clampToSDR(dst + src - A::halfValue());
+    }
+};
+
+/// CFGrainExtract
+template<typename T>
+struct GrainExtract : ClampedSourceAndDestinationModeBase<T, CFGrainExtract<T>> {
+    template<class A>
+    static ALWAYS_INLINE typename A::value_v composeChannel(const typename A::value_v &src, const typename A::value_v &dst)
+    {
+        return A::clampToSDR(dst - src + A::halfValue());
+    }
+};
+
+/// CFHardLight
+template<typename T>
+struct HardLight : ClampedSourceModeBase<T, CFHardLight<T>> {
+    template<class A>
+    static ALWAYS_INLINE typename A::value_v composeChannel(const typename A::value_v &src, const typename A::value_v &dst)
+    {
+        using value_v = typename A::value_v;
+
+        const value_v src2 = src + src;
+
+        // screen(src*2.0 - 1.0, dst)
+        const value_v screen = A::unionShapeOpacity(A::toChannel(src2 - A::unitValue()), dst);
+        const value_v multiply = A::mul(A::toChannel(src2), dst);
+
+        return A::select(A::isHalfValueFuzzy(src),
+                         dst,
+                         A::select(src > A::halfValue(), screen, multiply));
+    }
+};
+
+/// CFOverlay, it keeps the clamping policy of CFHardLight
+template<typename T>
+struct Overlay : ClampedSourceModeBase<T, CFOverlay<T>> {
+    template<class A>
+    static ALWAYS_INLINE typename A::value_v composeChannel(const typename A::value_v &src, const typename A::value_v &dst)
+    {
+        return HardLight<T>::template composeChannel<A>(dst, src);
+    }
+};
+
+/**
+ * Creates a generic (scalar) version of the \p Mode, exactly the
+ * same op as the one created by KoCompositeOps.h
+ */
+struct KoGenericSCScalarOpCreator {
+    template<typename Mode>
+    static KoCompositeOp *create(const KoColorSpace *cs, const QString &id, const QString &category)
+    {
+        using Traits = typename Mode::Traits;
+        return new KoCompositeOpGenericSCFunctor<Traits, typename Mode::ScalarFunctor, KoAdditiveBlendingPolicy<Traits>>(cs, id, category);
+    }
+};
+
+/**
+ * Creates an op for blend mode \p mode using \p OpCreator,
+ * returns nullptr if the mode has no optimized version
+ */
+template<typename channels_type, typename OpCreator>
+KoCompositeOp *createOptimizedGenericSCOp(const KoColorSpace *cs, KoOptimizedSCMode mode, const QString &id, const QString &category)
+{
+    using T = channels_type;
+
+    switch (mode) {
+    case KoOptimizedSCMode::Multiply:
+        return OpCreator::template create<Multiply<T>>(cs, id, category);
+    case KoOptimizedSCMode::Screen:
+        return OpCreator::template create<Screen<T>>(cs, id, category);
+    case KoOptimizedSCMode::Overlay:
+        return OpCreator::template create<Overlay<T>>(cs, id, category);
+    case KoOptimizedSCMode::HardLight:
+        return OpCreator::template create<HardLight<T>>(cs, id, category);
+    case KoOptimizedSCMode::Darken:
+        return OpCreator::template create<Darken<T>>(cs, id, category);
+    case KoOptimizedSCMode::Lighten:
+        return OpCreator::template create<Lighten<T>>(cs, id, category);
+    case KoOptimizedSCMode::Addition:
+        return OpCreator::template create<Addition<T>>(cs, id, category);
+    case KoOptimizedSCMode::Subtract:
+        return OpCreator::template create<Subtract<T>>(cs, id, category);
+    case KoOptimizedSCMode::Difference:
+        return OpCreator::template create<Difference<T>>(cs, id, category);
+    case KoOptimizedSCMode::Exclusion:
+        return OpCreator::template create<Exclusion<T>>(cs, id, category);
+    case KoOptimizedSCMode::GrainMerge:
+        return OpCreator::template create<GrainMerge<T>>(cs, id, category);
+    case KoOptimizedSCMode::GrainExtract:
+        return OpCreator::template create<GrainExtract<T>>(cs, id, category);
+    case KoOptimizedSCMode::None:
+        break;
+    }
+
+    return nullptr;
+}
+
+} // namespace KoGenericSCModes
+
+/**
+ * Maps the scalar functor of a separable blend mode to its optimized
+ * version. The functors must be the same as the ScalarFunctor of the
+ * corresponding mode in KoGenericSCModes.
+ */
+template<typename Functor>
+struct KoOptimizedSCModeForFunctor {
+    static constexpr KoOptimizedSCMode value = KoOptimizedSCMode::None;
+};
+
+template<typename T>
+struct KoOptimizedSCModeForFunctor<CFOverlay<T>> {
+    static constexpr KoOptimizedSCMode value = KoOptimizedSCMode::Overlay;
+};
+
+template<typename T>
+struct KoOptimizedSCModeForFunctor<CFHardLight<T>> {
+    static constexpr KoOptimizedSCMode value = KoOptimizedSCMode::HardLight;
+};
+
+template<typename T>
+struct KoOptimizedSCModeForFunctor<CFExclusion<T>> {
+    static constexpr KoOptimizedSCMode value = KoOptimizedSCMode::Exclusion;
+};
+
+template<typename T>
+struct KoOptimizedSCModeForFunctor<CFGrainMerge<T>> {
+    static constexpr KoOptimizedSCMode value = KoOptimizedSCMode::GrainMerge;
+};
+
+template<typename T>
+struct KoOptimizedSCModeForFunctor<CFGrainExtract<T>> {
+    static constexpr KoOptimizedSCMode value = KoOptimizedSCMode::GrainExtract;
+};
+
+/**
+ * The same mapping for the blend modes defined as plain
+ * composite functions
+ */
+template<typename T, T compositeFunc(T, T)>
+constexpr KoOptimizedSCMode optimizedSCModeForFunction()
+{
+    return compositeFunc == &cfMultiply<T> ? KoOptimizedSCMode::Multiply :
+           compositeFunc == &cfScreen<T> ? KoOptimizedSCMode::Screen :
+           compositeFunc == &cfDarkenOnly<T> ? KoOptimizedSCMode::Darken :
+           compositeFunc == &cfLightenOnly<T> ? KoOptimizedSCMode::Lighten :
+           compositeFunc == &cfAddition<T> ? KoOptimizedSCMode::Addition :
+           compositeFunc == &cfSubtract<T> ? KoOptimizedSCMode::Subtract :
+           compositeFunc == &cfDifference<T> ? KoOptimizedSCMode::Difference :
+           KoOptimizedSCMode::None;
+}
+
+#endif // KOOPTIMIZEDCOMPOSITEOPGENERICSCMODES_H
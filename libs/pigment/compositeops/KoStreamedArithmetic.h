@@ -0,0 +1,577 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __KOSTREAMED_ARITHMETIC_H
+#define __KOSTREAMED_ARITHMETIC_H
+
+#include <limits>
+#include <type_traits>
+
+#include "KoStreamedMath.h"
+
+/**
+ * Vector versions of the functions from Arithmetic namespace
+ * (KoColorSpaceMaths.h) for RGBA pixels with the alpha channel placed
+ * last.
+ *
+ * Every function returns exactly the same value as its scalar
+ * counterpart for channels_type, including the rounding and the
+ * wrapping of the integer values when they are cast back into
+ * channels_type. That is, the optimized composite ops built on these
+ * functions produce the same pixels as the generic ones.
+ *
+ * Integer channels are kept in int lanes, floating point channels in
+ * float lanes. The type of the lane is available as value_v.
+ */
+template<typename channels_type, typename _impl>
+struct KoStreamedArithmetic;
+
+template<typename channels_type, typename _impl>
+struct KoStreamedIntegerArithmeticBase {
+    using int_v = xsimd::batch<int, _impl>;
+    using uint_v = xsimd::batch<unsigned int, _impl>;
+    using float_v = xsimd::batch<float, _impl>;
+    using value_v = int_v;
+    using mask_v = typename int_v::batch_bool_type;
+
+    static_assert(int_v::size == float_v::size, "the selected architecture does not guarantee vector size equality!");
+
+    static constexpr int unit = KoColorSpaceMathsTraits<channels_type>::unitValue;
+    static constexpr int half = KoColorSpaceMathsTraits<channels_type>::halfValue;
+
+    static ALWAYS_INLINE int_v zeroValue()
+    {
+        return int_v(0);
+    }
+
+    static ALWAYS_INLINE int_v unitValue()
+    {
+        return int_v(unit);
+    }
+
+    static ALWAYS_INLINE int_v halfValue()
+    {
+        return int_v(half);
+    }
+
+    static ALWAYS_INLINE int_v fromScalar(channels_type value)
+    {
+        return int_v(value);
+    }
+
+    static ALWAYS_INLINE int_v select(const mask_v &mask, const int_v &a, const int_v &b)
+    {
+        return xsimd::select(mask, a, b);
+    }
+
+    /**
+     * Logical shift to the right, that is the lanes are treated
+     * as unsigned values
+     */
+    static ALWAYS_INLINE int_v srl(const int_v &x, int shift)
+    {
+        return xsimd::bitwise_cast_compat<int>(xsimd::bitwise_cast_compat<unsigned int>(x) >> shift);
+    }
+
+    /**
+     * Compares the lanes as unsigned values
+     */
+    static ALWAYS_INLINE mask_v greaterOrEqualUnsigned(const int_v &a, const int_v &b)
+    {
+        const int_v signBit(std::numeric_limits<int>::min());
+        return (a ^ signBit) >= (b ^ signBit);
+    }
+
+    /**
+     * KoColorSpaceMaths<channels_type, float>::scaleToA()
+     */
+    static ALWAYS_INLINE float_v toFloat(const int_v &x)
+    {
+        return xsimd::to_float(x) / float_v(float(unit));
+    }
+
+    /**
+     * KoColorSpaceMaths<float, channels_type>::scaleToA()
+     */
+    static ALWAYS_INLINE int_v fromFloat(const float_v &x)
+    {
+        const float_v v = x * float_v(float(unit));
+        const float_v clamped =
+            xsimd::select(v < float_v(0.0f), float_v(0.0f),
+                          xsimd::select(v > float_v(float(unit)), float_v(float(unit)), v));
+
+        // float2int()
+        return xsimd::to_int(clamped + float_v(0.5f));
+    }
+
+    /**
+     * Emulates the cast into channels_type, that is the value is
+     * wrapped around
+     */
+    static ALWAYS_INLINE int_v toChannel(const int_v &x)
+    {
+        return x & int_v(unit);
+    }
+
+    static ALWAYS_INLINE int_v inv(const int_v &a)
+    {
+        return int_v(unit) - a;
+    }
+
+    /**
+     * UINT8_DIVIDE and UINT16_DIVIDE: (a * unit + b / 2) / b
+     *
+     * There is no integer division in SIMD, so the quotient is
+     * estimated in floats and then fixed using the exact remainder.
+     * The result is exact for any quotient that fits into 31 bits.
+     * The lanes with \p b equal to zero are undefined.
+     */
+    static ALWAYS_INLINE int_v div(const int_v &a, const int_v &b)
+    {
+        const int_v halfB = b >> 1;
+
+        // for quint16 it overflows int, but the bits are the same as in uint
+        const int_v n = a * int_v(unit) + halfB;
+
+        const float_v fb = xsimd::to_float(b);
+        int_v q = xsimd::to_int((xsimd::to_float(a) * float_v(float(unit)) + xsimd::to_float(halfB)) / fb);
+
+        int_v r = n - q * b;
+        q += xsimd::to_int(xsimd::to_float(r) / fb);
+        r = n - q * b;
+
+        const mask_v isNegative = r < int_v(0);
+        q = xsimd::select(isNegative, q - int_v(1), q);
+        r = xsimd::select(isNegative, r + b, r);
+        q = xsimd::select(r >= b, q + int_v(1), q);
+
+        return q;
+    }
+
+    /**
+     * Arithmetic::clamp<T>() of a composite value
+     */
+    static ALWAYS_INLINE int_v clamp(const int_v &x)
+    {
+        return clampToSDR(x);
+    }
+
+    static ALWAYS_INLINE int_v clampToSDR(const int_v &x)
+    {
+        return max(int_v(0), min(int_v(unit), x));
+    }
+
+    static ALWAYS_INLINE int_v clampChannelToSDR(const int_v &x)
+    {
+        return x;
+    }
+
+    static ALWAYS_INLINE int_v clampChannelToSDRBottom(const int_v &x)
+    {
+        return x;
+    }
+
+    /**
+     * Same semantics as qMin()
+     */
+    static ALWAYS_INLINE int_v min(const int_v &a, const int_v &b)
+    {
+        return xsimd::select(a < b, a, b);
+    }
+
+    /**
+     * Same semantics as qMax()
+     */
+    static ALWAYS_INLINE int_v max(const int_v &a, const int_v &b)
+    {
+        return xsimd::select(a < b, b, a);
+    }
+
+    static ALWAYS_INLINE mask_v isZeroValueFuzzy(const int_v &a)
+    {
+        return a == int_v(0);
+    }
+
+    static ALWAYS_INLINE mask_v isUnitValueFuzzy(const int_v &a)
+    {
+        return a == int_v(unit);
+    }
+
+    static ALWAYS_INLINE mask_v isHalfValueFuzzy(const int_v &a)
+    {
+        return a == int_v(half);
+    }
+};
+
+template<typename _impl>
+struct KoStreamedArithmetic<quint8, _impl> : public KoStreamedIntegerArithmeticBase<quint8, _impl> {
+    using base_class = KoStreamedIntegerArithmeticBase<quint8, _impl>;
+    using typename base_class::int_v;
+    using typename base_class::uint_v;
+    using typename base_class::value_v;
+    using typename base_class::mask_v;
+    using base_class::inv;
+    using base_class::toChannel;
+
+    /// UINT8_MULT
+    static ALWAYS_INLINE int_v mul(const int_v &a, const int_v &b)
+    {
+        const int_v c = a * b + int_v(0x80);
+        return ((c >> 8) + c) >> 8;
+    }
+
+    /// UINT8_MULT3
+    static ALWAYS_INLINE int_v mul(const int_v &a, const int_v &b, const int_v &c)
+    {
+        const int_v t = a * b * c + int_v(0x7F5B);
+        return ((t >> 7) + t) >> 16;
+    }
+
+    /// UINT8_BLEND(b, a, alpha)
+    static ALWAYS_INLINE int_v lerp(const int_v &a, const int_v &b, const int_v &alpha)
+    {
+        int_v c = (b - a) * alpha + int_v(0x80);
+        c = ((c >> 8) + c) >> 8;
+        return toChannel(c + a);
+    }
+
+    static ALWAYS_INLINE int_v unionShapeOpacity(const int_v &a, const int_v &b)
+    {
+        return toChannel(a + b - mul(a, b));
+    }
+
+    static ALWAYS_INLINE int_v blend(const int_v &src, const int_v &srcAlpha, const int_v &dst, const int_v &dstAlpha, const int_v &cfValue)
+    {
+        return toChannel(mul(inv(srcAlpha), dstAlpha, dst) + mul(inv(dstAlpha), srcAlpha, src) + mul(dstAlpha, srcAlpha, cfValue));
+    }
+
+    static ALWAYS_INLINE int_v fetchMask(const quint8 *mask)
+    {
+        return xsimd::load_and_extend<int_v>(mask);
+    }
+
+    /**
+     * Reads int_v::size pixels, 4 bytes each, the alpha channel is
+     * stored in the most significant byte
+     */
+    template<bool aligned>
+    static ALWAYS_INLINE void read(const quint8 *data, int_v *colors, int_v &alpha)
+    {
+        using U = typename std::conditional<aligned, xsimd::aligned_mode, xsimd::unaligned_mode>::type;
+        const auto pixels = uint_v::load(reinterpret_cast<const typename uint_v::value_type *>(data), U{});
+        const uint_v mask(0xFF);
+
+        colors[0] = xsimd::bitwise_cast_compat<int>(pixels & mask);
+        colors[1] = xsimd::bitwise_cast_compat<int>((pixels >> 8) & mask);
+        colors[2] = xsimd::bitwise_cast_compat<int>((pixels >> 16) & mask);
+        alpha = xsimd::bitwise_cast_compat<int>(pixels >> 24);
+    }
+
+    /**
+     * NOTE: \p data must be aligned pointer!
+     */
+    static ALWAYS_INLINE void write(quint8 *data, const int_v *colors, const int_v &alpha)
+    {
+        const int_v mask(0xFF);
+
+        const auto pixels =
+            ((alpha & mask) << 24) | ((colors[2] & mask) << 16) | ((colors[1] & mask) << 8) | (colors[0] & mask);
+        xsimd::store_aligned(reinterpret_cast<typename int_v::value_type *>(data), pixels);
+    }
+};
+
+template<typename _impl>
+struct KoStreamedArithmetic<quint16, _impl> : public KoStreamedIntegerArithmeticBase<quint16, _impl> {
+    using base_class = KoStreamedIntegerArithmeticBase<quint16, _impl>;
+    using typename base_class::int_v;
+    using typename base_class::uint_v;
+    using typename base_class::value_v;
+    using typename base_class::mask_v;
+    using base_class::inv;
+    using base_class::srl;
+    using base_class::toChannel;
+
+    /**
+     * Exact x / 65535 for any x that is less than 65535 * 65537,
+     * the lanes are treated as unsigned values
+     */
+    static ALWAYS_INLINE int_v div65535(const int_v &x)
+    {
+        return srl(x + srl(x, 16) + int_v(1), 16);
+    }
+
+    /// UINT16_MULT
+    static ALWAYS_INLINE int_v mul(const int_v &a, const int_v &b)
+    {
+        const int_v c = a * b + int_v(0x8000);
+        return srl(srl(c, 16) + c, 16);
+    }
+
+    /**
+     * (qint64(a) * b * c) / (65535 * 65535)
+     *
+     * The product doesn't fit into 32 bits, so we split it:
+     * a * b = x * 65535 + y, x * c = u * 65535 + v, hence the
+     * quotient is u plus the carry of (v * 65535 + y * c) / 65535^2,
+     * which is either 0 or 1.
+     */
+    static ALWAYS_INLINE int_v mul(const int_v &a, const int_v &b, const int_v &c)
+    {
+        const int_v unit(65535);
+
+        const int_v ab = a * b;
+        const int_v x = div65535(ab);
+        const int_v y = ab - x * unit;
+
+        const int_v xc = x * c;
+        const int_v u = div65535(xc);
+        const int_v v = xc - u * unit;
+
+        const mask_v carry = base_class::greaterOrEqualUnsigned(y * c, unit * (unit - v));
+        return xsimd::select(carry, u + int_v(1), u);
+    }
+
+    /**
+     * KoColorSpaceMaths<quint16>::blend(b, a, alpha), the division
+     * is truncated towards zero
+     */
+    static ALWAYS_INLINE int_v lerp(const int_v &a, const int_v &b, const int_v &alpha)
+    {
+        const int_v diff = b - a;
+        const int_v c = div65535(xsimd::abs(diff) * alpha);
+        return toChannel(xsimd::select(diff < int_v(0), -c, c) + a);
+    }
+
+    static ALWAYS_INLINE int_v unionShapeOpacity(const int_v &a, const int_v &b)
+    {
+        return toChannel(a + b - mul(a, b));
+    }
+
+    static ALWAYS_INLINE int_v blend(const int_v &src, const int_v &srcAlpha, const int_v &dst, const int_v &dstAlpha, const int_v &cfValue)
+    {
+        return toChannel(mul(inv(srcAlpha), dstAlpha, dst) + mul(inv(dstAlpha), srcAlpha, src) + mul(dstAlpha, srcAlpha, cfValue));
+    }
+
+    /// UINT8_TO_UINT16
+    static ALWAYS_INLINE int_v fetchMask(const quint8 *mask)
+    {
+        const int_v value = xsimd::load_and_extend<int_v>(mask);
+        return (value << 8) | value;
+    }
+
+    template<bool aligned>
+    static ALWAYS_INLINE void read(const quint8 *data, int_v *colors, int_v &alpha)
+    {
+        // struct PackedPixel {
+        //    float rrgg;
+        //    float bbaa;
+        // }
+#if XSIMD_VERSION_MAJOR < 10
+        uint_v pixelsC1C2;
+        uint_v pixelsC3Alpha;
+        KoRgbaInterleavers<16>::deinterleave(data, pixelsC1C2, pixelsC3Alpha);
+#else
+        const auto *srcPtr = reinterpret_cast<const typename uint_v::value_type *>(data);
+        const auto idx1 = xsimd::detail::make_sequence_as_batch<int_v>() * 2; // stride == 2
+        const auto idx2 = idx1 + 1; // offset 1 == 2nd members
+
+        const auto pixelsC1C2 = uint_v::gather(srcPtr, idx1);
+        const auto pixelsC3Alpha = uint_v::gather(srcPtr, idx2);
+#endif
+        const uint_v mask(0xFFFF);
+
+        colors[0] = xsimd::bitwise_cast_compat<int>(pixelsC1C2 & mask);
+        colors[1] = xsimd::bitwise_cast_compat<int>(pixelsC1C2 >> 16);
+        colors[2] = xsimd::bitwise_cast_compat<int>(pixelsC3Alpha & mask);
+        alpha = xsimd::bitwise_cast_compat<int>(pixelsC3Alpha >> 16);
+    }
+
+    static ALWAYS_INLINE void write(quint8 *data, const int_v *colors, const int_v &alpha)
+    {
+        const uint_v mask(0xFFFF);
+
+        const auto v1 = xsimd::bitwise_cast_compat<unsigned int>(colors[0]);
+        const auto v2 = xsimd::bitwise_cast_compat<unsigned int>(colors[1]);
+        const auto v3 = xsimd::bitwise_cast_compat<unsigned int>(colors[2]);
+        const auto v4 = xsimd::bitwise_cast_compat<unsigned int>(alpha);
+
+        const auto c1c2 = ((v2 & mask) << 16) | (v1 & mask);
+        const auto c3ca = ((v4 & mask) << 16) | (v3 & mask);
+
+#if XSIMD_VERSION_MAJOR < 10
+        KoRgbaInterleavers<16>::interleave(data, c1c2, c3ca);
+#else
+        auto dstPtr = reinterpret_cast<typename int_v::value_type *>(data);
+
+        const auto idx1 = xsimd::detail::make_sequence_as_batch<int_v>() * 2;
+        const auto idx2 = idx1 + 1;
+
+        c1c2.scatter(dstPtr, idx1);
+        c3ca.scatter(dstPtr, idx2);
+#endif
+    }
+};
+
+template<typename _impl>
+struct KoStreamedArithmetic<float, _impl> {
+    using int_v = xsimd::batch<int, _impl>;
+    using float_v = xsimd::batch<float, _impl>;
+    using value_v = float_v;
+    using mask_v = typename float_v::batch_bool_type;
+
+    static ALWAYS_INLINE float_v zeroValue()
+    {
+        return float_v(0.0f);
+    }
+
+    static ALWAYS_INLINE float_v unitValue()
+    {
+        return float_v(1.0f);
+    }
+
+    static ALWAYS_INLINE float_v halfValue()
+    {
+        return float_v(0.5f);
+    }
+
+    static ALWAYS_INLINE float_v fromScalar(float value)
+    {
+        return float_v(value);
+    }
+
+    static ALWAYS_INLINE float_v select(const mask_v &mask, const float_v &a, const float_v &b)
+    {
+        return xsimd::select(mask, a, b);
+    }
+
+    static ALWAYS_INLINE float_v toChannel(const float_v &x)
+    {
+        return x;
+    }
+
+    static ALWAYS_INLINE float_v toFloat(const float_v &x)
+    {
+        return x;
+    }
+
+    static ALWAYS_INLINE float_v fromFloat(const float_v &x)
+    {
+        return x;
+    }
+
+    static ALWAYS_INLINE float_v inv(const float_v &a)
+    {
+        return float_v(1.0f) - a;
+    }
+
+    static ALWAYS_INLINE float_v mul(const float_v &a, const float_v &b)
+    {
+        return a * b;
+    }
+
+    static ALWAYS_INLINE float_v mul(const float_v &a, const float_v &b, const float_v &c)
+    {
+        return a * b * c;
+    }
+
+    static ALWAYS_INLINE float_v div(const float_v &a, const float_v &b)
+    {
+        return a / b;
+    }
+
+    static ALWAYS_INLINE float_v lerp(const float_v &a, const float_v &b, const float_v &alpha)
+    {
+        return (b - a) * alpha + a;
+    }
+
+    static ALWAYS_INLINE float_v unionShapeOpacity(const float_v &a, const float_v &b)
+    {
+        return a + b - a * b;
+    }
+
+    static ALWAYS_INLINE float_v blend(const float_v &src, const float_v &srcAlpha, const float_v &dst, const float_v &dstAlpha, const float_v &cfValue)
+    {
+        return mul(inv(srcAlpha), dstAlpha, dst) + mul(inv(dstAlpha), srcAlpha, src) + mul(dstAlpha, srcAlpha, cfValue);
+    }
+
+    /**
+     * KoColorSpaceMaths<float>::clamp() does nothing
+     */
+    static ALWAYS_INLINE float_v clamp(const float_v &x)
+    {
+        return x;
+    }
+
+    static ALWAYS_INLINE float_v clampToSDR(const float_v &x)
+    {
+        return max(float_v(0.0f), min(float_v(1.0f), x));
+    }
+
+    static ALWAYS_INLINE float_v clampChannelToSDR(const float_v &x)
+    {
+        return clampToSDR(x);
+    }
+
+    static ALWAYS_INLINE float_v clampChannelToSDRBottom(const float_v &x)
+    {
+        return max(float_v(0.0f), x);
+    }
+
+    /**
+     * Same semantics as qMin(), including NaN handling
+     */
+    static ALWAYS_INLINE float_v min(const float_v &a, const float_v &b)
+    {
+        return xsimd::select(a < b, a, b);
+    }
+
+    /**
+     * Same semantics as qMax(), including NaN handling
+     */
+    static ALWAYS_INLINE float_v max(const float_v &a, const float_v &b)
+    {
+        return xsimd::select(a < b, b, a);
+    }
+
+    /// qFuzzyIsNull()
+    static ALWAYS_INLINE mask_v isZeroValueFuzzy(const float_v &a)
+    {
+        return xsimd::abs(a) <= float_v(0.00001f);
+    }
+
+    /// qFuzzyCompare(a, 1.0f)
+    static ALWAYS_INLINE mask_v isUnitValueFuzzy(const float_v &a)
+    {
+        return xsimd::abs(a - float_v(1.0f)) * float_v(100000.f) <= min(xsimd::abs(a), float_v(1.0f));
+    }
+
+    /// qFuzzyCompare(a, 0.5f)
+    static ALWAYS_INLINE mask_v isHalfValueFuzzy(const float_v &a)
+    {
+        return xsimd::abs(a - float_v(0.5f)) * float_v(100000.f) <= min(xsimd::abs(a), float_v(0.5f));
+    }
+
+    /// KoLuts::Uint8ToFloat
+    static ALWAYS_INLINE float_v fetchMask(const quint8 *mask)
+    {
+        return xsimd::to_float(xsimd::load_and_extend<int_v>(mask)) / float_v(255.0f);
+    }
+
+    template<bool aligned>
+    static ALWAYS_INLINE void read(const quint8 *data, float_v *colors, float_v &alpha)
+    {
+        PixelWrapper<float, _impl> dataWrapper;
+        dataWrapper.read(data, colors[0], colors[1], colors[2], alpha);
+    }
+
+    static ALWAYS_INLINE void write(quint8 *data, const float_v *colors, const float_v &alpha)
+    {
+        PixelWrapper<float, _impl> dataWrapper;
+        dataWrapper.write(data, colors[0], colors[1], colors[2], alpha);
+    }
+};
+
+#endif /* __KOSTREAMED_ARITHMETIC_H */
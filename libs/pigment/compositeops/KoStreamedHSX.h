@@ -0,0 +1,277 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef __KOSTREAMED_HSX_H
+#define __KOSTREAMED_HSX_H
+
+#include <limits>
+
+#include "KoStreamedMath.h"
+
+/**
+ * Vector versions of the HSX functions from KoColorSpaceMaths.h
+ * (HSYType, HSIType, HSLType, HSVType, setSaturation(),
+ * setLightness() and friends). The functions follow the scalar ones
+ * operation by operation, the branches are replaced with masks.
+ */
+template<typename HSXType, typename _impl>
+struct KoStreamedHSXType;
+
+template<typename _impl>
+struct KoStreamedHSXCommon {
+    using float_v = xsimd::batch<float, _impl>;
+    using float_m = typename float_v::batch_bool_type;
+
+    /// Arithmetic::min(a, b, c)
+    static ALWAYS_INLINE float_v min(const float_v &a, const float_v &b, const float_v &c)
+    {
+        const float_v t = xsimd::select(a < b, a, b);
+        return xsimd::select(t < c, t, c);
+    }
+
+    /// Arithmetic::max(a, b, c)
+    static ALWAYS_INLINE float_v max(const float_v &a, const float_v &b, const float_v &c)
+    {
+        const float_v t = xsimd::select(a > b, a, b);
+        return xsimd::select(t > c, t, c);
+    }
+
+    static ALWAYS_INLINE float_v select(const float_m &mask, const float_v &a, const float_v &b)
+    {
+        return xsimd::select(mask, a, b);
+    }
+
+    static ALWAYS_INLINE float_v epsilon()
+    {
+        return float_v(std::numeric_limits<float>::epsilon());
+    }
+};
+
+template<typename _impl>
+struct KoStreamedHSXType<HSYType, _impl> : KoStreamedHSXCommon<_impl> {
+    using base_class = KoStreamedHSXCommon<_impl>;
+    using typename base_class::float_v;
+    static constexpr bool lightnessIsAverage = HSYType::lightnessIsAverage;
+
+    static ALWAYS_INLINE float_v getLightness(const float_v &r, const float_v &g, const float_v &b)
+    {
+        return float_v(float(0.299)) * r + float_v(float(0.587)) * g + float_v(float(0.114)) * b;
+    }
+
+    static ALWAYS_INLINE float_v getSaturation(const float_v &r, const float_v &g, const float_v &b)
+    {
+        return base_class::max(r, g, b) - base_class::min(r, g, b);
+    }
+};
+
+template<typename _impl>
+struct KoStreamedHSXType<HSIType, _impl> : KoStreamedHSXCommon<_impl> {
+    using base_class = KoStreamedHSXCommon<_impl>;
+    using typename base_class::float_v;
+    static constexpr bool lightnessIsAverage = HSIType::lightnessIsAverage;
+
+    static ALWAYS_INLINE float_v getLightness(const float_v &r, const float_v &g, const float_v &b)
+    {
+        return (r + g + b) * float_v(float(0.33333333333333333333));
+    }
+
+    static ALWAYS_INLINE float_v getSaturation(const float_v &r, const float_v &g, const float_v &b)
+    {
+        const float_v max = base_class::max(r, g, b);
+        const float_v min = base_class::min(r, g, b);
+        const float_v chroma = max - min;
+
+        return xsimd::select(chroma > base_class::epsilon(),
+                             float_v(1.0f) - min / getLightness(r, g, b),
+                             float_v(0.0f));
+    }
+};
+
+template<typename _impl>
+struct KoStreamedHSXType<HSLType, _impl> : KoStreamedHSXCommon<_impl> {
+    using base_class = KoStreamedHSXCommon<_impl>;
+    using typename base_class::float_v;
+    static constexpr bool lightnessIsAverage = HSLType::lightnessIsAverage;
+
+    static ALWAYS_INLINE float_v getLightness(const float_v &r, const float_v &g, const float_v &b)
+    {
+        return (base_class::max(r, g, b) + base_class::min(r, g, b)) * float_v(0.5f);
+    }
+
+    static ALWAYS_INLINE float_v getSaturation(const float_v &r, const float_v &g, const float_v &b)
+    {
+        const float_v max = base_class::max(r, g, b);
+        const float_v min = base_class::min(r, g, b);
+        const float_v chroma = max - min;
+        const float_v light = (max + min) * float_v(0.5f);
+        const float_v div = float_v(1.0f) - xsimd::abs(float_v(2.0f) * light - float_v(1.0f));
+
+        return xsimd::select(div > base_class::epsilon(), chroma / div, float_v(0.0f));
+    }
+};
+
+template<typename _impl>
+struct KoStreamedHSXType<HSVType, _impl> : KoStreamedHSXCommon<_impl> {
+    using base_class = KoStreamedHSXCommon<_impl>;
+    using typename base_class::float_v;
+    static constexpr bool lightnessIsAverage = HSVType::lightnessIsAverage;
+
+    static ALWAYS_INLINE float_v getLightness(const float_v &r, const float_v &g, const float_v &b)
+    {
+        return base_class::max(r, g, b);
+    }
+
+    static ALWAYS_INLINE float_v getSaturation(const float_v &r, const float_v &g, const float_v &b)
+    {
+        const float_v max = base_class::max(r, g, b);
+        const float_v min = base_class::min(r, g, b);
+
+        return xsimd::select(max > base_class::epsilon(), (max - min) / max, float_v(0.0f));
+    }
+};
+
+template<typename _impl>
+struct KoStreamedHSX : KoStreamedHSXCommon<_impl> {
+    using base_class = KoStreamedHSXCommon<_impl>;
+    using typename base_class::float_v;
+    using typename base_class::float_m;
+
+    template<typename HSXType>
+    static ALWAYS_INLINE float_v getLightness(const float_v &r, const float_v &g, const float_v &b)
+    {
+        return KoStreamedHSXType<HSXType, _impl>::getLightness(r, g, b);
+    }
+
+    template<typename HSXType>
+    static ALWAYS_INLINE float_v getSaturation(const float_v &r, const float_v &g, const float_v &b)
+    {
+        return KoStreamedHSXType<HSXType, _impl>::getSaturation(r, g, b);
+    }
+
+    /// \see ToneMapping()
+    template<typename HSXType>
+    static ALWAYS_INLINE void toneMapping(float_v &r, float_v &g, float_v &b)
+    {
+        const float_v zero(0.0f);
+        const float_v unit(1.0f);
+
+        const float_v l = getLightness<HSXType>(r, g, b);
+        const float_v n = base_class::min(r, g, b);
+        const float_v x = base_class::max(r, g, b);
+
+        const float_m hasNegative = n < zero;
+
+        if (xsimd::any(hasNegative)) {
+            const float_v stretch = l - n;
+            const float_m dropToZero = (l <= float_v(0.00001f)) || (stretch < base_class::epsilon());
+            const float_v iln = unit / stretch;
+
+            const float_m resetMask = hasNegative && dropToZero;
+            const float_m stretchMask = hasNegative && !dropToZero;
+
+            r = xsimd::select(resetMask, zero, xsimd::select(stretchMask, l + ((r - l) * l) * iln, r));
+            g = xsimd::select(resetMask, zero, xsimd::select(stretchMask, l + ((g - l) * l) * iln, g));
+            b = xsimd::select(resetMask, zero, xsimd::select(stretchMask, l + ((b - l) * l) * iln, b));
+        }
+
+        const float_m hasOverflow = x > unit;
+
+        if (xsimd::any(hasOverflow)) {
+            const float_v stretch = x - l;
+            const float_m useFallback = (l > unit) || (stretch < base_class::epsilon());
+            const float_v il = unit - l;
+            const float_v ixl = unit / stretch;
+
+            const float_m fallbackMask = hasOverflow && useFallback;
+            const float_m stretchMask = hasOverflow && !useFallback;
+
+            float_v fallbackR = unit;
+            float_v fallbackG = unit;
+            float_v fallbackB = unit;
+
+            if (!HSXType::lightnessIsAverage) {
+                fallbackR = xsimd::select(r < unit, r, unit);
+                fallbackG = xsimd::select(g < unit, g, unit);
+                fallbackB = xsimd::select(b < unit, b, unit);
+            }
+
+            r = xsimd::select(fallbackMask, fallbackR, xsimd::select(stretchMask, l + ((r - l) * il) * ixl, r));
+            g = xsimd::select(fallbackMask, fallbackG, xsimd::select(stretchMask, l + ((g - l) * il) * ixl, g));
+            b = xsimd::select(fallbackMask, fallbackB, xsimd::select(stretchMask, l + ((b - l) * il) * ixl, b));
+        }
+    }
+
+    template<typename HSXType>
+    static ALWAYS_INLINE void addLightness(float_v &r, float_v &g, float_v &b, const float_v &light)
+    {
+        r += light;
+        g += light;
+        b += light;
+
+        toneMapping<HSXType>(r, g, b);
+    }
+
+    template<typename HSXType>
+    static ALWAYS_INLINE void setLightness(float_v &r, float_v &g, float_v &b, const float_v &light)
+    {
+        addLightness<HSXType>(r, g, b, light - getLightness<HSXType>(r, g, b));
+    }
+
+    /**
+     * \see setSaturation()
+     *
+     * The scalar version sorts the channels with a sorting network,
+     * which defines which of the equal channels becomes "mid" and
+     * which becomes "max". We track the indices of the channels to
+     * get exactly the same result in the case of ties.
+     */
+    static ALWAYS_INLINE void setSaturation(float_v &r, float_v &g, float_v &b, const float_v &sat)
+    {
+        float_v minIndex(0.0f);
+        float_v midIndex(1.0f);
+        float_v maxIndex(2.0f);
+
+        float_v minValue = r;
+        float_v midValue = g;
+        float_v maxValue = b;
+
+        auto swap = [] (const float_m &mask, float_v &a, float_v &b) {
+            const float_v tmp = a;
+            a = xsimd::select(mask, b, a);
+            b = xsimd::select(mask, tmp, b);
+        };
+
+        float_m mask = midValue < minValue;
+        swap(mask, minIndex, midIndex);
+        swap(mask, minValue, midValue);
+
+        mask = maxValue < midValue;
+        swap(mask, midIndex, maxIndex);
+        swap(mask, midValue, maxValue);
+
+        mask = midValue < minValue;
+        swap(mask, minIndex, midIndex);
+        swap(mask, minValue, midValue);
+
+        const float_v chroma = maxValue - minValue;
+        const float_m isChromatic = chroma > base_class::epsilon();
+        const float_v newMidValue = ((midValue - minValue) * sat) / chroma;
+        const float_v zero(0.0f);
+
+        auto channelValue = [&] (const float_v &index) {
+            const float_v value =
+                xsimd::select(maxIndex == index, sat,
+                              xsimd::select(minIndex == index, zero, newMidValue));
+            return xsimd::select(isChromatic, value, zero);
+        };
+
+        r = channelValue(float_v(0.0f));
+        g = channelValue(float_v(1.0f));
+        b = channelValue(float_v(2.0f));
+    }
+};
+
+#endif /* __KOSTREAMED_HSX_H */
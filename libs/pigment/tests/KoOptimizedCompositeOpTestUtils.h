@@ -0,0 +1,142 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KOOPTIMIZEDCOMPOSITEOPTESTUTILS_H
+#define KOOPTIMIZEDCOMPOSITEOPTESTUTILS_H
+
+#include <simpletest.h>
+
+#include <QRandomGenerator>
+#include <QScopedPointer>
+
+#include <KoColorSpace.h>
+#include <KoColorSpaceMaths.h>
+#include <KoCompositeOp.h>
+
+#include "kis_debug.h"
+
+/**
+ * A common harness for the tests of the optimized composite ops. The
+ * op registered in the color space is compared against a reference op
+ * on random buffers, with and without mask, with different opacity,
+ * unaligned source and zero source stride.
+ */
+namespace KoOptimizedCompositeOpTestUtils
+{
+
+template<typename T>
+T randomChannel(QRandomGenerator &rnd)
+{
+    return T(rnd.bounded(int(KoColorSpaceMathsTraits<T>::unitValue) + 1));
+}
+
+template<>
+inline float randomChannel<float>(QRandomGenerator &rnd)
+{
+    // slightly out of SDR range to check the clamping
+    return float(rnd.bounded(1.4) - 0.2);
+}
+
+template<typename T>
+T randomAlpha(QRandomGenerator &rnd)
+{
+    // make sure all the branches of the compositor are used
+    switch (rnd.bounded(4)) {
+    case 0:
+        return KoColorSpaceMathsTraits<T>::zeroValue;
+    case 1:
+        return KoColorSpaceMathsTraits<T>::unitValue;
+    default:
+        return std::is_integral<T>::value ?
+            randomChannel<T>(rnd) : T(rnd.bounded(1.0));
+    }
+}
+
+/**
+ * Compares op \p id of RGBA color space \p cs with the op created by
+ * \p createRefOp(cs, id, category). The channels of the results are
+ * compared with \p channelsEqual(actual, expected).
+ */
+template<typename T, typename RefOpCreator, typename ChannelsEqual>
+void testOpAgainstReference(const KoColorSpace *cs, const QString &id,
+                            RefOpCreator createRefOp, ChannelsEqual channelsEqual)
+{
+    QVERIFY(cs);
+
+    const KoCompositeOp *op = cs->compositeOp(id);
+    QCOMPARE(op->id(), id);
+
+    QScopedPointer<KoCompositeOp> refOp(createRefOp(cs, id, op->category()));
+    QVERIFY(refOp);
+
+    const int width = 67;
+    const int height = 5;
+    const int pixelSize = 4 * sizeof(T);
+    const int numChannels = 4 * (width + 1) * height;
+
+    QRandomGenerator rnd(id.size());
+
+    QVector<T> src(numChannels);
+    QVector<T> dst(numChannels);
+    QVector<quint8> mask(width * height);
+
+    for (int i = 0; i < numChannels; i += 4) {
+        src[i] = randomChannel<T>(rnd);
+        src[i + 1] = randomChannel<T>(rnd);
+        src[i + 2] = randomChannel<T>(rnd);
+        src[i + 3] = randomAlpha<T>(rnd);
+
+        dst[i] = randomChannel<T>(rnd);
+        dst[i + 1] = randomChannel<T>(rnd);
+        dst[i + 2] = randomChannel<T>(rnd);
+        dst[i + 3] = randomAlpha<T>(rnd);
+    }
+
+    for (int i = 0; i < mask.size(); i++) {
+        mask[i] = quint8(rnd.bounded(4) ? rnd.bounded(256) : 255 * rnd.bounded(2));
+    }
+
+    for (int useMask = 0; useMask < 2; useMask++) {
+        for (float opacity : {1.0f, 0.5f}) {
+            for (int srcOffset = 0; srcOffset < 2; srcOffset++) {
+                for (int useSrcStride = 0; useSrcStride < 2; useSrcStride++) {
+                    QVector<T> dstOpt = dst;
+                    QVector<T> dstRef = dst;
+
+                    KoCompositeOp::ParameterInfo params;
+                    params.srcRowStart = reinterpret_cast<const quint8*>(src.constData()) + srcOffset * pixelSize;
+                    params.srcRowStride = useSrcStride ? (width + 1) * pixelSize : 0;
+                    params.maskRowStart = useMask ? mask.constData() : nullptr;
+                    params.maskRowStride = useMask ? width : 0;
+                    params.rows = height;
+                    params.cols = width;
+                    params.opacity = opacity;
+                    params.flow = 1.0;
+
+                    params.dstRowStart = reinterpret_cast<quint8*>(dstOpt.data());
+                    params.dstRowStride = (width + 1) * pixelSize;
+                    op->composite(params);
+
+                    params.dstRowStart = reinterpret_cast<quint8*>(dstRef.data());
+                    refOp->composite(params);
+
+                    for (int i = 0; i < numChannels; i++) {
+                        if (!channelsEqual(dstOpt[i], dstRef[i])) {
+                            qDebug() << "Pixel" << i / 4 << "channel" << i % 4
+                                     << "dst" << dst[i]
+                                     << "expected" << dstRef[i] << "actual" << dstOpt[i]
+                                     << ppVar(useMask) << ppVar(opacity) << ppVar(srcOffset) << ppVar(useSrcStride);
+                            QFAIL("optimized op differs from the reference one");
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+}
+
+#endif // KOOPTIMIZEDCOMPOSITEOPTESTUTILS_H
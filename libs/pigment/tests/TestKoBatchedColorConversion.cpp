@@ -0,0 +1,122 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestKoBatchedColorConversion.h"
+
+#include <simpletest.h>
+
+#include <QAtomicInt>
+#include <QRandomGenerator>
+#include <QThread>
+#include <QVector>
+
+#include <KoBatchedColorConversion.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+void TestKoBatchedColorConversion::testConvertPixels_data()
+{
+    QTest::addColumn<int>("numPixels");
+    QTest::addColumn<int>("batchSize");
+    QTest::addColumn<int>("maxThreads");
+
+    QTest::newRow("single-thread") << 10000 << 1000 << 1;
+    QTest::newRow("four-threads") << 10000 << 1000 << 4;
+    QTest::newRow("incomplete-batch") << 10007 << 1000 << 4;
+    QTest::newRow("more-threads-than-batches") << 100 << 64 << 8;
+    QTest::newRow("single-pixel-batches") << 1000 << 1 << 4;
+}
+
+void TestKoBatchedColorConversion::testConvertPixels()
+{
+    QFETCH(int, numPixels);
+    QFETCH(int, batchSize);
+    QFETCH(int, maxThreads);
+
+    const KoColorSpace *srcCs = KoColorSpaceRegistry::instance()->rgb8();
+    const KoColorSpace *dstCs = KoColorSpaceRegistry::instance()->lab16();
+
+    QVector<quint8> src(numPixels * srcCs->pixelSize());
+    QRandomGenerator rnd(1);
+    for (int i = 0; i < src.size(); i++) {
+        src[i] = quint8(rnd.bounded(256));
+    }
+
+    QVector<quint8> expected(numPixels * dstCs->pixelSize());
+    srcCs->convertPixelsTo(src.constData(), expected.data(), dstCs, numPixels,
+                           KoColorConversionTransformation::internalRenderingIntent(),
+                           KoColorConversionTransformation::internalConversionFlags());
+
+    KoBatchedColorConversion conversion(srcCs, dstCs,
+                                        KoColorConversionTransformation::internalRenderingIntent(),
+                                        KoColorConversionTransformation::internalConversionFlags());
+    conversion.setMaxThreads(maxThreads);
+
+    QVector<quint8> result(numPixels * dstCs->pixelSize());
+    conversion.convertPixels(src.constData(), result.data(), numPixels, batchSize);
+
+    QCOMPARE(result, expected);
+}
+
+void TestKoBatchedColorConversion::testEveryBatchProcessedOnce()
+{
+    KoBatchedColorConversion conversion(KoColorSpaceRegistry::instance()->rgb8(),
+                                        KoColorSpaceRegistry::instance()->lab16(),
+                                        KoColorConversionTransformation::internalRenderingIntent(),
+                                        KoColorConversionTransformation::internalConversionFlags());
+    conversion.setMaxThreads(4);
+
+    const int numBatches = 1000;
+    QVector<QAtomicInt> counters(numBatches);
+    QAtomicInt *countersPtr = counters.data();
+    QAtomicInt numNullTransformations;
+
+    conversion.run(numBatches,
+        [countersPtr, &numNullTransformations] (int batch, const KoColorConversionTransformation *transformation) {
+            if (!transformation) {
+                numNullTransformations.ref();
+            }
+            countersPtr[batch].ref();
+        });
+
+    QCOMPARE(numNullTransformations.loadAcquire(), 0);
+
+    for (int i = 0; i < numBatches; i++) {
+        QCOMPARE(counters[i].loadAcquire(), 1);
+    }
+}
+
+void TestKoBatchedColorConversion::testProgressReportedInCallingThread()
+{
+    KoBatchedColorConversion conversion(KoColorSpaceRegistry::instance()->rgb8(),
+                                        KoColorSpaceRegistry::instance()->lab16(),
+                                        KoColorConversionTransformation::internalRenderingIntent(),
+                                        KoColorConversionTransformation::internalConversionFlags());
+    conversion.setMaxThreads(4);
+
+    const int numBatches = 100;
+    QThread *callingThread = QThread::currentThread();
+
+    int lastProgress = -1;
+    bool progressInOtherThread = false;
+    bool progressDecreased = false;
+
+    conversion.run(numBatches,
+        [] (int, const KoColorConversionTransformation *) {
+            QThread::usleep(100);
+        },
+        [&] (int numProcessedBatches) {
+            progressInOtherThread |= QThread::currentThread() != callingThread;
+            progressDecreased |= numProcessedBatches < lastProgress;
+            lastProgress = numProcessedBatches;
+        });
+
+    QVERIFY(!progressInOtherThread);
+    QVERIFY(!progressDecreased);
+    QCOMPARE(lastProgress, numBatches);
+}
+
+SIMPLE_TEST_MAIN(TestKoBatchedColorConversion)
@@ -0,0 +1,23 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TESTKOBATCHEDCOLORCONVERSION_H
+#define TESTKOBATCHEDCOLORCONVERSION_H
+
+#include <QObject>
+
+class TestKoBatchedColorConversion : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testConvertPixels_data();
+    void testConvertPixels();
+
+    void testEveryBatchProcessedOnce();
+    void testProgressReportedInCallingThread();
+};
+
+#endif // TESTKOBATCHEDCOLORCONVERSION_H
@@ -0,0 +1,27 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef TESTOPTIMIZEDCOMPOSITEOPGENERICHSL_H
+#define TESTOPTIMIZEDCOMPOSITEOPGENERICHSL_H
+
+#include <QObject>
+
+class TestOptimizedCompositeOpGenericHSL : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testU8_data();
+    void testU8();
+
+    void testU16_data();
+    void testU16();
+
+    void testF32_data();
+    void testF32();
+
+    void testAlphaLockedFallback();
+};
+
+#endif // TESTOPTIMIZEDCOMPOSITEOPGENERICHSL_H
@@ -0,0 +1,150 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "TestOptimizedCompositeOpGenericSC.h"
+
+#include <simpletest.h>
+
+#include <KoColorModelStandardIds.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoCompositeOpRegistry.h>
+#include <KoIntegerMaths.h>
+
+#include "KoOptimizedCompositeOpTestUtils.h"
+
+#include "compositeops/KoOptimizedCompositeOpGenericSCModes.h"
+
+Q_DECLARE_METATYPE(KoOptimizedSCMode)
+
+namespace {
+
+const QVector<std::pair<QString, KoOptimizedSCMode>> optimizedOps = {
+    {COMPOSITE_MULT, KoOptimizedSCMode::Multiply},
+    {COMPOSITE_SCREEN, KoOptimizedSCMode::Screen},
+    {COMPOSITE_OVERLAY, KoOptimizedSCMode::Overlay},
+    {COMPOSITE_HARD_LIGHT, KoOptimizedSCMode::HardLight},
+    {COMPOSITE_DARKEN, KoOptimizedSCMode::Darken},
+    {COMPOSITE_LIGHTEN, KoOptimizedSCMode::Lighten},
+    {COMPOSITE_ADD, KoOptimizedSCMode::Addition},
+    {COMPOSITE_LINEAR_DODGE, KoOptimizedSCMode::Addition},
+    {COMPOSITE_SUBTRACT, KoOptimizedSCMode::Subtract},
+    {COMPOSITE_DIFF, KoOptimizedSCMode::Difference},
+    {COMPOSITE_EXCLUSION, KoOptimizedSCMode::Exclusion},
+    {COMPOSITE_GRAIN_MERGE, KoOptimizedSCMode::GrainMerge},
+    {COMPOSITE_GRAIN_EXTRACT, KoOptimizedSCMode::GrainExtract}
+};
+
+void addOpsData()
+{
+    QTest::addColumn<QString>("id");
+    QTest::addColumn<KoOptimizedSCMode>("mode");
+
+    for (const auto &op : optimizedOps) {
+        QTest::addRow("%s", op.first.toLatin1().data()) << op.first << op.second;
+    }
+}
+
+template<typename T>
+bool channelsEqual(T a, T b)
+{
+    return a == b;
+}
+
+template<>
+bool channelsEqual<float>(float a, float b)
+{
+    // the optimized version may use FMA instructions,
+    // which give slightly different rounding
+    return qAbs(a - b) <= 1e-5f * qMax(1.0f, qAbs(a));
+}
+
+template<typename T>
+void testOpImpl(const KoColorSpace *cs, const QString &id, KoOptimizedSCMode mode)
+{
+    auto createRefOp = [mode] (const KoColorSpace *colorSpace, const QString &opId, const QString &category) {
+        return KoGenericSCModes::createOptimizedGenericSCOp<T, KoGenericSCModes::KoGenericSCScalarOpCreator>(colorSpace, mode, opId, category);
+    };
+
+    KoOptimizedCompositeOpTestUtils::testOpAgainstReference<T>(cs, id, createRefOp, channelsEqual<T>);
+}
+
+}
+
+void TestOptimizedCompositeOpGenericSC::testU8_data()
+{
+    addOpsData();
+}
+
+void TestOptimizedCompositeOpGenericSC::testU8()
+{
+    QFETCH(QString, id);
+    QFETCH(KoOptimizedSCMode, mode);
+    testOpImpl<quint8>(KoColorSpaceRegistry::instance()->rgb8(), id, mode);
+}
+
+void TestOptimizedCompositeOpGenericSC::testU16_data()
+{
+    addOpsData();
+}
+
+void TestOptimizedCompositeOpGenericSC::testU16()
+{
+    QFETCH(QString, id);
+    QFETCH(KoOptimizedSCMode, mode);
+    testOpImpl<quint16>(KoColorSpaceRegistry::instance()->rgb16(), id, mode);
+}
+
+void TestOptimizedCompositeOpGenericSC::testF32_data()
+{
+    addOpsData();
+}
+
+void TestOptimizedCompositeOpGenericSC::testF32()
+{
+    QFETCH(QString, id);
+    QFETCH(KoOptimizedSCMode, mode);
+
+    const KoColorSpace *cs =
+        KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), Float32BitsColorDepthID.id(), 0);
+
+    if (!cs) {
+        QSKIP("RGBA F32 color space is not available");
+    }
+
+    testOpImpl<float>(cs, id, mode);
+}
+
+void TestOptimizedCompositeOpGenericSC::testChannelFlagsFallback()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    const KoCompositeOp *op = cs->compositeOp(COMPOSITE_MULT);
+
+    quint8 src[4] = {100, 100, 100, 255};
+    quint8 dst[4] = {200, 200, 200, 255};
+
+    QBitArray channelFlags(4, true);
+    channelFlags.clearBit(1);
+
+    KoCompositeOp::ParameterInfo params;
+    params.srcRowStart = src;
+    params.dstRowStart = dst;
+    params.srcRowStride = 4;
+    params.dstRowStride = 4;
+    params.rows = 1;
+    params.cols = 1;
+    params.opacity = 1.0;
+    params.flow = 1.0;
+    params.channelFlags = channelFlags;
+
+    op->composite(params);
+
+    QCOMPARE(dst[0], quint8(UINT8_MULT(100, 200)));
+    QCOMPARE(dst[1], quint8(200));
+    QCOMPARE(dst[2], quint8(UINT8_MULT(100, 200)));
+    QCOMPARE(dst[3], quint8(255));
+}
+
+SIMPLE_TEST_MAIN(TestOptimizedCompositeOpGenericSC)
@@ -0,0 +1,245 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestOptimizedMixColorsOp.h"
+
+#include <simpletest.h>
+
+#include <random>
+
+#include <QScopedPointer>
+
+#include <KoColorModelStandardIds.h>
+#include <KoColorModelStandardIdsUtils.h>
+#include <KoColorSpaceTraits.h>
+#include <KoMixColorsOpImpl.h>
+#include <KoOptimizedMixColorsOpFactory.h>
+
+#include "kis_debug.h"
+
+namespace {
+
+const int pixelCounts[] = {1, 3, 7, 16, 17, 100, 4101};
+
+enum WeightsMode {
+    BrushWeights,
+    LargeWeights,
+    SignedWeights
+};
+
+template<typename channels_type>
+struct MixTestData
+{
+    using Trait = KoColorSpaceTrait<channels_type, 4, 3>;
+
+    MixTestData(int numPixels, WeightsMode mode, std::mt19937 &generator)
+        : pixels(numPixels * Trait::pixelSize)
+        , weights(numPixels)
+        , weightSum(0)
+    {
+        channels_type *channels = reinterpret_cast<channels_type*>(pixels.data());
+
+        for (int i = 0; i < numPixels * Trait::channels_nb; i++) {
+            channels[i] = randomChannel(generator);
+        }
+
+        // make some of the pixels fully transparent or fully opaque
+        std::uniform_int_distribution<int> alphaDistribution(0, 9);
+        for (int i = 0; i < numPixels; i++) {
+            const int choice = alphaDistribution(generator);
+            if (choice == 0) {
+                channels[i * Trait::channels_nb + Trait::alpha_pos] = KoColorSpaceMathsTraits<channels_type>::zeroValue;
+            } else if (choice == 1) {
+                channels[i * Trait::channels_nb + Trait::alpha_pos] = KoColorSpaceMathsTraits<channels_type>::unitValue;
+            }
+        }
+
+        const int minWeight = mode == SignedWeights ? -255 : 0;
+        const int maxWeight = mode == LargeWeights ? 32767 : 255;
+        std::uniform_int_distribution<int> weightsDistribution(minWeight, maxWeight);
+
+        for (int i = 0; i < numPixels; i++) {
+            weights[i] = weightsDistribution(generator);
+            weightSum += weights[i];
+        }
+
+        if (weightSum <= 0) {
+            weightSum = 255;
+        }
+    }
+
+    static channels_type randomChannel(std::mt19937 &generator) {
+        if constexpr (std::is_floating_point<channels_type>::value) {
+            std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+            return distribution(generator);
+        } else {
+            std::uniform_int_distribution<int> distribution(0, KoColorSpaceMathsTraits<channels_type>::unitValue);
+            return distribution(generator);
+        }
+    }
+
+    QVector<quint8> pixels;
+    QVector<qint16> weights;
+    int weightSum;
+};
+
+template<typename channels_type>
+void compareResults(const quint8 *expectedU8, const quint8 *resultU8,
+                    int numPixels, WeightsMode mode, const char *method)
+{
+    const channels_type *expected = reinterpret_cast<const channels_type*>(expectedU8);
+    const channels_type *result = reinterpret_cast<const channels_type*>(resultU8);
+
+    for (int c = 0; c < 4; c++) {
+        const bool isSame = std::is_floating_point<channels_type>::value ?
+            qAbs(float(expected[c]) - float(result[c])) <= 1e-4f :
+            expected[c] == result[c];
+
+        if (!isSame) {
+            qDebug() << "Failed:" << method << ppVar(numPixels) << ppVar(mode) << ppVar(c);
+            qDebug() << "    expected:" << +expected[0] << +expected[1] << +expected[2] << +expected[3];
+            qDebug() << "    result:  " << +result[0] << +result[1] << +result[2] << +result[3];
+            QFAIL("the optimized mix op differs from the scalar one");
+        }
+    }
+}
+
+template<typename channels_type>
+void testMixColorsImpl()
+{
+    using Trait = KoColorSpaceTrait<channels_type, 4, 3>;
+
+    const KoMixColorsOpImpl<Trait> referenceOp;
+    QScopedPointer<KoMixColorsOp> op(
+        KoOptimizedMixColorsOpFactory::create(colorDepthIdForChannelType<channels_type>(), 4, 3));
+    QVERIFY(op);
+
+    std::mt19937 generator(1);
+
+    for (const WeightsMode mode : {BrushWeights, LargeWeights, SignedWeights}) {
+        // the float version does not guarantee precision for canceling weights
+        if (std::is_floating_point<channels_type>::value && mode == SignedWeights) continue;
+
+        for (const int numPixels : pixelCounts) {
+            MixTestData<channels_type> data(numPixels, mode, generator);
+
+            quint8 expected[Trait::pixelSize];
+            quint8 result[Trait::pixelSize];
+
+            referenceOp.mixColors(data.pixels.constData(), data.weights.constData(), numPixels, expected, data.weightSum);
+            op->mixColors(data.pixels.constData(), data.weights.constData(), numPixels, result, data.weightSum);
+            compareResults<channels_type>(expected, result, numPixels, mode, "weighted");
+
+            referenceOp.mixColors(data.pixels.constData(), numPixels, expected);
+            op->mixColors(data.pixels.constData(), numPixels, result);
+            compareResults<channels_type>(expected, result, numPixels, mode, "average");
+        }
+    }
+}
+
+template<typename channels_type>
+void testMixerImpl()
+{
+    using Trait = KoColorSpaceTrait<channels_type, 4, 3>;
+
+    const KoMixColorsOpImpl<Trait> referenceOp;
+    QScopedPointer<KoMixColorsOp> op(
+        KoOptimizedMixColorsOpFactory::create(colorDepthIdForChannelType<channels_type>(), 4, 3));
+    QVERIFY(op);
+
+    std::mt19937 generator(2);
+
+    for (const int numPixels : pixelCounts) {
+        MixTestData<channels_type> data(numPixels, BrushWeights, generator);
+
+        QScopedPointer<KoMixColorsOp::Mixer> referenceMixer(referenceOp.createMixer());
+        QScopedPointer<KoMixColorsOp::Mixer> mixer(op->createMixer());
+
+        /**
+         * Feed the data in uneven chunks, like the smudge and color
+         * sampling code does, alternating the weighted and the average
+         * accumulation.
+         */
+        int offset = 0;
+        int chunkSize = 1;
+        bool useWeights = true;
+
+        while (offset < numPixels) {
+            const int size = qMin(chunkSize, numPixels - offset);
+            const quint8 *pixels = data.pixels.constData() + offset * Trait::pixelSize;
+
+            if (useWeights) {
+                const qint16 *weights = data.weights.constData() + offset;
+                referenceMixer->accumulate(pixels, weights, 255, size);
+                mixer->accumulate(pixels, weights, 255, size);
+            } else {
+                referenceMixer->accumulateAverage(pixels, size);
+                mixer->accumulateAverage(pixels, size);
+            }
+
+            offset += size;
+            chunkSize = chunkSize * 3 + 1;
+            useWeights = !useWeights;
+        }
+
+        QCOMPARE(mixer->currentWeightsSum(), referenceMixer->currentWeightsSum());
+
+        quint8 expected[Trait::pixelSize];
+        quint8 result[Trait::pixelSize];
+
+        referenceMixer->computeMixedColor(expected);
+        mixer->computeMixedColor(result);
+        compareResults<channels_type>(expected, result, numPixels, BrushWeights, "mixer");
+    }
+}
+
+}
+
+void TestOptimizedMixColorsOp::testMixColorsU8()
+{
+    testMixColorsImpl<quint8>();
+}
+
+void TestOptimizedMixColorsOp::testMixColorsU16()
+{
+    testMixColorsImpl<quint16>();
+}
+
+void TestOptimizedMixColorsOp::testMixColorsF32()
+{
+    testMixColorsImpl<float>();
+}
+
+void TestOptimizedMixColorsOp::testMixerU8()
+{
+    testMixerImpl<quint8>();
+}
+
+void TestOptimizedMixColorsOp::testMixerU16()
+{
+    testMixerImpl<quint16>();
+}
+
+void TestOptimizedMixColorsOp::testMixerF32()
+{
+    testMixerImpl<float>();
+}
+
+void TestOptimizedMixColorsOp::testUnsupportedFormats()
+{
+    QScopedPointer<KoMixColorsOp> op;
+
+    op.reset(KoOptimizedMixColorsOpFactory::create(Integer8BitsColorDepthID, 5, 4));
+    QVERIFY(!op);
+
+    op.reset(KoOptimizedMixColorsOpFactory::create(Integer16BitsColorDepthID, 2, 1));
+    QVERIFY(!op);
+
+    op.reset(KoOptimizedMixColorsOpFactory::create(Float64BitsColorDepthID, 4, 3));
+    QVERIFY(!op);
+}
+
+SIMPLE_TEST_MAIN(TestOptimizedMixColorsOp)
@@ -0,0 +1,27 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TESTOPTIMIZEDMIXCOLORSOP_H
+#define TESTOPTIMIZEDMIXCOLORSOP_H
+
+#include <QObject>
+
+class TestOptimizedMixColorsOp : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testMixColorsU8();
+    void testMixColorsU16();
+    void testMixColorsF32();
+
+    void testMixerU8();
+    void testMixerU16();
+    void testMixerF32();
+
+    void testUnsupportedFormats();
+};
+
+#endif // TESTOPTIMIZEDMIXCOLORSOP_H
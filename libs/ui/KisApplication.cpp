@@ -77,6 +77,7 @@
 #include "kis_document_aware_spin_box_unit_manager.h"
 #include "KisViewManager.h"
 #include <KisUsageLogger.h>
+#include <KisTracer.h>
 
 #include <KritaVersionWrapper.h>
 #include <dialogs/KisSessionManagerDialog.h>
@@ -423,6 +424,10 @@ bool KisApplication::start(const KisApplicationArguments &args)
 {
     KisConfig cfg(false);
 
+    if (cfg.enablePerformanceTracing() || qEnvironmentVariableIsSet("KRITA_TRACE")) {
+        KisTracer::instance()->setEnabled(true);
+    }
+
 #if defined(Q_OS_WIN)
 #ifdef ENV32BIT
 
@@ -741,6 +746,10 @@ bool KisApplication::start(const KisApplicationArguments &args)
 
 KisApplication::~KisApplication()
 {
+    if (KisTracer::isEnabled()) {
+        KisTracer::instance()->saveChromeTrace(KisTracer::defaultTraceFileName());
+    }
+
     if (!isRunning()) {
         KisResourceCacheDb::deleteTemporaryResources();
     }
@@ -2282,6 +2282,7 @@ void KisDocument::slotConfigChanged()
         }
         d->undoStack->setUndoLimit(cfg.undoStackLimit());
     }
+    d->undoStack->setUndoMemoryLimit(qint64(cfg.undoStackMemoryLimit()) * 1024 * 1024);
     d->undoStack->setUseCumulativeUndoRedo(cfg.useCumulativeUndoRedo());
     d->undoStack->setCumulativeUndoData(cfg.cumulativeUndoData());
 
@@ -128,15 +128,23 @@ void KisIdleTasksManager::slotImageIsIdle()
         return;
     }
 
-    if (m_d->queue.isEmpty()) return;
+    KisIdleTaskStrokeStrategy *strategy = nullptr;
 
-    const int newTaskId = m_d->queue.dequeue();
+    /**
+     * The factory may have done its job without any stroke, then
+     * just go to the next task in the queue
+     */
+    while (!strategy && !m_d->queue.isEmpty()) {
+        const int newTaskId = m_d->queue.dequeue();
 
-    auto it = std::find_if(m_d->tasks.begin(), m_d->tasks.end(),
-                           kismpl::mem_equal_to(&TaskStruct::id, newTaskId));
-    KIS_SAFE_ASSERT_RECOVER_NOOP(it != m_d->tasks.end());
+        auto it = std::find_if(m_d->tasks.begin(), m_d->tasks.end(),
+                               kismpl::mem_equal_to(&TaskStruct::id, newTaskId));
+        KIS_SAFE_ASSERT_RECOVER(it != m_d->tasks.end()) { continue; }
+
+        strategy = it->factory(image);
+    }
 
-    KisIdleTaskStrokeStrategy *strategy = it->factory(image);
+    if (!strategy) return;
 
     connect(strategy, SIGNAL(sigIdleTaskFinished()), SLOT(slotTaskIsCompleted()));
     m_d->currentTaskCookie = strategy->idleTaskCookie();
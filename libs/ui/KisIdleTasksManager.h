@@ -29,6 +29,10 @@
  * The factory will be called by the task manager  every time
  * when it thinks that the idle task should be started.
  *
+ * If the task doesn't need a stroke of its own, e.g. it only
+ * asks the image to start some internal background stroke,
+ * the factory may do its job right away and return nullptr.
+ *
  *
  * addIdleTaskWithGuard() returns a TaskGuard handle, which
  * represents the registered task. It is a movable object
@@ -115,7 +119,8 @@ public:
      * every image modification.
      *
      * @param factory is a functor creating a KisIdleTaskStrokeStrategy
-     *                that will actually execute the task
+     *                that will actually execute the task, or returning
+     *                nullptr if the task has been done without a stroke
      * @return a TaskGuard object that can be used for task manipulations
      */
     [[nodiscard]]
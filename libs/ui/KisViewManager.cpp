@@ -231,6 +231,7 @@ public:
     KisMirrorManager mirrorManager;
     KisInputManager inputManager;
     KisIdleTasksManager idleTasksManager;
+    KisIdleTasksManager::TaskGuard lodWarmUpTaskGuard;
     KisTextPropertiesManager textPropertyManager;
 
     KisSignalAutoConnectionsStore viewConnections;
@@ -308,6 +309,19 @@ KisViewManager::KisViewManager(QWidget *parent, KisKActionCollection *_actionCol
 
     d->controlFrame.setup(parent);
 
+    /**
+     * Regenerate the outdated LoD planes while the user is idle, so that
+     * the first Instant Preview stroke started after some non-LoD action
+     * doesn't need to wait for them. The warm-up is a forgettable sync
+     * stroke started by the image itself, so the idle task needs no
+     * stroke of its own.
+     */
+    d->lodWarmUpTaskGuard =
+        d->idleTasksManager.addIdleTaskWithGuard([] (KisImageSP image) -> KisIdleTaskStrokeStrategy* {
+            image->warmUpLevelOfDetail();
+            return nullptr;
+        });
+
 
     //Check to draw scrollbars after "Canvas only mode" toggle is created.
     this->showHideScrollbars();
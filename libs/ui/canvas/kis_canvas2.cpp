@@ -11,11 +11,14 @@
 
 #include <functional>
 #include <numeric>
+#include <optional>
 
 #include <QApplication>
 #include <QWidget>
 #include <QVBoxLayout>
 #include <QTime>
+#include <QElapsedTimer>
+#include <QtMath>
 #include <QMouseEvent>
 #include <QScreen>
 #include <QScreen>
@@ -189,9 +192,38 @@ public:
     QRect regionOfInterest;
     qreal regionOfInterestMargin = 0.25;
 
+    /**
+     * The last position of the cursor over the canvas widget, the focus
+     * point of the viewport hint, \see updateViewportHints()
+     */
+    std::optional<QPoint> lastCursorPosition;
+
     QRect renderingLimit;
     int isBatchUpdateActive = 0;
 
+    /**
+     * Frame pacing, see KisImageConfig::canvasFramePacing()
+     */
+    int fpsLimit = 100;
+    qreal displayRefreshRate = 0.0;
+    bool framePacingEnabled = false;
+    int framePacingBudget = 50;
+    qreal uploadPixelsPerMs = 0.0;
+
+    qreal frameIntervalMs() const {
+        const qreal rate = displayRefreshRate > 0.0 ?
+            qMin(qreal(fpsLimit), displayRefreshRate) : qreal(fpsLimit);
+        return 1000.0 / rate;
+    }
+
+    void updateFrameRenderDelay() {
+        frameRenderStartCompressor.setDelay(
+            framePacingEnabled ? qMax(1, qFloor(frameIntervalMs())) : 1000 / fpsLimit);
+    }
+
+    void registerUploadSpeed(const QVector<KisUpdateInfoSP> &infoObjects, qint64 nsecs);
+    void splitFrameUploadWork(KisUpdateInfoList &infoObjects, KisUpdateInfoList &carriedOverObjects) const;
+
     bool effectiveLodAllowedInImage() const {
         return lodPreferredInImage && !bootstrapLodBlocked;
     }
@@ -208,6 +240,32 @@ public:
     QRect docUpdateRectToWidget(const QRectF &docRect);
 };
 
+void KisCanvas2::KisCanvas2Private::registerUploadSpeed(const QVector<KisUpdateInfoSP> &infoObjects, qint64 nsecs)
+{
+    const qint64 pixels =
+        std::accumulate(infoObjects.constBegin(), infoObjects.constEnd(), qint64(0),
+                        [] (qint64 sum, KisUpdateInfoSP info) {
+                            return sum + KisCanvasUpdatesCompressor::uploadPixels(info);
+                        });
+
+    if (pixels <= 0 || nsecs <= 0) return;
+
+    const qreal speed = pixels / (nsecs / 1000000.0);
+
+    // smooth out the spikes caused by the other GUI work
+    uploadPixelsPerMs = uploadPixelsPerMs > 0.0 ?
+        0.8 * uploadPixelsPerMs + 0.2 * speed : speed;
+}
+
+void KisCanvas2::KisCanvas2Private::splitFrameUploadWork(KisUpdateInfoList &infoObjects, KisUpdateInfoList &carriedOverObjects) const
+{
+    // no measurements yet, upload everything
+    if (uploadPixelsPerMs <= 0.0) return;
+
+    const qreal pixelsBudget = uploadPixelsPerMs * frameIntervalMs() * framePacingBudget / 100.0;
+    KisCanvasUpdatesCompressor::splitFrameUploadWork(infoObjects, carriedOverObjects, pixelsBudget);
+}
+
 namespace {
 KoShapeManager* fetchShapeManagerFromNode(KisNodeSP node)
 {
@@ -254,7 +312,11 @@ KisCanvas2::KisCanvas2(KisCoordinatesConverter *coordConverter, KoCanvasResource
     m_d->canvasUpdateCompressor.setMode(KisSignalCompressor::FIRST_ACTIVE);
 #endif
 
-    m_d->frameRenderStartCompressor.setDelay(1000 / config.fpsLimit());
+    m_d->fpsLimit = config.fpsLimit();
+    m_d->framePacingEnabled = config.canvasFramePacing();
+    m_d->framePacingBudget = config.canvasFramePacingBudget();
+
+    m_d->updateFrameRenderDelay();
     m_d->frameRenderStartCompressor.setMode(KisSignalCompressor::FIRST_ACTIVE);
     snapGuide()->overrideSnapStrategy(KoSnapGuide::PixelSnapping, new KisSnapPixelStrategy());
 }
@@ -272,6 +334,7 @@ void KisCanvas2::setup()
     setLodPreferredInCanvas(m_d->lodPreferredInImage);
     
     connect(m_d->view->canvasController()->proxyObject, SIGNAL(moveDocumentOffset(QPoint)), SLOT(documentOffsetMoved(QPoint)));
+    connect(m_d->view->canvasController()->proxyObject, SIGNAL(canvasMousePositionChanged(QPoint)), SLOT(slotCanvasMousePositionChanged(QPoint)));
     connect(KisConfigNotifier::instance(), SIGNAL(configChanged()), SLOT(slotConfigChanged()));
 
     /**
@@ -648,6 +711,8 @@ void KisCanvas2::disconnectImage()
     image->immediateLockForReadOnly();
     disconnect(image.data(), 0, this, 0);
     image->unlock();
+
+    image->removeUpdatesViewportHint(this);
 }
 
 void KisCanvas2::connectCurrentCanvas()
@@ -866,7 +931,15 @@ void KisCanvas2::updateCanvasProjection()
     };
 
     auto uploadData = [this, tryIssueCanvasUpdates](const QVector<KisUpdateInfoSP> &infoObjects) {
+        QElapsedTimer uploadTimer;
+        uploadTimer.start();
+
         QVector<QRect> viewportRects = m_d->canvasWidget->updateCanvasProjection(infoObjects);
+
+        if (m_d->framePacingEnabled) {
+            m_d->registerUploadSpeed(infoObjects, uploadTimer.nsecsElapsed());
+        }
+
         const QRect vRect = std::accumulate(viewportRects.constBegin(), viewportRects.constEnd(),
                                             QRect(), std::bit_or<QRect>());
 
@@ -879,6 +952,22 @@ void KisCanvas2::updateCanvasProjection()
     KisUpdateInfoList originalInfoObjects;
     m_d->projectionUpdatesCompressor.takeUpdateInfo(originalInfoObjects);
 
+    /**
+     * In frame pacing mode we upload only the amount of data that fits
+     * into the budget of one display frame, the rest is uploaded on the
+     * next tick of the compressor. It keeps the GUI thread free for
+     * repainting the cursor and the brush outline during heavy updates.
+     */
+    if (m_d->framePacingEnabled) {
+        KisUpdateInfoList carriedOverInfoObjects;
+        m_d->splitFrameUploadWork(originalInfoObjects, carriedOverInfoObjects);
+
+        if (!carriedOverInfoObjects.isEmpty()) {
+            m_d->projectionUpdatesCompressor.putBackUpdateInfo(carriedOverInfoObjects);
+            m_d->frameRenderStartCompressor.start();
+        }
+    }
+
     for (auto it = originalInfoObjects.constBegin();
          it != originalInfoObjects.constEnd();
          ++it) {
@@ -1139,6 +1228,34 @@ void KisCanvas2::slotUpdateRegionOfInterest()
     if (m_d->regionOfInterest != oldRegionOfInterest) {
         Q_EMIT sigRegionOfInterestChanged(m_d->regionOfInterest);
     }
+
+    updateViewportHints();
+}
+
+void KisCanvas2::slotCanvasMousePositionChanged(const QPoint &position)
+{
+    m_d->lastCursorPosition = position;
+    updateViewportHints();
+}
+
+void KisCanvas2::updateViewportHints()
+{
+    KisImageSP image = m_d->view->image();
+    if (!image) return;
+
+    KisUpdatesViewportHint hint;
+    hint.visibleRect =
+        m_d->coordinatesConverter->widgetRectInImagePixels().toAlignedRect() &
+        m_d->coordinatesConverter->imageRectInImagePixels();
+
+    const QWidget *widget = canvasWidget();
+    if (widget && m_d->lastCursorPosition &&
+        widget->rect().contains(*m_d->lastCursorPosition)) {
+
+        hint.focusPoint = m_d->coordinatesConverter->widgetToImage(QPointF(*m_d->lastCursorPosition));
+    }
+
+    image->setUpdatesViewportHint(this, hint);
 }
 
 void KisCanvas2::slotReferenceImagesChanged()
@@ -1249,6 +1366,13 @@ void KisCanvas2::slotConfigChanged()
     m_d->vastScrolling = cfg.vastScrolling();
     m_d->regionOfInterestMargin = KisImageConfig(true).animationCacheRegionOfInterestMargin();
 
+    {
+        KisImageConfig imageConfig(true);
+        m_d->framePacingEnabled = imageConfig.canvasFramePacing();
+        m_d->framePacingBudget = imageConfig.canvasFramePacingBudget();
+        m_d->updateFrameRenderDelay();
+    }
+
     resetCanvas(cfg.useOpenGL());
 
     QWidget *mainWindow = m_d->view->mainWindow();
@@ -1269,6 +1393,11 @@ void KisCanvas2::slotScreenChanged(QScreen *screen)
      * because this data is not yet ready when screenChanged signal is delivered.
      */
 
+    if (screen) {
+        m_d->displayRefreshRate = screen->refreshRate();
+        m_d->updateFrameRenderDelay();
+    }
+
     const int canvasScreenNumber = qApp->screens().indexOf(screen);
 
     if (canvasScreenNumber != -1) {
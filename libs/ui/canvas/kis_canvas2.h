@@ -295,6 +295,8 @@ private Q_SLOTS:
 
     void slotUpdateRegionOfInterest();
 
+    void slotCanvasMousePositionChanged(const QPoint &position);
+
     void slotReferenceImagesChanged();
 
     void slotImageColorSpaceChanged();
@@ -329,6 +331,7 @@ private:
     void setDisplayConfig(const KisDisplayConfig &config);
 
     void notifyLevelOfDetailChange();
+    void updateViewportHints();
 
     // Completes construction of canvas.
     // To be called by KisView in its constructor, once it has been setup enough
@@ -6,6 +6,8 @@
 
 #include "kis_canvas_updates_compressor.h"
 
+#include <algorithm>
+
 bool KisCanvasUpdatesCompressor::putUpdateInfo(KisUpdateInfoSP info)
 {
     const int levelOfDetail = info->levelOfDetail();
@@ -45,3 +47,55 @@ void KisCanvasUpdatesCompressor::takeUpdateInfo(KisUpdateInfoList &list)
     QMutexLocker l(&m_mutex);
     m_updatesList.swap(list);
 }
+
+void KisCanvasUpdatesCompressor::putBackUpdateInfo(const KisUpdateInfoList &list)
+{
+    QMutexLocker l(&m_mutex);
+
+    KisUpdateInfoList result;
+
+    Q_FOREACH (KisUpdateInfoSP info, list) {
+        const bool isOverridden =
+            info->canBeCompressed() &&
+            std::any_of(m_updatesList.constBegin(), m_updatesList.constEnd(),
+                        [info] (KisUpdateInfoSP newInfo) {
+                            return newInfo->canBeCompressed() &&
+                                newInfo->levelOfDetail() == info->levelOfDetail() &&
+                                newInfo->dirtyImageRect().contains(info->dirtyImageRect());
+                        });
+
+        if (!isOverridden) {
+            result.append(info);
+        }
+    }
+
+    result.append(m_updatesList);
+    m_updatesList.swap(result);
+}
+
+void KisCanvasUpdatesCompressor::splitFrameUploadWork(KisUpdateInfoList &infoObjects, KisUpdateInfoList &carriedOverObjects, qreal pixelsBudget)
+{
+    qint64 pixels = 0;
+    bool hasUploads = false;
+
+    for (auto it = infoObjects.begin(); it != infoObjects.end(); ++it) {
+        if (dynamic_cast<const KisMarkerUpdateInfo*>(it->data())) continue;
+
+        const qint64 infoPixels = uploadPixels(*it);
+
+        if (hasUploads && pixels + infoPixels > pixelsBudget) {
+            carriedOverObjects = infoObjects.mid(std::distance(infoObjects.begin(), it));
+            infoObjects.erase(it, infoObjects.end());
+            break;
+        }
+
+        pixels += infoPixels;
+        hasUploads = true;
+    }
+}
+
+qint64 KisCanvasUpdatesCompressor::uploadPixels(KisUpdateInfoSP info)
+{
+    const QRect rc = info->dirtyImageRect();
+    return (qint64(rc.width()) * rc.height()) >> (2 * info->levelOfDetail());
+}
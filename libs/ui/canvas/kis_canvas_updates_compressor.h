@@ -15,12 +15,35 @@
 
 typedef QList<KisUpdateInfoSP> KisUpdateInfoList;
 
-class KisCanvasUpdatesCompressor
+class KRITAUI_EXPORT KisCanvasUpdatesCompressor
 {
 public:
     bool putUpdateInfo(KisUpdateInfoSP info);
     void takeUpdateInfo(KisUpdateInfoList &list);
 
+    /**
+     * Returns the updates, which have been taken by takeUpdateInfo()
+     * but not processed, back to the head of the queue. The updates
+     * that are overridden by the newer ones are dropped.
+     */
+    void putBackUpdateInfo(const KisUpdateInfoList &list);
+
+    /**
+     * Splits \p infoObjects into the updates that fit into \p pixelsBudget
+     * and the ones that should be carried over to the next frame. The
+     * latter are moved into \p carriedOverObjects.
+     *
+     * The markers are never reordered with the updates, so everything
+     * after the first carried over update is carried over as well. At
+     * least one update is always left in \p infoObjects.
+     */
+    static void splitFrameUploadWork(KisUpdateInfoList &infoObjects, KisUpdateInfoList &carriedOverObjects, qreal pixelsBudget);
+
+    /**
+     * The number of pixels that should be uploaded for \p info
+     */
+    static qint64 uploadPixels(KisUpdateInfoSP info);
+
 private:
     QMutex m_mutex;
     KisUpdateInfoList m_updatesList;
@@ -45,6 +45,7 @@
 #include <KoCanvasController.h>
 #include <KisRepaintDebugger.h>
 #include <KisDisplayConfig.h>
+#include <KisTracer.h>
 
 class KisQPainterCanvas::Private
 {
@@ -87,6 +88,8 @@ void KisQPainterCanvas::setPrescaledProjection(KisPrescaledProjectionSP prescale
 
 void KisQPainterCanvas::paintEvent(QPaintEvent * ev)
 {
+    KIS_TRACE_SCOPE(Paint, "paint canvas");
+
     KisImageWSP image = canvas()->image();
     if (image == 0) return;
 
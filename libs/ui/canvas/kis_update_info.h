@@ -131,7 +131,7 @@ public:
     KisImagePatch patch;
 };
 
-class KisMarkerUpdateInfo : public KisUpdateInfo
+class KRITAUI_EXPORT KisMarkerUpdateInfo : public KisUpdateInfo
 {
 public:
     enum Type {
@@ -45,6 +45,8 @@
 #include <kis_icon.h>
 #include <KisPart.h>
 #include <KisSpinBoxI18nHelper.h>
+#include <KisTracer.h>
+#include <KisUsageLogger.h>
 #include <KoColorModelStandardIds.h>
 #include <KoColorProfile.h>
 #include <KoColorSpaceEngine.h>
@@ -420,6 +422,7 @@ GeneralTab::GeneralTab(QWidget *_parent, const char *_name)
     m_chkConvertOnImport->setChecked(cfg.convertToImageColorspaceOnImport());
 
     m_undoStackSize->setValue(cfg.undoStackLimit());
+    m_undoMemoryLimit->setValue(cfg.undoStackMemoryLimit());
     chkCumulativeUndo->setChecked(cfg.useCumulativeUndoRedo());
     connect(chkCumulativeUndo, SIGNAL(toggled(bool)), btnAdvancedCumulativeUndo, SLOT(setEnabled(bool)));
     btnAdvancedCumulativeUndo->setEnabled(chkCumulativeUndo->isChecked());
@@ -691,6 +694,7 @@ void GeneralTab::setDefault()
     chkHideAutosaveFiles->setChecked(true);
 
     m_undoStackSize->setValue(cfg.undoStackLimit(true));
+    m_undoMemoryLimit->setValue(cfg.undoStackMemoryLimit(true));
     chkCumulativeUndo->setChecked(cfg.useCumulativeUndoRedo(true));
     m_cumulativeUndoData = cfg.cumulativeUndoData(true);
 
@@ -832,6 +836,11 @@ int GeneralTab::undoStackSize()
     return m_undoStackSize->value();
 }
 
+int GeneralTab::undoMemoryLimit()
+{
+    return m_undoMemoryLimit->value();
+}
+
 bool GeneralTab::showOutlineWhilePainting()
 {
     return m_showOutlinePainting->isChecked();
@@ -1571,6 +1580,10 @@ PerformanceTab::PerformanceTab(QWidget *parent, const char *name)
     sliderFpsLimit->setRange(20, 300);
     sliderFpsLimit->setSuffix(i18n(" fps"));
 
+    sliderFramePacingBudget->setRange(10, 100);
+    KisSpinBoxI18nHelper::setText(sliderFramePacingBudget,
+                                  i18nc("{n} is the number value, % is the percent sign", "{n}%"));
+
     connect(sliderThreadsLimit, SIGNAL(valueChanged(int)), SLOT(slotThreadsLimitChanged(int)));
     connect(sliderFrameClonesLimit, SIGNAL(valueChanged(int)), SLOT(slotFrameClonesLimitChanged(int)));
 
@@ -1589,6 +1602,7 @@ PerformanceTab::PerformanceTab(QWidget *parent, const char *name)
     connect(chkUseRegionOfInterest, SIGNAL(toggled(bool)), intRegionOfInterestMargin, SLOT(setEnabled(bool)));
 
     connect(chkTransformToolUseInStackPreview, SIGNAL(toggled(bool)), chkTransformToolForceLodMode, SLOT(setEnabled(bool)));
+    connect(chkCanvasFramePacing, SIGNAL(toggled(bool)), sliderFramePacingBudget, SLOT(setEnabled(bool)));
 
 #ifndef Q_OS_WIN
     // AVX workaround is needed on Windows+GCC only
@@ -1612,6 +1626,7 @@ void PerformanceTab::load(bool requestDefault)
     sliderUndoLimit->setValue(cfg.memorySoftLimitPercent(requestDefault));
 
     chkPerformanceLogging->setChecked(cfg.enablePerfLog(requestDefault));
+    chkPerformanceTracing->setChecked(cfg.enablePerformanceTracing(requestDefault));
     chkProgressReporting->setChecked(cfg.enableProgressReporting(requestDefault));
 
     sliderSwapSize->setValue(cfg.maxSwapSize(requestDefault) / 1024);
@@ -1624,6 +1639,9 @@ void PerformanceTab::load(bool requestDefault)
     sliderFrameClonesLimit->setValue(m_lastUsedClonesLimit);
 
     sliderFpsLimit->setValue(cfg.fpsLimit(requestDefault));
+    chkCanvasFramePacing->setChecked(cfg.canvasFramePacing(requestDefault));
+    sliderFramePacingBudget->setValue(cfg.canvasFramePacingBudget(requestDefault));
+    sliderFramePacingBudget->setEnabled(chkCanvasFramePacing->isChecked());
 
     {
         KisConfig cfg2(true);
@@ -1677,6 +1695,21 @@ void PerformanceTab::save()
     cfg.setMemoryPoolLimitPercent(sliderPoolLimit->value());
 
     cfg.setEnablePerfLog(chkPerformanceLogging->isChecked());
+
+    cfg.setEnablePerformanceTracing(chkPerformanceTracing->isChecked());
+    if (chkPerformanceTracing->isChecked() != KisTracer::isEnabled()) {
+        if (KisTracer::isEnabled()) {
+            KisTracer::instance()->setEnabled(false);
+
+            const QString fileName = KisTracer::defaultTraceFileName();
+            if (KisTracer::instance()->saveChromeTrace(fileName)) {
+                KisUsageLogger::log(QString("Performance trace saved to %1").arg(fileName));
+            }
+        } else {
+            KisTracer::instance()->clear();
+            KisTracer::instance()->setEnabled(true);
+        }
+    }
     cfg.setEnableProgressReporting(chkProgressReporting->isChecked());
 
     cfg.setMaxSwapSize(sliderSwapSize->value() * 1024);
@@ -1687,6 +1720,8 @@ void PerformanceTab::save()
     cfg.setFrameRenderingClones(sliderFrameClonesLimit->value());
     cfg.setFrameRenderingTimeout(sliderFrameTimeout->value() * 1000);
     cfg.setFpsLimit(sliderFpsLimit->value());
+    cfg.setCanvasFramePacing(chkCanvasFramePacing->isChecked());
+    cfg.setCanvasFramePacingBudget(sliderFramePacingBudget->value());
 
     {
         KisConfig cfg2(true);
@@ -2496,6 +2531,7 @@ bool KisDlgPreferences::editPreferences()
         cfg.setZoomHorizontal(m_general->chkZoomHorizontally->isChecked());
         cfg.setConvertToImageColorspaceOnImport(m_general->convertToImageColorspaceOnImport());
         cfg.setUndoStackLimit(m_general->undoStackSize());
+        cfg.setUndoStackMemoryLimit(m_general->undoMemoryLimit());
         cfg.setCumulativeUndoRedo(m_general->chkCumulativeUndo->isChecked());
         cfg.setCumulativeUndoData(m_general->m_cumulativeUndoData);
 
@@ -73,6 +73,7 @@ public:
     int autoSaveInterval();
     void setDefault();
     int undoStackSize();
+    int undoMemoryLimit();
     bool showOutlineWhilePainting();
     bool showEraserOutlineWhilePainting();
 
@@ -52,6 +52,7 @@
 #include "kis_input_manager_p.h"
 #include "kis_algebra_2d.h"
 #include "config-qt-patches-present.h"
+#include <KisTracer.h>
 
 
 template <typename T>
@@ -171,6 +172,36 @@ void KisInputManager::setupAsEventFilter(QObject *receiver)
     }
 }
 
+namespace {
+const char* traceEventName(QEvent::Type type)
+{
+    switch (type) {
+    case QEvent::MouseButtonPress:
+        return "mouse press";
+    case QEvent::MouseButtonRelease:
+        return "mouse release";
+    case QEvent::MouseMove:
+        return "mouse move";
+    case QEvent::TabletPress:
+        return "tablet press";
+    case QEvent::TabletMove:
+        return "tablet move";
+    case QEvent::TabletRelease:
+        return "tablet release";
+    case QEvent::TouchBegin:
+        return "touch begin";
+    case QEvent::TouchUpdate:
+        return "touch update";
+    case QEvent::TouchEnd:
+        return "touch end";
+    case QEvent::Wheel:
+        return "wheel";
+    default:
+        return 0;
+    }
+}
+}
+
 #if defined (__clang__)
 #pragma GCC diagnostic ignored "-Wswitch"
 #endif
@@ -181,6 +212,9 @@ bool KisInputManager::eventFilter(QObject* object, QEvent* event)
 
     if (d->eventEater.eventFilter(object, event)) return false;
 
+    KisTraceScope traceScope(KisTracer::InputEvent,
+                             KisTracer::isEnabled() ? traceEventName(event->type()) : 0);
+
     if (!d->matcher.hasRunningShortcut()) {
 
         int savedPriorityEventFilterSeqNo = d->priorityEventFilterSeqNo;
@@ -173,6 +173,16 @@ void KisConfig::setUndoStackLimit(int limit) const
     m_cfg.writeEntry("undoStackLimit", limit);
 }
 
+int KisConfig::undoStackMemoryLimit(bool defaultValue) const
+{
+    return (defaultValue ? 0 : m_cfg.readEntry("undoStackMemoryLimit", 0));
+}
+
+void KisConfig::setUndoStackMemoryLimit(int limit) const
+{
+    m_cfg.writeEntry("undoStackMemoryLimit", limit);
+}
+
 bool KisConfig::useCumulativeUndoRedo(bool defaultValue) const
 {
     return (defaultValue ? false : m_cfg.readEntry("useCumulativeUndoRedo",false));
@@ -2233,6 +2243,16 @@ void KisConfig::setEnableBrushSpeedLogging(bool value) const
     m_cfg.writeEntry("enableBrushSpeedLogging", value);
 }
 
+bool KisConfig::enablePerformanceTracing(bool defaultValue) const
+{
+    return (defaultValue ? false : m_cfg.readEntry("enablePerformanceTracing", false));
+}
+
+void KisConfig::setEnablePerformanceTracing(bool value) const
+{
+    m_cfg.writeEntry("enablePerformanceTracing", value);
+}
+
 void KisConfig::setDisableVectorOptimizations(bool value)
 {
     // use the old key name for compatibility
@@ -56,6 +56,13 @@ public:
     int undoStackLimit(bool defaultValue = false) const;
     void setUndoStackLimit(int limit) const;
 
+    /**
+     * The maximum memory occupied by the undo data of a document,
+     * in MiB. Zero means there is no limit.
+     */
+    int undoStackMemoryLimit(bool defaultValue = false) const;
+    void setUndoStackMemoryLimit(int limit) const;
+
     bool useCumulativeUndoRedo(bool defaultValue = false) const;
     void setCumulativeUndoRedo(bool value);
 
@@ -600,6 +607,9 @@ public:
     void setEnableBrushSpeedLogging(bool value) const;
     bool enableBrushSpeedLogging(bool defaultValue = false) const;
 
+    void setEnablePerformanceTracing(bool value) const;
+    bool enablePerformanceTracing(bool defaultValue = false) const;
+
     void setDisableVectorOptimizations(bool value);
     bool disableVectorOptimizations(bool defaultValue = false) const;
 
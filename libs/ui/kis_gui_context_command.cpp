@@ -36,3 +36,9 @@ void KisGuiContextCommand::redo()
 {
     Q_EMIT sigExecuteCommand(m_command.data(), false);
 }
+
+qint64 KisGuiContextCommand::memoryUsage() const
+{
+    return KUndo2Command::memoryUsage() +
+        (m_command ? m_command->memoryUsage() : 0);
+}
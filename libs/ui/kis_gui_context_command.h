@@ -28,6 +28,8 @@ public:
     void undo() override;
     void redo() override;
 
+    qint64 memoryUsage() const override;
+
 Q_SIGNALS:
     void sigExecuteCommand(KUndo2Command *command, bool undo);
 
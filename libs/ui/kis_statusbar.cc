@@ -302,6 +302,53 @@ void KisStatusBar::updateMemoryStatus()
 
     QString longStats = imageStatsMsg + "\n" + memoryStatsMsg;
 
+    if (stats.swapSize > 0) {
+        const QString swapStatsMsg =
+                i18nc("tooltip on statusbar memory reporting button (swap stats)",
+                      "\n"
+                      "  swap file:\t %1\n"
+                      "  fragmentation:\t %2%\n"
+                      "  chunk alloc/free:\t %3 / %4 ns\n"
+                      "  prefetched tiles:\t %5\n"
+                      "  prefetch hits/misses:\t %6 / %7\n"
+                      "  direct reads:\t %8",
+                      format.formatByteSize(stats.swapFileSize),
+                      QString::number(100.0 * stats.swapFragmentation, 'f', 1),
+                      stats.swapChunkAllocationTime,
+                      stats.swapChunkFreeTime,
+                      stats.swapPrefetchedTiles,
+                      stats.swapPrefetchHits,
+                      stats.swapInMisses,
+                      stats.swapDirectReads);
+
+        longStats += swapStatsMsg;
+
+        if (stats.swapDeduplicatedTiles > 0) {
+            longStats +=
+                i18nc("tooltip on statusbar memory reporting button (swap deduplication stats)",
+                      "\n"
+                      "  shared tiles:\t %1 (%2 saved)",
+                      stats.swapDeduplicatedTiles,
+                      format.formatByteSize(stats.swapDeduplicatedSize));
+        }
+    }
+
+    if (stats.compressedHistorySize > 0) {
+        const qreal compressionRatio =
+            qreal(stats.compressedHistoryOriginalSize) / stats.compressedHistorySize;
+
+        const QString compressedHistoryStatsMsg =
+                i18nc("tooltip on statusbar memory reporting button (compressed undo data stats)",
+                      "\n\n"
+                      "Compressed undo data:\t %1 / %2\n"
+                      "  compression ratio:\t %3",
+                      format.formatByteSize(stats.compressedHistorySize),
+                      format.formatByteSize(stats.compressedHistoryLimit),
+                      QString::number(compressionRatio, 'f', 1));
+
+        longStats += compressedHistoryStatsMsg;
+    }
+
     QString shortStats = format.formatByteSize(stats.imageSize);
     QIcon icon;
     const qint64 warnLevel = stats.tilesHardLimit - stats.tilesHardLimit / 8;
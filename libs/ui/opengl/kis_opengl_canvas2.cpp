@@ -22,6 +22,7 @@
 
 #include "KisOpenGLModeProber.h"
 #include "KisOpenGLContextSwitchLock.h"
+#include <KisTracer.h>
 
 static bool OPENGL_SUCCESS = false;
 
@@ -197,6 +198,8 @@ void KisOpenGLCanvas2::resizeGL(int width, int height)
 
 void KisOpenGLCanvas2::paintGL()
 {
+    KIS_TRACE_SCOPE(Paint, "paint canvas");
+
     const QRect updateRect = d->updateRect ? *d->updateRect : QRect();
 
     if (!OPENGL_SUCCESS) {
@@ -32,6 +32,7 @@
 #include <QVector3D>
 #include "kis_painting_tweaks.h"
 #include "KisOpenGLBufferCreationGuard.h"
+#include <KisTracer.h>
 
 /// we use Angle's EGL on Windows, so we need access to
 /// EGL_ANGLE_platform_angle definition
@@ -340,6 +341,8 @@ void KisOpenGLImageTextures::recalculateCache(KisUpdateInfoSP info, bool blockMi
     KisOpenGLUpdateInfoSP glInfo = dynamic_cast<KisOpenGLUpdateInfo*>(info.data());
     if(!glInfo) return;
 
+    KIS_TRACE_SCOPE(TextureUpload, "texture upload");
+
     QScopedPointer<KisOpenGLSync> sync;
     int numProcessedTiles = 0;
 
@@ -0,0 +1,158 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisCanvasUpdatesCompressorTest.h"
+
+#include <simpletest.h>
+
+#include "canvas/kis_canvas_updates_compressor.h"
+#include "canvas/kis_update_info.h"
+
+namespace {
+
+KisUpdateInfoSP createUpdate(const QRect &rc, int levelOfDetail = 0)
+{
+    KisOpenGLUpdateInfo *info = new KisOpenGLUpdateInfo();
+    info->assignDirtyImageRect(rc);
+    info->assignLevelOfDetail(levelOfDetail);
+    return KisUpdateInfoSP(info);
+}
+
+KisUpdateInfoSP createMarker(KisMarkerUpdateInfo::Type type)
+{
+    return new KisMarkerUpdateInfo(type, QRect(0, 0, 256, 256));
+}
+
+}
+
+void KisCanvasUpdatesCompressorTest::testPutBackUpdateInfo()
+{
+    KisCanvasUpdatesCompressor compressor;
+
+    KisUpdateInfoSP oldA = createUpdate(QRect(0, 0, 64, 64));
+    KisUpdateInfoSP oldB = createUpdate(QRect(64, 0, 64, 64));
+    KisUpdateInfoSP oldC = createUpdate(QRect(128, 0, 64, 64));
+
+    compressor.putUpdateInfo(oldA);
+    compressor.putUpdateInfo(oldB);
+    compressor.putUpdateInfo(oldC);
+
+    KisUpdateInfoList taken;
+    compressor.takeUpdateInfo(taken);
+    QCOMPARE(taken.size(), 3);
+
+    KisUpdateInfoSP newA = createUpdate(QRect(0, 0, 64, 64));
+    KisUpdateInfoSP newLod = createUpdate(QRect(64, 0, 64, 64), 1);
+    compressor.putUpdateInfo(newA);
+    compressor.putUpdateInfo(newLod);
+
+    // oldA is overridden by newA, oldB has a different lod than newLod
+    compressor.putBackUpdateInfo(taken);
+
+    KisUpdateInfoList result;
+    compressor.takeUpdateInfo(result);
+
+    QCOMPARE(result.size(), 4);
+    QCOMPARE(result[0], oldB);
+    QCOMPARE(result[1], oldC);
+    QCOMPARE(result[2], newA);
+    QCOMPARE(result[3], newLod);
+}
+
+void KisCanvasUpdatesCompressorTest::testPutBackKeepsMarkers()
+{
+    KisCanvasUpdatesCompressor compressor;
+
+    KisUpdateInfoSP marker = createMarker(KisMarkerUpdateInfo::EndBatch);
+    KisUpdateInfoSP oldA = createUpdate(QRect(0, 0, 64, 64));
+
+    KisUpdateInfoSP newA = createUpdate(QRect(0, 0, 256, 256));
+    compressor.putUpdateInfo(newA);
+
+    compressor.putBackUpdateInfo({oldA, marker});
+
+    KisUpdateInfoList result;
+    compressor.takeUpdateInfo(result);
+
+    QCOMPARE(result.size(), 2);
+    QCOMPARE(result[0], marker);
+    QCOMPARE(result[1], newA);
+}
+
+void KisCanvasUpdatesCompressorTest::testSplitFrameUploadWork()
+{
+    KisUpdateInfoSP a = createUpdate(QRect(0, 0, 64, 64));
+    KisUpdateInfoSP b = createUpdate(QRect(64, 0, 64, 64));
+    KisUpdateInfoSP c = createUpdate(QRect(128, 0, 64, 64));
+
+    KisUpdateInfoList infoObjects = {a, b, c};
+    KisUpdateInfoList carriedOver;
+
+    KisCanvasUpdatesCompressor::splitFrameUploadWork(infoObjects, carriedOver, 2 * 64 * 64);
+
+    QCOMPARE(infoObjects, KisUpdateInfoList({a, b}));
+    QCOMPARE(carriedOver, KisUpdateInfoList({c}));
+
+    infoObjects = {a, b, c};
+    carriedOver.clear();
+
+    KisCanvasUpdatesCompressor::splitFrameUploadWork(infoObjects, carriedOver, 3 * 64 * 64);
+
+    QCOMPARE(infoObjects, KisUpdateInfoList({a, b, c}));
+    QVERIFY(carriedOver.isEmpty());
+}
+
+void KisCanvasUpdatesCompressorTest::testSplitFrameUploadWorkUploadsAtLeastOne()
+{
+    KisUpdateInfoSP a = createUpdate(QRect(0, 0, 64, 64));
+    KisUpdateInfoSP b = createUpdate(QRect(64, 0, 64, 64));
+
+    KisUpdateInfoList infoObjects = {a, b};
+    KisUpdateInfoList carriedOver;
+
+    KisCanvasUpdatesCompressor::splitFrameUploadWork(infoObjects, carriedOver, 1);
+
+    QCOMPARE(infoObjects, KisUpdateInfoList({a}));
+    QCOMPARE(carriedOver, KisUpdateInfoList({b}));
+}
+
+void KisCanvasUpdatesCompressorTest::testSplitFrameUploadWorkWithMarkers()
+{
+    KisUpdateInfoSP start = createMarker(KisMarkerUpdateInfo::StartBatch);
+    KisUpdateInfoSP a = createUpdate(QRect(0, 0, 64, 64));
+    KisUpdateInfoSP b = createUpdate(QRect(64, 0, 64, 64));
+    KisUpdateInfoSP end = createMarker(KisMarkerUpdateInfo::EndBatch);
+
+    KisUpdateInfoList infoObjects = {start, a, b, end};
+    KisUpdateInfoList carriedOver;
+
+    // the markers are not counted in the budget and are
+    // never reordered with the updates
+    KisCanvasUpdatesCompressor::splitFrameUploadWork(infoObjects, carriedOver, 64 * 64);
+
+    QCOMPARE(infoObjects, KisUpdateInfoList({start, a}));
+    QCOMPARE(carriedOver, KisUpdateInfoList({b, end}));
+}
+
+void KisCanvasUpdatesCompressorTest::testSplitFrameUploadWorkLevelOfDetail()
+{
+    QCOMPARE(KisCanvasUpdatesCompressor::uploadPixels(createUpdate(QRect(0, 0, 64, 64))), qint64(64 * 64));
+    QCOMPARE(KisCanvasUpdatesCompressor::uploadPixels(createUpdate(QRect(0, 0, 64, 64), 1)), qint64(32 * 32));
+
+    KisUpdateInfoSP a = createUpdate(QRect(0, 0, 128, 128), 1);
+    KisUpdateInfoSP b = createUpdate(QRect(128, 0, 128, 128), 1);
+    KisUpdateInfoSP c = createUpdate(QRect(256, 0, 128, 128), 1);
+
+    KisUpdateInfoList infoObjects = {a, b, c};
+    KisUpdateInfoList carriedOver;
+
+    KisCanvasUpdatesCompressor::splitFrameUploadWork(infoObjects, carriedOver, 2 * 64 * 64);
+
+    QCOMPARE(infoObjects, KisUpdateInfoList({a, b}));
+    QCOMPARE(carriedOver, KisUpdateInfoList({c}));
+}
+
+SIMPLE_TEST_MAIN(KisCanvasUpdatesCompressorTest)
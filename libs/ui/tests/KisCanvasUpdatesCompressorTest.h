@@ -0,0 +1,23 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KISCANVASUPDATESCOMPRESSORTEST_H
+#define KISCANVASUPDATESCOMPRESSORTEST_H
+
+#include <QObject>
+
+class KisCanvasUpdatesCompressorTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testPutBackUpdateInfo();
+    void testPutBackKeepsMarkers();
+    void testSplitFrameUploadWork();
+    void testSplitFrameUploadWorkUploadsAtLeastOne();
+    void testSplitFrameUploadWorkWithMarkers();
+    void testSplitFrameUploadWorkLevelOfDetail();
+};
+
+#endif // KISCANVASUPDATESCOMPRESSORTEST_H
@@ -0,0 +1,213 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestLcmsLutColorConversion.h"
+
+#include <cmath>
+#include <random>
+
+#include <simpletest.h>
+#include <testpigment.h>
+
+#include "kis_debug.h"
+
+#include "KoColorSpace.h"
+#include "KoColorSpaceRegistry.h"
+#include "KoColorModelStandardIds.h"
+#include "KoColorSpaceMaths.h"
+#include "KoLutColorConversionTransformation.h"
+
+namespace {
+
+KoColorConversionTransformation *createExactConverter(const KoColorSpace *srcCs, const KoColorSpace *dstCs)
+{
+    return KoColorSpaceRegistry::instance()->createColorConverter(
+        srcCs, dstCs,
+        KoColorConversionTransformation::internalRenderingIntent(),
+        KoColorConversionTransformation::internalConversionFlags());
+}
+
+KoColorConversionTransformation *createToLabConverter(const KoColorSpace *cs)
+{
+    return createExactConverter(cs, KoColorSpaceRegistry::instance()->lab16());
+}
+
+template<typename channel_t>
+QVector<quint8> randomPixels(int numPixels)
+{
+    const int unit = KoColorSpaceMathsTraits<channel_t>::unitValue;
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> distribution(0, unit);
+
+    QVector<quint8> result(numPixels * 4 * sizeof(channel_t));
+    channel_t *pixel = reinterpret_cast<channel_t*>(result.data());
+
+    for (int i = 0; i < numPixels * 4; i++) {
+        *pixel++ = channel_t(distribution(generator));
+    }
+
+    return result;
+}
+
+}
+
+void TestLcmsLutColorConversion::testDeltaE_data()
+{
+    QTest::addColumn<QString>("srcModel");
+    QTest::addColumn<QString>("srcDepth");
+    QTest::addColumn<QString>("dstModel");
+    QTest::addColumn<QString>("dstDepth");
+    QTest::addColumn<qreal>("tolerance");
+
+    QTest::newRow("rgb8-cmyk8")
+        << RGBAColorModelID.id() << Integer8BitsColorDepthID.id()
+        << CMYKAColorModelID.id() << Integer8BitsColorDepthID.id() << 1.0;
+
+    QTest::newRow("rgb16-cmyk16")
+        << RGBAColorModelID.id() << Integer16BitsColorDepthID.id()
+        << CMYKAColorModelID.id() << Integer16BitsColorDepthID.id() << 1.0;
+
+    QTest::newRow("rgb16-cmyk8")
+        << RGBAColorModelID.id() << Integer16BitsColorDepthID.id()
+        << CMYKAColorModelID.id() << Integer8BitsColorDepthID.id() << 2.0;
+
+    QTest::newRow("rgb8-lab16")
+        << RGBAColorModelID.id() << Integer8BitsColorDepthID.id()
+        << LABAColorModelID.id() << Integer16BitsColorDepthID.id() << 0.5;
+}
+
+void TestLcmsLutColorConversion::testDeltaE()
+{
+    QFETCH(QString, srcModel);
+    QFETCH(QString, srcDepth);
+    QFETCH(QString, dstModel);
+    QFETCH(QString, dstDepth);
+    QFETCH(qreal, tolerance);
+
+    const KoColorSpace *srcCs = KoColorSpaceRegistry::instance()->colorSpace(srcModel, srcDepth, 0);
+    const KoColorSpace *dstCs = KoColorSpaceRegistry::instance()->colorSpace(dstModel, dstDepth, 0);
+    QVERIFY(srcCs);
+    QVERIFY(dstCs);
+
+    QScopedPointer<KoColorConversionTransformation> exact(createExactConverter(srcCs, dstCs));
+    QScopedPointer<KoColorConversionTransformation> toLab(createToLabConverter(dstCs));
+    QVERIFY(!dynamic_cast<KoLutColorConversionTransformation*>(exact.data()));
+
+    QSharedPointer<const KoColorConversionLut3D> lut =
+        KoLutColorConversionTransformation::createLut(exact.data(), toLab.data(), tolerance);
+    QVERIFY(lut);
+
+    KoLutColorConversionTransformation approximated(srcCs, dstCs,
+                                                    exact->renderingIntent(),
+                                                    exact->conversionFlags(),
+                                                    lut);
+
+    /**
+     * Use an odd number of pixels to cover the tail, which is not
+     * processed with the vector code.
+     */
+    const int numPixels = 65536 + 3;
+
+    const QVector<quint8> src =
+        srcDepth == Integer8BitsColorDepthID.id() ?
+            randomPixels<quint8>(numPixels) : randomPixels<quint16>(numPixels);
+
+    QVector<quint8> exactDst(numPixels * dstCs->pixelSize());
+    QVector<quint8> lutDst(numPixels * dstCs->pixelSize());
+
+    exact->transform(src.constData(), exactDst.data(), numPixels);
+    approximated.transform(src.constData(), lutDst.data(), numPixels);
+
+    QVector<quint16> exactLab(numPixels * 4);
+    QVector<quint16> lutLab(numPixels * 4);
+
+    toLab->transform(exactDst.constData(), reinterpret_cast<quint8*>(exactLab.data()), numPixels);
+    toLab->transform(lutDst.constData(), reinterpret_cast<quint8*>(lutLab.data()), numPixels);
+
+    qreal maxDeltaE = 0.0;
+    qreal sumDeltaE = 0.0;
+
+    for (int i = 0; i < numPixels; i++) {
+        const quint16 *lab1 = exactLab.constData() + 4 * i;
+        const quint16 *lab2 = lutLab.constData() + 4 * i;
+
+        const qreal dL = (qreal(lab1[0]) - lab2[0]) * 100.0 / 65535.0;
+        const qreal da = (qreal(lab1[1]) - lab2[1]) / 257.0;
+        const qreal db = (qreal(lab1[2]) - lab2[2]) / 257.0;
+        const qreal deltaE = std::sqrt(dL * dL + da * da + db * db);
+
+        maxDeltaE = qMax(maxDeltaE, deltaE);
+        sumDeltaE += deltaE;
+
+        const qreal exactAlpha = dstCs->opacityF(exactDst.constData() + i * dstCs->pixelSize());
+        const qreal lutAlpha = dstCs->opacityF(lutDst.constData() + i * dstCs->pixelSize());
+
+        if (std::abs(exactAlpha - lutAlpha) > 1.0 / 255.0) {
+            qDebug() << "Alpha mismatch at pixel" << i << ppVar(exactAlpha) << ppVar(lutAlpha);
+            QFAIL("the alpha channel is not preserved");
+        }
+    }
+
+    const qreal averageDeltaE = sumDeltaE / numPixels;
+
+    qDebug() << ppVar(lut->gridSize) << ppVar(maxDeltaE) << ppVar(averageDeltaE);
+
+    /**
+     * The tolerance is guaranteed for the validation set only, so give
+     * the random colors some margin.
+     */
+    QVERIFY(maxDeltaE <= 1.5 * tolerance);
+    QVERIFY(averageDeltaE <= 0.5 * tolerance);
+}
+
+void TestLcmsLutColorConversion::testTooStrictTolerance()
+{
+    const KoColorSpace *srcCs = KoColorSpaceRegistry::instance()->rgb8();
+    const KoColorSpace *dstCs =
+        KoColorSpaceRegistry::instance()->colorSpace(CMYKAColorModelID.id(), Integer8BitsColorDepthID.id(), 0);
+    QVERIFY(dstCs);
+
+    QScopedPointer<KoColorConversionTransformation> exact(createExactConverter(srcCs, dstCs));
+    QScopedPointer<KoColorConversionTransformation> toLab(createToLabConverter(dstCs));
+
+    // even the rounding of the destination channels doesn't fit
+    QVERIFY(!KoLutColorConversionTransformation::createLut(exact.data(), toLab.data(), 0.001));
+}
+
+void TestLcmsLutColorConversion::testUnsupportedConversions()
+{
+    KoColorSpaceRegistry *registry = KoColorSpaceRegistry::instance();
+
+    const KoColorSpace *rgb8 = registry->rgb8();
+    const KoColorSpace *rgb16 = registry->rgb16();
+    const KoColorSpace *rgbF32 = registry->colorSpace(RGBAColorModelID.id(), Float32BitsColorDepthID.id(), 0);
+    const KoColorSpace *cmyk8 = registry->colorSpace(CMYKAColorModelID.id(), Integer8BitsColorDepthID.id(), 0);
+
+    QVERIFY(rgbF32);
+    QVERIFY(cmyk8);
+
+    const KoColorConversionTransformation::ConversionFlags flags =
+        KoColorConversionTransformation::internalConversionFlags();
+
+    QVERIFY(KoLutColorConversionTransformation::canUseLut(rgb8, cmyk8, flags));
+    QVERIFY(KoLutColorConversionTransformation::canUseLut(rgb16, cmyk8, flags));
+
+    // depth-only conversion
+    QVERIFY(!KoLutColorConversionTransformation::canUseLut(rgb8, rgb16, flags));
+
+    // floating point color spaces
+    QVERIFY(!KoLutColorConversionTransformation::canUseLut(rgbF32, cmyk8, flags));
+    QVERIFY(!KoLutColorConversionTransformation::canUseLut(rgb8, rgbF32, flags));
+
+    // non-RGB source
+    QVERIFY(!KoLutColorConversionTransformation::canUseLut(cmyk8, rgb8, flags));
+
+    // gamut check
+    QVERIFY(!KoLutColorConversionTransformation::canUseLut(rgb8, cmyk8, flags | KoColorConversionTransformation::GamutCheck));
+}
+
+KISTEST_MAIN(TestLcmsLutColorConversion)
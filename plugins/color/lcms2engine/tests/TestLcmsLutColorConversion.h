@@ -0,0 +1,22 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TESTLCMSLUTCOLORCONVERSION_H
+#define TESTLCMSLUTCOLORCONVERSION_H
+
+#include <QObject>
+
+class TestLcmsLutColorConversion : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testDeltaE_data();
+    void testDeltaE();
+    void testTooStrictTolerance();
+    void testUnsupportedConversions();
+};
+
+#endif // TESTLCMSLUTCOLORCONVERSION_H
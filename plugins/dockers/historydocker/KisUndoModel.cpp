@@ -45,6 +45,7 @@
 ****************************************************************************/
 #include "KisUndoModel.h"
 #include <klocalizedstring.h>
+#include <kformat.h>
 
 KisUndoModel::KisUndoModel(QObject *parent)
     : QAbstractItemModel(parent)
@@ -208,6 +209,18 @@ QVariant KisUndoModel::data(const QModelIndex &index, int role) const
             QString("%1 (Merged %2)").arg(currentCommand->text().toString()).arg(calcNumMergedCommands(currentCommand)) :
             currentCommand->text().toString();
     }
+    else if (role == Qt::ToolTipRole) {
+        if (index.row() > 0) {
+            const KUndo2Command* currentCommand = m_stack->command(index.row() - 1);
+            const qint64 memoryUsage = currentCommand->memoryUsage();
+
+            if (memoryUsage > 0) {
+                return i18nc("@info:tooltip", "%1\nUndo data: %2",
+                             currentCommand->text().toString(),
+                             KFormat().formatByteSize(memoryUsage));
+            }
+        }
+    }
     else if (role == Qt::DecorationRole) {
         if (index.row() > 0) {
             const KUndo2Command* currentCommand = m_stack->command(index.row() - 1);